@@ -52,10 +52,37 @@ typedef enum {
     INTERRUPT_MAX,          /*!< Maximum interrupt */
 } nesl_interrupt_e;
 
+/*!
+ * @enum nesl_subsystem_e
+ * @brief Subsystem type, hashed separately to locate state divergence.
+ */
+typedef enum {
+    SUBSYSTEM_BUS = 0,      /*!< Bus cycle */
+    SUBSYSTEM_AUDIO,        /*!< Audio subsystem */
+    SUBSYSTEM_INPUT,        /*!< Input subsystem */
+    SUBSYSTEM_MAPPER,       /*!< Mapper subsystem, including the cartridge RAM */
+    SUBSYSTEM_PROCESSOR,    /*!< Processor subsystem */
+    SUBSYSTEM_VIDEO,        /*!< Video subsystem */
+    SUBSYSTEM_MAX,          /*!< Maximum subsystem */
+} nesl_subsystem_e;
+
+/*!
+ * @struct nesl_bus_t
+ * @brief Bus context (opaque, owned by the bus).
+ */
+typedef struct nesl_bus_s nesl_bus_t;
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
 
+/*!
+ * @brief Capture bus and subsystem state, bound to the calling thread, into the bus owned capture state. Only the RAM pages
+ *        written since the last capture or restore are copied, making per-frame captures cheap.
+ * @return Constant pointer to capture state, in the format written by nesl_bus_save (valid until the bus is uninitialized)
+ */
+const void *nesl_bus_capture(void);
+
 /*!
  * @brief Cycle bus and subsystems through one cycle.
  * @return true if frame is complete, false otherwise
@@ -63,12 +90,43 @@ extern "C" {
 bool nesl_bus_cycle(void);
 
 /*!
- * @brief Initialize bus and subsystems.
- * @param[in] data Constant pointer to cartridge data
- * @param[in] length Cartridge data length in bytes
+ * @brief Get bus context bound to the calling thread.
+ * @return Pointer to bus context, or NULL if unbound
+ */
+nesl_bus_t *nesl_bus_get(void);
+
+/*!
+ * @brief Get bus battery save status, failing if the cartridge battery save could not be mapped and program RAM will not persist.
+ * @return NESL_FAILURE if the battery save could not be mapped, NESL_SUCCESS otherwise
+ */
+nesl_error_e nesl_bus_get_battery(void);
+
+/*!
+ * @brief Get bus error, failing once a subsystem has failed outside of an operation returning an error (audio recording).
+ * @return NESL_FAILURE if a subsystem failed, NESL_SUCCESS otherwise
+ */
+nesl_error_e nesl_bus_get_error(void);
+
+/*!
+ * @brief Get bus reset count, counting reset interrupts since initialization.
+ * @return Reset count
+ */
+uint32_t nesl_bus_get_reset(void);
+
+/*!
+ * @brief Hash bus and subsystem state, bound to the calling thread, per subsystem. The state is taken through a capture, so this
+ *        must not be called between a capture and the restore relying on it.
+ * @param[out] hash Pointer to subsystem hashes, one per subsystem type
+ */
+void nesl_bus_hash(uint64_t *hash);
+
+/*!
+ * @brief Initialize bus and subsystems from a single arena sized from the cartridge header, binding the new bus context to the
+ *        calling thread.
+ * @param[in] context Constant pointer to NESL context (cartridge data and options)
  * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
  */
-nesl_error_e nesl_bus_initialize(const void *data, int length);
+nesl_error_e nesl_bus_initialize(const nesl_t *context);
 
 /*!
  * @brief Send bus interrupt to subsystems.
@@ -77,6 +135,20 @@ nesl_error_e nesl_bus_initialize(const void *data, int length);
  */
 nesl_error_e nesl_bus_interrupt(nesl_interrupt_e type);
 
+/*!
+ * @brief Load bus and subsystem state, bound to the calling thread. The state must come from a bus with the same cartridge data.
+ * @param[in] data Constant pointer to state data, written by nesl_bus_save
+ * @return State length in bytes
+ */
+size_t nesl_bus_load(const void *data);
+
+/*!
+ * @brief Load bus and subsystem state, bound to the calling thread, from a save slot, if save slots are enabled and the slot holds
+ *        a valid state.
+ * @param[in] index Save slot index
+ */
+void nesl_bus_load_slot(int index);
+
 /*!
  * @brief Read byte from bus subsystems.
  * @param[in] type Bus type
@@ -86,9 +158,51 @@ nesl_error_e nesl_bus_interrupt(nesl_interrupt_e type);
 uint8_t nesl_bus_read(nesl_bus_e type, uint16_t address);
 
 /*!
- * @brief Uninitialize bus and subsystems.
+ * @brief Rewind bus and subsystems bound to the calling thread to the start of the previous frame, if the rewind buffer holds it.
+ *        The previous frame is emulated again on the next cycles, so rewinding every frame steps backwards through the held frames.
+ */
+void nesl_bus_rewind(void);
+
+/*!
+ * @brief Restore bus and subsystem state, bound to the calling thread, from the last capture. Only the RAM pages written since
+ *        the last capture or restore are copied back.
+ */
+void nesl_bus_restore(void);
+
+/*!
+ * @brief Save bus and subsystem state, bound to the calling thread. Audio output buffers are not part of the state.
+ * @param[out] data Pointer to state data, or NULL to query the state length
+ * @return State length in bytes
+ */
+size_t nesl_bus_save(void *data);
+
+/*!
+ * @brief Save bus and subsystem state, bound to the calling thread, to a save slot, if save slots are enabled. The state is
+ *        captured on the calling thread, then compressed and written to disk in the background.
+ * @param[in] index Save slot index
+ * @return NESL_FAILURE if an earlier save slot write failed, NESL_SUCCESS otherwise
+ */
+nesl_error_e nesl_bus_save_slot(int index);
+
+/*!
+ * @brief Bind bus context to the calling thread.
+ * @param[in] bus Pointer to bus context, or NULL to unbind
+ */
+void nesl_bus_set(nesl_bus_t *bus);
+
+/*!
+ * @brief Hide video and/or audio output of the following frames on the bus bound to the calling thread, for run-ahead. Frames
+ *        with hidden audio are speculative, and are not pushed to the rewind buffer.
+ * @param[in] video Hide video output
+ * @param[in] audio Hide audio output
+ */
+void nesl_bus_set_hidden(bool video, bool audio);
+
+/*!
+ * @brief Uninitialize bus and subsystems bound to the calling thread.
+ * @return NESL_FAILURE if a subsystem could not complete its output (audio recording), NESL_SUCCESS otherwise
  */
-void nesl_bus_uninitialize(void);
+nesl_error_e nesl_bus_uninitialize(void);
 
 /*!
  * @brief Write byte to bus subsystems.
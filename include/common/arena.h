@@ -0,0 +1,75 @@
+/*
+ * NESL
+ * Copyright (C) 2022 David Jolly
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+ * @file arena.h
+ * @brief Common per-instance memory arena.
+ */
+
+#ifndef NESL_ARENA_H_
+#define NESL_ARENA_H_
+
+#include <common.h>
+
+#define ARENA_ALIGNMENT 64                                                                  /*!< Arena allocation alignment in bytes */
+#define ARENA_SIZE(_SIZE_) ((((size_t)(_SIZE_)) + (ARENA_ALIGNMENT - 1)) & ~((size_t)ARENA_ALIGNMENT - 1))   /*!< Arena allocation size in bytes */
+
+/*!
+ * @struct nesl_arena_t
+ * @brief Arena context, handing out zeroed blocks from a single allocation sized up front.
+ */
+typedef struct {
+    uint8_t *data;                          /*!< Arena memory */
+    size_t capacity;                        /*!< Arena capacity in bytes */
+    size_t offset;                          /*!< Arena allocated length in bytes */
+} nesl_arena_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*!
+ * @brief Allocate zeroed block from arena.
+ * @param[in,out] arena Pointer to arena context
+ * @param[in] size Block size in bytes
+ * @return Pointer to block, aligned to ARENA_ALIGNMENT, or NULL if the arena is exhausted
+ */
+void *nesl_arena_allocate(nesl_arena_t *arena, size_t size);
+
+/*!
+ * @brief Initialize arena.
+ * @param[in,out] arena Pointer to arena context
+ * @param[in] capacity Arena capacity in bytes, as a sum of ARENA_SIZE block sizes
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+nesl_error_e nesl_arena_initialize(nesl_arena_t *arena, size_t capacity);
+
+/*!
+ * @brief Uninitialize arena, releasing every block allocated from it.
+ * @param[in,out] arena Pointer to arena context
+ */
+void nesl_arena_uninitialize(nesl_arena_t *arena);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* NESL_ARENA_H_ */
@@ -0,0 +1,62 @@
+/*
+ * NESL
+ * Copyright (C) 2022 David Jolly
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+ * @file cache.h
+ * @brief Common process-wide ROM cache.
+ */
+
+#ifndef NESL_CACHE_H_
+#define NESL_CACHE_H_
+
+#include <hash.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*!
+ * @brief Acquire read-only ROM image with the same contents as the caller's data, copying it into the cache on first use.
+ *        Instances acquiring identical data share one reference-counted image.
+ * @param[out] image Pointer to constant ROM image pointer
+ * @param[in] data Constant pointer to ROM data
+ * @param[in] length ROM data length in bytes
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+nesl_error_e nesl_cache_acquire(const void **image, const void *data, int length);
+
+/*!
+ * @brief Release ROM image, freeing it when the last reference is released.
+ * @param[in] image Constant pointer to ROM image (can be NULL or data not held by the cache)
+ */
+void nesl_cache_release(const void *image);
+
+/*!
+ * @brief Retain an acquired ROM image, adding a reference without rehashing its contents.
+ * @param[in] image Constant pointer to ROM image (can be NULL or data not held by the cache)
+ */
+void nesl_cache_retain(const void *image);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* NESL_CACHE_H_ */
@@ -0,0 +1,63 @@
+/*
+ * NESL
+ * Copyright (C) 2022 David Jolly
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+ * @file dirty.h
+ * @brief Common dirty page bitmap, tracking the pages of a buffer written since it was last copied.
+ */
+
+#ifndef NESL_DIRTY_H_
+#define NESL_DIRTY_H_
+
+#include <common.h>
+
+#define DIRTY_SHIFT 6                                                                   /*!< Dirty page shift (64 byte pages) */
+#define DIRTY_WORD (64 << DIRTY_SHIFT)                                                  /*!< Buffer length covered by a bitmap word in bytes */
+#define DIRTY_WORDS(_LENGTH_) (((_LENGTH_) + DIRTY_WORD - 1) / DIRTY_WORD)              /*!< Bitmap length in words, for a buffer length in bytes */
+#define DIRTY_SET(_DIRTY_, _OFFSET_) \
+    ((_DIRTY_)[(_OFFSET_) / DIRTY_WORD] |= (1ULL << (((_OFFSET_) >> DIRTY_SHIFT) & 63)))  /*!< Mark the page holding a buffer offset dirty */
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*!
+ * @brief Copy dirty pages between buffers, clearing the bitmap.
+ * @param[in,out] dirty Pointer to dirty bitmap
+ * @param[out] destination Pointer to destination buffer
+ * @param[in] source Constant pointer to source buffer
+ * @param[in] length Buffer length in bytes
+ * @return Buffer length in bytes
+ */
+size_t nesl_dirty_copy(uint64_t *dirty, void *destination, const void *source, size_t length);
+
+/*!
+ * @brief Mark all pages dirty, forcing the next copy to copy the entire buffer.
+ * @param[out] dirty Pointer to dirty bitmap
+ * @param[in] length Buffer length in bytes
+ */
+void nesl_dirty_set(uint64_t *dirty, size_t length);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* NESL_DIRTY_H_ */
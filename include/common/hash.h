@@ -0,0 +1,54 @@
+/*
+ * NESL
+ * Copyright (C) 2022 David Jolly
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+ * @file hash.h
+ * @brief Common 64-bit content hash.
+ */
+
+#ifndef NESL_HASH_H_
+#define NESL_HASH_H_
+
+#include <common.h>
+
+#define HASH_MULTIPLIER_0 0x87C37B91114253D5ULL /*!< Word multiplier */
+#define HASH_MULTIPLIER_1 0x4CF5AD432745937FULL /*!< Accumulator multiplier */
+#define HASH_MULTIPLIER_2 0xFF51AFD7ED558CCDULL /*!< First finalizer multiplier */
+#define HASH_MULTIPLIER_3 0xC4CEB9FE1A85EC53ULL /*!< Second finalizer multiplier */
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*!
+ * @brief Hash data array (not cryptographic, stable across runs and hosts of the same byte order).
+ * @param[in] data Constant pointer to data array
+ * @param[in] length Data array length in bytes
+ * @param[in] seed Hash seed, or a previous hash to chain arrays
+ * @return 64-bit hash
+ */
+uint64_t nesl_hash(const void *data, size_t length, uint64_t seed);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* NESL_HASH_H_ */
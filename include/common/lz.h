@@ -0,0 +1,66 @@
+/*
+ * NESL
+ * Copyright (C) 2022 David Jolly
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+ * @file lz.h
+ * @brief Common LZ codec, a byte-aligned LZ77 block format with greedy hash matching, tuned for fast decompression.
+ */
+
+#ifndef NESL_LZ_H_
+#define NESL_LZ_H_
+
+#include <common.h>
+
+#define LZ_BOUND(_LENGTH_) ((_LENGTH_) + ((_LENGTH_) / 255) + 16) /*!< Worst case compressed length in bytes */
+#define LZ_HASH 12                          /*!< Match hash table size in bits */
+#define LZ_MATCH 4                          /*!< Minimum match length in bytes */
+#define LZ_OFFSET 65535                     /*!< Maximum match offset in bytes */
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*!
+ * @brief Compress data as sequences of a token (literal length << 4 | match length - 4, 15 extended by bytes up to 255),
+ *        literals and a 16-bit match offset, ending with a literal-only sequence.
+ * @param[in] data Constant pointer to data
+ * @param[in] length Data length in bytes
+ * @param[out] compressed Pointer to compressed data
+ * @param[in] capacity Compressed data capacity in bytes (LZ_BOUND always fits)
+ * @return Compressed length in bytes, or 0 if the compressed data does not fit
+ */
+size_t nesl_lz_compress(const void *data, size_t length, void *compressed, size_t capacity);
+
+/*!
+ * @brief Decompress data, rejecting malformed data.
+ * @param[in] compressed Constant pointer to compressed data
+ * @param[in] length Compressed length in bytes
+ * @param[out] data Pointer to data
+ * @param[in] capacity Data capacity in bytes
+ * @return Data length in bytes, or 0 if the compressed data is malformed or does not fit
+ */
+size_t nesl_lz_decompress(const void *compressed, size_t length, void *data, size_t capacity);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* NESL_LZ_H_ */
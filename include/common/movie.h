@@ -0,0 +1,129 @@
+/*
+ * NESL
+ * Copyright (C) 2022 David Jolly
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+ * @file movie.h
+ * @brief Input movie, holding per-frame controller input and reset events, with periodic keyframe states for seeking.
+ */
+
+#ifndef NESL_MOVIE_H_
+#define NESL_MOVIE_H_
+
+#include <common.h>
+
+#define MOVIE_INTERVAL 600                  /*!< Keyframe interval in frames */
+#define MOVIE_MAGIC "NMV\x1A"               /*!< Input movie magic number */
+#define MOVIE_PORTS 1                       /*!< Controller ports, one byte of button bits per port per frame */
+#define MOVIE_VERSION 1                     /*!< Input movie version */
+
+/*!
+ * @struct nesl_movie_header_t
+ * @brief Input movie header, followed by the input, the reset frame indices and the keyframe states.
+ */
+typedef struct {
+    char magic[4];                          /*!< Magic number */
+    uint32_t version;                       /*!< Input movie version */
+    uint64_t hash;                          /*!< Cartridge data hash */
+    uint32_t frames;                        /*!< Frame count */
+    uint32_t ports;                         /*!< Controller ports */
+    uint32_t interval;                      /*!< Keyframe interval in frames */
+    uint32_t resets;                        /*!< Reset count */
+    uint32_t keyframes;                     /*!< Keyframe count */
+    uint32_t length;                        /*!< Keyframe state length in bytes */
+} nesl_movie_header_t;
+
+/*!
+ * @struct nesl_movie_t
+ * @brief Input movie context.
+ */
+typedef struct {
+    nesl_movie_header_t header;             /*!< Input movie header */
+    uint8_t *input;                         /*!< Input, one byte of button bits per port per frame */
+    uint32_t *reset;                        /*!< Reset frame indices, in ascending order */
+    uint8_t *state;                         /*!< Keyframe states, one every interval frames from the first frame */
+
+    struct {
+        uint32_t input;                     /*!< Input capacity in frames */
+        uint32_t reset;                     /*!< Reset capacity in entries */
+        uint32_t state;                     /*!< Keyframe capacity in states */
+    } capacity;
+} nesl_movie_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*!
+ * @brief Append frame to input movie, storing a keyframe state on every interval frame.
+ * @param[in,out] movie Pointer to input movie context
+ * @param[in] input Constant pointer to input, one byte of button bits per port
+ * @param[in] reset Reset before the frame
+ * @param[in] state Constant pointer to state at the start of the frame, before any reset
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+nesl_error_e nesl_movie_append(nesl_movie_t *movie, const uint8_t *input, bool reset, const void *state);
+
+/*!
+ * @brief Initialize empty input movie for recording.
+ * @param[in,out] movie Pointer to input movie context
+ * @param[in] hash Cartridge data hash
+ * @param[in] length Keyframe state length in bytes
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+nesl_error_e nesl_movie_initialize(nesl_movie_t *movie, uint64_t hash, uint32_t length);
+
+/*!
+ * @brief Check if an input movie resets before a frame.
+ * @param[in] movie Constant pointer to input movie context
+ * @param[in] frame Frame index
+ * @return true if reset before the frame, false otherwise
+ */
+bool nesl_movie_is_reset(const nesl_movie_t *movie, uint32_t frame);
+
+/*!
+ * @brief Read input movie from path, matching the expected cartridge data hash and keyframe state length.
+ * @param[in,out] movie Pointer to input movie context
+ * @param[in] path Constant pointer to input movie path string
+ * @param[in] hash Cartridge data hash
+ * @param[in] length Keyframe state length in bytes
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+nesl_error_e nesl_movie_read(nesl_movie_t *movie, const char *path, uint64_t hash, uint32_t length);
+
+/*!
+ * @brief Uninitialize input movie.
+ * @param[in,out] movie Pointer to input movie context
+ */
+void nesl_movie_uninitialize(nesl_movie_t *movie);
+
+/*!
+ * @brief Write input movie to path.
+ * @param[in] movie Constant pointer to input movie context
+ * @param[in] path Constant pointer to input movie path string
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+nesl_error_e nesl_movie_write(const nesl_movie_t *movie, const char *path);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* NESL_MOVIE_H_ */
@@ -0,0 +1,126 @@
+/*
+ * NESL
+ * Copyright (C) 2022 David Jolly
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+ * @file pool.h
+ * @brief Common work-stealing thread pool.
+ */
+
+#ifndef NESL_POOL_H_
+#define NESL_POOL_H_
+
+#include <stdatomic.h>
+#include <common.h>
+
+/*!
+ * @brief Pool task routine, run once for each index of a job.
+ * @param[in,out] context Pointer to task context
+ * @param[in] index Task index
+ */
+typedef void (*nesl_pool_task)(void *context, int index);
+
+/*!
+ * @struct nesl_pool_deque_t
+ * @brief Thread pool deque, holding a contiguous range of unclaimed task indices (one per cache line).
+ */
+typedef struct {
+    _Alignas(64) _Atomic uint64_t range;    /*!< Unclaimed task range, top index (low word) to bottom index (high word) */
+} nesl_pool_deque_t;
+
+/*!
+ * @struct nesl_pool_job_t
+ * @brief Thread pool job context.
+ */
+typedef struct {
+    nesl_pool_task task;                    /*!< Task routine */
+    void *context;                          /*!< Task context */
+    int busy;                               /*!< Worker threads running job tasks */
+} nesl_pool_job_t;
+
+struct nesl_pool_s;
+
+/*!
+ * @struct nesl_pool_worker_t
+ * @brief Thread pool worker context.
+ */
+typedef struct {
+    struct nesl_pool_s *pool;               /*!< Pointer to thread pool context */
+    pthread_t thread;                       /*!< Worker thread */
+    int index;                              /*!< Worker index (also its deque index) */
+} nesl_pool_worker_t;
+
+/*!
+ * @struct nesl_pool_s
+ * @brief Thread pool context.
+ */
+
+/*!
+ * @struct nesl_pool_t
+ * @brief Thread pool context.
+ */
+typedef struct nesl_pool_s {
+    nesl_pool_worker_t *worker;             /*!< Worker threads */
+    nesl_pool_deque_t *deque;               /*!< Deques, one per worker thread followed by one for the calling thread */
+    int count;                              /*!< Worker thread count */
+    bool affinity;                          /*!< Worker threads pinned to processors */
+    nesl_pool_job_t *job;                   /*!< Queued job (NULL if none) */
+    uint32_t generation;                    /*!< Job generation, incremented for each queued job */
+    pthread_mutex_t lock;                   /*!< Mutex */
+    pthread_cond_t signal;                  /*!< Condition signalled when a job is queued or the pool stops */
+    pthread_cond_t complete;                /*!< Condition signalled when a worker thread leaves a job */
+    bool running;                           /*!< Worker threads running flag */
+} nesl_pool_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*!
+ * @brief Initialize thread pool, starting the worker threads.
+ * @param[in,out] pool Pointer to thread pool context
+ * @param[in] count Worker thread count (the calling thread also runs tasks, 0 runs every task on the calling thread)
+ * @param[in] affinity Pin each worker thread to its own processor (calling thread keeps the first processor)
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+nesl_error_e nesl_pool_initialize(nesl_pool_t *pool, int count, bool affinity);
+
+/*!
+ * @brief Run a job on the thread pool, returning once every task has completed. Tasks are split into contiguous ranges,
+ *        one per deque, rotating between jobs; threads drain their own range from the bottom, then steal from the top of
+ *        the others. Jobs must not be run concurrently on the same pool.
+ * @param[in,out] pool Pointer to thread pool context
+ * @param[in] task Pointer to task routine
+ * @param[in,out] context Pointer to task context
+ * @param[in] count Task count
+ */
+void nesl_pool_run(nesl_pool_t *pool, nesl_pool_task task, void *context, int count);
+
+/*!
+ * @brief Uninitialize thread pool, stopping the worker threads.
+ * @param[in,out] pool Pointer to thread pool context
+ */
+void nesl_pool_uninitialize(nesl_pool_t *pool);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* NESL_POOL_H_ */
@@ -0,0 +1,115 @@
+/*
+ * NESL
+ * Copyright (C) 2022 David Jolly
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+ * @file replay.h
+ * @brief Replay hashes, holding per-frame hashes of an input movie playback for verification.
+ */
+
+#ifndef NESL_REPLAY_H_
+#define NESL_REPLAY_H_
+
+#include <common.h>
+
+#define REPLAY_MAGIC "NRH\x1A"              /*!< Replay hashes magic number */
+#define REPLAY_VERSION 1                    /*!< Replay hashes version */
+
+/*!
+ * @struct nesl_replay_header_t
+ * @brief Replay hashes header, followed by the hashes of every frame.
+ */
+typedef struct {
+    char magic[4];                          /*!< Magic number */
+    uint32_t version;                       /*!< Replay hashes version */
+    uint64_t hash;                          /*!< Cartridge data hash */
+    uint32_t frames;                        /*!< Frame count */
+    uint32_t count;                         /*!< Hash count per frame */
+} nesl_replay_header_t;
+
+/*!
+ * @struct nesl_replay_t
+ * @brief Replay hashes context.
+ */
+typedef struct {
+    nesl_replay_header_t header;            /*!< Replay hashes header */
+    uint64_t *hash;                         /*!< Hashes, count per frame */
+    uint32_t capacity;                      /*!< Hash capacity in frames */
+} nesl_replay_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*!
+ * @brief Append frame hashes to replay hashes.
+ * @param[in,out] replay Pointer to replay hashes context
+ * @param[in] hash Constant pointer to frame hashes, count long
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+nesl_error_e nesl_replay_append(nesl_replay_t *replay, const uint64_t *hash);
+
+/*!
+ * @brief Compare frame hashes against replay hashes.
+ * @param[in] replay Constant pointer to replay hashes context
+ * @param[in] frame Frame index
+ * @param[in] hash Constant pointer to frame hashes, count long
+ * @return Index of the first differing hash, count if the frame is past the last frame, or -1 if every hash matches
+ */
+int nesl_replay_compare(const nesl_replay_t *replay, uint32_t frame, const uint64_t *hash);
+
+/*!
+ * @brief Initialize empty replay hashes for recording.
+ * @param[in,out] replay Pointer to replay hashes context
+ * @param[in] hash Cartridge data hash
+ * @param[in] count Hash count per frame
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+nesl_error_e nesl_replay_initialize(nesl_replay_t *replay, uint64_t hash, uint32_t count);
+
+/*!
+ * @brief Read replay hashes from path, matching the expected cartridge data hash and hash count per frame.
+ * @param[in,out] replay Pointer to replay hashes context
+ * @param[in] path Constant pointer to replay hashes path string
+ * @param[in] hash Cartridge data hash
+ * @param[in] count Hash count per frame
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+nesl_error_e nesl_replay_read(nesl_replay_t *replay, const char *path, uint64_t hash, uint32_t count);
+
+/*!
+ * @brief Uninitialize replay hashes.
+ * @param[in,out] replay Pointer to replay hashes context
+ */
+void nesl_replay_uninitialize(nesl_replay_t *replay);
+
+/*!
+ * @brief Write replay hashes to path.
+ * @param[in] replay Constant pointer to replay hashes context
+ * @param[in] path Constant pointer to replay hashes path string
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+nesl_error_e nesl_replay_write(const nesl_replay_t *replay, const char *path);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* NESL_REPLAY_H_ */
@@ -0,0 +1,122 @@
+/*
+ * NESL
+ * Copyright (C) 2022 David Jolly
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+ * @file rewind.h
+ * @brief Rewind buffer, holding per-frame states as XOR/RLE deltas against LZ compressed keyframes.
+ */
+
+#ifndef NESL_REWIND_H_
+#define NESL_REWIND_H_
+
+#include <lz.h>
+
+#define REWIND_INTERVAL 60                  /*!< Keyframe interval in frames */
+#define REWIND_RECORD 256                   /*!< Expected record length in bytes, sizing the entry ring */
+#define REWIND_RUN 128                      /*!< Maximum encoded run length in bytes */
+#define REWIND_BOUND(_LENGTH_) ((_LENGTH_) + ((_LENGTH_) / REWIND_RUN) + 16) /*!< Record capacity in bytes (covering LZ_BOUND), larger deltas are pushed as keyframes */
+
+/*!
+ * @struct nesl_rewind_entry_t
+ * @brief Rewind entry, locating one record in the data ring.
+ */
+typedef struct {
+    size_t offset;                          /*!< Record offset in bytes */
+    size_t length;                          /*!< Record length in bytes */
+    bool keyframe;                          /*!< Keyframe record (LZ compressed), otherwise a delta against the previous keyframe */
+} nesl_rewind_entry_t;
+
+/*!
+ * @struct nesl_rewind_t
+ * @brief Rewind context, bounded to a single allocation sized up front.
+ */
+typedef struct {
+    size_t length;                          /*!< State length in bytes */
+    uint8_t *state;                         /*!< State buffer, free for the caller to stage states */
+    uint8_t *record;                        /*!< Record buffer, holding REWIND_BOUND bytes */
+
+    struct {
+        uint8_t *state;                     /*!< Keyframe state, referenced by deltas */
+        int count;                          /*!< Delta count since keyframe */
+        bool valid;                         /*!< Keyframe state valid */
+    } keyframe;
+
+    struct {
+        uint8_t *data;                      /*!< Data ring */
+        size_t capacity;                    /*!< Data ring capacity in bytes */
+        size_t head;                        /*!< Data ring offset after the newest record */
+    } data;
+
+    struct {
+        nesl_rewind_entry_t *data;          /*!< Entry ring */
+        int capacity;                       /*!< Entry ring capacity in entries */
+        int tail;                           /*!< Entry ring index of the oldest entry */
+        int count;                          /*!< Entry ring count in entries */
+    } entry;
+} nesl_rewind_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*!
+ * @brief Initialize rewind buffer.
+ * @param[in,out] rewind Pointer to rewind context
+ * @param[in] capacity Rewind capacity in bytes, including the state buffers and the entry ring
+ * @param[in] length State length in bytes
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+nesl_error_e nesl_rewind_initialize(nesl_rewind_t *rewind, size_t capacity, size_t length);
+
+/*!
+ * @brief Peek newest state in rewind buffer, without removing it.
+ * @param[in,out] rewind Pointer to rewind context
+ * @param[out] state Pointer to state
+ * @return true if a state was decoded, false if the rewind buffer is empty
+ */
+bool nesl_rewind_peek(nesl_rewind_t *rewind, void *state);
+
+/*!
+ * @brief Pop newest state from rewind buffer, discarding it.
+ * @param[in,out] rewind Pointer to rewind context
+ * @return true if a state was popped, false if the rewind buffer is empty
+ */
+bool nesl_rewind_pop(nesl_rewind_t *rewind);
+
+/*!
+ * @brief Push state into rewind buffer, evicting the oldest states (and deltas depending on them) if full. A delta that does not
+ *        fit in REWIND_BOUND bytes is pushed as a keyframe instead.
+ * @param[in,out] rewind Pointer to rewind context
+ * @param[in] state Constant pointer to state
+ */
+void nesl_rewind_push(nesl_rewind_t *rewind, const void *state);
+
+/*!
+ * @brief Uninitialize rewind buffer.
+ * @param[in,out] rewind Pointer to rewind context
+ */
+void nesl_rewind_uninitialize(nesl_rewind_t *rewind);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* NESL_REWIND_H_ */
@@ -0,0 +1,117 @@
+/*
+ * NESL
+ * Copyright (C) 2022 David Jolly
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+ * @file slot.h
+ * @brief Save slots, holding numbered states written to disk by a background thread.
+ */
+
+#ifndef NESL_SLOT_H_
+#define NESL_SLOT_H_
+
+#include <lz.h>
+
+#define SLOT_COUNT 9                        /*!< Save slot count */
+#define SLOT_MAGIC "NSL\x1A"                /*!< Save slot magic number */
+
+/*!
+ * @struct nesl_slot_header_t
+ * @brief Save slot header, followed by the LZ compressed state.
+ */
+typedef struct {
+    char magic[4];                          /*!< Magic number */
+    uint32_t slot;                          /*!< Save slot index */
+    uint64_t hash;                          /*!< Cartridge data hash */
+    uint64_t length;                        /*!< State length in bytes */
+    uint64_t compressed;                    /*!< Compressed state length in bytes */
+    uint64_t checksum;                      /*!< State hash */
+} nesl_slot_header_t;
+
+/*!
+ * @struct nesl_slot_t
+ * @brief Save slot context, with every buffer allocated up front.
+ */
+typedef struct {
+    const char *directory;                  /*!< Save slot directory path */
+    uint64_t hash;                          /*!< Cartridge data hash */
+    size_t length;                          /*!< State length in bytes (0 if disabled) */
+    uint8_t *data;                          /*!< Buffer allocation */
+    uint8_t *state[SLOT_COUNT];             /*!< Pending states, copied in by the emulation thread */
+    bool pending[SLOT_COUNT];               /*!< Pending state flags */
+    uint8_t *load;                          /*!< Loaded state */
+
+    struct {
+        pthread_t thread;                   /*!< Writer thread */
+        pthread_mutex_t lock;               /*!< Mutex, guarding the pending states and the writer state */
+        pthread_cond_t condition;           /*!< Condition, signaled when a state is pending or the writer should quit */
+        uint8_t *state;                     /*!< Writer state, swapped with the pending state it writes */
+        uint8_t *compressed;                /*!< Writer compressed state */
+        int active;                         /*!< Save slot index being written (-1 if none) */
+        int failed;                         /*!< Save slot index of the last failed write */
+        int error;                          /*!< Error number of the last failed write, until reported (0 if none) */
+        bool quit;                          /*!< Writer quit flag */
+    } writer;
+} nesl_slot_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*!
+ * @brief Initialize save slots, starting the writer thread. The directory must be writable.
+ * @param[in,out] slot Pointer to save slot context
+ * @param[in] directory Constant pointer to save slot directory path string
+ * @param[in] hash Cartridge data hash, keying the save slot files
+ * @param[in] length State length in bytes
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+nesl_error_e nesl_slot_initialize(nesl_slot_t *slot, const char *directory, uint64_t hash, size_t length);
+
+/*!
+ * @brief Load state from save slot, taken from a save still pending or being written, or from its file through a read-only
+ *        mapping, checked against its checksum.
+ * @param[in,out] slot Pointer to save slot context
+ * @param[in] index Save slot index
+ * @return Constant pointer to state, or NULL if the save slot is empty or invalid
+ */
+const void *nesl_slot_load(nesl_slot_t *slot, int index);
+
+/*!
+ * @brief Save state to save slot, copying it into the slot's pending state for the writer thread to compress, write and sync.
+ *        A failed write is recorded by the writer thread and reported by the next save.
+ * @param[in,out] slot Pointer to save slot context
+ * @param[in] index Save slot index
+ * @param[in] state Constant pointer to state
+ * @return NESL_FAILURE if an earlier write failed, NESL_SUCCESS otherwise
+ */
+nesl_error_e nesl_slot_save(nesl_slot_t *slot, int index, const void *state);
+
+/*!
+ * @brief Uninitialize save slots, writing any pending states before stopping the writer thread.
+ * @param[in,out] slot Pointer to save slot context
+ */
+void nesl_slot_uninitialize(nesl_slot_t *slot);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* NESL_SLOT_H_ */
@@ -27,9 +27,18 @@
 #ifndef NESL_H_
 #define NESL_H_
 
+#include <stdint.h>
+
 #define NESL_API_VERSION_1 1                    /*!< Interface version 1 */
 #define NESL_API_VERSION NESL_API_VERSION_1     /*!< Current interface version */
 
+#define NESL_STATE_VERSION_1 1                  /*!< Save-state version 1 */
+#define NESL_STATE_VERSION_2 2                  /*!< Save-state version 2, adding compressed save-states */
+#define NESL_STATE_VERSION NESL_STATE_VERSION_2 /*!< Current save-state version */
+
+#define NESL_DISPLAY_HEIGHT 240                 /*!< Display height in pixels */
+#define NESL_DISPLAY_WIDTH 256                  /*!< Display width in pixels */
+
 /*!
  * @enum nesl_error_e
  * @brief NESL error code.
@@ -40,18 +49,61 @@ typedef enum {
     NESL_QUIT,                                  /*!< Internal event, assume operation succeeded */
 } nesl_error_e;
 
+/*!
+ * @enum nesl_service_e
+ * @brief NESL service backend.
+ */
+typedef enum {
+    NESL_SERVICE_SDL = 0,                       /*!< SDL window, audio device and controllers */
+    NESL_SERVICE_HEADLESS,                      /*!< In-memory display, caller supplied input, captured or discarded audio */
+} nesl_service_e;
+
 /*!
  * @struct nesl_t
  * @brief NESL context.
  */
 typedef struct {
-    void *data;                                 /*!< Data */
+    void *data;                                 /*!< Data (copied into a process-wide ROM cache on create, shared by instances with identical data) */
     int length;                                 /*!< Data length in bytes */
+    int mapped;                                 /*!< Data is a caller owned read-only mapping, referenced in place rather than cached, that must outlive the instance (default:false) */
     char *title;                                /*!< Window title (can be NULL) */
     int linear;                                 /*!< Window linear scaling (default:false) */
     int scale;                                  /*!< Window scaling [1-8] (default:1) */
+    int quiet;                                  /*!< Disable audio device output, keeping audio register state (default:false) */
+    char *record;                               /*!< Audio record path, .wav extension selects WAV, otherwise raw PCM (can be NULL) */
+    int rate;                                   /*!< Audio sample rate in Hz (default:44100) */
+    nesl_service_e service;                     /*!< Service backend (default:NESL_SERVICE_SDL) */
+    const unsigned char *input;                 /*!< Headless input, one byte of button bits per frame (A,B,Select,Start,Up,Down,Left,Right from bit 0) (can be NULL) */
+    int input_length;                           /*!< Headless input length in frames, quitting after the last frame (0:unbounded) */
+    int capture;                                /*!< Headless audio capture, otherwise audio is discarded (default:false) */
+    int compact;                                /*!< Headless compact display, keeping palette indices instead of ARGB pixels (default:false) */
+    int ahead;                                  /*!< Run-ahead frames, emulated hidden past each displayed frame to hide game input lag (0:disabled) */
+    int rewind;                                 /*!< Rewind buffer size in MB, holding per-frame states stepped back through by a key (0:disabled) */
+    char *snapshot;                             /*!< Startup snapshot directory, resuming from a post-boot state keyed by ROM hash and core version (can be NULL) */
+    char *movie;                                /*!< Input movie path, recorded from the first frame and written on destroy, disabling rewind (can be NULL) */
+    int playback;                               /*!< Play the input movie back from its first keyframe instead of recording it, quitting after the last frame (default:false) */
+    char *save;                                 /*!< Battery save path, mapping battery-backed program RAM to persist it, disabling the startup snapshot and disabled by an input movie (can be NULL) */
+    char *slot;                                 /*!< Save slot directory, holding numbered states saved and loaded by keys, disabled by an input movie (can be NULL) */
+    char *replay;                               /*!< Replay hashes path, verifying every input movie playback frame against it, or recording it if missing (can be NULL) */
 } nesl_t;
 
+/*!
+ * @struct nesl_instance_t
+ * @brief NESL instance (opaque).
+ */
+typedef struct nesl_instance_s nesl_instance_t;
+
+/*!
+ * @struct nesl_frame_t
+ * @brief NESL frame, pointing into instance owned memory (valid until the next step).
+ */
+typedef struct {
+    const uint32_t *pixel;                      /*!< Display pixels, 256x240 ARGB (NULL if headless compact display is enabled) */
+    const uint16_t *index;                      /*!< Display palette indices, 256x240 (NULL unless headless compact display is enabled) */
+    const void *audio;                          /*!< Audio samples written during the frame (NULL unless headless capture is enabled) */
+    int audio_length;                           /*!< Audio samples length in bytes */
+} nesl_frame_t;
+
 /*!
  * @struct nesl_version_t
  * @brief NESL version.
@@ -74,17 +126,142 @@ extern "C" {
 nesl_error_e nesl(const nesl_t *context);
 
 /*!
- * @brief Get NESL error string.
+ * @brief Clone NESL instance into an independent headless instance at the same machine state, sharing the read-only ROM image
+ *        instead of reloading it. Clones take their display and audio settings from the instance, without window, audio
+ *        recording, headless input, rewind, snapshot or input movie, and may be stepped on other threads while the instance is stepped.
+ *        The instance must not be stepped while it is being cloned.
+ * @param[out] clone Pointer to cloned NESL instance pointer (set to NULL on failure)
+ * @param[in] instance Constant pointer to NESL instance
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+nesl_error_e nesl_clone(nesl_instance_t **clone, const nesl_instance_t *instance);
+
+/*!
+ * @brief Create NESL instance with a caller defined context. Instances are independent and may be stepped from any thread,
+ *        but a single instance must not be used from more than one thread at a time.
+ * @param[out] instance Pointer to NESL instance pointer (set to NULL on failure)
+ * @param[in] context Constant pointer to caller defined context
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+nesl_error_e nesl_create(nesl_instance_t **instance, const nesl_t *context);
+
+/*!
+ * @brief Destroy NESL instance, writing any recorded input movie or replay hashes. The instance is released even on failure.
+ * @param[in,out] instance Pointer to NESL instance (can be NULL)
+ * @return NESL_FAILURE if the input movie, replay hashes or audio recording could not be written, NESL_SUCCESS otherwise
+ */
+nesl_error_e nesl_destroy(nesl_instance_t *instance);
+
+/*!
+ * @brief Get NESL instance battery save status. A battery save that cannot be created or mapped does not fail instance
+ *        creation, the program RAM is kept in memory instead and this call fails, so the caller can warn that saves will not persist.
+ * @param[in] instance Pointer to NESL instance
+ * @return NESL_FAILURE if the battery save could not be mapped, NESL_SUCCESS otherwise
+ */
+nesl_error_e nesl_get_battery(nesl_instance_t *instance);
+
+/*!
+ * @brief Get ARGB color of a display palette index.
+ * @param[in] index Palette index (color | red << 6 | green << 7 | blue << 8, emphasis bits from the mask register)
+ * @return ARGB color value
+ */
+uint32_t nesl_get_color(uint16_t index);
+
+/*!
+ * @brief Get NESL error string, for the last failure on the calling thread.
  * @return Constant pointer to NESL error string
  */
 const char *nesl_get_error(void);
 
+/*!
+ * @brief Get NESL instance save-state length, bounding the compressed save-state length.
+ * @param[in] instance Pointer to NESL instance
+ * @return Save-state length in bytes
+ */
+int nesl_get_state_length(nesl_instance_t *instance);
+
 /*!
  * @brief Get NESL version.
  * @return Constant pointer to NESL version
  */
 const nesl_version_t *nesl_get_version(void);
 
+/*!
+ * @brief Load NESL instance state from a save-state or compressed save-state, taken from an instance with identical data and
+ *        save-state version.
+ * @param[in,out] instance Pointer to NESL instance
+ * @param[in] data Constant pointer to save-state data
+ * @param[in] length Save-state length in bytes
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+nesl_error_e nesl_load_state(nesl_instance_t *instance, const void *data, int length);
+
+/*!
+ * @brief Save NESL instance state to a flat save-state (versioned header, followed by the machine state). Display, audio
+ *        output buffers and host input are not part of the save-state.
+ * @param[in] instance Pointer to NESL instance
+ * @param[out] data Pointer to save-state data
+ * @param[in] length Save-state data length in bytes, at least nesl_get_state_length
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+nesl_error_e nesl_save_state(nesl_instance_t *instance, void *data, int length);
+
+/*!
+ * @brief Save NESL instance state to a compressed save-state, with the machine state LZ compressed (stored uncompressed if it
+ *        does not shrink).
+ * @param[in] instance Pointer to NESL instance
+ * @param[out] data Pointer to save-state data
+ * @param[in,out] length Pointer to save-state data length in bytes, at least nesl_get_state_length, set to the compressed
+ *                       save-state length
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+nesl_error_e nesl_save_state_compressed(nesl_instance_t *instance, void *data, int *length);
+
+/*!
+ * @brief Seek NESL instance to a frame of the input movie it plays back, from the nearest keyframe at or before the frame.
+ *        Frames between the keyframe and the frame are run without video or audio output.
+ * @param[in,out] instance Pointer to NESL instance
+ * @param[in] frame Frame index, up to the input movie frame count
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+nesl_error_e nesl_seek_movie(nesl_instance_t *instance, int frame);
+
+/*!
+ * @brief Configure the internal thread pool used by nesl_vec_step, before its first use.
+ * @param[in] count Worker thread count (negative for one per online processor, less the calling thread, the default)
+ * @param[in] affinity Pin each worker thread to its own processor (default:false)
+ * @return NESL_FAILURE if the thread pool is already running, NESL_SUCCESS otherwise
+ */
+nesl_error_e nesl_set_pool(int count, int affinity);
+
+/*!
+ * @brief Step NESL instance through one frame (poll, run until frame completes, redraw).
+ * @param[in,out] instance Pointer to NESL instance
+ * @return NESL_FAILURE on failure, NESL_SUCCESS or NESL_QUIT otherwise
+ */
+nesl_error_e nesl_step(nesl_instance_t *instance);
+
+/*!
+ * @brief Step NESL instance through one frame with caller supplied input, returning the frame without copying.
+ * @param[in,out] instance Pointer to NESL instance
+ * @param[in] input Controller button bits for the frame (A,B,Select,Start,Up,Down,Left,Right from bit 0)
+ * @param[out] frame Pointer to NESL frame
+ * @return NESL_FAILURE on failure, NESL_SUCCESS or NESL_QUIT otherwise
+ */
+nesl_error_e nesl_step_frame(nesl_instance_t *instance, uint8_t input, nesl_frame_t *frame);
+
+/*!
+ * @brief Step a batch of NESL instances through one frame each on the internal work-stealing thread pool, with caller
+ *        supplied input. Each instance is one task, so a slow instance only holds up the thread running it.
+ * @param[in,out] instance Array of pointers to NESL instances (each instance must appear at most once)
+ * @param[in] input Array of controller button bits, one per instance (A,B,Select,Start,Up,Down,Left,Right from bit 0)
+ * @param[in] count Number of instances
+ * @param[out] observation Pointer to contiguous observation buffer, receiving count display frames of NESL_DISPLAY_WIDTH x
+ *                         NESL_DISPLAY_HEIGHT ARGB pixels in instance order, expanding compact displays (can be NULL)
+ * @return NESL_FAILURE if any instance failed, NESL_QUIT if any instance quit, NESL_SUCCESS otherwise
+ */
+nesl_error_e nesl_vec_step(nesl_instance_t *instance[], const uint8_t input[], int count, uint32_t *observation);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
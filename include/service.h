@@ -45,6 +45,12 @@ typedef enum {
     BUTTON_MAX,         /*!< Maximum button */
 } nesl_button_e;
 
+/*!
+ * @struct nesl_service_t
+ * @brief Service context (opaque, owned by the service implementation).
+ */
+typedef struct nesl_service_s nesl_service_t;
+
 /*!
  * @brief Audio callback routine used to collect audio samples.
  * @param[in,out] context Constant pointer to audio context
@@ -57,6 +63,12 @@ typedef void (*nesl_service_get_audio)(void *context, uint8_t *data, int length)
 extern "C" {
 #endif /* __cplusplus */
 
+/*!
+ * @brief Get service context bound to the calling thread.
+ * @return Pointer to service context, or NULL if unbound
+ */
+nesl_service_t *nesl_service_get(void);
+
 /*!
  * @brief Get controller button state.
  * @param[in] button Button type
@@ -64,6 +76,32 @@ extern "C" {
  */
 bool nesl_service_get_button(nesl_button_e button);
 
+/*!
+ * @brief Get audio captured since the last poll (headless backend with capture enabled).
+ * @param[out] length Pointer to captured length in bytes
+ * @return Constant pointer to captured audio samples, or NULL if not captured
+ */
+const void *nesl_service_get_capture(int *length);
+
+/*!
+ * @brief Get ARGB color of a display palette index.
+ * @param[in] index Palette index (color | red << 6 | green << 7 | blue << 8)
+ * @return ARGB color value
+ */
+uint32_t nesl_service_get_color(uint16_t index);
+
+/*!
+ * @brief Get display pixels.
+ * @return Constant pointer to 256x240 ARGB pixels, or NULL if not available
+ */
+const uint32_t *nesl_service_get_display(void);
+
+/*!
+ * @brief Get display palette indices (headless backend with compact display enabled).
+ * @return Constant pointer to 256x240 palette indices, or NULL if not available
+ */
+const uint16_t *nesl_service_get_index(void);
+
 /*!
  * @brief Get controller sensor state.
  * @return true if not-detected, false if detected
@@ -77,13 +115,11 @@ bool nesl_service_get_sensor(void);
 bool nesl_service_get_trigger(void);
 
 /*!
- * @brief Initialize service.
- * @param[in] title Constant pointer to window title
- * @param[in] linear Linear scaling enabled
- * @param[in] scale Scaling value
+ * @brief Initialize service with the backend selected by the caller, binding the new service context to the calling thread.
+ * @param[in] context Constant pointer to caller defined context
  * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
  */
-nesl_error_e nesl_service_initialize(const char *title, int linear, int scale);
+nesl_error_e nesl_service_initialize(const nesl_t *context);
 
 /*!
  * @brief Poll service state.
@@ -107,9 +143,23 @@ nesl_error_e nesl_service_reset(void);
  * @brief Set service audio callback.
  * @param[in] callback Pointer to audio callback function
  * @param[in] context Constant pointer to audio context
+ * @param[in] rate Sample rate (Hz)
  * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
  */
-nesl_error_e nesl_service_set_audio(nesl_service_get_audio callback, void *context);
+nesl_error_e nesl_service_set_audio(nesl_service_get_audio callback, void *context, int rate);
+
+/*!
+ * @brief Bind service context to the calling thread.
+ * @param[in] service Pointer to service context, or NULL to unbind
+ */
+void nesl_service_set(nesl_service_t *service);
+
+/*!
+ * @brief Set service input, overriding the backend controller button state.
+ * @param[in] enabled Input override enabled
+ * @param[in] state Controller button bits, indexed by button type
+ */
+void nesl_service_set_input(bool enabled, uint8_t state);
 
 /*!
  * @brief Set service pixel.
@@ -123,10 +173,17 @@ nesl_error_e nesl_service_set_audio(nesl_service_get_audio callback, void *conte
 void nesl_service_set_pixel(uint8_t color, bool red, bool green, bool blue, uint8_t x, uint8_t y);
 
 /*!
- * @brief Uninitialize service.
+ * @brief Uninitialize service bound to the calling thread.
  */
 void nesl_service_uninitialize(void);
 
+/*!
+ * @brief Write audio samples to service.
+ * @param[in] data Constant pointer to audio samples
+ * @param[in] length Audio samples length in bytes
+ */
+void nesl_service_write_audio(const void *data, int length);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
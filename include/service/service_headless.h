@@ -0,0 +1,146 @@
+/*
+ * NESL
+ * Copyright (C) 2022 David Jolly
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+ * @file service_headless.h
+ * @brief Headless service backend.
+ */
+
+#ifndef NESL_SERVICE_HEADLESS_H_
+#define NESL_SERVICE_HEADLESS_H_
+
+#include <service.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*!
+ * @brief Get headless backend controller button state.
+ * @param[in] context Pointer to headless backend context
+ * @param[in] button Button type
+ * @return true if pressed, false if released
+ */
+bool nesl_service_headless_get_button(void *context, nesl_button_e button);
+
+/*!
+ * @brief Get headless backend audio captured since the last poll.
+ * @param[in] context Pointer to headless backend context
+ * @param[out] length Pointer to captured length in bytes
+ * @return Constant pointer to captured audio samples, or NULL if not captured
+ */
+const void *nesl_service_headless_get_capture(void *context, int *length);
+
+/*!
+ * @brief Get headless backend display pixels.
+ * @param[in] context Pointer to headless backend context
+ * @return Constant pointer to 256x240 ARGB pixels, or NULL if compact display is enabled
+ */
+const uint32_t *nesl_service_headless_get_display(void *context);
+
+/*!
+ * @brief Get headless backend display palette indices.
+ * @param[in] context Pointer to headless backend context
+ * @return Constant pointer to 256x240 palette indices, or NULL unless compact display is enabled
+ */
+const uint16_t *nesl_service_headless_get_index(void *context);
+
+/*!
+ * @brief Get headless backend controller sensor state.
+ * @param[in] context Pointer to headless backend context
+ * @return true if not-detected, false if detected
+ */
+bool nesl_service_headless_get_sensor(void *context);
+
+/*!
+ * @brief Get headless backend controller trigger state.
+ * @param[in] context Pointer to headless backend context
+ * @return true if pressed, false if released
+ */
+bool nesl_service_headless_get_trigger(void *context);
+
+/*!
+ * @brief Initialize headless backend.
+ * @param[out] context Pointer to headless backend context pointer
+ * @param[in] configuration Constant pointer to caller defined context
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+nesl_error_e nesl_service_headless_initialize(void **context, const nesl_t *configuration);
+
+/*!
+ * @brief Poll headless backend state.
+ * @param[in,out] context Pointer to headless backend context
+ * @return NESL_FAILURE on failure, NESL_SUCCESS or NESL_QUIT otherwise
+ */
+nesl_error_e nesl_service_headless_poll(void *context);
+
+/*!
+ * @brief Redraw headless backend pixels, completing the frame.
+ * @param[in,out] context Pointer to headless backend context
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+nesl_error_e nesl_service_headless_redraw(void *context);
+
+/*!
+ * @brief Reset headless backend.
+ * @param[in,out] context Pointer to headless backend context
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+nesl_error_e nesl_service_headless_reset(void *context);
+
+/*!
+ * @brief Set headless backend audio callback.
+ * @param[in,out] context Pointer to headless backend context
+ * @param[in] callback Pointer to audio callback function
+ * @param[in] audio Constant pointer to audio context
+ * @param[in] rate Sample rate (Hz)
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+nesl_error_e nesl_service_headless_set_audio(void *context, nesl_service_get_audio callback, void *audio, int rate);
+
+/*!
+ * @brief Set headless backend pixel.
+ * @param[in,out] context Pointer to headless backend context
+ * @param[in] index Palette index (color | red << 6 | green << 7 | blue << 8)
+ * @param[in] x X-coordinate
+ * @param[in] y Y-coordinate
+ */
+void nesl_service_headless_set_pixel(void *context, uint16_t index, uint8_t x, uint8_t y);
+
+/*!
+ * @brief Uninitialize headless backend.
+ * @param[in,out] context Pointer to headless backend context
+ */
+void nesl_service_headless_uninitialize(void *context);
+
+/*!
+ * @brief Write audio samples to headless backend.
+ * @param[in,out] context Pointer to headless backend context
+ * @param[in] data Constant pointer to audio samples
+ * @param[in] length Audio samples length in bytes
+ */
+void nesl_service_headless_write_audio(void *context, const void *data, int length);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* NESL_SERVICE_HEADLESS_H_ */
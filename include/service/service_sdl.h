@@ -0,0 +1,146 @@
+/*
+ * NESL
+ * Copyright (C) 2022 David Jolly
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+ * @file service_sdl.h
+ * @brief SDL service backend.
+ */
+
+#ifndef NESL_SERVICE_SDL_H_
+#define NESL_SERVICE_SDL_H_
+
+#include <service.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*!
+ * @brief Get sdl backend controller button state.
+ * @param[in] context Pointer to sdl backend context
+ * @param[in] button Button type
+ * @return true if pressed, false if released
+ */
+bool nesl_service_sdl_get_button(void *context, nesl_button_e button);
+
+/*!
+ * @brief Get sdl backend audio captured since the last poll.
+ * @param[in] context Pointer to sdl backend context
+ * @param[out] length Pointer to captured length in bytes
+ * @return Constant pointer to captured audio samples, or NULL if not captured
+ */
+const void *nesl_service_sdl_get_capture(void *context, int *length);
+
+/*!
+ * @brief Get sdl backend display pixels.
+ * @param[in] context Pointer to sdl backend context
+ * @return Constant pointer to 256x240 ARGB pixels
+ */
+const uint32_t *nesl_service_sdl_get_display(void *context);
+
+/*!
+ * @brief Get sdl backend display palette indices.
+ * @param[in] context Pointer to sdl backend context
+ * @return Constant pointer to 256x240 palette indices, or NULL if not available
+ */
+const uint16_t *nesl_service_sdl_get_index(void *context);
+
+/*!
+ * @brief Get sdl backend controller sensor state.
+ * @param[in] context Pointer to sdl backend context
+ * @return true if not-detected, false if detected
+ */
+bool nesl_service_sdl_get_sensor(void *context);
+
+/*!
+ * @brief Get sdl backend controller trigger state.
+ * @param[in] context Pointer to sdl backend context
+ * @return true if pressed, false if released
+ */
+bool nesl_service_sdl_get_trigger(void *context);
+
+/*!
+ * @brief Initialize sdl backend.
+ * @param[out] context Pointer to sdl backend context pointer
+ * @param[in] configuration Constant pointer to caller defined context
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+nesl_error_e nesl_service_sdl_initialize(void **context, const nesl_t *configuration);
+
+/*!
+ * @brief Poll sdl backend state.
+ * @param[in,out] context Pointer to sdl backend context
+ * @return NESL_FAILURE on failure, NESL_SUCCESS or NESL_QUIT otherwise
+ */
+nesl_error_e nesl_service_sdl_poll(void *context);
+
+/*!
+ * @brief Redraw sdl backend pixels to window.
+ * @param[in,out] context Pointer to sdl backend context
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+nesl_error_e nesl_service_sdl_redraw(void *context);
+
+/*!
+ * @brief Reset sdl backend.
+ * @param[in,out] context Pointer to sdl backend context
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+nesl_error_e nesl_service_sdl_reset(void *context);
+
+/*!
+ * @brief Set sdl backend audio callback.
+ * @param[in,out] context Pointer to sdl backend context
+ * @param[in] callback Pointer to audio callback function
+ * @param[in] audio Constant pointer to audio context
+ * @param[in] rate Sample rate (Hz)
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+nesl_error_e nesl_service_sdl_set_audio(void *context, nesl_service_get_audio callback, void *audio, int rate);
+
+/*!
+ * @brief Set sdl backend pixel.
+ * @param[in,out] context Pointer to sdl backend context
+ * @param[in] index Palette index (color | red << 6 | green << 7 | blue << 8)
+ * @param[in] x X-coordinate
+ * @param[in] y Y-coordinate
+ */
+void nesl_service_sdl_set_pixel(void *context, uint16_t index, uint8_t x, uint8_t y);
+
+/*!
+ * @brief Uninitialize sdl backend.
+ * @param[in,out] context Pointer to sdl backend context
+ */
+void nesl_service_sdl_uninitialize(void *context);
+
+/*!
+ * @brief Write audio samples to sdl backend.
+ * @param[in,out] context Pointer to sdl backend context
+ * @param[in] data Constant pointer to audio samples
+ * @param[in] length Audio samples length in bytes
+ */
+void nesl_service_sdl_write_audio(void *context, const void *data, int length);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* NESL_SERVICE_SDL_H_ */
@@ -0,0 +1,67 @@
+/*
+ * NESL
+ * Copyright (C) 2022 David Jolly
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+ * @file snapshot.h
+ * @brief Startup snapshot cache.
+ */
+
+#ifndef NESL_SNAPSHOT_H_
+#define NESL_SNAPSHOT_H_
+
+#include <bus.h>
+
+#define SNAPSHOT_FRAMES 120                 /*!< Boot frames run before a startup snapshot is taken */
+#define SNAPSHOT_MAGIC "NSS\x1A"            /*!< Startup snapshot magic number */
+
+/*!
+ * @struct nesl_snapshot_header_t
+ * @brief Startup snapshot header, followed by the LZ compressed bus state.
+ */
+typedef struct {
+    char magic[4];                          /*!< Magic number */
+    nesl_version_t version;                 /*!< Core version */
+    uint32_t frames;                        /*!< Boot frames */
+    uint64_t hash;                          /*!< Cartridge data hash */
+    uint64_t length;                        /*!< Bus state length in bytes */
+    uint64_t compressed;                    /*!< Compressed bus state length in bytes */
+    uint64_t checksum;                      /*!< Bus state hash */
+} nesl_snapshot_header_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*!
+ * @brief Boot bus bound to the calling thread from a startup snapshot, keyed by cartridge data hash and core version. If no
+ *        matching snapshot exists, the boot frames are run without input and a new snapshot is stored.
+ * @param[in] directory Constant pointer to snapshot directory path string
+ * @param[in] data Constant pointer to cartridge data
+ * @param[in] length Cartridge data length in bytes
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+nesl_error_e nesl_snapshot_boot(const char *directory, const void *data, int length);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* NESL_SNAPSHOT_H_ */
@@ -27,12 +27,20 @@
 #ifndef NESL_AUDIO_H_
 #define NESL_AUDIO_H_
 
+#include <audio_buffer.h>
 #include <audio_dmc.h>
 #include <audio_noise.h>
+#include <audio_resampler.h>
+#include <audio_sink.h>
 #include <audio_square.h>
 #include <audio_triangle.h>
 #include <bus.h>
 
+#define AUDIO_CYCLES ((89342 * 60) / 3)                             /*!< Processor cycles per second */
+#define AUDIO_BUFFER 1024                                           /*!< Samples per device buffer */
+#define AUDIO_RATE 44100                                            /*!< Default sample rate (Hz) */
+#define AUDIO_SAMPLES 128                                           /*!< Samples per buffer write */
+
 /*!
  * @enum nesl_synthesizer_e
  * @brief Synthesizer type.
@@ -71,7 +79,19 @@ typedef union {
  * @brief Audio subsystem context.
  */
 typedef struct {
+    bool quiet;                                                     /*!< Quiet flag (no device output) */
+    bool record;                                                    /*!< Record flag (output to audio sink) */
+    bool hidden;                                                    /*!< Hidden flag (no mixing or output, for run-ahead and seek frames) */
+    bool failed;                                                    /*!< Record failure flag (audio sink write failed, recording stopped) */
     nesl_audio_buffer_t buffer;                                     /*!< Audio buffer context */
+    nesl_audio_sink_t sink;                                         /*!< Audio sink context */
+    nesl_audio_resampler_t resampler;                               /*!< Audio resampler context */
+
+    struct {
+        int count;                                                  /*!< Staged sample count */
+        nesl_audio_sample_t data[AUDIO_SAMPLES];                    /*!< Staged samples (output, not part of the save-state) */
+    } sample;
+
     nesl_audio_status_t status;                                     /*!< Status register */
 
     union {
@@ -86,7 +106,11 @@ typedef struct {
     } frame;
 
     struct {
-        nesl_audio_square_t square[SYNTHESIZER_SQUARE_2 + 1];  /*!< Square-wave synthesizer contexts */
+        uint16_t cycle;                                             /*!< Frame sequencer cycle */
+    } sequencer;
+
+    struct {
+        nesl_audio_square_t square[SYNTHESIZER_SQUARE_2 + 1];       /*!< Square-wave synthesizer contexts */
         nesl_audio_triangle_t triangle;                             /*!< Triangle synthesizer context */
         nesl_audio_noise_t noise;                                   /*!< Noise synthesizer context */
         nesl_audio_dmc_t dmc;                                       /*!< DMC synthesizer contexts */
@@ -104,12 +128,30 @@ extern "C" {
  */
 void nesl_audio_cycle(nesl_audio_t *audio, uint64_t cycle);
 
+/*!
+ * @brief Get audio subsystem error, failing once recording to the audio sink has failed.
+ * @param[in] audio Constant pointer to audio subsystem context
+ * @return NESL_FAILURE if recording failed, NESL_SUCCESS otherwise
+ */
+nesl_error_e nesl_audio_get_error(const nesl_audio_t *audio);
+
+/*!
+ * @brief Get audio subsystem arena size.
+ * @param[in] quiet Quiet flag, no device output when set
+ * @return Audio arena size in bytes
+ */
+size_t nesl_audio_get_size(bool quiet);
+
 /*!
  * @brief Initialize audio subsystem.
  * @param[in,out] audio Pointer to audio subsystem context
+ * @param[in,out] arena Pointer to arena context, holding the device buffer
+ * @param[in] quiet Quiet flag, no device output when set (only register state is emulated, unless recording)
+ * @param[in] record Constant pointer to record file path (can be NULL)
+ * @param[in] rate Sample rate in Hz (0 selects the default sample rate)
  * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
  */
-nesl_error_e nesl_audio_initialize(nesl_audio_t *audio);
+nesl_error_e nesl_audio_initialize(nesl_audio_t *audio, nesl_arena_t *arena, bool quiet, const char *record, int rate);
 
 /*!
  * @brief Read byte from audio subsystem.
@@ -129,8 +171,9 @@ nesl_error_e nesl_audio_reset(nesl_audio_t *audio);
 /*!
  * @brief Uninitialize audio subsystem.
  * @param[in,out] audio Pointer to audio subsystem context
+ * @return NESL_FAILURE if the audio sink could not be completed, NESL_SUCCESS otherwise
  */
-void nesl_audio_uninitialize(nesl_audio_t *audio);
+nesl_error_e nesl_audio_uninitialize(nesl_audio_t *audio);
 
 /*!
  * @brief Write byte to audio subsystem.
@@ -27,19 +27,28 @@
 #ifndef NESL_AUDIO_BUFFER_H_
 #define NESL_AUDIO_BUFFER_H_
 
-#include <common.h>
+#include <arena.h>
+
+/*!
+ * @brief Audio sample type (signed 16-bit when built with NESL_AUDIO_S16, 32-bit float otherwise).
+ */
+#ifdef NESL_AUDIO_S16
+typedef int16_t nesl_audio_sample_t;
+#else
+typedef float nesl_audio_sample_t;
+#endif /* NESL_AUDIO_S16 */
 
 /*!
  * @struct nesl_audio_buffer_t
  * @brief Audio circular-buffer context.
  */
 typedef struct {
-    pthread_mutex_t lock;   /*!< Mutex */
-    float *data;            /*!< Audio data buffer */
-    int count;              /*!< Audio data count */
-    int read;               /*!< Read index */
-    int write;              /*!< Write index */
-    bool full;              /*!< Full flag */
+    pthread_mutex_t lock;           /*!< Mutex */
+    nesl_audio_sample_t *data;      /*!< Audio data buffer */
+    int count;                      /*!< Audio data count */
+    int read;                       /*!< Read index */
+    int write;                      /*!< Write index */
+    bool full;                      /*!< Full flag */
 } nesl_audio_buffer_t;
 
 #ifdef __cplusplus
@@ -49,10 +58,11 @@ extern "C" {
 /*!
  * @brief Initialize audio buffer.
  * @param[in,out] buffer Constant pointer to audio buffer context
+ * @param[in,out] arena Pointer to arena context, holding the buffer entries
  * @param[in] count Max number of entries
  * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
  */
-nesl_error_e nesl_audio_buffer_initialize(nesl_audio_buffer_t *buffer, int count);
+nesl_error_e nesl_audio_buffer_initialize(nesl_audio_buffer_t *buffer, nesl_arena_t *arena, int count);
 
 /*!
  * @brief Read bytes from audio buffer.
@@ -61,7 +71,7 @@ nesl_error_e nesl_audio_buffer_initialize(nesl_audio_buffer_t *buffer, int count
  * @param[in] count Maximum number of entries in data array
  * @return Number of entries read
  */
-int nesl_audio_buffer_read(nesl_audio_buffer_t *buffer, float *data, int count);
+int nesl_audio_buffer_read(nesl_audio_buffer_t *buffer, nesl_audio_sample_t *data, int count);
 
 /*!
  * @brief Readable bytes in audio buffer.
@@ -90,7 +100,7 @@ void nesl_audio_buffer_uninitialize(nesl_audio_buffer_t *buffer);
  * @param[in] count Bumber of entries in data array
  * @return Number of entries written
  */
-int nesl_audio_buffer_write(nesl_audio_buffer_t *buffer, float *data, int count);
+int nesl_audio_buffer_write(nesl_audio_buffer_t *buffer, nesl_audio_sample_t *data, int count);
 
 /*!
  * @brief Writable bytes in audio buffer.
@@ -27,14 +27,32 @@
 #ifndef NESL_AUDIO_DMC_H_
 #define NESL_AUDIO_DMC_H_
 
-#include <audio_buffer.h>
+#include <bus.h>
 
 /*!
  * @struct nesl_audio_dmc_t
  * @brief Audio DMC synthesizer context.
  */
 typedef struct {
-    nesl_audio_buffer_t buffer;                     /*!< Audio buffer context */
+    bool interrupt;                                 /*!< Interrupt flag */
+    uint8_t level;                                  /*!< Output level */
+
+    struct {
+        uint16_t count;                             /*!< Timer count */
+    } timer;
+
+    struct {
+        uint16_t address;                           /*!< Current sample address */
+        uint16_t remaining;                         /*!< Sample bytes remaining */
+        uint8_t data;                               /*!< Sample buffer */
+        bool empty;                                 /*!< Sample buffer empty flag */
+    } reader;
+
+    struct {
+        uint8_t shift;                              /*!< Shift register */
+        uint8_t remaining;                          /*!< Bits remaining */
+        bool silence;                               /*!< Silence flag */
+    } output;
 
     union {
 
@@ -72,32 +90,36 @@ typedef struct {
 /*!
  * @brief Cycle audio DMC synthesizer through one cycle.
  * @param[in,out] dmc Pointer to audio DMC synthesizer context
- * @param[in] elapsed Current time in seconds
  */
-void nesl_audio_dmc_cycle(nesl_audio_dmc_t *dmc, float elapsed);
+void nesl_audio_dmc_cycle(nesl_audio_dmc_t *dmc);
 
 /*!
- * @brief Initialize audio DMC synthesizer.
- * @param[in,out] dmc Pointer to audio DMC synthesizer context
- * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ * @brief Get audio DMC synthesizer interrupt flag.
+ * @param[in] dmc Constant pointer to audio DMC synthesizer context
+ * @return Interrupt flag
  */
-nesl_error_e nesl_audio_dmc_initialize(nesl_audio_dmc_t *dmc);
+bool nesl_audio_dmc_get_interrupt(const nesl_audio_dmc_t *dmc);
 
 /*!
- * @brief Read bytes from audio DMC synthesizer.
- * @param[in,out] dmc Pointer to audio DMC synthesizer context
- * @param[in,out] data Pointer to data array
- * @param[in] length Maximum number of entries in data array
- * @return Number of entries read
+ * @brief Get audio DMC synthesizer sample bytes remaining.
+ * @param[in] dmc Constant pointer to audio DMC synthesizer context
+ * @return Sample bytes remaining
+ */
+uint16_t nesl_audio_dmc_get_length(const nesl_audio_dmc_t *dmc);
+
+/*!
+ * @brief Get audio DMC synthesizer output level.
+ * @param[in] dmc Constant pointer to audio DMC synthesizer context
+ * @return Output level [0-127]
  */
-int nesl_audio_dmc_read(nesl_audio_dmc_t *dmc, float *data, int length);
+uint8_t nesl_audio_dmc_get_output(const nesl_audio_dmc_t *dmc);
 
 /*!
- * @brief Readable bytes in audio DMC synthesizer.
+ * @brief Initialize audio DMC synthesizer.
  * @param[in,out] dmc Pointer to audio DMC synthesizer context
- * @return Number of entries readable
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
  */
-int nesl_audio_dmc_readable(nesl_audio_dmc_t *dmc);
+nesl_error_e nesl_audio_dmc_initialize(nesl_audio_dmc_t *dmc);
 
 /*!
  * @brief Reset audio DMC synthesizer.
@@ -106,6 +128,13 @@ int nesl_audio_dmc_readable(nesl_audio_dmc_t *dmc);
  */
 nesl_error_e nesl_audio_dmc_reset(nesl_audio_dmc_t *dmc);
 
+/*!
+ * @brief Set audio DMC synthesizer enable flag.
+ * @param[in,out] dmc Pointer to audio DMC synthesizer context
+ * @param[in] enable Enable flag
+ */
+void nesl_audio_dmc_set_enable(nesl_audio_dmc_t *dmc, bool enable);
+
 /*!
  * @brief Uninitialize audio DMC synthesizer.
  * @param[in,out] dmc Pointer to audio DMC synthesizer context
@@ -27,14 +27,26 @@
 #ifndef NESL_AUDIO_NOISE_H_
 #define NESL_AUDIO_NOISE_H_
 
-#include <audio_buffer.h>
+#include <common.h>
 
 /*!
  * @struct nesl_audio_noise_t
  * @brief Audio noise synthesizer context.
  */
 typedef struct {
-    nesl_audio_buffer_t buffer;                 /*!< Audio buffer context */
+    bool enable;                                /*!< Enable flag */
+    uint8_t length;                             /*!< Length counter */
+    uint16_t shift;                             /*!< Shift register */
+
+    struct {
+        bool start;                             /*!< Start flag */
+        uint8_t divider;                        /*!< Divider */
+        uint8_t decay;                          /*!< Decay level */
+    } envelope;
+
+    struct {
+        uint16_t count;                         /*!< Timer count */
+    } timer;
 
     union {
 
@@ -58,7 +70,7 @@ typedef struct {
                 struct {
                     uint8_t index : 4;          /*!< Index */
                     uint8_t unused : 3;         /*!< Unused bits */
-                    uint8_t loop : 1;           /*!< Loop flag */
+                    uint8_t mode : 1;           /*!< Mode flag */
                 };
 
                 uint8_t raw;                    /*!< Raw byte */
@@ -82,32 +94,36 @@ typedef struct {
 /*!
  * @brief Cycle audio noise synthesizer through one cycle.
  * @param[in,out] noise Pointer to audio noise synthesizer context
- * @param elapsed Current time in seconds
  */
-void nesl_audio_noise_cycle(nesl_audio_noise_t *noise, float elapsed);
+void nesl_audio_noise_cycle(nesl_audio_noise_t *noise);
 
 /*!
- * @brief Initialize audio noise synthesizer.
+ * @brief Clock audio noise synthesizer envelope and length units.
  * @param[in,out] noise Pointer to audio noise synthesizer context
- * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ * @param[in] half Half-frame flag (clocks length unit)
  */
-nesl_error_e nesl_audio_noise_initialize(nesl_audio_noise_t *noise);
+void nesl_audio_noise_frame(nesl_audio_noise_t *noise, bool half);
 
 /*!
- * @brief Read bytes from audio noise synthesizer.
- * @param[in,out] noise Pointer to audio noise synthesizer context
- * @param[in,out] data Pointer to data array
- * @param[in] length Maximum number of entries in data array
- * @return Number of entries read
+ * @brief Get audio noise synthesizer length counter.
+ * @param[in] noise Constant pointer to audio noise synthesizer context
+ * @return Length counter
  */
-int nesl_audio_noise_read(nesl_audio_noise_t *noise, float *data, int length);
+uint8_t nesl_audio_noise_get_length(const nesl_audio_noise_t *noise);
 
 /*!
- * @brief Readable bytes in audio noise synthesizer.
+ * @brief Get audio noise synthesizer output level.
+ * @param[in] noise Constant pointer to audio noise synthesizer context
+ * @return Output level [0-15]
+ */
+uint8_t nesl_audio_noise_get_output(const nesl_audio_noise_t *noise);
+
+/*!
+ * @brief Initialize audio noise synthesizer.
  * @param[in,out] noise Pointer to audio noise synthesizer context
- * @return Number of entries readable
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
  */
-int nesl_audio_noise_readable(nesl_audio_noise_t *noise);
+nesl_error_e nesl_audio_noise_initialize(nesl_audio_noise_t *noise);
 
 /*!
  * @brief Reset audio noise synthesizer.
@@ -116,6 +132,13 @@ int nesl_audio_noise_readable(nesl_audio_noise_t *noise);
  */
 nesl_error_e nesl_audio_noise_reset(nesl_audio_noise_t *noise);
 
+/*!
+ * @brief Set audio noise synthesizer enable flag.
+ * @param[in,out] noise Pointer to audio noise synthesizer context
+ * @param[in] enable Enable flag
+ */
+void nesl_audio_noise_set_enable(nesl_audio_noise_t *noise, bool enable);
+
 /*!
  * @brief Uninitialize audio noise synthesizer.
  * @param[in,out] noise Pointer to audio noise synthesizer context
@@ -0,0 +1,97 @@
+/*
+ * NESL
+ * Copyright (C) 2022 David Jolly
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+ * @file audio_resampler.h
+ * @brief Audio polyphase FIR resampler.
+ */
+
+#ifndef NESL_AUDIO_RESAMPLER_H_
+#define NESL_AUDIO_RESAMPLER_H_
+
+#include <audio_buffer.h>
+
+#define AUDIO_RESAMPLER_PHASES 32                   /*!< Filter phases per input sample */
+#define AUDIO_RESAMPLER_PI 3.14159265358979323846   /*!< Pi */
+#define AUDIO_RESAMPLER_ZEROS 6                     /*!< Output-rate zero-crossings on each side of the filter kernel */
+
+#ifdef NESL_AUDIO_S16
+#define AUDIO_RESAMPLER_LANES 16                    /*!< Filter taps per vector (int16) */
+#define AUDIO_RESAMPLER_SHIFT 15                    /*!< Filter coefficient fixed-point fraction bits (Q15) */
+#else
+#define AUDIO_RESAMPLER_LANES 8                     /*!< Filter taps per vector (float) */
+#endif /* NESL_AUDIO_S16 */
+
+/*!
+ * @struct nesl_audio_resampler_t
+ * @brief Audio resampler context.
+ */
+typedef struct {
+    uint32_t input;                         /*!< Input sample rate (Hz) */
+    uint32_t output;                        /*!< Output sample rate (Hz) */
+    uint32_t accumulator;                   /*!< Output sample-rate accumulator */
+    int taps;                               /*!< Filter taps per phase */
+    int index;                              /*!< History write index */
+    const nesl_audio_sample_t *coefficient; /*!< Filter coefficients, per phase (Q15 with signed 16-bit samples), shared by matching sample rates */
+    nesl_audio_sample_t *history;           /*!< Input history (mirrored, so each window is contiguous) */
+} nesl_audio_resampler_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*!
+ * @brief Initialize audio resampler. The filter coefficient table is built once per pair of sample rates and shared read-only
+ *        by every resampler using them, only the input history is allocated per resampler.
+ * @param[in,out] resampler Pointer to audio resampler context
+ * @param[in] input Input sample rate (Hz)
+ * @param[in] output Output sample rate (Hz), must be less than half the input sample rate
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+nesl_error_e nesl_audio_resampler_initialize(nesl_audio_resampler_t *resampler, uint32_t input, uint32_t output);
+
+/*!
+ * @brief Reset audio resampler.
+ * @param[in,out] resampler Pointer to audio resampler context
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+nesl_error_e nesl_audio_resampler_reset(nesl_audio_resampler_t *resampler);
+
+/*!
+ * @brief Uninitialize audio resampler, releasing its reference to the shared filter coefficient table.
+ * @param[in,out] resampler Pointer to audio resampler context
+ */
+void nesl_audio_resampler_uninitialize(nesl_audio_resampler_t *resampler);
+
+/*!
+ * @brief Write input sample to audio resampler.
+ * @param[in,out] resampler Pointer to audio resampler context
+ * @param[in] input Input sample
+ * @param[out] output Pointer to output sample
+ * @return true if an output sample was produced, false otherwise
+ */
+bool nesl_audio_resampler_write(nesl_audio_resampler_t *resampler, nesl_audio_sample_t input, nesl_audio_sample_t *output);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* NESL_AUDIO_RESAMPLER_H_ */
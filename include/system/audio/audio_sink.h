@@ -0,0 +1,99 @@
+/*
+ * NESL
+ * Copyright (C) 2022 David Jolly
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+ * @file audio_sink.h
+ * @brief Audio file sink (WAV/raw PCM), written from a background thread.
+ */
+
+#ifndef NESL_AUDIO_SINK_H_
+#define NESL_AUDIO_SINK_H_
+
+#include <audio_buffer.h>
+
+#define AUDIO_SINK_SAMPLES 65536    /*!< Samples per batched file write */
+
+/*!
+ * @enum nesl_audio_sink_e
+ * @brief Audio sink type.
+ */
+typedef enum {
+    AUDIO_SINK_RAW = 0,             /*!< Raw PCM samples */
+    AUDIO_SINK_WAV,                 /*!< WAV file (RIFF header, followed by PCM samples) */
+    AUDIO_SINK_MAX,                 /*!< Maximum audio sink */
+} nesl_audio_sink_e;
+
+/*!
+ * @struct nesl_audio_sink_t
+ * @brief Audio sink context.
+ */
+typedef struct {
+    nesl_audio_sink_e type;         /*!< Sink type */
+    FILE *file;                     /*!< File handle */
+    int rate;                       /*!< Sample rate (Hz) */
+    uint32_t length;                /*!< Bytes written to file, excluding header */
+    pthread_t thread;               /*!< Writer thread */
+    pthread_mutex_t lock;           /*!< Mutex */
+    pthread_cond_t signal;          /*!< Condition signalled when a batch is queued or written */
+    bool running;                   /*!< Writer thread running flag */
+    bool pending;                   /*!< Back batch pending flag */
+    int error;                      /*!< Writer error number of the first failed write, kept until close (0 if none) */
+
+    struct {
+        nesl_audio_sample_t *data;  /*!< Batch samples */
+        int count;                  /*!< Batch sample count */
+    } batch[2];                     /*!< Front (filling) and back (writing) batches */
+} nesl_audio_sink_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*!
+ * @brief Initialize audio sink, opening the file at path and starting the writer thread.
+ * @param[in,out] sink Pointer to audio sink context
+ * @param[in] path Constant pointer to file path (a .wav extension selects WAV, otherwise raw PCM)
+ * @param[in] rate Sample rate (Hz)
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+nesl_error_e nesl_audio_sink_initialize(nesl_audio_sink_t *sink, const char *path, int rate);
+
+/*!
+ * @brief Uninitialize audio sink, flushing queued samples and closing the file.
+ * @param[in,out] sink Pointer to audio sink context
+ * @return NESL_FAILURE if a write failed or the file could not be completed, NESL_SUCCESS otherwise
+ */
+nesl_error_e nesl_audio_sink_uninitialize(nesl_audio_sink_t *sink);
+
+/*!
+ * @brief Write samples to audio sink. A failed write by the writer thread is reported by the next batch queued.
+ * @param[in,out] sink Pointer to audio sink context
+ * @param[in] data Constant pointer to data array
+ * @param[in] count Number of entries in data array
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+nesl_error_e nesl_audio_sink_write(nesl_audio_sink_t *sink, const nesl_audio_sample_t *data, int count);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* NESL_AUDIO_SINK_H_ */
@@ -27,14 +27,32 @@
 #ifndef NESL_AUDIO_SQUARE_H_
 #define NESL_AUDIO_SQUARE_H_
 
-#include <audio_buffer.h>
+#include <common.h>
 
 /*!
  * @struct nesl_audio_square_t
  * @brief Audio square-wave synthesizer context.
  */
 typedef struct {
-    nesl_audio_buffer_t buffer;                 /*!< Audio buffer context */
+    uint8_t channel;                            /*!< Channel index (0:first, 1:second) */
+    bool enable;                                /*!< Enable flag */
+    uint8_t length;                             /*!< Length counter */
+
+    struct {
+        bool start;                             /*!< Start flag */
+        uint8_t divider;                        /*!< Divider */
+        uint8_t decay;                          /*!< Decay level */
+    } envelope;
+
+    struct {
+        bool reload;                            /*!< Reload flag */
+        uint8_t divider;                        /*!< Divider */
+    } sweep;
+
+    struct {
+        uint16_t count;                         /*!< Timer count */
+        uint8_t step;                           /*!< Duty-cycle step */
+    } timer;
 
     union {
 
@@ -84,32 +102,37 @@ typedef struct {
 /*!
  * @brief Cycle audio square-wave synthesizer through one cycle.
  * @param[in,out] square Pointer to audio square-wave synthesizer context
- * @param elapsed Current time in seconds
  */
-void nesl_audio_square_cycle(nesl_audio_square_t *square, float elapsed);
+void nesl_audio_square_cycle(nesl_audio_square_t *square);
 
 /*!
- * @brief Initialize audio square-wave synthesizer.
+ * @brief Clock audio square-wave synthesizer envelope, sweep and length units.
  * @param[in,out] square Pointer to audio square-wave synthesizer context
- * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ * @param[in] half Half-frame flag (clocks sweep and length units)
  */
-nesl_error_e nesl_audio_square_initialize(nesl_audio_square_t *square);
+void nesl_audio_square_frame(nesl_audio_square_t *square, bool half);
 
 /*!
- * @brief Read bytes from audio square-wave synthesizer.
- * @param[in,out] square Pointer to audio square-wave synthesizer context
- * @param[in,out] data Pointer to data array
- * @param[in] length Maximum number of entries in data array
- * @return Number of entries read
+ * @brief Get audio square-wave synthesizer length counter.
+ * @param[in] square Constant pointer to audio square-wave synthesizer context
+ * @return Length counter
+ */
+uint8_t nesl_audio_square_get_length(const nesl_audio_square_t *square);
+
+/*!
+ * @brief Get audio square-wave synthesizer output level.
+ * @param[in] square Constant pointer to audio square-wave synthesizer context
+ * @return Output level [0-15]
  */
-int nesl_audio_square_read(nesl_audio_square_t *square, float *data, int length);
+uint8_t nesl_audio_square_get_output(const nesl_audio_square_t *square);
 
 /*!
- * @brief Readable bytes in audio square-wave synthesizer.
+ * @brief Initialize audio square-wave synthesizer.
  * @param[in,out] square Pointer to audio square-wave synthesizer context
- * @return Number of entries readable
+ * @param[in] channel Channel index (0:first, 1:second)
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
  */
-int nesl_audio_square_readable(nesl_audio_square_t *square);
+nesl_error_e nesl_audio_square_initialize(nesl_audio_square_t *square, uint8_t channel);
 
 /*!
  * @brief Reset audio square-wave synthesizer.
@@ -118,6 +141,13 @@ int nesl_audio_square_readable(nesl_audio_square_t *square);
  */
 nesl_error_e nesl_audio_square_reset(nesl_audio_square_t *square);
 
+/*!
+ * @brief Set audio square-wave synthesizer enable flag.
+ * @param[in,out] square Pointer to audio square-wave synthesizer context
+ * @param[in] enable Enable flag
+ */
+void nesl_audio_square_set_enable(nesl_audio_square_t *square, bool enable);
+
 /*!
  * @brief Uninitialize audio square-wave synthesizer.
  * @param[in,out] square Pointer to audio square-wave synthesizer context
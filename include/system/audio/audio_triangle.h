@@ -27,14 +27,25 @@
 #ifndef NESL_AUDIO_TRIANGLE_H_
 #define NESL_AUDIO_TRIANGLE_H_
 
-#include <audio_buffer.h>
+#include <common.h>
 
 /*!
  * @struct nesl_audio_triangle_t
  * @brief Audio triangle-wave synthesizer context.
  */
 typedef struct {
-    nesl_audio_buffer_t buffer;                 /*!< Audio buffer context */
+    bool enable;                                /*!< Enable flag */
+    uint8_t length;                             /*!< Length counter */
+
+    struct {
+        bool reload;                            /*!< Reload flag */
+        uint8_t counter;                        /*!< Linear counter */
+    } linear;
+
+    struct {
+        uint16_t count;                         /*!< Timer count */
+        uint8_t step;                           /*!< Sequencer step */
+    } timer;
 
     union {
 
@@ -64,39 +75,43 @@ typedef struct {
             } length;
         };
 
-        uint8_t byte[4];                            /*!< Raw bytes */
+        uint8_t byte[4];                        /*!< Raw bytes */
     } state;
 } nesl_audio_triangle_t;
 
 /*!
  * @brief Cycle audio triangle-wave synthesizer through one cycle.
  * @param[in,out] triangle Pointer to audio triangle-wave synthesizer context
- * @param elapsed Current time in seconds
  */
-void nesl_audio_triangle_cycle(nesl_audio_triangle_t *triangle, float elapsed);
+void nesl_audio_triangle_cycle(nesl_audio_triangle_t *triangle);
 
 /*!
- * @brief Initialize audio triangle-wave synthesizer.
+ * @brief Clock audio triangle-wave synthesizer linear and length units.
  * @param[in,out] triangle Pointer to audio triangle-wave synthesizer context
- * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ * @param[in] half Half-frame flag (clocks length unit)
  */
-nesl_error_e nesl_audio_triangle_initialize(nesl_audio_triangle_t *triangle);
+void nesl_audio_triangle_frame(nesl_audio_triangle_t *triangle, bool half);
 
 /*!
- * @brief Read bytes from audio triangle-wave synthesizer.
- * @param[in,out] triangle Pointer to audio triangle-wave synthesizer context
- * @param[in,out] data Pointer to data array
- * @param[in] length Maximum number of entries in data array
- * @return Number of entries read
+ * @brief Get audio triangle-wave synthesizer length counter.
+ * @param[in] triangle Constant pointer to audio triangle-wave synthesizer context
+ * @return Length counter
+ */
+uint8_t nesl_audio_triangle_get_length(const nesl_audio_triangle_t *triangle);
+
+/*!
+ * @brief Get audio triangle-wave synthesizer output level.
+ * @param[in] triangle Constant pointer to audio triangle-wave synthesizer context
+ * @return Output level [0-15]
  */
-int nesl_audio_triangle_read(nesl_audio_triangle_t *triangle, float *data, int length);
+uint8_t nesl_audio_triangle_get_output(const nesl_audio_triangle_t *triangle);
 
 /*!
- * @brief Readable bytes in audio triangle-wave synthesizer.
+ * @brief Initialize audio triangle-wave synthesizer.
  * @param[in,out] triangle Pointer to audio triangle-wave synthesizer context
- * @return Number of entries readable
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
  */
-int nesl_audio_triangle_readable(nesl_audio_triangle_t *triangle);
+nesl_error_e nesl_audio_triangle_initialize(nesl_audio_triangle_t *triangle);
 
 /*!
  * @brief Reset audio triangle-wave synthesizer.
@@ -105,6 +120,13 @@ int nesl_audio_triangle_readable(nesl_audio_triangle_t *triangle);
  */
 nesl_error_e nesl_audio_triangle_reset(nesl_audio_triangle_t *triangle);
 
+/*!
+ * @brief Set audio triangle-wave synthesizer enable flag.
+ * @param[in,out] triangle Pointer to audio triangle-wave synthesizer context
+ * @param[in] enable Enable flag
+ */
+void nesl_audio_triangle_set_enable(nesl_audio_triangle_t *triangle, bool enable);
+
 /*!
  * @brief Uninitialize audio triangle-wave synthesizer.
  * @param[in,out] triangle Pointer to audio triangle-wave synthesizer context
@@ -27,7 +27,8 @@
 #ifndef NESL_CARTRIDGE_H_
 #define NESL_CARTRIDGE_H_
 
-#include <common.h>
+#include <arena.h>
+#include <dirty.h>
 
 /*!
  * @enum nesl_bank_e
@@ -83,7 +84,7 @@ typedef struct {
 
         struct {
             uint8_t mirror : 1;             /*!< Mirror type (0:Horizontal, 1:Vertical) */
-            uint8_t ram : 1;                /*!< Program RAM present */
+            uint8_t ram : 1;                /*!< Battery-backed program RAM present */
             uint8_t trainer : 1;            /*!< Trainer present */
             uint8_t four_screen : 1;        /*!< Four-screen flag */
             uint8_t type_low : 4;           /*!< Mapper type (low-nibble) */
@@ -118,21 +119,50 @@ typedef struct {
 typedef struct {
     const nesl_cartridge_header_t *header;  /*!< Constant pointer to cartridge header */
 
+    struct {
+        uint32_t character;                 /*!< Character bank address mask */
+    } mask;
+
     struct {
         uint8_t *character;                 /*!< Pointer to character RAM banks */
         uint8_t *program;                   /*!< Pointer to program RAM banks */
     } ram;
 
+    struct {
+        uint64_t *character;                /*!< Pointer to character RAM dirty pages, written since the last capture */
+        uint64_t *program;                  /*!< Pointer to program RAM dirty pages, written since the last capture */
+    } dirty;
+
     struct {
         const uint8_t *character;           /*!< Pointer to character ROM banks */
         const uint8_t *program;             /*!< Pointer to program ROM banks */
     } rom;
+
+    struct {
+        size_t length;                      /*!< Program RAM length mapped from the battery save file in bytes (0 if unmapped) */
+        const char *failure;                /*!< Battery save operation that failed ("open", "resize" or "map"), NULL if none failed */
+        int error;                          /*!< Battery save errno, if an operation failed */
+    } battery;
 } nesl_cartridge_t;
 
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
 
+/*!
+ * @brief Capture cartridge subsystem RAM banks into state, copying only the pages written since the last capture or restore.
+ * @param[in,out] cartridge Pointer to cartridge subsystem context
+ * @param[in,out] data Pointer to state data, holding the last capture
+ * @return State length in bytes
+ */
+size_t nesl_cartridge_capture(nesl_cartridge_t *cartridge, void *data);
+
+/*!
+ * @brief Flush cartridge subsystem battery-backed program RAM to its battery save file, without waiting for the write to complete.
+ * @param[in,out] cartridge Pointer to cartridge subsystem context
+ */
+void nesl_cartridge_flush(nesl_cartridge_t *cartridge);
+
 /*!
  * @brief Get cartridge bank count
  * @param[in,out] cartridge Pointer to cartridge subsystem context
@@ -141,6 +171,13 @@ extern "C" {
  */
 uint8_t nesl_cartridge_get_banks(nesl_cartridge_t *cartridge, nesl_bank_e type);
 
+/*!
+ * @brief Get cartridge battery save status, failing if the battery save could not be mapped and program RAM will not persist.
+ * @param[in] cartridge Constant pointer to cartridge subsystem context
+ * @return NESL_FAILURE if the battery save could not be mapped, NESL_SUCCESS otherwise
+ */
+nesl_error_e nesl_cartridge_get_battery(const nesl_cartridge_t *cartridge);
+
 /*!
  * @brief Get cartridge mapper type
  * @param[in,out] cartridge Pointer to cartridge subsystem context
@@ -156,13 +193,33 @@ nesl_mapper_e nesl_cartridge_get_mapper(nesl_cartridge_t *cartridge);
 nesl_mirror_e nesl_cartridge_get_mirror(nesl_cartridge_t *cartridge);
 
 /*!
- * @brief Initialize cartridge subsystem.
+ * @brief Get cartridge subsystem arena size, for the RAM banks described by the cartridge header.
+ * @param[in] data Constant pointer to cartridge data
+ * @param[in] length Cartridge data length in bytes
+ * @return Cartridge arena size in bytes
+ */
+size_t nesl_cartridge_get_size(const void *data, int length);
+
+/*!
+ * @brief Initialize cartridge subsystem. Battery-backed program RAM is mapped from the battery save file, if given, so writes
+ *        persist without extra work on the write path. If the file cannot be mapped, the program RAM is allocated from the
+ *        arena without persistence, reported through nesl_cartridge_get_battery.
  * @param[in,out] cartridge Pointer to cartridge subsystem context
+ * @param[in,out] arena Pointer to arena context, holding the RAM banks
  * @param[in] data Constant pointer to cartridge data
  * @param[in] length Cartridge data length in bytes
+ * @param[in] save Constant pointer to battery save path string, created if missing (can be NULL)
  * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
  */
-nesl_error_e nesl_cartridge_initialize(nesl_cartridge_t *cartridge, const void *data, int length);
+nesl_error_e nesl_cartridge_initialize(nesl_cartridge_t *cartridge, nesl_arena_t *arena, const void *data, int length, const char *save);
+
+/*!
+ * @brief Load cartridge subsystem RAM banks from state, marking every page dirty.
+ * @param[in,out] cartridge Pointer to cartridge subsystem context
+ * @param[in] data Constant pointer to state data, written by nesl_cartridge_save
+ * @return State length in bytes
+ */
+size_t nesl_cartridge_load(nesl_cartridge_t *cartridge, const void *data);
 
 /*!
  * @brief Read byte from cartridge subsystem RAM bank.
@@ -183,7 +240,23 @@ uint8_t nesl_cartridge_read_ram(nesl_cartridge_t *cartridge, nesl_bank_e type, u
 uint8_t nesl_cartridge_read_rom(nesl_cartridge_t *cartridge, nesl_bank_e type, uint32_t address);
 
 /*!
- * @brief Uninitialize cartridge subsystem.
+ * @brief Restore cartridge subsystem RAM banks from state, copying back only the pages written since the last capture or restore.
+ * @param[in,out] cartridge Pointer to cartridge subsystem context
+ * @param[in] data Constant pointer to state data, holding the last capture
+ * @return State length in bytes
+ */
+size_t nesl_cartridge_restore(nesl_cartridge_t *cartridge, const void *data);
+
+/*!
+ * @brief Save cartridge subsystem RAM banks to state.
+ * @param[in] cartridge Constant pointer to cartridge subsystem context
+ * @param[out] data Pointer to state data, or NULL to query the state length
+ * @return State length in bytes
+ */
+size_t nesl_cartridge_save(const nesl_cartridge_t *cartridge, void *data);
+
+/*!
+ * @brief Uninitialize cartridge subsystem, flushing and unmapping any battery-backed program RAM.
  * @param[in,out] cartridge Pointer to cartridge subsystem context
  */
 void nesl_cartridge_uninitialize(nesl_cartridge_t *cartridge);
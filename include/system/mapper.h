@@ -47,9 +47,11 @@ typedef struct nesl_mapper_s {
 
     struct {
         nesl_error_e (*interrupt)(struct nesl_mapper_s *mapper);                                            /*!< Mapper extension interrupt */
+        size_t (*load)(struct nesl_mapper_s *mapper, const void *data);                                     /*!< Mapper extension load state */
         uint8_t (*read_ram)(struct nesl_mapper_s *mapper, nesl_bank_e type, uint16_t address);              /*!< Mapper extension read RAM */
         uint8_t (*read_rom)(struct nesl_mapper_s *mapper, nesl_bank_e type, uint16_t address);              /*!< Mapper extension read ROM */
         nesl_error_e (*reset)(struct nesl_mapper_s *mapper);                                                /*!< Mapper extension reset */
+        size_t (*save)(const struct nesl_mapper_s *mapper, void *data);                                     /*!< Mapper extension save state */
         void (*write_ram)(struct nesl_mapper_s *mapper, nesl_bank_e type, uint16_t address, uint8_t data);  /*!< Mapper extension write RAM */
         void (*write_rom)(struct nesl_mapper_s *mapper, nesl_bank_e type, uint16_t address, uint8_t data);  /*!< Mapper extension write ROM */
     } extension;
@@ -68,14 +70,46 @@ typedef struct nesl_mapper_s {
 extern "C" {
 #endif /* __cplusplus */
 
+/*!
+ * @brief Capture mapper subsystem bank, mirror and extension state into state, followed by the cartridge RAM pages written since
+ *        the last capture or restore.
+ * @param[in,out] mapper Pointer to mapper subsystem context
+ * @param[in,out] data Pointer to state data, holding the last capture
+ * @return State length in bytes
+ */
+size_t nesl_mapper_capture(nesl_mapper_t *mapper, void *data);
+
+/*!
+ * @brief Flush mapper subsystem battery-backed cartridge program RAM to its battery save file, without waiting for the write to complete.
+ * @param[in,out] mapper Pointer to mapper subsystem context
+ */
+void nesl_mapper_flush(nesl_mapper_t *mapper);
+
+/*!
+ * @brief Get mapper subsystem battery save status, failing if the cartridge battery save could not be mapped.
+ * @param[in] mapper Constant pointer to mapper subsystem context
+ * @return NESL_FAILURE if the battery save could not be mapped, NESL_SUCCESS otherwise
+ */
+nesl_error_e nesl_mapper_get_battery(const nesl_mapper_t *mapper);
+
+/*!
+ * @brief Get mapper subsystem arena size, for the extension context and cartridge RAM banks described by the cartridge header.
+ * @param[in] data Constant pointer to cartridge data
+ * @param[in] length Cartridge data length in bytes
+ * @return Mapper arena size in bytes
+ */
+size_t nesl_mapper_get_size(const void *data, int length);
+
 /*!
  * @brief Initialize mapper subsystem.
  * @param[in,out] mapper Pointer to mapper subsystem context
+ * @param[in,out] arena Pointer to arena context, holding the extension context and cartridge RAM banks
  * @param[in] data Constant pointer to cartridge data
  * @param[in] length Cartridge data length in bytes
+ * @param[in] save Constant pointer to battery save path string, mapping battery-backed cartridge program RAM (can be NULL)
  * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
  */
-nesl_error_e nesl_mapper_initialize(nesl_mapper_t *mapper, const void *data, int length);
+nesl_error_e nesl_mapper_initialize(nesl_mapper_t *mapper, nesl_arena_t *arena, const void *data, int length, const char *save);
 
 /*!
  * @brief Send mapper subsystem interrupt.
@@ -84,6 +118,14 @@ nesl_error_e nesl_mapper_initialize(nesl_mapper_t *mapper, const void *data, int
  */
 nesl_error_e nesl_mapper_interrupt(nesl_mapper_t *mapper);
 
+/*!
+ * @brief Load mapper subsystem bank, mirror and extension state, followed by the cartridge RAM banks.
+ * @param[in,out] mapper Pointer to mapper subsystem context
+ * @param[in] data Constant pointer to state data, written by nesl_mapper_save
+ * @return State length in bytes
+ */
+size_t nesl_mapper_load(nesl_mapper_t *mapper, const void *data);
+
 /*!
  * @brief Read byte from mapper subsystem.
  * @param[in,out] mapper Pointer to mapper subsystem context
@@ -100,6 +142,23 @@ uint8_t nesl_mapper_read(nesl_mapper_t *mapper, nesl_bank_e type, uint16_t addre
  */
 nesl_error_e nesl_mapper_reset(nesl_mapper_t *mapper);
 
+/*!
+ * @brief Restore mapper subsystem bank, mirror and extension state from state, followed by the cartridge RAM pages written since
+ *        the last capture or restore.
+ * @param[in,out] mapper Pointer to mapper subsystem context
+ * @param[in] data Constant pointer to state data, holding the last capture
+ * @return State length in bytes
+ */
+size_t nesl_mapper_restore(nesl_mapper_t *mapper, const void *data);
+
+/*!
+ * @brief Save mapper subsystem bank, mirror and extension state, followed by the cartridge RAM banks.
+ * @param[in] mapper Constant pointer to mapper subsystem context
+ * @param[out] data Pointer to state data, or NULL to query the state length
+ * @return State length in bytes
+ */
+size_t nesl_mapper_save(const nesl_mapper_t *mapper, void *data);
+
 /*!
  * @brief Uninitialize mapper subsystem.
  * @param[in,out] mapper Pointer to mapper subsystem context
@@ -59,9 +59,10 @@ extern "C" {
 /*!
  * @brief Initialize mapper-30 extension.
  * @param[in,out] mapper Pointer to mapper subsystem context
+ * @param[in,out] arena Pointer to arena context, holding the extension context
  * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
  */
-nesl_error_e nesl_mapper_30_initialize(nesl_mapper_t *mapper);
+nesl_error_e nesl_mapper_30_initialize(nesl_mapper_t *mapper, nesl_arena_t *arena);
 
 /*!
  * @brief Send mapper-30 extension interrupt.
@@ -70,6 +71,14 @@ nesl_error_e nesl_mapper_30_initialize(nesl_mapper_t *mapper);
  */
 nesl_error_e nesl_mapper_30_interrupt(nesl_mapper_t *mapper);
 
+/*!
+ * @brief Load mapper-30 extension state.
+ * @param[in,out] mapper Pointer to mapper subsystem context
+ * @param[in] data Constant pointer to state data
+ * @return State length in bytes
+ */
+size_t nesl_mapper_30_load(nesl_mapper_t *mapper, const void *data);
+
 /*!
  * @brief Read byte from mapper-30 RAM extension.
  * @param[in,out] mapper Pointer to mapper subsystem context
@@ -95,6 +104,14 @@ uint8_t nesl_mapper_30_read_rom(nesl_mapper_t *mapper, nesl_bank_e type, uint16_
  */
 nesl_error_e nesl_mapper_30_reset(nesl_mapper_t *mapper);
 
+/*!
+ * @brief Save mapper-30 extension state.
+ * @param[in] mapper Constant pointer to mapper subsystem context
+ * @param[out] data Pointer to state data, or NULL to query the state length
+ * @return State length in bytes
+ */
+size_t nesl_mapper_30_save(const nesl_mapper_t *mapper, void *data);
+
 /*!
  * @brief Uninitialize mapper-30 extension.
  * @param[in,out] mapper Pointer to mapper subsystem context
@@ -28,6 +28,7 @@
 #define NESL_PROCESSOR_H_
 
 #include <bus.h>
+#include <dirty.h>
 
 /*!
  * @enum nesl_instruction_e
@@ -138,6 +139,7 @@ typedef union {
  * @brief Processor subsystem context.
  */
 typedef struct {
+    uint64_t dirty;                         /*!< Program RAM dirty pages, written since the last capture (not saved) */
     uint8_t cycle;                          /*!< Remaining cycles */
     uint8_t ram[2 * 1024];                  /*!< Program RAM buffer */
 
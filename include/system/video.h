@@ -28,6 +28,7 @@
 #define NESL_VIDEO_H_
 
 #include <bus.h>
+#include <dirty.h>
 
 /*!
  * @enum nesl_port_e
@@ -130,6 +131,8 @@ typedef struct {
     uint16_t cycle;                                 /*!< Current cycle (x-coordinate) */
     int16_t scanline;                               /*!< Current scanline (y-coordinate) */
     const nesl_mirror_e *mirror;                    /*!< Constant pointer to mapper mirror */
+    bool hidden;                                    /*!< Hidden flag (no pixel output, for run-ahead frames) */
+    uint64_t dirty;                                 /*!< RAM dirty pages, written since the last capture (not saved) */
 
     struct {
         nesl_video_address_t v;                     /*!< Internal address */
@@ -24,18 +24,30 @@
  * @brief Common bus.
  */
 
+#include <stddef.h>
 #include <audio.h>
+#include <hash.h>
 #include <input.h>
 #include <mapper.h>
 #include <processor.h>
+#include <rewind.h>
+#include <slot.h>
 #include <video.h>
 
+#define BUS_FLUSH 300               /*!< Frames between battery save flushes (5 seconds) */
+
 /*!
- * @struct nesl_bus_t
+ * @struct nesl_bus_s
  * @brief Bus and subsystem contexts.
  */
-typedef struct {
+struct nesl_bus_s {
+    nesl_arena_t arena;             /*!< Arena context, holding the bus and subsystem allocations */
     uint64_t cycle;                 /*!< Cycle-count since start of emulation */
+    nesl_rewind_t rewind;           /*!< Rewind context, holding per-frame states (if enabled) */
+    uint8_t *capture;               /*!< Capture state, matching the bus and subsystems as of the last capture or restore */
+    uint32_t reset;                 /*!< Reset count since initialization (not saved) */
+    uint32_t flush;                 /*!< Frame count since the last battery save flush (not saved) */
+    nesl_slot_t slot;               /*!< Save slot context, holding numbered states written by a background thread (if enabled) */
 
     struct {
         nesl_audio_t audio;         /*!< Audio subsystem context */
@@ -44,9 +56,39 @@ typedef struct {
         nesl_processor_t processor; /*!< Processor subsystem context */
         nesl_video_t video;         /*!< Video subsystem context */
     } subsystem;
-} nesl_bus_t;
+};
 
-static nesl_bus_t g_bus = {};       /*!< Bus context */
+/*!
+ * @struct nesl_bus_state_t
+ * @brief Bus state range, a pointer-free range of the bus context copied into state.
+ */
+typedef struct {
+    nesl_subsystem_e subsystem;     /*!< Range subsystem */
+    size_t offset;                  /*!< Range offset in bytes, from the start of the bus context */
+    size_t length;                  /*!< Range length in bytes */
+    size_t dirty;                   /*!< Range dirty bitmap offset in bytes, from the start of the bus context (0 if copied whole) */
+} nesl_bus_state_t;
+
+/*!
+ * @brief Bus state ranges array, skipping the audio output buffers, the dirty bitmaps and the video mirror pointer.
+ * @note If a new subsystem is added, its state must be added into this array
+ */
+static const nesl_bus_state_t STATE[] = {
+    { SUBSYSTEM_BUS, offsetof(nesl_bus_t, cycle), sizeof(uint64_t), },                                                                               /*!< Bus cycle */
+    { SUBSYSTEM_AUDIO, offsetof(nesl_bus_t, subsystem.audio.status), sizeof(nesl_audio_t) - offsetof(nesl_audio_t, status), },                       /*!< Audio registers and synthesizers */
+    { SUBSYSTEM_INPUT, offsetof(nesl_bus_t, subsystem.input), sizeof(nesl_input_t), },                                                               /*!< Input */
+    { SUBSYSTEM_PROCESSOR, offsetof(nesl_bus_t, subsystem.processor.cycle), offsetof(nesl_processor_t, ram) - offsetof(nesl_processor_t, cycle), },  /*!< Processor cycle */
+    { SUBSYSTEM_PROCESSOR, offsetof(nesl_bus_t, subsystem.processor.ram), sizeof(((nesl_processor_t *)NULL)->ram),
+        offsetof(nesl_bus_t, subsystem.processor.dirty), },                                                                                          /*!< Processor RAM */
+    { SUBSYSTEM_PROCESSOR, offsetof(nesl_bus_t, subsystem.processor.interrupt), sizeof(nesl_processor_t) - offsetof(nesl_processor_t, interrupt), }, /*!< Processor registers */
+    { SUBSYSTEM_VIDEO, offsetof(nesl_bus_t, subsystem.video.cycle), offsetof(nesl_video_t, mirror), },                                               /*!< Video cycle and scanline */
+    { SUBSYSTEM_VIDEO, offsetof(nesl_bus_t, subsystem.video.address), offsetof(nesl_video_t, ram) - offsetof(nesl_video_t, address), },              /*!< Video registers */
+    { SUBSYSTEM_VIDEO, offsetof(nesl_bus_t, subsystem.video.ram), sizeof(((nesl_video_t *)NULL)->ram),
+        offsetof(nesl_bus_t, subsystem.video.dirty), },                                                                                              /*!< Video RAM */
+    { SUBSYSTEM_VIDEO, offsetof(nesl_bus_t, subsystem.video.sprite), sizeof(nesl_video_t) - offsetof(nesl_video_t, sprite), },                       /*!< Video sprites */
+    };
+
+static _Thread_local nesl_bus_t *g_bus = NULL; /*!< Bus context (bound to the calling thread) */
 
 #ifdef __cplusplus
 extern "C" {
@@ -64,62 +106,158 @@ static nesl_error_e nesl_bus_reset(void)
         goto exit;
     }
 
-    if((result = nesl_mapper_reset(&g_bus.subsystem.mapper)) == NESL_FAILURE) {
+    if((result = nesl_mapper_reset(&g_bus->subsystem.mapper)) == NESL_FAILURE) {
         goto exit;
     }
 
-    if((result = nesl_audio_reset(&g_bus.subsystem.audio)) == NESL_FAILURE) {
+    if((result = nesl_audio_reset(&g_bus->subsystem.audio)) == NESL_FAILURE) {
         goto exit;
     }
 
-    if((result = nesl_input_reset(&g_bus.subsystem.input)) == NESL_FAILURE) {
+    if((result = nesl_input_reset(&g_bus->subsystem.input)) == NESL_FAILURE) {
         goto exit;
     }
 
-    if((result = nesl_processor_reset(&g_bus.subsystem.processor)) == NESL_FAILURE) {
+    if((result = nesl_processor_reset(&g_bus->subsystem.processor)) == NESL_FAILURE) {
         goto exit;
     }
 
-    if((result = nesl_video_reset(&g_bus.subsystem.video, &g_bus.subsystem.mapper.mirror)) == NESL_FAILURE) {
+    if((result = nesl_video_reset(&g_bus->subsystem.video, &g_bus->subsystem.mapper.mirror)) == NESL_FAILURE) {
         goto exit;
     }
 
-    g_bus.cycle = 0;
+    g_bus->cycle = 0;
 
 exit:
     return result;
 }
 
+const void *nesl_bus_capture(void)
+{
+    size_t result = 0;
+
+    for(int index = 0; index < (sizeof(STATE) / sizeof(*(STATE))); ++index) {
+
+        if(STATE[index].dirty) {
+            result += nesl_dirty_copy((uint64_t *)((uint8_t *)g_bus + STATE[index].dirty), &g_bus->capture[result],
+                (const uint8_t *)g_bus + STATE[index].offset, STATE[index].length);
+        } else {
+            memcpy(&g_bus->capture[result], (const uint8_t *)g_bus + STATE[index].offset, STATE[index].length);
+            result += STATE[index].length;
+        }
+    }
+
+    nesl_mapper_capture(&g_bus->subsystem.mapper, &g_bus->capture[result]);
+
+    return g_bus->capture;
+}
+
 bool nesl_bus_cycle(void)
 {
-    nesl_processor_cycle(&g_bus.subsystem.processor, g_bus.cycle);
-    nesl_audio_cycle(&g_bus.subsystem.audio, g_bus.cycle);
-    ++g_bus.cycle;
+    bool result;
+
+    nesl_processor_cycle(&g_bus->subsystem.processor, g_bus->cycle);
+    nesl_audio_cycle(&g_bus->subsystem.audio, g_bus->cycle);
+    ++g_bus->cycle;
+
+    if((result = nesl_video_cycle(&g_bus->subsystem.video)) && !g_bus->subsystem.audio.hidden) {
+
+        if(g_bus->rewind.length) {
+            nesl_rewind_push(&g_bus->rewind, nesl_bus_capture());
+        }
+
+        if(++g_bus->flush >= BUS_FLUSH) {
+            nesl_mapper_flush(&g_bus->subsystem.mapper);
+            g_bus->flush = 0;
+        }
+    }
+
+    return result;
+}
+
+nesl_bus_t *nesl_bus_get(void)
+{
+    return g_bus;
+}
 
-    return nesl_video_cycle(&g_bus.subsystem.video);
+nesl_error_e nesl_bus_get_battery(void)
+{
+    return nesl_mapper_get_battery(&g_bus->subsystem.mapper);
 }
 
-nesl_error_e nesl_bus_initialize(const void *data, int length)
+nesl_error_e nesl_bus_get_error(void)
 {
+    return nesl_audio_get_error(&g_bus->subsystem.audio);
+}
+
+uint32_t nesl_bus_get_reset(void)
+{
+    return g_bus->reset;
+}
+
+void nesl_bus_hash(uint64_t *hash)
+{
+    size_t offset = 0;
+    const uint8_t *state = nesl_bus_capture();
+
+    memset(hash, 0, SUBSYSTEM_MAX * sizeof(*hash));
+
+    for(int index = 0; index < (sizeof(STATE) / sizeof(*(STATE))); ++index) {
+        hash[STATE[index].subsystem] = nesl_hash(&state[offset], STATE[index].length, hash[STATE[index].subsystem]);
+        offset += STATE[index].length;
+    }
+
+    hash[SUBSYSTEM_MAPPER] = nesl_hash(&state[offset], nesl_mapper_save(&g_bus->subsystem.mapper, NULL), 0);
+}
+
+nesl_error_e nesl_bus_initialize(const nesl_t *context)
+{
+    nesl_arena_t arena = {};
     nesl_error_e result;
 
-    if((result = nesl_mapper_initialize(&g_bus.subsystem.mapper, data, length)) == NESL_FAILURE) {
+    if((result = nesl_arena_initialize(&arena, ARENA_SIZE(sizeof(*g_bus)) + nesl_mapper_get_size(context->data, context->length)
+            + nesl_audio_get_size(context->quiet))) == NESL_FAILURE) {
+        goto exit;
+    }
+
+    if(!(g_bus = nesl_arena_allocate(&arena, sizeof(*g_bus)))) {
+        result = SET_ERROR("Failed to allocate bus -- %.02f KB (%i bytes)", sizeof(*g_bus) / 1024.f, sizeof(*g_bus));
+        nesl_arena_uninitialize(&arena);
+        goto exit;
+    }
+
+    g_bus->arena = arena;
+
+    if((result = nesl_mapper_initialize(&g_bus->subsystem.mapper, &g_bus->arena, context->data, context->length, context->save)) == NESL_FAILURE) {
+        goto exit;
+    }
+
+    if((result = nesl_audio_initialize(&g_bus->subsystem.audio, &g_bus->arena, context->quiet, context->record, context->rate)) == NESL_FAILURE) {
+        goto exit;
+    }
+
+    if((result = nesl_input_initialize(&g_bus->subsystem.input)) == NESL_FAILURE) {
+        goto exit;
+    }
+
+    if((result = nesl_processor_initialize(&g_bus->subsystem.processor)) == NESL_FAILURE) {
         goto exit;
     }
 
-    if((result = nesl_audio_initialize(&g_bus.subsystem.audio)) == NESL_FAILURE) {
+    if((result = nesl_video_initialize(&g_bus->subsystem.video, &g_bus->subsystem.mapper.mirror)) == NESL_FAILURE) {
         goto exit;
     }
 
-    if((result = nesl_input_initialize(&g_bus.subsystem.input)) == NESL_FAILURE) {
+    if(!(g_bus->capture = calloc(1, nesl_bus_save(NULL)))) {
+        result = SET_ERROR("Failed to allocate capture -- %.02f KB (%i bytes)", nesl_bus_save(NULL) / 1024.f, (int)nesl_bus_save(NULL));
         goto exit;
     }
 
-    if((result = nesl_processor_initialize(&g_bus.subsystem.processor)) == NESL_FAILURE) {
+    if(context->rewind && ((result = nesl_rewind_initialize(&g_bus->rewind, (size_t)context->rewind * 1024 * 1024, nesl_bus_save(NULL))) == NESL_FAILURE)) {
         goto exit;
     }
 
-    if((result = nesl_video_initialize(&g_bus.subsystem.video, &g_bus.subsystem.mapper.mirror)) == NESL_FAILURE) {
+    if(context->slot && ((result = nesl_slot_initialize(&g_bus->slot, context->slot, nesl_hash(context->data, context->length, 0), nesl_bus_save(NULL))) == NESL_FAILURE)) {
         goto exit;
     }
 
@@ -135,7 +273,7 @@ nesl_error_e nesl_bus_interrupt(nesl_interrupt_e type)
         case INTERRUPT_MASKABLE:
         case INTERRUPT_NON_MASKABLE:
 
-            if((result = nesl_processor_interrupt(&g_bus.subsystem.processor, type == INTERRUPT_MASKABLE)) == NESL_FAILURE) {
+            if((result = nesl_processor_interrupt(&g_bus->subsystem.processor, type == INTERRUPT_MASKABLE)) == NESL_FAILURE) {
                 goto exit;
             }
             break;
@@ -144,10 +282,12 @@ nesl_error_e nesl_bus_interrupt(nesl_interrupt_e type)
             if((result = nesl_bus_reset()) == NESL_FAILURE) {
                 goto exit;
             }
+
+            ++g_bus->reset;
             break;
         case INTERRUPT_MAPPER:
 
-            if((result = nesl_mapper_interrupt(&g_bus.subsystem.mapper)) == NESL_FAILURE) {
+            if((result = nesl_mapper_interrupt(&g_bus->subsystem.mapper)) == NESL_FAILURE) {
                 goto exit;
             }
             break;
@@ -159,6 +299,34 @@ exit:
     return result;
 }
 
+size_t nesl_bus_load(const void *data)
+{
+    size_t result = 0;
+    const uint8_t *offset = data;
+
+    for(int index = 0; index < (sizeof(STATE) / sizeof(*(STATE))); ++index) {
+        memcpy((uint8_t *)g_bus + STATE[index].offset, &offset[result], STATE[index].length);
+        result += STATE[index].length;
+
+        if(STATE[index].dirty) {
+            nesl_dirty_set((uint64_t *)((uint8_t *)g_bus + STATE[index].dirty), STATE[index].length);
+        }
+    }
+
+    result += nesl_mapper_load(&g_bus->subsystem.mapper, &offset[result]);
+
+    return result;
+}
+
+void nesl_bus_load_slot(int index)
+{
+    const void *state;
+
+    if(g_bus->slot.length && (state = nesl_slot_load(&g_bus->slot, index))) {
+        nesl_bus_load(state);
+    }
+}
+
 uint8_t nesl_bus_read(nesl_bus_e type, uint16_t address)
 {
     uint8_t result = 0;
@@ -168,22 +336,22 @@ uint8_t nesl_bus_read(nesl_bus_e type, uint16_t address)
 
             switch(address) {
                 case 0x0000 ... 0x1FFF:
-                    result = nesl_processor_read(&g_bus.subsystem.processor, address);
+                    result = nesl_processor_read(&g_bus->subsystem.processor, address);
                     break;
                 case 0x2000 ... 0x3FFF:
-                    result = nesl_video_read_port(&g_bus.subsystem.video, address);
+                    result = nesl_video_read_port(&g_bus->subsystem.video, address);
                     break;
                 case 0x4015:
-                    result = nesl_audio_read(&g_bus.subsystem.audio, address);
+                    result = nesl_audio_read(&g_bus->subsystem.audio, address);
                     break;
                 case 0x4016 ... 0x4017:
-                    result = nesl_input_read(&g_bus.subsystem.input, address);
+                    result = nesl_input_read(&g_bus->subsystem.input, address);
                     break;
                 case 0x6000 ... 0x7FFF:
-                    result = nesl_mapper_read(&g_bus.subsystem.mapper, BANK_PROGRAM_RAM, address);
+                    result = nesl_mapper_read(&g_bus->subsystem.mapper, BANK_PROGRAM_RAM, address);
                     break;
                 case 0x8000 ... 0xFFFF:
-                    result = nesl_mapper_read(&g_bus.subsystem.mapper, BANK_PROGRAM_ROM, address);
+                    result = nesl_mapper_read(&g_bus->subsystem.mapper, BANK_PROGRAM_ROM, address);
                     break;
                 default:
                     break;
@@ -193,10 +361,10 @@ uint8_t nesl_bus_read(nesl_bus_e type, uint16_t address)
 
             switch(address) {
                 case 0x0000 ... 0x1FFF:
-                    result = nesl_mapper_read(&g_bus.subsystem.mapper, BANK_CHARACTER_ROM, address);
+                    result = nesl_mapper_read(&g_bus->subsystem.mapper, BANK_CHARACTER_ROM, address);
                     break;
                 case 0x2000 ... 0x3FFF:
-                    result = nesl_video_read(&g_bus.subsystem.video, address);
+                    result = nesl_video_read(&g_bus->subsystem.video, address);
                     break;
                 default:
                     break;
@@ -206,7 +374,7 @@ uint8_t nesl_bus_read(nesl_bus_e type, uint16_t address)
 
             switch(address) {
                 case 0x0000 ... 0x00FF:
-                    result = nesl_video_read_oam(&g_bus.subsystem.video, address);
+                    result = nesl_video_read_oam(&g_bus->subsystem.video, address);
                     break;
                 default:
                     break;
@@ -219,14 +387,94 @@ uint8_t nesl_bus_read(nesl_bus_e type, uint16_t address)
     return result;
 }
 
-void nesl_bus_uninitialize(void)
+void nesl_bus_rewind(void)
+{
+
+    if((g_bus->rewind.entry.count > 2) && nesl_rewind_pop(&g_bus->rewind) && nesl_rewind_pop(&g_bus->rewind)
+            && nesl_rewind_peek(&g_bus->rewind, g_bus->rewind.state)) {
+        nesl_bus_load(g_bus->rewind.state);
+    }
+}
+
+void nesl_bus_restore(void)
 {
-    nesl_video_uninitialize(&g_bus.subsystem.video);
-    nesl_processor_uninitialize(&g_bus.subsystem.processor);
-    nesl_input_uninitialize(&g_bus.subsystem.input);
-    nesl_audio_uninitialize(&g_bus.subsystem.audio);
-    nesl_mapper_uninitialize(&g_bus.subsystem.mapper);
-    memset(&g_bus, 0, sizeof(g_bus));
+    size_t result = 0;
+
+    for(int index = 0; index < (sizeof(STATE) / sizeof(*(STATE))); ++index) {
+
+        if(STATE[index].dirty) {
+            result += nesl_dirty_copy((uint64_t *)((uint8_t *)g_bus + STATE[index].dirty), (uint8_t *)g_bus + STATE[index].offset,
+                &g_bus->capture[result], STATE[index].length);
+        } else {
+            memcpy((uint8_t *)g_bus + STATE[index].offset, &g_bus->capture[result], STATE[index].length);
+            result += STATE[index].length;
+        }
+    }
+
+    nesl_mapper_restore(&g_bus->subsystem.mapper, &g_bus->capture[result]);
+}
+
+size_t nesl_bus_save(void *data)
+{
+    size_t result = 0;
+    uint8_t *offset = data;
+
+    for(int index = 0; index < (sizeof(STATE) / sizeof(*(STATE))); ++index) {
+
+        if(offset) {
+            memcpy(&offset[result], (const uint8_t *)g_bus + STATE[index].offset, STATE[index].length);
+        }
+
+        result += STATE[index].length;
+    }
+
+    result += nesl_mapper_save(&g_bus->subsystem.mapper, offset ? &offset[result] : NULL);
+
+    return result;
+}
+
+nesl_error_e nesl_bus_save_slot(int index)
+{
+    nesl_error_e result = NESL_SUCCESS;
+
+    if(g_bus->slot.length) {
+        result = nesl_slot_save(&g_bus->slot, index, nesl_bus_capture());
+    }
+
+    return result;
+}
+
+void nesl_bus_set(nesl_bus_t *bus)
+{
+    g_bus = bus;
+}
+
+void nesl_bus_set_hidden(bool video, bool audio)
+{
+    g_bus->subsystem.video.hidden = video;
+    g_bus->subsystem.audio.hidden = audio;
+}
+
+nesl_error_e nesl_bus_uninitialize(void)
+{
+    nesl_error_e result = NESL_SUCCESS;
+
+    if(g_bus) {
+        nesl_arena_t arena = g_bus->arena;
+
+        nesl_slot_uninitialize(&g_bus->slot);
+        nesl_rewind_uninitialize(&g_bus->rewind);
+        free(g_bus->capture);
+        nesl_video_uninitialize(&g_bus->subsystem.video);
+        nesl_processor_uninitialize(&g_bus->subsystem.processor);
+        nesl_input_uninitialize(&g_bus->subsystem.input);
+        result = nesl_audio_uninitialize(&g_bus->subsystem.audio);
+        nesl_mapper_uninitialize(&g_bus->subsystem.mapper);
+        g_bus = NULL;
+        nesl_arena_uninitialize(&arena);
+    }
+
+    return result;
 }
 
 void nesl_bus_write(nesl_bus_e type, uint16_t address, uint8_t data)
@@ -238,24 +486,24 @@ void nesl_bus_write(nesl_bus_e type, uint16_t address, uint8_t data)
             switch(address) {
                 case 0x0000 ... 0x1FFF:
                 case 0x4014:
-                    nesl_processor_write(&g_bus.subsystem.processor, address, data);
+                    nesl_processor_write(&g_bus->subsystem.processor, address, data);
                     break;
                 case 0x2000 ... 0x3FFF:
-                    nesl_video_write_port(&g_bus.subsystem.video, address, data);
+                    nesl_video_write_port(&g_bus->subsystem.video, address, data);
                     break;
                 case 0x4000 ... 0x4013:
                 case 0x4015:
                 case 0x4017:
-                    nesl_audio_write(&g_bus.subsystem.audio, address, data);
+                    nesl_audio_write(&g_bus->subsystem.audio, address, data);
                     break;
                 case 0x4016:
-                    nesl_input_write(&g_bus.subsystem.input, address, data);
+                    nesl_input_write(&g_bus->subsystem.input, address, data);
                     break;
                 case 0x6000 ... 0x7FFF:
-                    nesl_mapper_write(&g_bus.subsystem.mapper, BANK_PROGRAM_RAM, address, data);
+                    nesl_mapper_write(&g_bus->subsystem.mapper, BANK_PROGRAM_RAM, address, data);
                     break;
                 case 0x8000 ... 0xFFFF:
-                    nesl_mapper_write(&g_bus.subsystem.mapper, BANK_PROGRAM_ROM, address, data);
+                    nesl_mapper_write(&g_bus->subsystem.mapper, BANK_PROGRAM_ROM, address, data);
                     break;
                 default:
                     break;
@@ -265,10 +513,10 @@ void nesl_bus_write(nesl_bus_e type, uint16_t address, uint8_t data)
 
             switch(address) {
                 case 0x0000 ... 0x1FFF:
-                    nesl_mapper_write(&g_bus.subsystem.mapper, BANK_CHARACTER_ROM, address, data);
+                    nesl_mapper_write(&g_bus->subsystem.mapper, BANK_CHARACTER_ROM, address, data);
                     break;
                 case 0x2000 ... 0x3FFF:
-                    nesl_video_write(&g_bus.subsystem.video, address, data);
+                    nesl_video_write(&g_bus->subsystem.video, address, data);
                     break;
                 default:
                     break;
@@ -278,7 +526,7 @@ void nesl_bus_write(nesl_bus_e type, uint16_t address, uint8_t data)
 
             switch(address) {
                 case 0x0000 ... 0x00FF:
-                    nesl_video_write_oam(&g_bus.subsystem.video, address, data);
+                    nesl_video_write_oam(&g_bus->subsystem.video, address, data);
                     break;
                 default:
                     break;
@@ -0,0 +1,76 @@
+/*
+ * NESL
+ * Copyright (C) 2022 David Jolly
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+ * @file arena.c
+ * @brief Common per-instance memory arena.
+ */
+
+#include <arena.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+void *nesl_arena_allocate(nesl_arena_t *arena, size_t size)
+{
+    void *result = NULL;
+
+    if(ARENA_SIZE(size) <= (arena->capacity - arena->offset)) {
+        result = &arena->data[arena->offset];
+        memset(result, 0, size);
+        arena->offset += ARENA_SIZE(size);
+    }
+
+    return result;
+}
+
+nesl_error_e nesl_arena_initialize(nesl_arena_t *arena, size_t capacity)
+{
+    nesl_error_e result = NESL_SUCCESS;
+
+    memset(arena, 0, sizeof(*arena));
+    capacity = ARENA_SIZE(capacity);
+
+    if(!(arena->data = aligned_alloc(ARENA_ALIGNMENT, capacity ? capacity : ARENA_ALIGNMENT))) {
+        result = SET_ERROR("Failed to allocate arena -- %.02f KB (%i bytes)", capacity / 1024.f, capacity);
+        goto exit;
+    }
+
+    arena->capacity = capacity;
+
+exit:
+    return result;
+}
+
+void nesl_arena_uninitialize(nesl_arena_t *arena)
+{
+
+    if(arena->data) {
+        free(arena->data);
+    }
+
+    memset(arena, 0, sizeof(*arena));
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
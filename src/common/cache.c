@@ -0,0 +1,142 @@
+/*
+ * NESL
+ * Copyright (C) 2022 David Jolly
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+ * @file cache.c
+ * @brief Common process-wide ROM cache.
+ */
+
+#include <cache.h>
+
+/*!
+ * @struct nesl_cache_entry_t
+ * @brief ROM cache entry.
+ */
+typedef struct nesl_cache_entry_s {
+    struct nesl_cache_entry_s *next;    /*!< Next cache entry */
+    uint64_t hash;                      /*!< ROM content hash */
+    int length;                         /*!< ROM length in bytes */
+    int count;                          /*!< ROM reference count */
+    uint8_t data[];                     /*!< ROM image */
+} nesl_cache_entry_t;
+
+/*!
+ * @struct nesl_cache_t
+ * @brief ROM cache context.
+ */
+typedef struct {
+    pthread_mutex_t lock;               /*!< Cache lock */
+    nesl_cache_entry_t *entry;          /*!< Cache entries */
+} nesl_cache_t;
+
+static nesl_cache_t g_cache = { .lock = PTHREAD_MUTEX_INITIALIZER, };   /*!< ROM cache context (process-wide) */
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+nesl_error_e nesl_cache_acquire(const void **image, const void *data, int length)
+{
+    uint64_t hash;
+    nesl_cache_entry_t *entry;
+    nesl_error_e result = NESL_SUCCESS;
+
+    *image = data;
+
+    if(data && (length > 0)) {
+        hash = nesl_hash(data, length, 0);
+        pthread_mutex_lock(&g_cache.lock);
+
+        for(entry = g_cache.entry; entry; entry = entry->next) {
+
+            if((entry->hash == hash) && (entry->length == length) && !memcmp(entry->data, data, length)) {
+                break;
+            }
+        }
+
+        if(!entry) {
+
+            if((entry = malloc(sizeof(*entry) + length))) {
+                entry->next = g_cache.entry;
+                entry->hash = hash;
+                entry->length = length;
+                entry->count = 0;
+                memcpy(entry->data, data, length);
+                g_cache.entry = entry;
+            } else {
+                result = SET_ERROR("Failed to allocate ROM image -- %.02f KB (%i bytes)", length / 1024.f, length);
+            }
+        }
+
+        if(entry) {
+            ++entry->count;
+            *image = entry->data;
+        }
+
+        pthread_mutex_unlock(&g_cache.lock);
+    }
+
+    return result;
+}
+
+void nesl_cache_release(const void *image)
+{
+    nesl_cache_entry_t **entry;
+
+    pthread_mutex_lock(&g_cache.lock);
+
+    for(entry = &g_cache.entry; *entry; entry = &(*entry)->next) {
+
+        if((*entry)->data == image) {
+
+            if(!--(*entry)->count) {
+                nesl_cache_entry_t *next = (*entry)->next;
+
+                free(*entry);
+                *entry = next;
+            }
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&g_cache.lock);
+}
+
+void nesl_cache_retain(const void *image)
+{
+    nesl_cache_entry_t *entry;
+
+    pthread_mutex_lock(&g_cache.lock);
+
+    for(entry = g_cache.entry; entry; entry = entry->next) {
+
+        if(entry->data == image) {
+            ++entry->count;
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&g_cache.lock);
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
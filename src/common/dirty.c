@@ -0,0 +1,60 @@
+/*
+ * NESL
+ * Copyright (C) 2022 David Jolly
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+ * @file dirty.c
+ * @brief Common dirty page bitmap, tracking the pages of a buffer written since it was last copied.
+ */
+
+#include <dirty.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+size_t nesl_dirty_copy(uint64_t *dirty, void *destination, const void *source, size_t length)
+{
+
+    for(size_t word = 0; word < DIRTY_WORDS(length); ++word) {
+
+        while(dirty[word]) {
+            size_t offset = (word * DIRTY_WORD) + ((size_t)__builtin_ctzll(dirty[word]) << DIRTY_SHIFT);
+
+            if(offset < length) {
+                memcpy((uint8_t *)destination + offset, (const uint8_t *)source + offset,
+                    ((length - offset) < (1 << DIRTY_SHIFT)) ? (length - offset) : (1 << DIRTY_SHIFT));
+            }
+
+            dirty[word] &= dirty[word] - 1;
+        }
+    }
+
+    return length;
+}
+
+void nesl_dirty_set(uint64_t *dirty, size_t length)
+{
+    memset(dirty, 0xFF, DIRTY_WORDS(length) * sizeof(*dirty));
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
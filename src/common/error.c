@@ -34,7 +34,7 @@ typedef struct {
     char buffer[256];               /*!< Error string */
 } nesl_error_t;
 
-static nesl_error_t g_error = {};   /*!< Error context */
+static _Thread_local nesl_error_t g_error = {}; /*!< Error context (per-thread) */
 
 #ifdef __cplusplus
 extern "C" {
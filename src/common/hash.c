@@ -0,0 +1,76 @@
+/*
+ * NESL
+ * Copyright (C) 2022 David Jolly
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+ * @file hash.c
+ * @brief Common 64-bit content hash.
+ */
+
+#include <hash.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*!
+ * @brief Mix word into hash accumulator.
+ * @param[in] hash Hash accumulator
+ * @param[in] word Data word
+ * @return Hash accumulator
+ */
+static uint64_t nesl_hash_word(uint64_t hash, uint64_t word)
+{
+    hash ^= word * HASH_MULTIPLIER_0;
+
+    return ((hash << 31) | (hash >> 33)) * HASH_MULTIPLIER_1;
+}
+
+uint64_t nesl_hash(const void *data, size_t length, uint64_t seed)
+{
+    size_t offset = 0;
+    uint64_t result = seed ^ (length * HASH_MULTIPLIER_1);
+
+    for(; (offset + sizeof(uint64_t)) <= length; offset += sizeof(uint64_t)) {
+        uint64_t word;
+
+        memcpy(&word, (const uint8_t *)data + offset, sizeof(word));
+        result = nesl_hash_word(result, word);
+    }
+
+    if(offset < length) {
+        uint64_t word = 0;
+
+        memcpy(&word, (const uint8_t *)data + offset, length - offset);
+        result = nesl_hash_word(result, word);
+    }
+
+    result ^= result >> 33;
+    result *= HASH_MULTIPLIER_2;
+    result ^= result >> 33;
+    result *= HASH_MULTIPLIER_3;
+    result ^= result >> 33;
+
+    return result;
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
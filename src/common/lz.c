@@ -0,0 +1,223 @@
+/*
+ * NESL
+ * Copyright (C) 2022 David Jolly
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+ * @file lz.c
+ * @brief Common LZ codec, a byte-aligned LZ77 block format with greedy hash matching, tuned for fast decompression.
+ */
+
+#include <lz.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*!
+ * @brief Read extended length, following a saturated token nibble.
+ * @param[in] compressed Constant pointer to compressed data
+ * @param[in] length Compressed length in bytes
+ * @param[in,out] index Pointer to compressed data index
+ * @param[in,out] value Pointer to length, holding the token nibble
+ * @return true if read, false if the compressed data ended
+ */
+static bool nesl_lz_read_length(const uint8_t *compressed, size_t length, size_t *index, size_t *value)
+{
+    bool result = true;
+
+    if(*value == 15) {
+        uint8_t extend;
+
+        do {
+
+            if(*index >= length) {
+                result = false;
+                break;
+            }
+
+            extend = compressed[(*index)++];
+            *value += extend;
+        } while(extend == 255);
+    }
+
+    return result;
+}
+
+/*!
+ * @brief Write sequence of literals and an optional match.
+ * @param[out] compressed Pointer to compressed data
+ * @param[in] capacity Compressed data capacity in bytes
+ * @param[in,out] index Pointer to compressed data index
+ * @param[in] literal Constant pointer to literals
+ * @param[in] literals Literal length in bytes
+ * @param[in] offset Match offset in bytes (0 for a literal-only sequence)
+ * @param[in] match Match length in bytes
+ * @return true if written, false if the sequence does not fit
+ */
+static bool nesl_lz_write_sequence(uint8_t *compressed, size_t capacity, size_t *index, const uint8_t *literal, size_t literals,
+    size_t offset, size_t match)
+{
+    size_t token = *index;
+    bool result = false;
+
+    if((*index + 1 + (literals / 255) + 1 + literals + 2 + (match / 255) + 1) > capacity) {
+        goto exit;
+    }
+
+    compressed[(*index)++] = ((literals < 15) ? literals : 15) << 4;
+
+    if(literals >= 15) {
+
+        for(size_t remaining = literals - 15;; remaining -= 255) {
+            compressed[(*index)++] = (remaining < 255) ? remaining : 255;
+
+            if(remaining < 255) {
+                break;
+            }
+        }
+    }
+
+    memcpy(&compressed[*index], literal, literals);
+    *index += literals;
+
+    if(offset) {
+        match -= LZ_MATCH;
+        compressed[token] |= (match < 15) ? match : 15;
+        compressed[(*index)++] = offset;
+        compressed[(*index)++] = offset >> 8;
+
+        if(match >= 15) {
+
+            for(size_t remaining = match - 15;; remaining -= 255) {
+                compressed[(*index)++] = (remaining < 255) ? remaining : 255;
+
+                if(remaining < 255) {
+                    break;
+                }
+            }
+        }
+    }
+
+    result = true;
+
+exit:
+    return result;
+}
+
+size_t nesl_lz_compress(const void *data, size_t length, void *compressed, size_t capacity)
+{
+    uint32_t table[1 << LZ_HASH] = {};
+    const uint8_t *source = data;
+    size_t anchor = 0, index = 0, result = 0;
+
+    while((index + LZ_MATCH) <= length) {
+        uint32_t sequence, hash;
+        size_t candidate, match = LZ_MATCH;
+
+        memcpy(&sequence, &source[index], sizeof(sequence));
+        hash = (sequence * 2654435761U) >> (32 - LZ_HASH);
+        candidate = table[hash];
+        table[hash] = index;
+
+        if((candidate >= index) || ((index - candidate) > LZ_OFFSET) || memcmp(&source[candidate], &sequence, sizeof(sequence))) {
+            index += 1 + ((index - anchor) >> 6);
+            continue;
+        }
+
+        while(((index + match) < length) && (source[candidate + match] == source[index + match])) {
+            ++match;
+        }
+
+        if(!nesl_lz_write_sequence(compressed, capacity, &result, &source[anchor], index - anchor, index - candidate, match)) {
+            result = 0;
+            goto exit;
+        }
+
+        index += match;
+        anchor = index;
+    }
+
+    if(!nesl_lz_write_sequence(compressed, capacity, &result, &source[anchor], length - anchor, 0, 0)) {
+        result = 0;
+        goto exit;
+    }
+
+exit:
+    return result;
+}
+
+size_t nesl_lz_decompress(const void *compressed, size_t length, void *data, size_t capacity)
+{
+    size_t index = 0, result = 0;
+    const uint8_t *source = compressed;
+    uint8_t *destination = data;
+
+    while(index < length) {
+        size_t literals = source[index] >> 4, match = source[index] & 15, offset;
+
+        ++index;
+
+        if(!nesl_lz_read_length(source, length, &index, &literals) || (literals > (length - index)) || (literals > (capacity - result))) {
+            result = 0;
+            goto exit;
+        }
+
+        memcpy(&destination[result], &source[index], literals);
+        index += literals;
+        result += literals;
+
+        if(index >= length) {
+            break;
+        }
+
+        if((length - index) < 2) {
+            result = 0;
+            goto exit;
+        }
+
+        offset = source[index] | (source[index + 1] << 8);
+        index += 2;
+
+        if(!nesl_lz_read_length(source, length, &index, &match) || !offset || (offset > result)
+                || ((match += LZ_MATCH) > (capacity - result))) {
+            result = 0;
+            goto exit;
+        }
+
+        if(offset >= match) {
+            memcpy(&destination[result], &destination[result - offset], match);
+            result += match;
+        } else {
+
+            for(size_t chunk; match; match -= chunk, offset += chunk) {
+                chunk = (offset < match) ? offset : match;
+                memcpy(&destination[result], &destination[result - offset], chunk);
+                result += chunk;
+            }
+        }
+    }
+
+exit:
+    return result;
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
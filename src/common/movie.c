@@ -0,0 +1,245 @@
+/*
+ * NESL
+ * Copyright (C) 2022 David Jolly
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+ * @file movie.c
+ * @brief Input movie, holding per-frame controller input and reset events, with periodic keyframe states for seeking.
+ */
+
+#include <movie.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*!
+ * @brief Reserve space for one more element in a growable array, doubling its capacity when full.
+ * @param[in,out] data Pointer to array pointer
+ * @param[in,out] capacity Pointer to array capacity in elements
+ * @param[in] count Array count in elements
+ * @param[in] size Element size in bytes
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_movie_reserve(void **data, uint32_t *capacity, uint32_t count, size_t size)
+{
+    void *reserved = NULL;
+    nesl_error_e result = NESL_SUCCESS;
+
+    if(count >= *capacity) {
+        uint32_t reserve = *capacity ? (2 * *capacity) : 64;
+
+        if(!(reserved = realloc(*data, (size_t)reserve * size))) {
+            result = SET_ERROR("Failed to allocate movie -- %.02f KB (%zu bytes)", ((size_t)reserve * size) / 1024.f, (size_t)reserve * size);
+            goto exit;
+        }
+
+        *data = reserved;
+        *capacity = reserve;
+    }
+
+exit:
+    return result;
+}
+
+nesl_error_e nesl_movie_append(nesl_movie_t *movie, const uint8_t *input, bool reset, const void *state)
+{
+    nesl_error_e result = NESL_SUCCESS;
+
+    if(!(movie->header.frames % movie->header.interval)) {
+
+        if((result = nesl_movie_reserve((void **)&movie->state, &movie->capacity.state, movie->header.keyframes,
+                movie->header.length)) == NESL_FAILURE) {
+            goto exit;
+        }
+
+        memcpy(&movie->state[(size_t)movie->header.keyframes++ * movie->header.length], state, movie->header.length);
+    }
+
+    if(reset) {
+
+        if((result = nesl_movie_reserve((void **)&movie->reset, &movie->capacity.reset, movie->header.resets,
+                sizeof(*movie->reset))) == NESL_FAILURE) {
+            goto exit;
+        }
+
+        movie->reset[movie->header.resets++] = movie->header.frames;
+    }
+
+    if((result = nesl_movie_reserve((void **)&movie->input, &movie->capacity.input, movie->header.frames,
+            movie->header.ports)) == NESL_FAILURE) {
+        goto exit;
+    }
+
+    memcpy(&movie->input[(size_t)movie->header.frames++ * movie->header.ports], input, movie->header.ports);
+
+exit:
+    return result;
+}
+
+nesl_error_e nesl_movie_initialize(nesl_movie_t *movie, uint64_t hash, uint32_t length)
+{
+    memset(movie, 0, sizeof(*movie));
+    memcpy(movie->header.magic, MOVIE_MAGIC, sizeof(movie->header.magic));
+    movie->header.version = MOVIE_VERSION;
+    movie->header.hash = hash;
+    movie->header.ports = MOVIE_PORTS;
+    movie->header.interval = MOVIE_INTERVAL;
+    movie->header.length = length;
+
+    return NESL_SUCCESS;
+}
+
+bool nesl_movie_is_reset(const nesl_movie_t *movie, uint32_t frame)
+{
+    uint32_t begin = 0, end = movie->header.resets;
+
+    while(begin < end) {
+        uint32_t middle = begin + ((end - begin) / 2);
+
+        if(movie->reset[middle] < frame) {
+            begin = middle + 1;
+        } else {
+            end = middle;
+        }
+    }
+
+    return (begin < movie->header.resets) && (movie->reset[begin] == frame);
+}
+
+nesl_error_e nesl_movie_read(nesl_movie_t *movie, const char *path, uint64_t hash, uint32_t length)
+{
+    FILE *file = NULL;
+    nesl_movie_header_t header = {};
+    nesl_error_e result = NESL_SUCCESS;
+
+    memset(movie, 0, sizeof(*movie));
+
+    if(!(file = fopen(path, "rb"))) {
+        result = SET_ERROR("Failed to open movie -- %s", path);
+        goto exit;
+    }
+
+    if(fread(&header, sizeof(header), 1, file) != 1) {
+        result = SET_ERROR("Failed to read movie -- %s", path);
+        goto exit;
+    }
+
+    if(memcmp(header.magic, MOVIE_MAGIC, sizeof(header.magic))) {
+        result = SET_ERROR("Malformed movie -- %s", "String mismatch");
+        goto exit;
+    }
+
+    if((header.version != MOVIE_VERSION) || (header.ports != MOVIE_PORTS)) {
+        result = SET_ERROR("Unsupported movie version -- %u (%u ports)", header.version, header.ports);
+        goto exit;
+    }
+
+    if((header.hash != hash) || (header.length != length)) {
+        result = SET_ERROR("Mismatched movie data -- %016llx", (unsigned long long)header.hash);
+        goto exit;
+    }
+
+    if(!header.interval || (header.resets > header.frames)
+            || (header.keyframes != ((header.frames + header.interval - 1) / header.interval))) {
+        result = SET_ERROR("Malformed movie -- %u frames, %u keyframes", header.frames, header.keyframes);
+        goto exit;
+    }
+
+    movie->header = header;
+    movie->capacity.input = header.frames;
+    movie->capacity.reset = header.resets;
+    movie->capacity.state = header.keyframes;
+
+    if((header.frames && !(movie->input = malloc((size_t)header.frames * header.ports)))
+            || (header.resets && !(movie->reset = malloc((size_t)header.resets * sizeof(*movie->reset))))
+            || (header.keyframes && !(movie->state = malloc((size_t)header.keyframes * header.length)))) {
+        result = SET_ERROR("Failed to allocate movie -- %u frames", header.frames);
+        goto exit;
+    }
+
+    if((header.frames && (fread(movie->input, (size_t)header.frames * header.ports, 1, file) != 1))
+            || (header.resets && (fread(movie->reset, (size_t)header.resets * sizeof(*movie->reset), 1, file) != 1))
+            || (header.keyframes && (fread(movie->state, (size_t)header.keyframes * header.length, 1, file) != 1))) {
+        result = SET_ERROR("Failed to read movie -- %s", path);
+        goto exit;
+    }
+
+    for(uint32_t index = 1; index < header.resets; ++index) {
+
+        if(movie->reset[index] <= movie->reset[index - 1]) {
+            result = SET_ERROR("Malformed movie -- Reset %u out of order", index);
+            goto exit;
+        }
+    }
+
+exit:
+
+    if(file) {
+        fclose(file);
+        file = NULL;
+    }
+
+    return result;
+}
+
+void nesl_movie_uninitialize(nesl_movie_t *movie)
+{
+    free(movie->input);
+    free(movie->reset);
+    free(movie->state);
+    memset(movie, 0, sizeof(*movie));
+}
+
+nesl_error_e nesl_movie_write(const nesl_movie_t *movie, const char *path)
+{
+    FILE *file = NULL;
+    nesl_error_e result = NESL_SUCCESS;
+
+    if(!(file = fopen(path, "wb"))) {
+        result = SET_ERROR("Failed to open movie -- %s", path);
+        goto exit;
+    }
+
+    if((fwrite(&movie->header, sizeof(movie->header), 1, file) != 1)
+            || (movie->header.frames && (fwrite(movie->input, (size_t)movie->header.frames * movie->header.ports, 1, file) != 1))
+            || (movie->header.resets && (fwrite(movie->reset, (size_t)movie->header.resets * sizeof(*movie->reset), 1, file) != 1))
+            || (movie->header.keyframes && (fwrite(movie->state, (size_t)movie->header.keyframes * movie->header.length, 1, file) != 1))) {
+        result = SET_ERROR("Failed to write movie -- %s", path);
+        goto exit;
+    }
+
+exit:
+
+    if(file) {
+
+        if(fclose(file) && (result == NESL_SUCCESS)) {
+            result = SET_ERROR("Failed to write movie -- %s", path);
+        }
+
+        file = NULL;
+    }
+
+    return result;
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
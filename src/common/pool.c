@@ -0,0 +1,270 @@
+/*
+ * NESL
+ * Copyright (C) 2022 David Jolly
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+ * @file pool.c
+ * @brief Common work-stealing thread pool.
+ */
+
+#define _GNU_SOURCE
+
+#include <sched.h>
+#include <unistd.h>
+#include <pool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*!
+ * @brief Claim a task index from a deque.
+ * @param[in,out] deque Pointer to thread pool deque
+ * @param[in] steal Claim from the top (stealing), otherwise from the bottom (owner)
+ * @param[out] index Pointer to claimed task index
+ * @return true if claimed, false if the deque is empty
+ */
+static bool nesl_pool_claim(nesl_pool_deque_t *deque, bool steal, int *index)
+{
+    bool result = false;
+    uint64_t range = atomic_load_explicit(&deque->range, memory_order_relaxed), next;
+
+    for(;;) {
+        uint32_t top = range, bottom = range >> 32;
+
+        if(top >= bottom) {
+            break;
+        }
+
+        next = steal ? (((uint64_t)bottom << 32) | (top + 1)) : (((uint64_t)(bottom - 1) << 32) | top);
+
+        if(atomic_compare_exchange_weak_explicit(&deque->range, &range, next, memory_order_acq_rel, memory_order_relaxed)) {
+            *index = steal ? top : (bottom - 1);
+            result = true;
+            break;
+        }
+    }
+
+    return result;
+}
+
+/*!
+ * @brief Run job tasks from the owned deque, then steal from the other deques, until none remain.
+ * @param[in,out] pool Pointer to thread pool context
+ * @param[in,out] job Pointer to thread pool job context
+ * @param[in] owner Owned deque index
+ */
+static void nesl_pool_drain(nesl_pool_t *pool, nesl_pool_job_t *job, int owner)
+{
+    int count = pool->count + 1, index;
+
+    for(;;) {
+        bool claimed = nesl_pool_claim(&pool->deque[owner], false, &index);
+
+        for(int victim = 1; !claimed && (victim < count); ++victim) {
+            claimed = nesl_pool_claim(&pool->deque[(owner + victim) % count], true, &index);
+        }
+
+        if(!claimed) {
+            break;
+        }
+
+        job->task(job->context, index);
+    }
+}
+
+/*!
+ * @brief Pin thread pool worker thread to its own processor.
+ * @param[in,out] worker Pointer to thread pool worker context
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_pool_pin(nesl_pool_worker_t *worker)
+{
+    nesl_error_e result = NESL_SUCCESS;
+#ifdef __linux__
+    cpu_set_t set;
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+
+    CPU_ZERO(&set);
+    CPU_SET((worker->index + 1) % ((count > 0) ? count : 1), &set);
+
+    if(pthread_setaffinity_np(worker->thread, sizeof(set), &set)) {
+        result = SET_ERROR("Failed to pin pool thread -- %i", worker->index);
+        goto exit;
+    }
+
+exit:
+#endif /* __linux__ */
+    return result;
+}
+
+/*!
+ * @brief Thread pool worker thread.
+ * @param[in,out] context Pointer to thread pool worker context
+ * @return NULL
+ */
+static void *nesl_pool_worker(void *context)
+{
+    uint32_t generation;
+    nesl_pool_worker_t *worker = context;
+    nesl_pool_t *pool = worker->pool;
+
+    pthread_mutex_lock(&pool->lock);
+    generation = pool->generation;
+
+    for(;;) {
+        nesl_pool_job_t *job;
+
+        while(pool->running && (!pool->job || (pool->generation == generation))) {
+            pthread_cond_wait(&pool->signal, &pool->lock);
+        }
+
+        if(!pool->running) {
+            break;
+        }
+
+        generation = pool->generation;
+        job = pool->job;
+        ++job->busy;
+        pthread_mutex_unlock(&pool->lock);
+        nesl_pool_drain(pool, job, worker->index);
+        pthread_mutex_lock(&pool->lock);
+
+        if(!--job->busy) {
+            pthread_cond_broadcast(&pool->complete);
+        }
+    }
+
+    pthread_mutex_unlock(&pool->lock);
+
+    return NULL;
+}
+
+nesl_error_e nesl_pool_initialize(nesl_pool_t *pool, int count, bool affinity)
+{
+    nesl_error_e result = NESL_SUCCESS;
+
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->signal, NULL);
+    pthread_cond_init(&pool->complete, NULL);
+    pool->affinity = affinity;
+    pool->running = true;
+
+    if(count < 0) {
+        count = 0;
+    }
+
+    if(!(pool->deque = aligned_alloc(_Alignof(nesl_pool_deque_t), (count + 1) * sizeof(*pool->deque)))) {
+        result = SET_ERROR("Failed to allocate pool deques -- %.02f KB (%i bytes)", ((count + 1) * sizeof(*pool->deque)) / 1024.f,
+            (count + 1) * sizeof(*pool->deque));
+        goto exit;
+    }
+
+    for(int index = 0; index <= count; ++index) {
+        atomic_init(&pool->deque[index].range, 0);
+    }
+
+    if(count && !(pool->worker = calloc(count, sizeof(*pool->worker)))) {
+        result = SET_ERROR("Failed to allocate pool threads -- %.02f KB (%i bytes)", (count * sizeof(*pool->worker)) / 1024.f,
+            count * sizeof(*pool->worker));
+        goto exit;
+    }
+
+    for(; pool->count < count; ++pool->count) {
+        nesl_pool_worker_t *worker = &pool->worker[pool->count];
+
+        worker->pool = pool;
+        worker->index = pool->count;
+
+        if(pthread_create(&worker->thread, NULL, nesl_pool_worker, worker)) {
+            result = SET_ERROR("Failed to create pool thread -- %i", worker->index);
+            goto exit;
+        }
+
+        if(pool->affinity && ((result = nesl_pool_pin(worker)) == NESL_FAILURE)) {
+            ++pool->count;
+            goto exit;
+        }
+    }
+
+exit:
+    return result;
+}
+
+void nesl_pool_run(nesl_pool_t *pool, nesl_pool_task task, void *context, int count)
+{
+    int deques = pool->count + 1;
+    nesl_pool_job_t job = { .task = task, .context = context, };
+
+    pthread_mutex_lock(&pool->lock);
+    ++pool->generation;
+
+    for(int index = 0; index < deques; ++index) {
+        int chunk = (index + pool->generation) % deques;
+        uint64_t top = ((int64_t)chunk * count) / deques, bottom = ((int64_t)(chunk + 1) * count) / deques;
+
+        atomic_store_explicit(&pool->deque[index].range, (bottom << 32) | top, memory_order_relaxed);
+    }
+
+    if(pool->count && (count > 1)) {
+        pool->job = &job;
+        pthread_cond_broadcast(&pool->signal);
+    }
+
+    pthread_mutex_unlock(&pool->lock);
+    nesl_pool_drain(pool, &job, pool->count);
+    pthread_mutex_lock(&pool->lock);
+    pool->job = NULL;
+
+    while(job.busy) {
+        pthread_cond_wait(&pool->complete, &pool->lock);
+    }
+
+    pthread_mutex_unlock(&pool->lock);
+}
+
+void nesl_pool_uninitialize(nesl_pool_t *pool)
+{
+    pthread_mutex_lock(&pool->lock);
+    pool->running = false;
+    pthread_cond_broadcast(&pool->signal);
+    pthread_mutex_unlock(&pool->lock);
+
+    for(int index = 0; index < pool->count; ++index) {
+        pthread_join(pool->worker[index].thread, NULL);
+    }
+
+    if(pool->worker) {
+        free(pool->worker);
+    }
+
+    if(pool->deque) {
+        free(pool->deque);
+    }
+
+    pthread_cond_destroy(&pool->complete);
+    pthread_cond_destroy(&pool->signal);
+    pthread_mutex_destroy(&pool->lock);
+    memset(pool, 0, sizeof(*pool));
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
@@ -0,0 +1,183 @@
+/*
+ * NESL
+ * Copyright (C) 2022 David Jolly
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+ * @file replay.c
+ * @brief Replay hashes, holding per-frame hashes of an input movie playback for verification.
+ */
+
+#include <replay.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+nesl_error_e nesl_replay_append(nesl_replay_t *replay, const uint64_t *hash)
+{
+    nesl_error_e result = NESL_SUCCESS;
+
+    if(replay->header.frames >= replay->capacity) {
+        uint64_t *reserved = NULL;
+        uint32_t reserve = replay->capacity ? (2 * replay->capacity) : 1024;
+        size_t length = (size_t)reserve * replay->header.count * sizeof(*replay->hash);
+
+        if(!(reserved = realloc(replay->hash, length))) {
+            result = SET_ERROR("Failed to allocate replay hashes -- %.02f KB (%zu bytes)", length / 1024.f, length);
+            goto exit;
+        }
+
+        replay->hash = reserved;
+        replay->capacity = reserve;
+    }
+
+    memcpy(&replay->hash[(size_t)replay->header.frames++ * replay->header.count], hash, replay->header.count * sizeof(*hash));
+
+exit:
+    return result;
+}
+
+int nesl_replay_compare(const nesl_replay_t *replay, uint32_t frame, const uint64_t *hash)
+{
+    int result = -1;
+
+    if(frame >= replay->header.frames) {
+        result = replay->header.count;
+    } else {
+        const uint64_t *expected = &replay->hash[(size_t)frame * replay->header.count];
+
+        for(uint32_t index = 0; index < replay->header.count; ++index) {
+
+            if(expected[index] != hash[index]) {
+                result = index;
+                break;
+            }
+        }
+    }
+
+    return result;
+}
+
+nesl_error_e nesl_replay_initialize(nesl_replay_t *replay, uint64_t hash, uint32_t count)
+{
+    memset(replay, 0, sizeof(*replay));
+    memcpy(replay->header.magic, REPLAY_MAGIC, sizeof(replay->header.magic));
+    replay->header.version = REPLAY_VERSION;
+    replay->header.hash = hash;
+    replay->header.count = count;
+
+    return NESL_SUCCESS;
+}
+
+nesl_error_e nesl_replay_read(nesl_replay_t *replay, const char *path, uint64_t hash, uint32_t count)
+{
+    FILE *file = NULL;
+    nesl_replay_header_t header = {};
+    nesl_error_e result = NESL_SUCCESS;
+
+    memset(replay, 0, sizeof(*replay));
+
+    if(!(file = fopen(path, "rb"))) {
+        result = SET_ERROR("Failed to open replay hashes -- %s", path);
+        goto exit;
+    }
+
+    if(fread(&header, sizeof(header), 1, file) != 1) {
+        result = SET_ERROR("Failed to read replay hashes -- %s", path);
+        goto exit;
+    }
+
+    if(memcmp(header.magic, REPLAY_MAGIC, sizeof(header.magic))) {
+        result = SET_ERROR("Malformed replay hashes -- %s", "String mismatch");
+        goto exit;
+    }
+
+    if((header.version != REPLAY_VERSION) || (header.count != count)) {
+        result = SET_ERROR("Unsupported replay hashes version -- %u (%u hashes)", header.version, header.count);
+        goto exit;
+    }
+
+    if(header.hash != hash) {
+        result = SET_ERROR("Mismatched replay hashes data -- %016llx", (unsigned long long)header.hash);
+        goto exit;
+    }
+
+    replay->header = header;
+    replay->capacity = header.frames;
+
+    if(header.frames && !(replay->hash = malloc((size_t)header.frames * header.count * sizeof(*replay->hash)))) {
+        result = SET_ERROR("Failed to allocate replay hashes -- %u frames", header.frames);
+        goto exit;
+    }
+
+    if(header.frames && (fread(replay->hash, (size_t)header.frames * header.count * sizeof(*replay->hash), 1, file) != 1)) {
+        result = SET_ERROR("Failed to read replay hashes -- %s", path);
+        goto exit;
+    }
+
+exit:
+
+    if(file) {
+        fclose(file);
+        file = NULL;
+    }
+
+    return result;
+}
+
+void nesl_replay_uninitialize(nesl_replay_t *replay)
+{
+    free(replay->hash);
+    memset(replay, 0, sizeof(*replay));
+}
+
+nesl_error_e nesl_replay_write(const nesl_replay_t *replay, const char *path)
+{
+    FILE *file = NULL;
+    nesl_error_e result = NESL_SUCCESS;
+
+    if(!(file = fopen(path, "wb"))) {
+        result = SET_ERROR("Failed to open replay hashes -- %s", path);
+        goto exit;
+    }
+
+    if((fwrite(&replay->header, sizeof(replay->header), 1, file) != 1)
+            || (replay->header.frames && (fwrite(replay->hash, (size_t)replay->header.frames * replay->header.count * sizeof(*replay->hash), 1, file) != 1))) {
+        result = SET_ERROR("Failed to write replay hashes -- %s", path);
+        goto exit;
+    }
+
+exit:
+
+    if(file) {
+
+        if(fclose(file) && (result == NESL_SUCCESS)) {
+            result = SET_ERROR("Failed to write replay hashes -- %s", path);
+        }
+
+        file = NULL;
+    }
+
+    return result;
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
@@ -0,0 +1,278 @@
+/*
+ * NESL
+ * Copyright (C) 2022 David Jolly
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+ * @file rewind.c
+ * @brief Rewind buffer.
+ */
+
+#include <rewind.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*!
+ * @brief Decode delta record, XORing its runs into state.
+ * @param[in] data Constant pointer to record
+ * @param[in] length Record length in bytes
+ * @param[in,out] state Pointer to state, holding the reference state
+ */
+static void nesl_rewind_decode(const uint8_t *data, size_t length, uint8_t *state)
+{
+
+    for(size_t index = 0, offset = 0; index < length;) {
+        uint8_t control = data[index++];
+
+        if(control & 0x80) {
+            offset += (control & 0x7F) + 1;
+        } else {
+
+            for(int run = 0; run <= control; ++run) {
+                state[offset++] ^= data[index++];
+            }
+        }
+    }
+}
+
+/*!
+ * @brief Encode delta record, as runs of unchanged (0x80 | length - 1) and changed (length - 1, followed by XORed bytes) bytes.
+ * @param[in] state Constant pointer to state
+ * @param[in] reference Constant pointer to reference state
+ * @param[in] length State length in bytes
+ * @param[out] data Pointer to record
+ * @param[in] capacity Record capacity in bytes
+ * @return Record length in bytes, or 0 if the record does not fit
+ */
+static size_t nesl_rewind_encode(const uint8_t *state, const uint8_t *reference, size_t length, uint8_t *data, size_t capacity)
+{
+    size_t result = 0;
+
+    for(size_t offset = 0, run; offset < length; offset += run) {
+
+        for(run = 0; ((offset + run) < length) && (run < REWIND_RUN); ++run) {
+
+            if(state[offset + run] ^ reference[offset + run]) {
+                break;
+            }
+        }
+
+        if((result + (run ? 1 : 2)) > capacity) {
+            result = 0;
+            break;
+        }
+
+        if(run) {
+            data[result++] = 0x80 | (run - 1);
+        } else {
+            size_t control = result++;
+
+            for(; ((offset + run) < length) && (run < REWIND_RUN) && (result < capacity); ++run) {
+                uint8_t value = state[offset + run] ^ reference[offset + run];
+
+                if(!value) {
+                    break;
+                }
+
+                data[result++] = value;
+            }
+
+            data[control] = run - 1;
+        }
+    }
+
+    return result;
+}
+
+/*!
+ * @brief Evict oldest entry from rewind buffer, along with the deltas depending on it.
+ * @param[in,out] rewind Pointer to rewind context
+ */
+static void nesl_rewind_evict(nesl_rewind_t *rewind)
+{
+
+    do {
+        rewind->entry.tail = (rewind->entry.tail + 1) % rewind->entry.capacity;
+        --rewind->entry.count;
+    } while(rewind->entry.count && !rewind->entry.data[rewind->entry.tail].keyframe);
+
+    if(!rewind->entry.count) {
+        rewind->data.head = 0;
+    }
+}
+
+nesl_error_e nesl_rewind_initialize(nesl_rewind_t *rewind, size_t capacity, size_t length)
+{
+    uint8_t *data = NULL;
+    nesl_error_e result = NESL_SUCCESS;
+    size_t fixed = (2 * length) + REWIND_BOUND(length), remaining = (capacity > fixed) ? (capacity - fixed) : 0;
+
+    memset(rewind, 0, sizeof(*rewind));
+
+    if(remaining < (REWIND_BOUND(length) + sizeof(nesl_rewind_entry_t))) {
+        result = SET_ERROR("Invalid rewind capacity -- %.02f KB (%zu bytes), expecting at least %.02f KB (%zu bytes)", capacity / 1024.f, capacity,
+            (fixed + REWIND_BOUND(length) + sizeof(nesl_rewind_entry_t)) / 1024.f, fixed + REWIND_BOUND(length) + sizeof(nesl_rewind_entry_t));
+        goto exit;
+    }
+
+    if(!(data = malloc(capacity))) {
+        result = SET_ERROR("Failed to allocate rewind buffer -- %.02f KB (%zu bytes)", capacity / 1024.f, capacity);
+        goto exit;
+    }
+
+    rewind->entry.capacity = remaining / (REWIND_RECORD + sizeof(nesl_rewind_entry_t));
+
+    if(!rewind->entry.capacity || ((remaining - (rewind->entry.capacity * sizeof(nesl_rewind_entry_t))) < REWIND_BOUND(length))) {
+        rewind->entry.capacity = 1;
+    }
+
+    rewind->entry.data = (nesl_rewind_entry_t *)data;
+    rewind->data.data = data + (rewind->entry.capacity * sizeof(nesl_rewind_entry_t));
+    rewind->data.capacity = remaining - (rewind->entry.capacity * sizeof(nesl_rewind_entry_t));
+    rewind->state = rewind->data.data + rewind->data.capacity;
+    rewind->keyframe.state = rewind->state + length;
+    rewind->record = rewind->keyframe.state + length;
+    rewind->length = length;
+
+exit:
+    return result;
+}
+
+bool nesl_rewind_peek(nesl_rewind_t *rewind, void *state)
+{
+    bool result = false;
+
+    if(rewind->entry.count) {
+        int index = (rewind->entry.tail + rewind->entry.count - 1) % rewind->entry.capacity, keyframe = index, count = 0;
+
+        while(!rewind->entry.data[keyframe].keyframe) {
+            keyframe = (keyframe + rewind->entry.capacity - 1) % rewind->entry.capacity;
+            ++count;
+        }
+
+        nesl_lz_decompress(&rewind->data.data[rewind->entry.data[keyframe].offset], rewind->entry.data[keyframe].length, rewind->keyframe.state,
+            rewind->length);
+        memcpy(state, rewind->keyframe.state, rewind->length);
+
+        if(keyframe != index) {
+            nesl_rewind_decode(&rewind->data.data[rewind->entry.data[index].offset], rewind->entry.data[index].length, state);
+        }
+
+        rewind->keyframe.valid = true;
+        rewind->keyframe.count = count;
+        result = true;
+    }
+
+    return result;
+}
+
+bool nesl_rewind_pop(nesl_rewind_t *rewind)
+{
+    bool result = false;
+
+    if(rewind->entry.count) {
+        const nesl_rewind_entry_t *entry = &rewind->entry.data[(rewind->entry.tail + rewind->entry.count - 1) % rewind->entry.capacity];
+
+        if(entry->keyframe) {
+            rewind->keyframe.valid = false;
+        } else {
+            --rewind->keyframe.count;
+        }
+
+        rewind->data.head = entry->offset;
+        --rewind->entry.count;
+        result = true;
+    }
+
+    return result;
+}
+
+void nesl_rewind_push(nesl_rewind_t *rewind, const void *state)
+{
+    size_t length;
+    nesl_rewind_entry_t *entry;
+    bool keyframe = !rewind->keyframe.valid || (rewind->keyframe.count >= (REWIND_INTERVAL - 1));
+
+    for(;;) {
+
+        if(!keyframe) {
+            keyframe = !(length = nesl_rewind_encode(state, rewind->keyframe.state, rewind->length, rewind->record, REWIND_BOUND(rewind->length)));
+        }
+
+        if(keyframe) {
+            length = nesl_lz_compress(state, rewind->length, rewind->record, REWIND_BOUND(rewind->length));
+        }
+
+        if(rewind->entry.count == rewind->entry.capacity) {
+            nesl_rewind_evict(rewind);
+        }
+
+        if((rewind->data.head + length) > rewind->data.capacity) {
+
+            while(rewind->entry.count && (rewind->entry.data[rewind->entry.tail].offset >= rewind->data.head)) {
+                nesl_rewind_evict(rewind);
+            }
+
+            rewind->data.head = 0;
+        }
+
+        while(rewind->entry.count && (rewind->entry.data[rewind->entry.tail].offset >= rewind->data.head)
+                && (rewind->entry.data[rewind->entry.tail].offset < (rewind->data.head + length))) {
+            nesl_rewind_evict(rewind);
+        }
+
+        if(keyframe || rewind->entry.count) {
+            break;
+        }
+
+        keyframe = true;
+    }
+
+    memcpy(&rewind->data.data[rewind->data.head], rewind->record, length);
+    entry = &rewind->entry.data[(rewind->entry.tail + rewind->entry.count) % rewind->entry.capacity];
+    entry->offset = rewind->data.head;
+    entry->length = length;
+    entry->keyframe = keyframe;
+    rewind->data.head += length;
+    ++rewind->entry.count;
+
+    if(keyframe) {
+        memcpy(rewind->keyframe.state, state, rewind->length);
+        rewind->keyframe.valid = true;
+        rewind->keyframe.count = 0;
+    } else {
+        ++rewind->keyframe.count;
+    }
+}
+
+void nesl_rewind_uninitialize(nesl_rewind_t *rewind)
+{
+
+    if(rewind->entry.data) {
+        free(rewind->entry.data);
+    }
+
+    memset(rewind, 0, sizeof(*rewind));
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
@@ -0,0 +1,319 @@
+/*
+ * NESL
+ * Copyright (C) 2022 David Jolly
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+ * @file slot.c
+ * @brief Save slots, holding numbered states written to disk by a background thread.
+ */
+
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <hash.h>
+#include <slot.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*!
+ * @brief Get save slot file path.
+ * @param[in] slot Constant pointer to save slot context
+ * @param[in] index Save slot index
+ * @param[out] path Pointer to path string
+ * @param[in] length Path string length in bytes
+ */
+static void nesl_slot_get_path(const nesl_slot_t *slot, int index, char *path, size_t length)
+{
+    snprintf(path, length, "%s/%016" PRIx64 ".%i.state", slot->directory, slot->hash, index + 1);
+}
+
+/*!
+ * @brief Read save slot file through a read-only mapping into the loaded state, if it matches the expected header and checksum.
+ * @param[in,out] slot Pointer to save slot context
+ * @param[in] index Save slot index
+ * @return true if a matching save slot was read, false otherwise
+ */
+static bool nesl_slot_read(nesl_slot_t *slot, int index)
+{
+    int file = -1;
+    bool result = false;
+    struct stat status = {};
+    char path[PATH_MAX] = {};
+    const uint8_t *data = MAP_FAILED;
+    nesl_slot_header_t header = {};
+
+    nesl_slot_get_path(slot, index, path, sizeof(path));
+
+    if((file = open(path, O_RDONLY)) == -1) {
+        goto exit;
+    }
+
+    if((fstat(file, &status) == -1) || (status.st_size < sizeof(header))) {
+        goto exit;
+    }
+
+    if((data = mmap(NULL, status.st_size, PROT_READ, MAP_PRIVATE, file, 0)) == MAP_FAILED) {
+        goto exit;
+    }
+
+    memcpy(&header, data, sizeof(header));
+
+    if(memcmp(header.magic, SLOT_MAGIC, sizeof(header.magic)) || (header.slot != index) || (header.hash != slot->hash)
+            || (header.length != slot->length) || (header.compressed != (status.st_size - sizeof(header)))) {
+        goto exit;
+    }
+
+    result = (nesl_lz_decompress(data + sizeof(header), header.compressed, slot->load, slot->length) == slot->length)
+        && (nesl_hash(slot->load, slot->length, 0) == header.checksum);
+
+exit:
+
+    if(data != MAP_FAILED) {
+        munmap((void *)data, status.st_size);
+        data = MAP_FAILED;
+    }
+
+    if(file != -1) {
+        close(file);
+        file = -1;
+    }
+
+    return result;
+}
+
+/*!
+ * @brief Write writer state to save slot file, through a temporary file synced and renamed into place once complete.
+ * @param[in,out] slot Pointer to save slot context
+ * @param[in] index Save slot index
+ * @return 0 on success, the error number of the failed step otherwise
+ */
+static int nesl_slot_write(nesl_slot_t *slot, int index)
+{
+    int descriptor, result = 0;
+    FILE *file = NULL;
+    char path[PATH_MAX] = {}, temporary[PATH_MAX] = {};
+    nesl_slot_header_t header = { .magic = SLOT_MAGIC, .slot = index, .hash = slot->hash, .length = slot->length, };
+
+    header.checksum = nesl_hash(slot->writer.state, slot->length, 0);
+    header.compressed = nesl_lz_compress(slot->writer.state, slot->length, slot->writer.compressed, LZ_BOUND(slot->length));
+    nesl_slot_get_path(slot, index, path, sizeof(path));
+
+    if(snprintf(temporary, sizeof(temporary), "%s.XXXXXX", path) >= sizeof(temporary)) {
+        result = ENAMETOOLONG;
+        goto exit;
+    }
+
+    if((descriptor = mkstemp(temporary)) == -1) {
+        result = errno;
+        goto exit;
+    }
+
+    if(!(file = fdopen(descriptor, "wb"))) {
+        result = errno;
+        close(descriptor);
+        unlink(temporary);
+        goto exit;
+    }
+
+    if((fwrite(&header, sizeof(header), 1, file) != 1) || (fwrite(slot->writer.compressed, header.compressed, 1, file) != 1)
+            || fflush(file) || fsync(descriptor)) {
+        result = errno ? errno : EIO;
+        fclose(file);
+        unlink(temporary);
+        goto exit;
+    }
+
+    if(fclose(file) || rename(temporary, path)) {
+        result = errno ? errno : EIO;
+        unlink(temporary);
+        goto exit;
+    }
+
+exit:
+    return result;
+}
+
+/*!
+ * @brief Writer thread routine, writing pending states until asked to quit with none pending.
+ * @param[in,out] context Pointer to save slot context
+ * @return NULL
+ */
+static void *nesl_slot_run(void *context)
+{
+    nesl_slot_t *slot = context;
+
+    pthread_mutex_lock(&slot->writer.lock);
+
+    for(;;) {
+        int error, index = 0;
+
+        while((index < SLOT_COUNT) && !slot->pending[index]) {
+            ++index;
+        }
+
+        if(index < SLOT_COUNT) {
+            uint8_t *state = slot->writer.state;
+
+            slot->writer.state = slot->state[index];
+            slot->state[index] = state;
+            slot->pending[index] = false;
+            slot->writer.active = index;
+            pthread_mutex_unlock(&slot->writer.lock);
+            error = nesl_slot_write(slot, index);
+            pthread_mutex_lock(&slot->writer.lock);
+            slot->writer.active = -1;
+
+            if(error) {
+                slot->writer.error = error;
+                slot->writer.failed = index;
+            }
+        } else if(slot->writer.quit) {
+            break;
+        } else {
+            pthread_cond_wait(&slot->writer.condition, &slot->writer.lock);
+        }
+    }
+
+    pthread_mutex_unlock(&slot->writer.lock);
+
+    return NULL;
+}
+
+nesl_error_e nesl_slot_initialize(nesl_slot_t *slot, const char *directory, uint64_t hash, size_t length)
+{
+    nesl_error_e result = NESL_SUCCESS;
+    size_t capacity = ((SLOT_COUNT + 2) * length) + LZ_BOUND(length);
+
+    memset(slot, 0, sizeof(*slot));
+    slot->directory = directory;
+    slot->hash = hash;
+
+    if(access(directory, W_OK)) {
+        result = SET_ERROR("Save slot directory is not writable -- %s (%s)", directory, strerror(errno));
+        goto exit;
+    }
+
+    if(!(slot->data = malloc(capacity))) {
+        result = SET_ERROR("Failed to allocate save slots -- %.02f KB (%zu bytes)", capacity / 1024.f, capacity);
+        goto exit;
+    }
+
+    for(int index = 0; index < SLOT_COUNT; ++index) {
+        slot->state[index] = slot->data + (index * length);
+    }
+
+    slot->load = slot->data + (SLOT_COUNT * length);
+    slot->writer.state = slot->load + length;
+    slot->writer.compressed = slot->writer.state + length;
+    slot->writer.active = -1;
+    pthread_mutex_init(&slot->writer.lock, NULL);
+    pthread_cond_init(&slot->writer.condition, NULL);
+
+    if(pthread_create(&slot->writer.thread, NULL, nesl_slot_run, slot)) {
+        result = SET_ERROR("Failed to create save slot thread -- %s", slot->directory);
+        pthread_cond_destroy(&slot->writer.condition);
+        pthread_mutex_destroy(&slot->writer.lock);
+        free(slot->data);
+        slot->data = NULL;
+        goto exit;
+    }
+
+    slot->length = length;
+
+exit:
+    return result;
+}
+
+const void *nesl_slot_load(nesl_slot_t *slot, int index)
+{
+    const void *result = NULL;
+
+    if(slot->length && (index >= 0) && (index < SLOT_COUNT)) {
+        pthread_mutex_lock(&slot->writer.lock);
+
+        if(slot->pending[index]) {
+            memcpy(slot->load, slot->state[index], slot->length);
+            result = slot->load;
+        } else if(slot->writer.active == index) {
+            memcpy(slot->load, slot->writer.state, slot->length);
+            result = slot->load;
+        }
+
+        pthread_mutex_unlock(&slot->writer.lock);
+
+        if(!result && nesl_slot_read(slot, index)) {
+            result = slot->load;
+        }
+    }
+
+    return result;
+}
+
+nesl_error_e nesl_slot_save(nesl_slot_t *slot, int index, const void *state)
+{
+    int error = 0, failed = 0;
+    nesl_error_e result = NESL_SUCCESS;
+
+    if(slot->length && (index >= 0) && (index < SLOT_COUNT)) {
+        pthread_mutex_lock(&slot->writer.lock);
+        memcpy(slot->state[index], state, slot->length);
+        slot->pending[index] = true;
+        error = slot->writer.error;
+        failed = slot->writer.failed;
+        slot->writer.error = 0;
+        pthread_cond_signal(&slot->writer.condition);
+        pthread_mutex_unlock(&slot->writer.lock);
+    }
+
+    if(error) {
+        result = SET_ERROR("Failed to write save slot %i -- %s", failed + 1, strerror(error));
+    }
+
+    return result;
+}
+
+void nesl_slot_uninitialize(nesl_slot_t *slot)
+{
+
+    if(slot->length) {
+        pthread_mutex_lock(&slot->writer.lock);
+        slot->writer.quit = true;
+        pthread_cond_signal(&slot->writer.condition);
+        pthread_mutex_unlock(&slot->writer.lock);
+        pthread_join(slot->writer.thread, NULL);
+        pthread_cond_destroy(&slot->writer.condition);
+        pthread_mutex_destroy(&slot->writer.lock);
+    }
+
+    free(slot->data);
+    memset(slot, 0, sizeof(*slot));
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
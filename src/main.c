@@ -24,12 +24,20 @@
  * @brief NESL launcher application.
  */
 
+#define _GNU_SOURCE
+
+#include <fcntl.h>
 #include <getopt.h>
 #include <libgen.h>
+#include <limits.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <nesl.h>
 
 /*!
@@ -37,10 +45,20 @@
  * @brief Interface option.
  */
 typedef enum {
+    OPTION_AHEAD,           /*!< Set run-ahead frames */
+    OPTION_CACHE,           /*!< Cache startup snapshot in directory */
+    OPTION_SLOT,            /*!< Set save slot directory */
     OPTION_HELP,            /*!< Show help information */
     OPTION_LINEAR,          /*!< Set linear scaling */
+    OPTION_MOVIE,           /*!< Record input movie to file */
+    OPTION_HEADLESS,        /*!< Run headless for frames */
+    OPTION_PLAYBACK,        /*!< Play input movie from file */
+    OPTION_QUIET,           /*!< Disable audio output */
+    OPTION_RECORD,          /*!< Record audio to file */
     OPTION_SCALE,           /*!< Set window scaling */
     OPTION_VERSION,         /*!< Show version information */
+    OPTION_REWIND,          /*!< Set rewind buffer size (MB) */
+    OPTION_REPLAY,          /*!< Verify input movie replay hashes in file */
     OPTION_MAX,             /*!< Maximum option */
 } nesl_option_e;
 
@@ -58,7 +76,7 @@ extern "C" {
 #endif /* __cplusplus */
 
 /*!
- * @brief Read file at path.
+ * @brief Map file at path read-only, leaving pages to be faulted in on first access.
  * @param[in] context Pointer to NESL context
  * @param[in] base Pointer to base path string
  * @param[in] path Pointer to path string
@@ -66,49 +84,68 @@ extern "C" {
  */
 static nesl_error_e read_file(nesl_t *context, char *base, char *path)
 {
-    FILE *file = NULL;
+    int file = -1;
+    struct stat status = {};
+    void *data = MAP_FAILED;
     nesl_error_e result = NESL_SUCCESS;
 
-    if(!(file = fopen(path, "rb"))) {
+    if((file = open(path, O_RDONLY)) == -1) {
         TRACE(NESL_FAILURE, "%s: File does not exist -- %s\n", base, path);
         result = NESL_FAILURE;
         goto exit;
     }
 
-    fseek(file, 0, SEEK_END);
-
-    if((context->length = ftell(file)) <= 0) {
-        TRACE(NESL_FAILURE, "%s: File is empty -- %s\n", base, path);
+    if(fstat(file, &status) == -1) {
+        TRACE(NESL_FAILURE, "%s: Failed to read file -- %s\n", base, path);
         result = NESL_FAILURE;
         goto exit;
     }
 
-    fseek(file, 0, SEEK_SET);
-
-    if(!(context->data = calloc(context->length, sizeof(uint8_t)))) {
-        TRACE(NESL_FAILURE, "%s: Failed to allocate buffer -- %.2f KB (%i bytes)\n", base, context->length / 1024.f, context->length);
+    if((context->length = status.st_size) <= 0) {
+        TRACE(NESL_FAILURE, "%s: File is empty -- %s\n", base, path);
         result = NESL_FAILURE;
         goto exit;
     }
 
-    if(fread(context->data, sizeof(uint8_t), context->length, file) != context->length) {
-        TRACE(NESL_FAILURE, "%s: Failed to read file -- %s\n", base, path);
+    if((data = mmap(NULL, context->length, PROT_READ, MAP_PRIVATE, file, 0)) == MAP_FAILED) {
+        TRACE(NESL_FAILURE, "%s: Failed to map file -- %.2f KB (%i bytes)\n", base, context->length / 1024.f, context->length);
         result = NESL_FAILURE;
         goto exit;
     }
 
+    context->data = data;
+    context->mapped = true;
     context->title = basename(path);
 
 exit:
 
-    if(file) {
-        fclose(file);
-        file = NULL;
+    if(file != -1) {
+        close(file);
+        file = -1;
     }
 
     return result;
 }
 
+/*!
+ * @brief Set battery save path, next to the file with its extension replaced by .sav.
+ * @param[in,out] context Pointer to NESL context
+ * @param[out] save Pointer to battery save path string
+ * @param[in] length Battery save path string length in bytes
+ * @param[in] path Constant pointer to file path string
+ */
+static void set_save(nesl_t *context, char *save, size_t length, const char *path)
+{
+    const char *extension = strrchr(path, '.');
+
+    if(!extension || strchr(extension, '/')) {
+        extension = path + strlen(path);
+    }
+
+    snprintf(save, length, "%.*s.sav", (int)(extension - path), path);
+    context->save = save;
+}
+
 /*!
  * @brief Show version string in stream.
  * @param[in,out] stream File stream
@@ -145,8 +182,11 @@ static void show_help(FILE *stream, bool verbose)
     TRACE(NESL_SUCCESS, "%s", "nesl [options] file\n");
 
     if(verbose) {
-        const char *OPTION[] = { "-h", "-l", "-s", "-v", },
-            *DESCRIPTION[] = { "Show help information", "Set linear scaling", "Set window scaling", "Show version information", };
+        const char *OPTION[] = { "-a", "-c", "-d", "-h", "-l", "-m", "-n", "-p", "-q", "-r", "-s", "-v", "-w", "-x", },
+            *DESCRIPTION[] = { "Set run-ahead frames", "Cache startup snapshot in directory", "Set save slot directory", "Show help information", "Set linear scaling",
+                "Record input movie to file", "Run headless for frames", "Play input movie from file", "Disable audio output", "Record audio to file",
+                "Set window scaling", "Show version information", "Set rewind buffer size (MB)",
+                "Verify input movie replay hashes in file", };
 
         TRACE(NESL_SUCCESS, "%s", "\n");
 
@@ -161,25 +201,62 @@ int main(int argc, char *argv[])
 {
     int option;
     nesl_t context = {};
+    char save[PATH_MAX] = {};
+    nesl_instance_t *instance = NULL;
     nesl_error_e result = NESL_SUCCESS;
 
     opterr = 1;
 
-    while((option = getopt(argc, argv, "hls:v")) != -1) {
+    while((option = getopt(argc, argv, "a:c:d:hlm:n:p:qr:s:vw:x:")) != -1) {
 
         switch(option) {
+            case 'a':
+                context.ahead = strtol(optarg, NULL, 10);
+                break;
+            case 'c':
+                context.snapshot = optarg;
+                break;
+            case 'd':
+                context.slot = optarg;
+                break;
             case 'h':
                 show_help(stdout, true);
                 goto exit;
             case 'l':
                 context.linear = true;
                 break;
+            case 'm':
+                context.movie = optarg;
+                context.playback = false;
+                break;
+            case 'n':
+                context.service = NESL_SERVICE_HEADLESS;
+                context.input_length = strtol(optarg, NULL, 10);
+                break;
+            case 'p':
+                context.movie = optarg;
+                context.playback = true;
+                break;
+            case 'q':
+                context.quiet = true;
+                break;
+            case 'r':
+                context.record = optarg;
+                break;
             case 's':
                 context.scale = strtol(optarg, NULL, 10);
                 break;
             case 'v':
                 show_version(stdout, false);
                 goto exit;
+            case 'w':
+                context.rewind = strtol(optarg, NULL, 10);
+                break;
+            case 'x':
+                context.replay = optarg;
+                context.service = NESL_SERVICE_HEADLESS;
+                context.quiet = true;
+                break;
             case '?':
             default:
                 result = NESL_FAILURE;
@@ -188,6 +265,7 @@ int main(int argc, char *argv[])
     }
 
     for(option = optind; option < argc; ++option) {
+        set_save(&context, save, sizeof(save), argv[option]);
 
         if((result = read_file(&context, argv[0], argv[option])) == NESL_FAILURE) {
             goto exit;
@@ -195,7 +273,22 @@ int main(int argc, char *argv[])
         break;
     }
 
-    if((result = nesl(&context)) == NESL_FAILURE) {
+    if((result = nesl_create(&instance, &context)) == NESL_FAILURE) {
+        TRACE(NESL_FAILURE, "%s: %s\n", argv[0], nesl_get_error());
+        goto exit;
+    }
+
+    if(nesl_get_battery(instance) == NESL_FAILURE) {
+        TRACE(NESL_FAILURE, "%s: Warning: %s\n", argv[0], nesl_get_error());
+    }
+
+    while((result = nesl_step(instance)) == NESL_SUCCESS);
+
+    if(nesl_destroy(instance) == NESL_FAILURE) {
+        result = NESL_FAILURE;
+    }
+
+    if(result == NESL_FAILURE) {
         TRACE(NESL_FAILURE, "%s: %s\n", argv[0], nesl_get_error());
         goto exit;
     }
@@ -203,11 +296,11 @@ int main(int argc, char *argv[])
 exit:
 
     if(context.data) {
-        free(context.data);
+        munmap(context.data, context.length);
         context.data = NULL;
     }
 
-    return (int)result;
+    return (result == NESL_FAILURE) ? EXIT_FAILURE : EXIT_SUCCESS;
 }
 
 #ifdef __cplusplus
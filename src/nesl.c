@@ -24,38 +24,851 @@
  * @brief NESL interface.
  */
 
+#include <unistd.h>
 #include <bus.h>
+#include <cache.h>
+#include <cartridge.h>
+#include <hash.h>
+#include <lz.h>
+#include <movie.h>
+#include <pool.h>
+#include <replay.h>
 #include <service.h>
+#include <snapshot.h>
+
+#define REPLAY_COUNT (SUBSYSTEM_MAX + 1)    /*!< Replay hash count per frame, the display followed by the subsystems */
+#define STATE_COMPRESSED 0x1                /*!< Save-state flag, machine state LZ compressed */
+
+/*!
+ * @brief Replay hash names, the display followed by the subsystems.
+ */
+static const char *REPLAY[] = {
+    "display", "bus", "audio", "input", "mapper", "processor", "video",
+    };
+
+/*!
+ * @struct nesl_instance_s
+ * @brief NESL instance context.
+ */
+struct nesl_instance_s {
+    nesl_bus_t *bus;            /*!< Bus context */
+    nesl_service_t *service;    /*!< Service context */
+    const void *rom;            /*!< Shared ROM image, or caller mapped data */
+    uint64_t hash;              /*!< ROM hash, matched against save-states, movies and replays */
+    bool hashed;                /*!< ROM hash computed, deferred to first use so caller mapped ROM pages are not all faulted in */
+    int ahead;                  /*!< Run-ahead frames (0:disabled) */
+    nesl_t context;             /*!< Creation context, with data pointing at the ROM image (cloned instances start from it) */
+
+    struct {
+        nesl_movie_t data;      /*!< Input movie, recorded or played back */
+        const char *path;       /*!< Input movie path (NULL if disabled) */
+        bool playback;          /*!< Input movie played back, otherwise recorded */
+        uint32_t frame;         /*!< Input movie playback frame */
+    } movie;
+
+    struct {
+        nesl_replay_t data;     /*!< Replay hashes, recorded or verified */
+        const char *path;       /*!< Replay hashes path (NULL if disabled) */
+        bool verify;            /*!< Replay hashes verified, otherwise recorded */
+    } replay;
+};
+
+/*!
+ * @struct nesl_state_header_t
+ * @brief NESL save-state header, followed by the bus state.
+ */
+typedef struct {
+    char magic[4];              /*!< Magic number */
+    uint32_t version;           /*!< Save-state version */
+    uint64_t hash;              /*!< ROM hash */
+    uint64_t length;            /*!< Save-state length in bytes, including the header */
+    uint64_t flags;             /*!< Save-state flags (STATE_COMPRESSED) */
+} nesl_state_header_t;
+
+/*!
+ * @struct nesl_vector_t
+ * @brief NESL batched step context.
+ */
+typedef struct {
+    nesl_instance_t **instance;     /*!< Instances */
+    const uint8_t *input;           /*!< Instance input */
+    uint32_t *observation;          /*!< Observation buffer */
+    atomic_int failure;             /*!< First failed instance index (-1 if none) */
+    atomic_bool quit;               /*!< Instance quit flag */
+    char error[256];                /*!< First failed instance error string */
+} nesl_vector_t;
+
+/*!
+ * @struct nesl_pool_context_t
+ * @brief NESL thread pool context (shared by all instances).
+ */
+typedef struct {
+    nesl_pool_t pool;               /*!< Thread pool */
+    pthread_mutex_t lock;           /*!< Mutex, held while the thread pool is initialized or running a batch */
+    bool initialized;               /*!< Thread pool initialized flag */
+    int count;                      /*!< Worker thread count (negative for one per online processor, less the calling thread) */
+    bool affinity;                  /*!< Worker threads pinned to processors */
+} nesl_pool_context_t;
+
+static nesl_pool_context_t g_pool = { .lock = PTHREAD_MUTEX_INITIALIZER, .count = -1, }; /*!< Thread pool context */
 
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
 
+/*!
+ * @brief Uninitialize thread pool at exit.
+ */
+static void nesl_pool_exit(void)
+{
+    pthread_mutex_lock(&g_pool.lock);
+
+    if(g_pool.initialized) {
+        nesl_pool_uninitialize(&g_pool.pool);
+        g_pool.initialized = false;
+    }
+
+    pthread_mutex_unlock(&g_pool.lock);
+}
+
+/*!
+ * @brief Initialize thread pool on first use, must be called with the thread pool mutex held.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_pool_start(void)
+{
+    nesl_error_e result = NESL_SUCCESS;
+
+    if(!g_pool.initialized) {
+        int count = g_pool.count;
+
+        if(count < 0) {
+            count = sysconf(_SC_NPROCESSORS_ONLN) - 1;
+        }
+
+        if((result = nesl_pool_initialize(&g_pool.pool, count, g_pool.affinity)) == NESL_FAILURE) {
+            nesl_pool_uninitialize(&g_pool.pool);
+            goto exit;
+        }
+
+        atexit(nesl_pool_exit);
+        g_pool.initialized = true;
+    }
+
+exit:
+    return result;
+}
+
+/*!
+ * @brief Get ROM hash of NESL instance, computed on first use.
+ * @param[in,out] instance Pointer to NESL instance
+ * @return ROM hash
+ */
+static uint64_t nesl_get_hash(nesl_instance_t *instance)
+{
+
+    if(!instance->hashed) {
+        instance->hash = nesl_hash(instance->rom, instance->context.length, 0);
+        instance->hashed = true;
+    }
+
+    return instance->hash;
+}
+
+/*!
+ * @brief Play the next input movie frame back into the bound NESL instance, resetting the bus if the frame starts with a reset
+ *        and overriding the controller input with the frame input.
+ * @param[in,out] instance Pointer to NESL instance
+ * @return NESL_FAILURE on failure, NESL_QUIT after the last frame, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_movie_play(nesl_instance_t *instance)
+{
+    nesl_error_e result = NESL_SUCCESS;
+
+    if(instance->movie.frame >= instance->movie.data.header.frames) {
+        result = NESL_QUIT;
+        goto exit;
+    }
+
+    if(nesl_movie_is_reset(&instance->movie.data, instance->movie.frame)
+            && ((result = nesl_bus_interrupt(INTERRUPT_RESET)) == NESL_FAILURE)) {
+        goto exit;
+    }
+
+    nesl_service_set_input(true, instance->movie.data.input[(size_t)instance->movie.frame++ * instance->movie.data.header.ports]);
+
+exit:
+    return result;
+}
+
+/*!
+ * @brief Hash the display and subsystems of the bound NESL instance after an input movie playback frame, and verify the hashes
+ *        against the replay hashes or record them.
+ * @param[in,out] instance Pointer to NESL instance
+ * @return NESL_FAILURE on failure or divergence, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_replay_frame(nesl_instance_t *instance)
+{
+    int index;
+    const uint32_t *display;
+    const uint16_t *compact;
+    uint64_t hash[REPLAY_COUNT] = {};
+    nesl_error_e result = NESL_SUCCESS;
+    uint32_t frame = instance->movie.frame - 1;
+
+    if((display = nesl_service_get_display())) {
+        hash[0] = nesl_hash(display, NESL_DISPLAY_WIDTH * NESL_DISPLAY_HEIGHT * sizeof(*display), 0);
+    } else if((compact = nesl_service_get_index())) {
+        hash[0] = nesl_hash(compact, NESL_DISPLAY_WIDTH * NESL_DISPLAY_HEIGHT * sizeof(*compact), 0);
+    }
+
+    nesl_bus_hash(&hash[1]);
+
+    if(instance->replay.verify) {
+
+        if((index = nesl_replay_compare(&instance->replay.data, frame, hash)) != -1) {
+            result = SET_ERROR("Replay diverged at frame %u -- %s", frame, (index < REPLAY_COUNT) ? REPLAY[index] : "length");
+            goto exit;
+        }
+    } else if((frame == instance->replay.data.header.frames) && ((result = nesl_replay_append(&instance->replay.data, hash)) == NESL_FAILURE)) {
+        goto exit;
+    }
+
+exit:
+    return result;
+}
+
+/*!
+ * @brief Run the bound NESL instance through one frame (poll, run until frame completes, redraw). With run-ahead enabled, the
+ *        frame is run without video output and captured, followed by the hidden frames without audio output, the last of which
+ *        is displayed, before the captured frame is restored. With an input movie enabled, the frame input and any reset raised
+ *        while polling are appended to the movie, along with the state before polling, or the frame is played back from it and
+ *        checked against the replay hashes.
+ * @param[in,out] instance Pointer to NESL instance
+ * @return NESL_FAILURE on failure, NESL_SUCCESS or NESL_QUIT otherwise
+ */
+static nesl_error_e nesl_run(nesl_instance_t *instance)
+{
+    const void *state = NULL;
+    nesl_error_e result;
+    uint32_t reset = nesl_bus_get_reset();
+
+    if(instance->movie.path && !instance->movie.playback) {
+        state = nesl_bus_capture();
+    }
+
+    if((result = nesl_service_poll()) == NESL_SUCCESS) {
+
+        if(state) {
+            uint8_t input = 0;
+
+            for(nesl_button_e button = 0; button < BUTTON_MAX; ++button) {
+                input |= nesl_service_get_button(button) << button;
+            }
+
+            if((result = nesl_movie_append(&instance->movie.data, &input, nesl_bus_get_reset() != reset, state)) == NESL_FAILURE) {
+                goto exit;
+            }
+        } else if(instance->movie.path && ((result = nesl_movie_play(instance)) != NESL_SUCCESS)) {
+            goto exit;
+        }
+
+        if(instance->ahead) {
+            nesl_bus_set_hidden(true, false);
+
+            while(!nesl_bus_cycle());
+
+            nesl_bus_capture();
+
+            for(int frame = 1; frame <= instance->ahead; ++frame) {
+                nesl_bus_set_hidden(frame < instance->ahead, true);
+
+                while(!nesl_bus_cycle());
+            }
+
+            nesl_bus_restore();
+            nesl_bus_set_hidden(false, false);
+        } else {
+
+            while(!nesl_bus_cycle());
+        }
+
+        if((result = nesl_bus_get_error()) == NESL_FAILURE) {
+            goto exit;
+        }
+
+        if((result = nesl_service_redraw()) == NESL_FAILURE) {
+            goto exit;
+        }
+
+        if(instance->replay.path && ((result = nesl_replay_frame(instance)) == NESL_FAILURE)) {
+            goto exit;
+        }
+    }
+
+exit:
+    return result;
+}
+
+/*!
+ * @brief Bind NESL instance bus and service contexts to the calling thread.
+ * @param[in] instance Constant pointer to NESL instance, or NULL to unbind
+ */
+static void nesl_set_instance(const nesl_instance_t *instance)
+{
+    nesl_bus_set(instance ? instance->bus : NULL);
+    nesl_service_set(instance ? instance->service : NULL);
+}
+
+/*!
+ * @brief Create NESL instance, acquiring the ROM image from the caller's data or sharing the parent instance's image.
+ * @param[out] instance Pointer to NESL instance pointer (set to NULL on failure)
+ * @param[in] context Constant pointer to caller defined context
+ * @param[in] parent Constant pointer to parent NESL instance (can be NULL)
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_create_instance(nesl_instance_t **instance, const nesl_t *context, const nesl_instance_t *parent)
+{
+    nesl_t configuration = *context;
+    int result = NESL_SUCCESS;
+
+    nesl_set_instance(NULL);
+
+    if(configuration.movie) {
+        configuration.rewind = 0;
+        configuration.save = NULL;
+        configuration.slot = NULL;
+    }
+
+    if(!(*instance = calloc(1, sizeof(**instance)))) {
+        result = SET_ERROR("Failed to allocate instance -- %.02f KB (%i bytes)", sizeof(**instance) / 1024.f, sizeof(**instance));
+        goto exit;
+    }
+
+    if(parent) {
+        (*instance)->rom = parent->rom;
+        (*instance)->hash = parent->hash;
+        (*instance)->hashed = parent->hashed;
+        nesl_cache_retain(parent->rom);
+    } else {
+
+        if(context->mapped) {
+            (*instance)->rom = context->data;
+        } else if((result = nesl_cache_acquire(&(*instance)->rom, context->data, context->length)) == NESL_FAILURE) {
+            goto exit;
+        }
+    }
+
+    configuration.data = (void *)(*instance)->rom;
+
+    if((result = nesl_service_initialize(&configuration)) == NESL_FAILURE) {
+        goto exit;
+    }
+
+    if((result = nesl_bus_initialize(&configuration)) == NESL_FAILURE) {
+        goto exit;
+    }
+
+    if(configuration.save && ((const nesl_cartridge_header_t *)configuration.data)->flag_6.ram) {
+        configuration.snapshot = NULL;
+    }
+
+    if(configuration.snapshot && (result = nesl_snapshot_boot(configuration.snapshot, configuration.data, configuration.length)) == NESL_FAILURE) {
+        goto exit;
+    }
+
+    (*instance)->context = configuration;
+
+    if(configuration.movie) {
+
+        if(configuration.playback) {
+
+            if((result = nesl_movie_read(&(*instance)->movie.data, configuration.movie, nesl_get_hash(*instance), nesl_bus_save(NULL))) == NESL_FAILURE) {
+                goto exit;
+            }
+
+            if((*instance)->movie.data.header.keyframes) {
+                nesl_bus_load((*instance)->movie.data.state);
+            }
+        } else if((result = nesl_movie_initialize(&(*instance)->movie.data, nesl_get_hash(*instance), nesl_bus_save(NULL))) == NESL_FAILURE) {
+            goto exit;
+        }
+
+        (*instance)->movie.path = configuration.movie;
+        (*instance)->movie.playback = configuration.playback;
+    }
+
+    if(configuration.replay) {
+
+        if(!configuration.movie || !configuration.playback) {
+            result = SET_ERROR("Replay hashes require input movie playback -- %s", configuration.replay);
+            goto exit;
+        }
+
+        if(!access(configuration.replay, F_OK)) {
+
+            if((result = nesl_replay_read(&(*instance)->replay.data, configuration.replay, nesl_get_hash(*instance), REPLAY_COUNT)) == NESL_FAILURE) {
+                goto exit;
+            }
+
+            if((*instance)->replay.data.header.frames != (*instance)->movie.data.header.frames) {
+                result = SET_ERROR("Mismatched replay hashes -- %u frames, expecting %u", (*instance)->replay.data.header.frames,
+                    (*instance)->movie.data.header.frames);
+                goto exit;
+            }
+
+            (*instance)->replay.verify = true;
+        } else if((result = nesl_replay_initialize(&(*instance)->replay.data, nesl_get_hash(*instance), REPLAY_COUNT)) == NESL_FAILURE) {
+            goto exit;
+        }
+
+        (*instance)->replay.path = configuration.replay;
+    }
+
+    (*instance)->ahead = (configuration.ahead > 0) ? configuration.ahead : 0;
+
+exit:
+
+    if(*instance) {
+        (*instance)->bus = nesl_bus_get();
+        (*instance)->service = nesl_service_get();
+
+        if(result == NESL_FAILURE) {
+            nesl_destroy(*instance);
+            *instance = NULL;
+        }
+    }
+
+    nesl_set_instance(NULL);
+
+    return result;
+}
+
+/*!
+ * @brief Destroy NESL instance, writing any recorded input movie or replay hashes.
+ * @param[in,out] instance Pointer to NESL instance (can be NULL)
+ * @return NESL_FAILURE if the input movie, replay hashes or audio recording could not be written, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_destroy_instance(nesl_instance_t *instance)
+{
+    nesl_error_e result = NESL_SUCCESS;
+
+    if(instance) {
+
+        if(instance->movie.path && !instance->movie.playback) {
+            result = nesl_movie_write(&instance->movie.data, instance->movie.path);
+        }
+
+        if(instance->replay.path && !instance->replay.verify
+                && (nesl_replay_write(&instance->replay.data, instance->replay.path) == NESL_FAILURE)) {
+            result = NESL_FAILURE;
+        }
+
+        nesl_movie_uninitialize(&instance->movie.data);
+        nesl_replay_uninitialize(&instance->replay.data);
+        nesl_set_instance(instance);
+
+        if(nesl_bus_uninitialize() == NESL_FAILURE) {
+            result = NESL_FAILURE;
+        }
+
+        nesl_service_uninitialize();
+        nesl_set_instance(NULL);
+        nesl_cache_release(instance->rom);
+        free(instance);
+    }
+
+    return result;
+}
+
+/*!
+ * @brief Step one instance of a batch, copying its display into the observation buffer.
+ * @param[in,out] context Pointer to NESL batched step context
+ * @param[in] index Instance index
+ */
+static void nesl_vec_step_task(void *context, int index)
+{
+    int result, expected = -1;
+    nesl_frame_t frame = {};
+    nesl_vector_t *vector = context;
+
+    if((result = nesl_step_frame(vector->instance[index], vector->input[index], &frame)) == NESL_FAILURE) {
+
+        if(atomic_compare_exchange_strong(&vector->failure, &expected, index)) {
+            snprintf(vector->error, sizeof(vector->error), "%s", nesl_get_error());
+        }
+    } else {
+
+        if(result == NESL_QUIT) {
+            atomic_store(&vector->quit, true);
+        }
+
+        if(vector->observation) {
+            uint32_t *observation = &vector->observation[(size_t)index * NESL_DISPLAY_WIDTH * NESL_DISPLAY_HEIGHT];
+
+            if(frame.pixel) {
+                memcpy(observation, frame.pixel, NESL_DISPLAY_WIDTH * NESL_DISPLAY_HEIGHT * sizeof(*frame.pixel));
+            } else if(frame.index) {
+
+                for(int pixel = 0; pixel < (NESL_DISPLAY_WIDTH * NESL_DISPLAY_HEIGHT); ++pixel) {
+                    observation[pixel] = nesl_service_get_color(frame.index[pixel]);
+                }
+            }
+        }
+    }
+}
+
 nesl_error_e nesl(const nesl_t *context)
 {
+    nesl_instance_t *instance = NULL;
     int result;
 
-    if((result = nesl_service_initialize(context->title, context->linear, context->scale)) == NESL_FAILURE) {
+    if((result = nesl_create(&instance, context)) == NESL_FAILURE) {
         goto exit;
     }
 
-    if((result = nesl_bus_initialize(context->data, context->length)) == NESL_FAILURE) {
+    while((result = nesl_step(instance)) == NESL_SUCCESS);
+
+exit:
+
+    if((nesl_destroy_instance(instance) == NESL_FAILURE) && (result != NESL_FAILURE)) {
+        result = NESL_FAILURE;
+    }
+
+    return result;
+}
+
+nesl_error_e nesl_clone(nesl_instance_t **clone, const nesl_instance_t *instance)
+{
+    size_t length;
+    uint8_t *state = NULL;
+    nesl_t configuration = instance->context;
+    nesl_error_e result = NESL_SUCCESS;
+
+    configuration.title = NULL;
+    configuration.record = NULL;
+    configuration.service = NESL_SERVICE_HEADLESS;
+    configuration.input = NULL;
+    configuration.input_length = 0;
+    configuration.rewind = 0;
+    configuration.snapshot = NULL;
+    configuration.movie = NULL;
+    configuration.save = NULL;
+    configuration.slot = NULL;
+    configuration.replay = NULL;
+
+    if((result = nesl_create_instance(clone, &configuration, instance)) == NESL_FAILURE) {
         goto exit;
     }
 
-    while((result = nesl_service_poll()) == NESL_SUCCESS) {
+    nesl_set_instance(instance);
+    length = nesl_bus_save(NULL);
 
-        while(!nesl_bus_cycle());
+    if(!(state = malloc(length))) {
+        result = SET_ERROR("Failed to allocate state -- %.02f KB (%zu bytes)", length / 1024.f, length);
+        nesl_destroy(*clone);
+        *clone = NULL;
+        goto exit;
+    }
 
-        if((result = nesl_service_redraw()) == NESL_FAILURE) {
+    nesl_bus_save(state);
+    nesl_set_instance(*clone);
+    nesl_bus_load(state);
+
+exit:
+    nesl_set_instance(NULL);
+    free(state);
+
+    return result;
+}
+
+nesl_error_e nesl_create(nesl_instance_t **instance, const nesl_t *context)
+{
+    return nesl_create_instance(instance, context, NULL);
+}
+
+nesl_error_e nesl_destroy(nesl_instance_t *instance)
+{
+    return nesl_destroy_instance(instance);
+}
+
+nesl_error_e nesl_get_battery(nesl_instance_t *instance)
+{
+    nesl_error_e result;
+
+    nesl_set_instance(instance);
+    result = nesl_bus_get_battery();
+    nesl_set_instance(NULL);
+
+    return result;
+}
+
+uint32_t nesl_get_color(uint16_t index)
+{
+    return nesl_service_get_color(index);
+}
+
+int nesl_get_state_length(nesl_instance_t *instance)
+{
+    int result;
+
+    nesl_set_instance(instance);
+    result = sizeof(nesl_state_header_t) + nesl_bus_save(NULL);
+    nesl_set_instance(NULL);
+
+    return result;
+}
+
+nesl_error_e nesl_load_state(nesl_instance_t *instance, const void *data, int length)
+{
+    uint8_t *state = NULL;
+    nesl_state_header_t header = {};
+    nesl_error_e result = NESL_SUCCESS;
+
+    nesl_set_instance(instance);
+
+    if(!data || (length < 0) || (length < sizeof(header))) {
+        result = SET_ERROR("Invalid state length -- %.02f KB (%i bytes)", length / 1024.f, length);
+        goto exit;
+    }
+
+    memcpy(&header, data, sizeof(header));
+
+    if(strncmp(header.magic, "NSV\x1A", 4)) {
+        result = SET_ERROR("Malformed state -- %s", "String mismatch");
+        goto exit;
+    }
+
+    if(header.version != NESL_STATE_VERSION) {
+        result = SET_ERROR("Unsupported state version -- %u", header.version);
+        goto exit;
+    }
+
+    if(header.hash != nesl_get_hash(instance)) {
+        result = SET_ERROR("Mismatched state data -- %016llx", (unsigned long long)header.hash);
+        goto exit;
+    }
+
+    if(header.flags & STATE_COMPRESSED) {
+
+        if(header.length != length) {
+            result = SET_ERROR("Invalid state length -- %.02f KB (%i bytes), expecting %.02f KB (%i bytes)", length / 1024.f, length,
+                header.length / 1024.f, (int)header.length);
+            goto exit;
+        }
+
+        if(!(state = malloc(nesl_bus_save(NULL)))) {
+            result = SET_ERROR("Failed to allocate state -- %.02f KB (%zu bytes)", nesl_bus_save(NULL) / 1024.f, nesl_bus_save(NULL));
+            goto exit;
+        }
+
+        if(nesl_lz_decompress((const uint8_t *)data + sizeof(header), length - sizeof(header), state, nesl_bus_save(NULL)) != nesl_bus_save(NULL)) {
+            result = SET_ERROR("Malformed state -- %s", "Decompression failed");
+            goto exit;
+        }
+
+        nesl_bus_load(state);
+    } else {
+
+        if((header.length != length) || (length != (sizeof(header) + nesl_bus_save(NULL)))) {
+            result = SET_ERROR("Invalid state length -- %.02f KB (%i bytes), expecting %.02f KB (%i bytes)", length / 1024.f, length,
+                (sizeof(header) + nesl_bus_save(NULL)) / 1024.f, (int)(sizeof(header) + nesl_bus_save(NULL)));
             goto exit;
         }
+
+        nesl_bus_load((const uint8_t *)data + sizeof(header));
     }
 
 exit:
-    nesl_bus_uninitialize();
-    nesl_service_uninitialize();
+    nesl_set_instance(NULL);
+    free(state);
+
+    return result;
+}
+
+nesl_error_e nesl_save_state(nesl_instance_t *instance, void *data, int length)
+{
+    nesl_error_e result = NESL_SUCCESS;
+    nesl_state_header_t header = { .magic = "NSV\x1A", .version = NESL_STATE_VERSION, .hash = nesl_get_hash(instance), };
 
+    nesl_set_instance(instance);
+    header.length = sizeof(header) + nesl_bus_save(NULL);
+
+    if(!data || (length < 0) || (length < header.length)) {
+        result = SET_ERROR("Invalid state length -- %.02f KB (%i bytes), expecting %.02f KB (%i bytes)", length / 1024.f, length,
+            header.length / 1024.f, (int)header.length);
+        goto exit;
+    }
+
+    memcpy(data, &header, sizeof(header));
+    nesl_bus_save((uint8_t *)data + sizeof(header));
+
+exit:
+    nesl_set_instance(NULL);
+
+    return result;
+}
+
+nesl_error_e nesl_save_state_compressed(nesl_instance_t *instance, void *data, int *length)
+{
+    size_t compressed;
+    nesl_error_e result = NESL_SUCCESS;
+    nesl_state_header_t header = { .magic = "NSV\x1A", .version = NESL_STATE_VERSION, .hash = nesl_get_hash(instance), .flags = STATE_COMPRESSED, };
+
+    nesl_set_instance(instance);
+    header.length = sizeof(header) + nesl_bus_save(NULL);
+
+    if(!data || (*length < 0) || (*length < header.length)) {
+        result = SET_ERROR("Invalid state length -- %.02f KB (%i bytes), expecting %.02f KB (%i bytes)", *length / 1024.f, *length,
+            header.length / 1024.f, (int)header.length);
+        goto exit;
+    }
+
+    if((compressed = nesl_lz_compress(nesl_bus_capture(), nesl_bus_save(NULL), (uint8_t *)data + sizeof(header),
+            header.length - sizeof(header) - 1))) {
+        header.length = sizeof(header) + compressed;
+    } else {
+        header.flags = 0;
+        nesl_bus_save((uint8_t *)data + sizeof(header));
+    }
+
+    memcpy(data, &header, sizeof(header));
+    *length = header.length;
+
+exit:
+    nesl_set_instance(NULL);
+
+    return result;
+}
+
+nesl_error_e nesl_seek_movie(nesl_instance_t *instance, int frame)
+{
+    uint32_t keyframe;
+    nesl_error_e result = NESL_SUCCESS;
+
+    nesl_set_instance(instance);
+
+    if(!instance->movie.path || !instance->movie.playback) {
+        result = SET_ERROR("Movie not played back -- %s", instance->movie.path ? instance->movie.path : "(none)");
+        goto exit;
+    }
+
+    if((frame < 0) || ((uint32_t)frame > instance->movie.data.header.frames)) {
+        result = SET_ERROR("Invalid movie frame -- %i, expecting 0-%u", frame, instance->movie.data.header.frames);
+        goto exit;
+    }
+
+    if(!instance->movie.data.header.keyframes) {
+        goto exit;
+    }
+
+    keyframe = frame / instance->movie.data.header.interval;
+
+    if(keyframe >= instance->movie.data.header.keyframes) {
+        keyframe = instance->movie.data.header.keyframes - 1;
+    }
+
+    nesl_bus_load(&instance->movie.data.state[(size_t)keyframe * instance->movie.data.header.length]);
+    instance->movie.frame = keyframe * instance->movie.data.header.interval;
+    nesl_bus_set_hidden(true, true);
+
+    while(instance->movie.frame < (uint32_t)frame) {
+
+        if((result = nesl_movie_play(instance)) != NESL_SUCCESS) {
+            break;
+        }
+
+        while(!nesl_bus_cycle());
+    }
+
+    nesl_bus_set_hidden(false, false);
+
+exit:
+    nesl_set_instance(NULL);
+
+    return result;
+}
+
+nesl_error_e nesl_set_pool(int count, int affinity)
+{
+    nesl_error_e result = NESL_SUCCESS;
+
+    pthread_mutex_lock(&g_pool.lock);
+
+    if(g_pool.initialized) {
+        result = SET_ERROR("Thread pool already running -- %i threads", g_pool.pool.count);
+        goto exit;
+    }
+
+    g_pool.count = count;
+    g_pool.affinity = affinity;
+
+exit:
+    pthread_mutex_unlock(&g_pool.lock);
+
+    return result;
+}
+
+nesl_error_e nesl_step(nesl_instance_t *instance)
+{
+    int result;
+
+    nesl_set_instance(instance);
+    nesl_service_set_input(false, 0);
+    result = nesl_run(instance);
+    nesl_set_instance(NULL);
+
+    return result;
+}
+
+nesl_error_e nesl_step_frame(nesl_instance_t *instance, uint8_t input, nesl_frame_t *frame)
+{
+    int result;
+
+    nesl_set_instance(instance);
+    nesl_service_set_input(true, input);
+
+    if((result = nesl_run(instance)) != NESL_FAILURE) {
+        frame->pixel = nesl_service_get_display();
+        frame->index = nesl_service_get_index();
+        frame->audio = nesl_service_get_capture(&frame->audio_length);
+    }
+
+    nesl_set_instance(NULL);
+
+    return result;
+}
+
+nesl_error_e nesl_vec_step(nesl_instance_t *instance[], const uint8_t input[], int count, uint32_t *observation)
+{
+    int failure;
+    nesl_error_e result = NESL_SUCCESS;
+    nesl_vector_t vector = { .instance = instance, .input = input, .observation = observation, };
+
+    atomic_init(&vector.failure, -1);
+    atomic_init(&vector.quit, false);
+    pthread_mutex_lock(&g_pool.lock);
+
+    if((result = nesl_pool_start()) == NESL_SUCCESS) {
+        nesl_pool_run(&g_pool.pool, nesl_vec_step_task, &vector, count);
+    }
+
+    pthread_mutex_unlock(&g_pool.lock);
+
+    if(result == NESL_FAILURE) {
+        goto exit;
+    }
+
+    if((failure = atomic_load(&vector.failure)) >= 0) {
+        result = SET_ERROR("Instance %i failed -- %s", failure, vector.error);
+        goto exit;
+    }
+
+    if(atomic_load(&vector.quit)) {
+        result = NESL_QUIT;
+    }
+
+exit:
     return result;
 }
 
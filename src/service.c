@@ -0,0 +1,268 @@
+/*
+ * NESL
+ * Copyright (C) 2022 David Jolly
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+ * @file service.c
+ * @brief Common service, dispatching to the backend selected at runtime.
+ */
+
+#include <service_headless.h>
+#ifndef NESL_NO_SDL
+#include <service_sdl.h>
+#endif /* NESL_NO_SDL */
+
+/*!
+ * @union nesl_color_t
+ * @brief Contains pixel color channels.
+ */
+typedef union {
+
+    struct {
+        uint8_t blue;                                                                                   /*!< Blue channel */
+        uint8_t green;                                                                                  /*!< Green channel */
+        uint8_t red;                                                                                    /*!< Red channel */
+    };
+
+    uint32_t raw;                                                                                       /*!< Raw word */
+} nesl_color_t;
+
+/*!
+ * @struct nesl_service_backend_t
+ * @brief Service backend context.
+ */
+typedef struct {
+    nesl_service_e type;                                                                                /*!< Service backend type */
+    bool (*get_button)(void *context, nesl_button_e button);                                            /*!< Service backend get button */
+    const void *(*get_capture)(void *context, int *length);                                             /*!< Service backend get capture */
+    const uint32_t *(*get_display)(void *context);                                                      /*!< Service backend get display */
+    const uint16_t *(*get_index)(void *context);                                                        /*!< Service backend get display indices */
+    bool (*get_sensor)(void *context);                                                                  /*!< Service backend get sensor */
+    bool (*get_trigger)(void *context);                                                                 /*!< Service backend get trigger */
+    nesl_error_e (*initialize)(void **context, const nesl_t *configuration);                            /*!< Service backend initialization */
+    nesl_error_e (*poll)(void *context);                                                                /*!< Service backend poll */
+    nesl_error_e (*redraw)(void *context);                                                              /*!< Service backend redraw */
+    nesl_error_e (*reset)(void *context);                                                               /*!< Service backend reset */
+    nesl_error_e (*set_audio)(void *context, nesl_service_get_audio callback, void *audio, int rate);   /*!< Service backend set audio */
+    void (*set_pixel)(void *context, uint16_t index, uint8_t x, uint8_t y);                             /*!< Service backend set pixel */
+    void (*uninitialize)(void *context);                                                                /*!< Service backend uninitialization */
+    void (*write_audio)(void *context, const void *data, int length);                                   /*!< Service backend write audio */
+} nesl_service_backend_t;
+
+/*!
+ * @struct nesl_service_s
+ * @brief Contains the service contexts.
+ */
+struct nesl_service_s {
+    const nesl_service_backend_t *backend;                                                              /*!< Service backend */
+    void *context;                                                                                      /*!< Service backend context */
+
+    struct {
+        bool enabled;                                                                                   /*!< Input override enabled */
+        uint8_t state;                                                                                  /*!< Input override button bits */
+    } input;
+};
+
+/*!
+ * @brief Supported service backends array.
+ * @note If a new service backend is added, it must be added into this array
+ */
+static const nesl_service_backend_t BACKEND[] = {
+#ifndef NESL_NO_SDL
+    { NESL_SERVICE_SDL, nesl_service_sdl_get_button, nesl_service_sdl_get_capture, nesl_service_sdl_get_display,
+        nesl_service_sdl_get_index, nesl_service_sdl_get_sensor, nesl_service_sdl_get_trigger, nesl_service_sdl_initialize, nesl_service_sdl_poll,
+        nesl_service_sdl_redraw, nesl_service_sdl_reset, nesl_service_sdl_set_audio, nesl_service_sdl_set_pixel,
+        nesl_service_sdl_uninitialize, nesl_service_sdl_write_audio, },                                /*!< SDL backend */
+#endif /* NESL_NO_SDL */
+    { NESL_SERVICE_HEADLESS, nesl_service_headless_get_button, nesl_service_headless_get_capture, nesl_service_headless_get_display,
+        nesl_service_headless_get_index, nesl_service_headless_get_sensor, nesl_service_headless_get_trigger, nesl_service_headless_initialize, nesl_service_headless_poll,
+        nesl_service_headless_redraw, nesl_service_headless_reset, nesl_service_headless_set_audio, nesl_service_headless_set_pixel,
+        nesl_service_headless_uninitialize, nesl_service_headless_write_audio, },                      /*!< Headless backend */
+    };
+
+static _Thread_local nesl_service_t *g_service = NULL;                                                 /*!< Service context (bound to the calling thread) */
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+nesl_service_t *nesl_service_get(void)
+{
+    return g_service;
+}
+
+bool nesl_service_get_button(nesl_button_e button)
+{
+    bool result;
+
+    if(g_service->input.enabled) {
+        result = (g_service->input.state & (1 << button)) ? true : false;
+    } else {
+        result = g_service->backend->get_button(g_service->context, button);
+    }
+
+    return result;
+}
+
+const void *nesl_service_get_capture(int *length)
+{
+    return g_service->backend->get_capture(g_service->context, length);
+}
+
+uint32_t nesl_service_get_color(uint16_t index)
+{
+    nesl_color_t pixel = {};
+    static const uint32_t PALETTE[] = {
+        0xFF656565, 0xFF002D69, 0xFF131F7F, 0xFF3C137C, 0xFF690B62, 0xFF730A37, 0xFF710F07, 0xFF5A1A00,
+        0xFF342800, 0xFF0B3400, 0xFF003C00, 0xFF003D10, 0xFF003840, 0xFF000000, 0xFF000000, 0xFF000000,
+        0xFFAEAEAE, 0xFF0F63B3, 0xFF4051D0, 0xFF7841CC, 0xFFA736A9, 0xFFC03470, 0xFFBD3C30, 0xFF9F4A00,
+        0xFF6D5C00, 0xFF366D00, 0xFF077704, 0xFF00793D, 0xFF00727D, 0xFF000000, 0xFF000000, 0xFF000000,
+        0xFFFEFEFF, 0xFF5DBCFF, 0xFF8FA1FF, 0xFFC890FF, 0xFFF785FA, 0xFFFF83C0, 0xFFFF8B7F, 0xFFEF9A49,
+        0xFFBDAC2C, 0xFF81A855, 0xFF55C753, 0xFF3CC98C, 0xFF3EC2CD, 0xFF4E4E4E, 0xFF000000, 0xFF000000,
+        0xFFFEFEFF, 0xFFBCDFFF, 0xFFD1D8FF, 0xFFE8D1FF, 0xFFFBCDFD, 0xFFFFCCE5, 0xFFFFCFCA, 0xFFF8D5B4,
+        0xFFE4DCA8, 0xFFCCE3A9, 0xFFB9E8B8, 0xFFAEE8D0, 0xFFAFE5EA, 0xFFB6B5B6, 0xFF000000, 0xFF000000,
+        };
+
+    pixel.raw = PALETTE[index & 0x3F];
+
+    if(index & 0x40) {
+        pixel.red = 0xFF;
+    }
+
+    if(index & 0x80) {
+        pixel.green = 0xFF;
+    }
+
+    if(index & 0x100) {
+        pixel.blue = 0xFF;
+    }
+
+    return pixel.raw;
+}
+
+const uint32_t *nesl_service_get_display(void)
+{
+    return g_service->backend->get_display(g_service->context);
+}
+
+const uint16_t *nesl_service_get_index(void)
+{
+    return g_service->backend->get_index(g_service->context);
+}
+
+bool nesl_service_get_sensor(void)
+{
+    return g_service->backend->get_sensor(g_service->context);
+}
+
+bool nesl_service_get_trigger(void)
+{
+    return g_service->backend->get_trigger(g_service->context);
+}
+
+nesl_error_e nesl_service_initialize(const nesl_t *context)
+{
+    int count = sizeof(BACKEND) / sizeof(*(BACKEND)), index;
+    nesl_error_e result = NESL_SUCCESS;
+
+    if(!(g_service = calloc(1, sizeof(*g_service)))) {
+        result = SET_ERROR("Failed to allocate service -- %.02f KB (%i bytes)", sizeof(*g_service) / 1024.f, sizeof(*g_service));
+        goto exit;
+    }
+
+    for(index = 0; index < count; ++index) {
+
+        if(BACKEND[index].type == context->service) {
+            g_service->backend = &BACKEND[index];
+            break;
+        }
+    }
+
+    if(index == count) {
+        result = SET_ERROR("Unsupported service backend -- %u", context->service);
+        goto exit;
+    }
+
+    if((result = g_service->backend->initialize(&g_service->context, context)) == NESL_FAILURE) {
+        goto exit;
+    }
+
+exit:
+    return result;
+}
+
+nesl_error_e nesl_service_poll(void)
+{
+    return g_service->backend->poll(g_service->context);
+}
+
+nesl_error_e nesl_service_redraw(void)
+{
+    return g_service->backend->redraw(g_service->context);
+}
+
+nesl_error_e nesl_service_reset(void)
+{
+    return g_service->backend->reset(g_service->context);
+}
+
+nesl_error_e nesl_service_set_audio(nesl_service_get_audio callback, void *context, int rate)
+{
+    return g_service->backend->set_audio(g_service->context, callback, context, rate);
+}
+
+void nesl_service_set(nesl_service_t *service)
+{
+    g_service = service;
+}
+
+void nesl_service_set_input(bool enabled, uint8_t state)
+{
+    g_service->input.enabled = enabled;
+    g_service->input.state = state;
+}
+
+void nesl_service_set_pixel(uint8_t color, bool red, bool green, bool blue, uint8_t x, uint8_t y)
+{
+    g_service->backend->set_pixel(g_service->context, (color & 0x3F) | (red << 6) | (green << 7) | (blue << 8), x, y);
+}
+
+void nesl_service_uninitialize(void)
+{
+
+    if(g_service) {
+
+        if(g_service->backend) {
+            g_service->backend->uninitialize(g_service->context);
+        }
+
+        free(g_service);
+        g_service = NULL;
+    }
+}
+
+void nesl_service_write_audio(const void *data, int length)
+{
+    g_service->backend->write_audio(g_service->context, data, length);
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
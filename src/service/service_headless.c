@@ -0,0 +1,231 @@
+/*
+ * NESL
+ * Copyright (C) 2022 David Jolly
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+ * @file service_headless.c
+ * @brief Headless service backend.
+ */
+
+#include <service_headless.h>
+
+/*!
+ * @struct nesl_service_headless_t
+ * @brief Contains the headless backend contexts.
+ */
+typedef struct {
+    bool compact;                   /*!< Compact display enabled */
+    uint32_t *pixel;                /*!< Pixel buffer, 256x240 ARGB (NULL if compact) */
+    uint16_t *index;                /*!< Palette index buffer, 256x240 (NULL unless compact) */
+
+    struct {
+        const uint8_t *data;        /*!< Input button bits, one byte per frame */
+        int length;                 /*!< Input length in frames */
+        int frame;                  /*!< Current frame */
+        uint8_t state;              /*!< Current frame button bits */
+    } input;
+
+    struct {
+        bool enabled;               /*!< Audio capture enabled */
+        uint8_t *data;              /*!< Captured audio samples */
+        int length;                 /*!< Captured audio length in bytes */
+        int capacity;               /*!< Captured audio capacity in bytes */
+    } capture;
+} nesl_service_headless_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+bool nesl_service_headless_get_button(void *context, nesl_button_e button)
+{
+    return (((nesl_service_headless_t *)context)->input.state & (1 << button)) ? true : false;
+}
+
+const void *nesl_service_headless_get_capture(void *context, int *length)
+{
+    nesl_service_headless_t *service = context;
+
+    *length = service->capture.length;
+
+    return service->capture.enabled ? service->capture.data : NULL;
+}
+
+const uint32_t *nesl_service_headless_get_display(void *context)
+{
+    return ((nesl_service_headless_t *)context)->pixel;
+}
+
+const uint16_t *nesl_service_headless_get_index(void *context)
+{
+    return ((nesl_service_headless_t *)context)->index;
+}
+
+bool nesl_service_headless_get_sensor(void *context)
+{
+    return true;
+}
+
+bool nesl_service_headless_get_trigger(void *context)
+{
+    return false;
+}
+
+nesl_error_e nesl_service_headless_initialize(void **context, const nesl_t *configuration)
+{
+    nesl_service_headless_t *service = NULL;
+    nesl_error_e result = NESL_SUCCESS;
+
+    if(!(*context = service = calloc(1, sizeof(*service)))) {
+        result = SET_ERROR("Failed to allocate headless backend -- %.02f KB (%i bytes)", sizeof(*service) / 1024.f, sizeof(*service));
+        goto exit;
+    }
+
+    if((service->compact = configuration->compact)) {
+
+        if(!(service->index = calloc(256 * 240, sizeof(*service->index)))) {
+            result = SET_ERROR("Failed to allocate index buffer -- %.02f KB (%i bytes)", (256 * 240 * sizeof(*service->index)) / 1024.f,
+                256 * 240 * sizeof(*service->index));
+            goto exit;
+        }
+    } else if(!(service->pixel = calloc(256 * 240, sizeof(*service->pixel)))) {
+        result = SET_ERROR("Failed to allocate pixel buffer -- %.02f KB (%i bytes)", (256 * 240 * sizeof(*service->pixel)) / 1024.f,
+            256 * 240 * sizeof(*service->pixel));
+        goto exit;
+    }
+
+    service->input.data = configuration->input;
+    service->input.length = (configuration->input_length > 0) ? configuration->input_length : 0;
+    service->capture.enabled = configuration->capture;
+
+    if((result = nesl_service_headless_reset(service)) == NESL_FAILURE) {
+        goto exit;
+    }
+
+exit:
+    return result;
+}
+
+nesl_error_e nesl_service_headless_poll(void *context)
+{
+    nesl_error_e result = NESL_SUCCESS;
+    nesl_service_headless_t *service = context;
+
+    if(service->input.length && (service->input.frame >= service->input.length)) {
+        result = NESL_QUIT;
+        goto exit;
+    }
+
+    service->input.state = (service->input.data && service->input.length) ? service->input.data[service->input.frame] : 0;
+    service->capture.length = 0;
+
+exit:
+    return result;
+}
+
+nesl_error_e nesl_service_headless_redraw(void *context)
+{
+    ++((nesl_service_headless_t *)context)->input.frame;
+
+    return NESL_SUCCESS;
+}
+
+nesl_error_e nesl_service_headless_reset(void *context)
+{
+    nesl_service_headless_t *service = context;
+
+    for(int index = 0; index < (256 * 240); ++index) {
+
+        if(service->compact) {
+            service->index[index] = 0x0F;
+        } else {
+            service->pixel[index] = 0xFF000000;
+        }
+    }
+
+    service->capture.length = 0;
+
+    return NESL_SUCCESS;
+}
+
+nesl_error_e nesl_service_headless_set_audio(void *context, nesl_service_get_audio callback, void *audio, int rate)
+{
+    return NESL_SUCCESS;
+}
+
+void nesl_service_headless_set_pixel(void *context, uint16_t index, uint8_t x, uint8_t y)
+{
+    nesl_service_headless_t *service = context;
+
+    if(service->compact) {
+        service->index[(y * 256) + x] = index;
+    } else {
+        service->pixel[(y * 256) + x] = nesl_service_get_color(index);
+    }
+}
+
+void nesl_service_headless_uninitialize(void *context)
+{
+    nesl_service_headless_t *service = context;
+
+    if(service) {
+
+        if(service->capture.data) {
+            free(service->capture.data);
+        }
+
+        if(service->index) {
+            free(service->index);
+        }
+
+        if(service->pixel) {
+            free(service->pixel);
+        }
+
+        free(service);
+    }
+}
+
+void nesl_service_headless_write_audio(void *context, const void *data, int length)
+{
+    nesl_service_headless_t *service = context;
+
+    if(service->capture.enabled) {
+
+        if((service->capture.length + length) > service->capture.capacity) {
+            int capacity = 2 * (service->capture.length + length);
+            uint8_t *capture = NULL;
+
+            if((capture = realloc(service->capture.data, capacity))) {
+                service->capture.data = capture;
+                service->capture.capacity = capacity;
+            }
+        }
+
+        if((service->capture.length + length) <= service->capture.capacity) {
+            memcpy(&service->capture.data[service->capture.length], data, length);
+            service->capture.length += length;
+        }
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
@@ -0,0 +1,179 @@
+/*
+ * NESL
+ * Copyright (C) 2022 David Jolly
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+ * @file snapshot.c
+ * @brief Startup snapshot cache.
+ */
+
+#define _GNU_SOURCE
+#include <inttypes.h>
+#include <limits.h>
+#include <unistd.h>
+#include <hash.h>
+#include <lz.h>
+#include <snapshot.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*!
+ * @brief Read startup snapshot from path, if it matches the expected header.
+ * @param[in] path Constant pointer to snapshot path string
+ * @param[in] expected Constant pointer to expected snapshot header
+ * @param[out] state Pointer to bus state buffer, holding the expected length
+ * @param[out] compressed Pointer to compressed bus state buffer, holding the worst case compressed length
+ * @return true if a matching snapshot was read, false otherwise
+ */
+static bool nesl_snapshot_read(const char *path, const nesl_snapshot_header_t *expected, uint8_t *state, uint8_t *compressed)
+{
+    FILE *file = NULL;
+    bool result = false;
+    nesl_snapshot_header_t header = {};
+
+    if(!(file = fopen(path, "rb"))) {
+        goto exit;
+    }
+
+    if(fread(&header, sizeof(header), 1, file) != 1) {
+        goto exit;
+    }
+
+    if(memcmp(header.magic, expected->magic, sizeof(header.magic)) || (header.version.major != expected->version.major)
+            || (header.version.minor != expected->version.minor) || (header.version.patch != expected->version.patch)
+            || (header.frames != expected->frames) || (header.hash != expected->hash) || (header.length != expected->length)
+            || !header.compressed || (header.compressed > LZ_BOUND(header.length))) {
+        goto exit;
+    }
+
+    if(fread(compressed, header.compressed, 1, file) != 1) {
+        goto exit;
+    }
+
+    result = (nesl_lz_decompress(compressed, header.compressed, state, header.length) == header.length)
+        && (nesl_hash(state, header.length, 0) == header.checksum);
+
+exit:
+
+    if(file) {
+        fclose(file);
+        file = NULL;
+    }
+
+    return result;
+}
+
+/*!
+ * @brief Write startup snapshot to path, through a temporary file renamed into place once complete.
+ * @param[in] path Constant pointer to snapshot path string
+ * @param[in] header Constant pointer to snapshot header
+ * @param[in] compressed Constant pointer to compressed bus state
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_snapshot_write(const char *path, const nesl_snapshot_header_t *header, const uint8_t *compressed)
+{
+    int descriptor;
+    FILE *file = NULL;
+    char temporary[PATH_MAX] = {};
+    nesl_error_e result = NESL_SUCCESS;
+
+    if(snprintf(temporary, sizeof(temporary), "%s.XXXXXX", path) >= sizeof(temporary)) {
+        result = SET_ERROR("Snapshot path is too long -- %s", path);
+        goto exit;
+    }
+
+    if((descriptor = mkstemp(temporary)) == -1) {
+        result = SET_ERROR("Failed to create snapshot -- %s", path);
+        goto exit;
+    }
+
+    if(!(file = fdopen(descriptor, "wb"))) {
+        close(descriptor);
+        unlink(temporary);
+        result = SET_ERROR("Failed to open snapshot -- %s", path);
+        goto exit;
+    }
+
+    if((fwrite(header, sizeof(*header), 1, file) != 1) || (fwrite(compressed, header->compressed, 1, file) != 1)) {
+        fclose(file);
+        unlink(temporary);
+        result = SET_ERROR("Failed to write snapshot -- %s", path);
+        goto exit;
+    }
+
+    if(fclose(file) || rename(temporary, path)) {
+        unlink(temporary);
+        result = SET_ERROR("Failed to write snapshot -- %s", path);
+        goto exit;
+    }
+
+exit:
+    return result;
+}
+
+nesl_error_e nesl_snapshot_boot(const char *directory, const void *data, int length)
+{
+    uint8_t *state = NULL;
+    char path[PATH_MAX] = {};
+    nesl_error_e result = NESL_SUCCESS;
+    nesl_snapshot_header_t header = { .magic = SNAPSHOT_MAGIC, .version = *nesl_get_version(), .frames = SNAPSHOT_FRAMES,
+        .hash = nesl_hash(data, length, 0), .length = nesl_bus_save(NULL), };
+
+    if(!(state = malloc(header.length + LZ_BOUND(header.length)))) {
+        result = SET_ERROR("Failed to allocate snapshot -- %.02f KB (%i bytes)", (header.length + LZ_BOUND(header.length)) / 1024.f,
+            (int)(header.length + LZ_BOUND(header.length)));
+        goto exit;
+    }
+
+    snprintf(path, sizeof(path), "%s/%016" PRIx64 ".snapshot", directory, header.hash);
+
+    if(nesl_snapshot_read(path, &header, state, state + header.length)) {
+        nesl_bus_load(state);
+    } else {
+        nesl_service_set_input(true, 0);
+
+        for(int frame = 0; frame < SNAPSHOT_FRAMES; ++frame) {
+            while(!nesl_bus_cycle());
+        }
+
+        nesl_bus_save(state);
+        header.checksum = nesl_hash(state, header.length, 0);
+        header.compressed = nesl_lz_compress(state, header.length, state + header.length, LZ_BOUND(header.length));
+
+        if((result = nesl_snapshot_write(path, &header, state + header.length)) == NESL_FAILURE) {
+            goto exit;
+        }
+    }
+
+exit:
+
+    if(state) {
+        free(state);
+        state = NULL;
+    }
+
+    return result;
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
@@ -30,6 +30,19 @@
 extern "C" {
 #endif /* __cplusplus */
 
+/*!
+ * @brief Clock audio synthesizer frame units.
+ * @param[in,out] audio Pointer to audio subsystem context
+ * @param[in] half Half-frame flag
+ */
+static void nesl_audio_frame(nesl_audio_t *audio, bool half)
+{
+    nesl_audio_square_frame(&audio->synthesizer.square[SYNTHESIZER_SQUARE_1], half);
+    nesl_audio_square_frame(&audio->synthesizer.square[SYNTHESIZER_SQUARE_2], half);
+    nesl_audio_triangle_frame(&audio->synthesizer.triangle, half);
+    nesl_audio_noise_frame(&audio->synthesizer.noise, half);
+}
+
 /*!
  * @brief Get audio data callback.
  * @param[in,out] context Pointer to audio context
@@ -43,7 +56,7 @@ static void nesl_audio_get_data(void *context, uint8_t *data, int length)
     memset(data, 0, length);
 
     if(nesl_audio_buffer_readable(buffer) >= 512) {
-        nesl_audio_buffer_read(buffer, (float *)data, length / sizeof(float));
+        nesl_audio_buffer_read(buffer, (nesl_audio_sample_t *)data, length / sizeof(nesl_audio_sample_t));
     }
 }
 
@@ -56,11 +69,112 @@ static uint8_t nesl_audio_get_status(nesl_audio_t *audio)
 {
     nesl_audio_status_t result = {};
 
-    /* TODO: GET STATUS */
+    result.square_0 = nesl_audio_square_get_length(&audio->synthesizer.square[SYNTHESIZER_SQUARE_1]) > 0;
+    result.square_1 = nesl_audio_square_get_length(&audio->synthesizer.square[SYNTHESIZER_SQUARE_2]) > 0;
+    result.triangle = nesl_audio_triangle_get_length(&audio->synthesizer.triangle) > 0;
+    result.noise = nesl_audio_noise_get_length(&audio->synthesizer.noise) > 0;
+    result.dmc = nesl_audio_dmc_get_length(&audio->synthesizer.dmc) > 0;
+    result.frame_interrupt = audio->status.frame_interrupt;
+    result.dmc_interrupt = nesl_audio_dmc_get_interrupt(&audio->synthesizer.dmc);
+    audio->status.frame_interrupt = false;
 
     return result.raw;
 }
 
+/*!
+ * @brief Determine if audio is synthesized (output to either the audio device or the audio sink). Hidden frames still clock the
+ *        synthesizers, so their state matches frames that are not hidden, and only skip mixing and output.
+ * @param[in] audio Constant pointer to audio subsystem context
+ * @return true if synthesized, false otherwise
+ */
+static bool nesl_audio_is_synthesized(const nesl_audio_t *audio)
+{
+    return !audio->quiet || audio->record;
+}
+
+/*!
+ * @brief Mix synthesizer outputs into a single sample.
+ * @param[in] audio Pointer to audio subsystem context
+ * @return Mixed sample
+ */
+static nesl_audio_sample_t nesl_audio_mix(nesl_audio_t *audio)
+{
+#ifdef NESL_AUDIO_S16
+    return (246 * (nesl_audio_square_get_output(&audio->synthesizer.square[SYNTHESIZER_SQUARE_1])
+            + nesl_audio_square_get_output(&audio->synthesizer.square[SYNTHESIZER_SQUARE_2])))
+        + (279 * nesl_audio_triangle_get_output(&audio->synthesizer.triangle))
+        + (162 * nesl_audio_noise_get_output(&audio->synthesizer.noise))
+        + (110 * nesl_audio_dmc_get_output(&audio->synthesizer.dmc));
+#else
+    return (0.00752f * (nesl_audio_square_get_output(&audio->synthesizer.square[SYNTHESIZER_SQUARE_1])
+            + nesl_audio_square_get_output(&audio->synthesizer.square[SYNTHESIZER_SQUARE_2])))
+        + (0.00851f * nesl_audio_triangle_get_output(&audio->synthesizer.triangle))
+        + (0.00494f * nesl_audio_noise_get_output(&audio->synthesizer.noise))
+        + (0.00335f * nesl_audio_dmc_get_output(&audio->synthesizer.dmc));
+#endif /* NESL_AUDIO_S16 */
+}
+
+/*!
+ * @brief Resample a mixed sample to the output sample-rate, flushing full batches into the audio buffer/service/sink. A failed
+ *        audio sink write stops recording, reported through the audio subsystem status.
+ * @param[in,out] audio Pointer to audio subsystem context
+ */
+static void nesl_audio_sample(nesl_audio_t *audio)
+{
+
+    if(nesl_audio_resampler_write(&audio->resampler, nesl_audio_mix(audio), &audio->sample.data[audio->sample.count])
+            && (++audio->sample.count == AUDIO_SAMPLES)) {
+
+        if(!audio->quiet) {
+            nesl_audio_buffer_write(&audio->buffer, audio->sample.data, AUDIO_SAMPLES);
+            nesl_service_write_audio(audio->sample.data, AUDIO_SAMPLES * sizeof(nesl_audio_sample_t));
+        }
+
+        if(audio->record && !audio->failed && (nesl_audio_sink_write(&audio->sink, audio->sample.data, AUDIO_SAMPLES) == NESL_FAILURE)) {
+            audio->failed = true;
+        }
+
+        audio->sample.count = 0;
+    }
+}
+
+/*!
+ * @brief Cycle audio frame sequencer through one processor cycle.
+ * @param[in,out] audio Pointer to audio subsystem context
+ */
+static void nesl_audio_sequencer(nesl_audio_t *audio)
+{
+
+    switch(++audio->sequencer.cycle) {
+        case 7457:
+        case 22371:
+            nesl_audio_frame(audio, false);
+            break;
+        case 14913:
+            nesl_audio_frame(audio, true);
+            break;
+        case 29829:
+
+            if(!audio->frame.mode) {
+                nesl_audio_frame(audio, true);
+
+                if(!audio->frame.interrupt_disable) {
+                    audio->status.frame_interrupt = true;
+                    nesl_bus_interrupt(INTERRUPT_MASKABLE);
+                }
+
+                audio->sequencer.cycle = 0;
+            }
+            break;
+        case 37281:
+            nesl_audio_frame(audio, true);
+            audio->sequencer.cycle = 0;
+            break;
+        default:
+            break;
+    }
+}
+
 /*!
  * @brief Set audio frame register.
  * @param[in] audio Pointer to audio subsystem context
@@ -69,8 +183,15 @@ static uint8_t nesl_audio_get_status(nesl_audio_t *audio)
 static void nesl_audio_set_frame(nesl_audio_t *audio, uint8_t data)
 {
     audio->frame.raw = data;
+    audio->sequencer.cycle = 0;
+
+    if(audio->frame.interrupt_disable) {
+        audio->status.frame_interrupt = false;
+    }
 
-    /* TODO: SET FRAME */
+    if(audio->frame.mode) {
+        nesl_audio_frame(audio, true);
+    }
 }
 
 /*!
@@ -80,77 +201,92 @@ static void nesl_audio_set_frame(nesl_audio_t *audio, uint8_t data)
  */
 static void nesl_audio_set_status(nesl_audio_t *audio, uint8_t data)
 {
-    audio->status.raw = data;
-
-    /* TODO: SET STATUS */
+    nesl_audio_status_t status = { .raw = data };
+
+    nesl_audio_square_set_enable(&audio->synthesizer.square[SYNTHESIZER_SQUARE_1], status.square_0);
+    nesl_audio_square_set_enable(&audio->synthesizer.square[SYNTHESIZER_SQUARE_2], status.square_1);
+    nesl_audio_triangle_set_enable(&audio->synthesizer.triangle, status.triangle);
+    nesl_audio_noise_set_enable(&audio->synthesizer.noise, status.noise);
+    nesl_audio_dmc_set_enable(&audio->synthesizer.dmc, status.dmc);
+    status.frame_interrupt = audio->status.frame_interrupt;
+    status.dmc_interrupt = false;
+    audio->status.raw = status.raw;
 }
 
 void nesl_audio_cycle(nesl_audio_t *audio, uint64_t cycle)
 {
 
-    if(!(cycle % 6)) {
-        float elapsed = (cycle / (float)89342) / (float)60;
+    if(!(cycle % 3)) {
+        bool synthesize = nesl_audio_is_synthesized(audio);
 
-        nesl_audio_square_cycle(&audio->synthesizer.square[SYNTHESIZER_SQUARE_1], elapsed);
-        nesl_audio_square_cycle(&audio->synthesizer.square[SYNTHESIZER_SQUARE_2], elapsed);
-        nesl_audio_triangle_cycle(&audio->synthesizer.triangle, elapsed);
-        nesl_audio_noise_cycle(&audio->synthesizer.noise, elapsed);
-        nesl_audio_dmc_cycle(&audio->synthesizer.dmc, elapsed);
+        if(synthesize) {
 
-        if((nesl_audio_square_readable(&audio->synthesizer.square[SYNTHESIZER_SQUARE_1]) >= 128)
-                || (nesl_audio_square_readable(&audio->synthesizer.square[SYNTHESIZER_SQUARE_2]) >= 128)
-                || (nesl_audio_triangle_readable(&audio->synthesizer.triangle) >= 128)
-                || (nesl_audio_noise_readable(&audio->synthesizer.noise) >= 128)
-                || (nesl_audio_dmc_readable(&audio->synthesizer.dmc) >= 128)) {
-            float data[SYNTHESIZER_MAX + 1][128] = {};
+            if(!(cycle % 6)) {
+                nesl_audio_square_cycle(&audio->synthesizer.square[SYNTHESIZER_SQUARE_1]);
+                nesl_audio_square_cycle(&audio->synthesizer.square[SYNTHESIZER_SQUARE_2]);
+            }
 
-            nesl_audio_square_read(&audio->synthesizer.square[SYNTHESIZER_SQUARE_1], data[SYNTHESIZER_SQUARE_1], 128);
-            nesl_audio_square_read(&audio->synthesizer.square[SYNTHESIZER_SQUARE_2], data[SYNTHESIZER_SQUARE_2], 128);
-            nesl_audio_triangle_read(&audio->synthesizer.triangle, data[SYNTHESIZER_TRIANGLE], 128);
-            nesl_audio_noise_read(&audio->synthesizer.noise, data[SYNTHESIZER_NOISE], 128);
-            nesl_audio_dmc_read(&audio->synthesizer.dmc, data[SYNTHESIZER_DMC], 128);
+            nesl_audio_triangle_cycle(&audio->synthesizer.triangle);
+            nesl_audio_noise_cycle(&audio->synthesizer.noise);
+        }
 
-            for(int sample = 0; sample < 128; ++sample) {
+        nesl_audio_dmc_cycle(&audio->synthesizer.dmc);
+        nesl_audio_sequencer(audio);
 
-                for(nesl_synthesizer_e channel = SYNTHESIZER_SQUARE_1; channel < SYNTHESIZER_MAX; ++channel) {
+        if(synthesize && !audio->hidden && !(cycle % 6)) {
+            nesl_audio_sample(audio);
+        }
+    }
+}
 
-                    if(data[channel][sample]) {
+nesl_error_e nesl_audio_get_error(const nesl_audio_t *audio)
+{
+    nesl_error_e result = NESL_SUCCESS;
 
-                        /* TODO: ASSIGN CHANNEL VOLUME */
-                        data[SYNTHESIZER_MAX][sample] += data[channel][sample] * 1.f;
-                        /* --- */
-                    }
-                }
+    if(audio->failed) {
+        result = SET_ERROR("Failed to record audio -- %i: %s", audio->sink.error, strerror(audio->sink.error));
+    }
 
-                /* TODO: ASSIGN MASTER VOLUME */
-                data[SYNTHESIZER_MAX][sample] *= 1.f;
-                /* --- */
+    return result;
+}
 
-                if(data[SYNTHESIZER_MAX][sample] < -1.f) {
-                    data[SYNTHESIZER_MAX][sample] = -1.f;
-                } else if(data[SYNTHESIZER_MAX][sample] > 1.f) {
-                    data[SYNTHESIZER_MAX][sample] = 1.f;
-                }
-            }
+size_t nesl_audio_get_size(bool quiet)
+{
+    return quiet ? 0 : ARENA_SIZE(AUDIO_BUFFER * sizeof(nesl_audio_sample_t));
+}
+
+nesl_error_e nesl_audio_initialize(nesl_audio_t *audio, nesl_arena_t *arena, bool quiet, const char *record, int rate)
+{
+    nesl_error_e result = NESL_SUCCESS;
+
+    if(rate <= 0) {
+        rate = AUDIO_RATE;
+    }
+
+    if(!(audio->quiet = quiet)) {
 
-            nesl_audio_buffer_write(&audio->buffer, data[SYNTHESIZER_MAX], 128);
+        if((result = nesl_audio_buffer_initialize(&audio->buffer, arena, AUDIO_BUFFER)) == NESL_FAILURE) {
+            goto exit;
         }
+    }
 
+    if((audio->record = (record != NULL))) {
 
+        if((result = nesl_audio_sink_initialize(&audio->sink, record, rate)) == NESL_FAILURE) {
+            goto exit;
+        }
     }
-}
 
-nesl_error_e nesl_audio_initialize(nesl_audio_t *audio)
-{
-    nesl_error_e result;
+    if(nesl_audio_is_synthesized(audio)) {
 
-    if((result = nesl_audio_buffer_initialize(&audio->buffer, 1024)) == NESL_FAILURE) {
-        goto exit;
+        if((result = nesl_audio_resampler_initialize(&audio->resampler, AUDIO_CYCLES / 2, rate)) == NESL_FAILURE) {
+            goto exit;
+        }
     }
 
     for(nesl_synthesizer_e channel = SYNTHESIZER_SQUARE_1; channel <= SYNTHESIZER_SQUARE_2; ++channel) {
 
-        if((result = nesl_audio_square_initialize(&audio->synthesizer.square[channel])) == NESL_FAILURE) {
+        if((result = nesl_audio_square_initialize(&audio->synthesizer.square[channel], channel)) == NESL_FAILURE) {
             goto exit;
         }
     }
@@ -196,6 +332,8 @@ nesl_error_e nesl_audio_reset(nesl_audio_t *audio)
 
     audio->frame.raw = 0;
     audio->status.raw = 0;
+    memset(&audio->sequencer, 0, sizeof(audio->sequencer));
+    memset(&audio->sample, 0, sizeof(audio->sample));
 
     for(nesl_synthesizer_e channel = SYNTHESIZER_SQUARE_1; channel <= SYNTHESIZER_SQUARE_2; ++channel) {
 
@@ -216,20 +354,32 @@ nesl_error_e nesl_audio_reset(nesl_audio_t *audio)
         goto exit;
     }
 
-    if((result = nesl_audio_buffer_reset(&audio->buffer)) == NESL_FAILURE) {
-        goto exit;
+    if(nesl_audio_is_synthesized(audio)) {
+
+        if((result = nesl_audio_resampler_reset(&audio->resampler)) == NESL_FAILURE) {
+            goto exit;
+        }
     }
 
-    if((result = nesl_service_set_audio(nesl_audio_get_data, audio)) == NESL_FAILURE) {
-        goto exit;
+    if(!audio->quiet) {
+
+        if((result = nesl_audio_buffer_reset(&audio->buffer)) == NESL_FAILURE) {
+            goto exit;
+        }
+
+        if((result = nesl_service_set_audio(nesl_audio_get_data, audio, audio->resampler.output)) == NESL_FAILURE) {
+            goto exit;
+        }
     }
 
 exit:
     return result;
 }
 
-void nesl_audio_uninitialize(nesl_audio_t *audio)
+nesl_error_e nesl_audio_uninitialize(nesl_audio_t *audio)
 {
+    nesl_error_e result = NESL_SUCCESS;
+
     nesl_audio_dmc_uninitialize(&audio->synthesizer.dmc);
     nesl_audio_noise_uninitialize(&audio->synthesizer.noise);
     nesl_audio_triangle_uninitialize(&audio->synthesizer.triangle);
@@ -238,8 +388,21 @@ void nesl_audio_uninitialize(nesl_audio_t *audio)
         nesl_audio_square_uninitialize(&audio->synthesizer.square[channel]);
     }
 
-    nesl_audio_buffer_uninitialize(&audio->buffer);
+    if(nesl_audio_is_synthesized(audio)) {
+        nesl_audio_resampler_uninitialize(&audio->resampler);
+    }
+
+    if(audio->record) {
+        result = nesl_audio_sink_uninitialize(&audio->sink);
+    }
+
+    if(!audio->quiet) {
+        nesl_audio_buffer_uninitialize(&audio->buffer);
+    }
+
     memset(audio, 0, sizeof(*audio));
+
+    return result;
 }
 
 void nesl_audio_write(nesl_audio_t *audio, uint16_t address, uint8_t data)
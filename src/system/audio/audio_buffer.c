@@ -36,7 +36,7 @@ extern "C" {
  * @param[in] data Pointer to data array
  * @param[in] count Maximum number of entries in data array
  */
-static void nesl_audio_buffer_copy_in(nesl_audio_buffer_t *buffer, float *data, int count)
+static void nesl_audio_buffer_copy_in(nesl_audio_buffer_t *buffer, nesl_audio_sample_t *data, int count)
 {
 
     if((buffer->write + count) >= buffer->count) {
@@ -59,7 +59,7 @@ static void nesl_audio_buffer_copy_in(nesl_audio_buffer_t *buffer, float *data,
  * @param[in] data Pointer to data array
  * @param[in] count Maximum number of entries in data array
  */
-static void nesl_audio_buffer_copy_out(nesl_audio_buffer_t *buffer, float *data, int count)
+static void nesl_audio_buffer_copy_out(nesl_audio_buffer_t *buffer, nesl_audio_sample_t *data, int count)
 {
 
     if((buffer->read + count) >= buffer->count) {
@@ -125,7 +125,7 @@ static bool nesl_audio_buffer_is_full(nesl_audio_buffer_t *buffer)
     return buffer->full;
 }
 
-nesl_error_e nesl_audio_buffer_initialize(nesl_audio_buffer_t *buffer, int count)
+nesl_error_e nesl_audio_buffer_initialize(nesl_audio_buffer_t *buffer, nesl_arena_t *arena, int count)
 {
     nesl_error_e result = NESL_SUCCESS;
 
@@ -134,7 +134,7 @@ nesl_error_e nesl_audio_buffer_initialize(nesl_audio_buffer_t *buffer, int count
         goto exit;
     }
 
-    if(!(buffer->data = calloc(count, sizeof(*buffer->data)))) {
+    if(!(buffer->data = nesl_arena_allocate(arena, count * sizeof(*buffer->data)))) {
         result = SET_ERROR("Failed to allocate buffer -- %u KB (%i bytes)", (count * sizeof(*buffer->data)) / 1024.f, count * sizeof(*buffer->data));
         goto exit;
     }
@@ -149,7 +149,7 @@ exit:
     return result;
 }
 
-int nesl_audio_buffer_read(nesl_audio_buffer_t *buffer, float *data, int count)
+int nesl_audio_buffer_read(nesl_audio_buffer_t *buffer, nesl_audio_sample_t *data, int count)
 {
     int result = 0;
 
@@ -181,7 +181,7 @@ int nesl_audio_buffer_readable(nesl_audio_buffer_t *buffer)
 nesl_error_e nesl_audio_buffer_reset(nesl_audio_buffer_t *buffer)
 {
     pthread_mutex_lock(&buffer->lock);
-    memset(buffer->data, 0, buffer->count);
+    memset(buffer->data, 0, buffer->count * sizeof(*buffer->data));
     buffer->read = 0;
     buffer->write = 0;
     buffer->full = false;
@@ -193,18 +193,13 @@ nesl_error_e nesl_audio_buffer_reset(nesl_audio_buffer_t *buffer)
 void nesl_audio_buffer_uninitialize(nesl_audio_buffer_t *buffer)
 {
 
-    if(buffer->data) {
-        free(buffer->data);
-        buffer->data = NULL;
-    }
-
     pthread_mutex_lock(&buffer->lock);
     pthread_mutex_unlock(&buffer->lock);
     pthread_mutex_destroy(&buffer->lock);
     memset(buffer, 0, sizeof(*buffer));
 }
 
-int nesl_audio_buffer_write(nesl_audio_buffer_t *buffer, float *data, int count)
+int nesl_audio_buffer_write(nesl_audio_buffer_t *buffer, nesl_audio_sample_t *data, int count)
 {
     int result = 0;
 
@@ -26,54 +26,132 @@
 
 #include <audio_dmc.h>
 
+/*!
+ * @brief Timer periods in processor cycles, indexed by rate register.
+ */
+static const uint16_t RATE[16] = {
+    428, 380, 340, 320, 286, 254, 226, 214, 190, 160, 142, 128, 106, 84, 72, 54,
+    };
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
 
-void nesl_audio_dmc_cycle(nesl_audio_dmc_t *dmc, float elapsed)
+/*!
+ * @brief Restart audio DMC synthesizer sample.
+ * @param[in,out] dmc Pointer to audio DMC synthesizer context
+ */
+static void nesl_audio_dmc_restart(nesl_audio_dmc_t *dmc)
 {
-    /* TODO: CYCLE SYNTHESIZER */
+    dmc->reader.address = 0xC000 + (dmc->state.address * 64);
+    dmc->reader.remaining = (dmc->state.length * 16) + 1;
 }
 
-nesl_error_e nesl_audio_dmc_initialize(nesl_audio_dmc_t *dmc)
+/*!
+ * @brief Fill audio DMC synthesizer sample buffer, if empty.
+ * @param[in,out] dmc Pointer to audio DMC synthesizer context
+ */
+static void nesl_audio_dmc_fetch(nesl_audio_dmc_t *dmc)
+{
+
+    if(dmc->reader.empty && dmc->reader.remaining) {
+        dmc->reader.data = nesl_bus_read(BUS_PROCESSOR, dmc->reader.address);
+        dmc->reader.empty = false;
+
+        if(++dmc->reader.address == 0x0000) {
+            dmc->reader.address = 0x8000;
+        }
+
+        if(!--dmc->reader.remaining) {
+
+            if(dmc->state.control.loop) {
+                nesl_audio_dmc_restart(dmc);
+            } else if(dmc->state.control.interrupt_enable) {
+                dmc->interrupt = true;
+                nesl_bus_interrupt(INTERRUPT_MASKABLE);
+            }
+        }
+    }
+}
+
+void nesl_audio_dmc_cycle(nesl_audio_dmc_t *dmc)
 {
-    int result;
 
-    if((result = nesl_audio_buffer_initialize(&dmc->buffer, 256)) == NESL_FAILURE) {
-        goto exit;
+    if(!dmc->timer.count) {
+        dmc->timer.count = RATE[dmc->state.control.index] - 1;
+
+        if(!dmc->output.silence) {
+
+            if(dmc->output.shift & 1) {
+
+                if(dmc->level <= 125) {
+                    dmc->level += 2;
+                }
+            } else if(dmc->level >= 2) {
+                dmc->level -= 2;
+            }
+        }
+
+        dmc->output.shift >>= 1;
+
+        if(!--dmc->output.remaining) {
+            dmc->output.remaining = 8;
+
+            if(!(dmc->output.silence = dmc->reader.empty)) {
+                dmc->output.shift = dmc->reader.data;
+                dmc->reader.empty = true;
+            }
+        }
+    } else {
+        --dmc->timer.count;
     }
 
-exit:
-    return result;
+    nesl_audio_dmc_fetch(dmc);
 }
 
-int nesl_audio_dmc_read(nesl_audio_dmc_t *dmc, float *data, int length)
+bool nesl_audio_dmc_get_interrupt(const nesl_audio_dmc_t *dmc)
 {
-    return nesl_audio_buffer_read(&dmc->buffer, data, length);
+    return dmc->interrupt;
 }
 
-int nesl_audio_dmc_readable(nesl_audio_dmc_t *dmc)
+uint16_t nesl_audio_dmc_get_length(const nesl_audio_dmc_t *dmc)
 {
-    return nesl_audio_buffer_readable(&dmc->buffer);
+    return dmc->reader.remaining;
+}
+
+uint8_t nesl_audio_dmc_get_output(const nesl_audio_dmc_t *dmc)
+{
+    return dmc->level;
+}
+
+nesl_error_e nesl_audio_dmc_initialize(nesl_audio_dmc_t *dmc)
+{
+    return nesl_audio_dmc_reset(dmc);
 }
 
 nesl_error_e nesl_audio_dmc_reset(nesl_audio_dmc_t *dmc)
 {
-    int result;
+    memset(dmc, 0, sizeof(*dmc));
+    dmc->reader.empty = true;
+    dmc->output.remaining = 8;
+    dmc->output.silence = true;
 
-    if((result = nesl_audio_buffer_reset(&dmc->buffer)) == NESL_FAILURE) {
-        goto exit;
-    }
+    return NESL_SUCCESS;
+}
 
-    memset(&dmc->state, 0, sizeof(dmc->state));
+void nesl_audio_dmc_set_enable(nesl_audio_dmc_t *dmc, bool enable)
+{
+    dmc->interrupt = false;
 
-exit:
-    return result;
+    if(!enable) {
+        dmc->reader.remaining = 0;
+    } else if(!dmc->reader.remaining) {
+        nesl_audio_dmc_restart(dmc);
+    }
 }
 
 void nesl_audio_dmc_uninitialize(nesl_audio_dmc_t *dmc)
 {
-    nesl_audio_buffer_uninitialize(&dmc->buffer);
     memset(dmc, 0, sizeof(*dmc));
 }
 
@@ -84,23 +162,12 @@ void nesl_audio_dmc_write(nesl_audio_dmc_t *dmc, uint16_t address, uint8_t data)
     switch(address) {
         case 0x4010:
 
-            /* TODO: PERFORM ANY NEEDED STATE-CHANGE OPERATIONS */
-
+            if(!dmc->state.control.interrupt_enable) {
+                dmc->interrupt = false;
+            }
             break;
         case 0x4011:
-
-            /* TODO: PERFORM ANY NEEDED STATE-CHANGE OPERATIONS */
-
-            break;
-        case 0x4012:
-
-            /* TODO: PERFORM ANY NEEDED STATE-CHANGE OPERATIONS */
-
-            break;
-        case 0x4013:
-
-            /* TODO: PERFORM ANY NEEDED STATE-CHANGE OPERATIONS */
-
+            dmc->level = dmc->state.load.counter;
             break;
         default:
             break;
@@ -26,54 +26,110 @@
 
 #include <audio_noise.h>
 
+/*!
+ * @brief Length counter values, indexed by length register.
+ */
+static const uint8_t LENGTH[32] = {
+    10, 254, 20, 2, 40, 4, 80, 6, 160, 8, 60, 10, 14, 12, 26, 14,
+    12, 16, 24, 18, 48, 20, 96, 22, 192, 24, 72, 26, 16, 28, 32, 30,
+    };
+
+/*!
+ * @brief Timer periods in processor cycles, indexed by period register.
+ */
+static const uint16_t PERIOD[16] = {
+    4, 8, 16, 32, 64, 96, 128, 160, 202, 254, 380, 508, 762, 1016, 2034, 4068,
+    };
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
 
-void nesl_audio_noise_cycle(nesl_audio_noise_t *noise, float elapsed)
+/*!
+ * @brief Clock audio noise synthesizer envelope unit.
+ * @param[in,out] noise Pointer to audio noise synthesizer context
+ */
+static void nesl_audio_noise_envelope(nesl_audio_noise_t *noise)
+{
+
+    if(noise->envelope.start) {
+        noise->envelope.start = false;
+        noise->envelope.decay = 15;
+        noise->envelope.divider = noise->state.envelope.volume;
+    } else if(!noise->envelope.divider) {
+        noise->envelope.divider = noise->state.envelope.volume;
+
+        if(noise->envelope.decay) {
+            --noise->envelope.decay;
+        } else if(noise->state.envelope.loop) {
+            noise->envelope.decay = 15;
+        }
+    } else {
+        --noise->envelope.divider;
+    }
+}
+
+void nesl_audio_noise_cycle(nesl_audio_noise_t *noise)
 {
-    /* TODO: CYCLE SYNTHESIZER */
+
+    if(!noise->timer.count) {
+        uint16_t feedback = (noise->shift ^ (noise->shift >> (noise->state.period.mode ? 6 : 1))) & 1;
+
+        noise->timer.count = PERIOD[noise->state.period.index] - 1;
+        noise->shift = (noise->shift >> 1) | (feedback << 14);
+    } else {
+        --noise->timer.count;
+    }
 }
 
-nesl_error_e nesl_audio_noise_initialize(nesl_audio_noise_t *noise)
+void nesl_audio_noise_frame(nesl_audio_noise_t *noise, bool half)
 {
-    int result;
+    nesl_audio_noise_envelope(noise);
 
-    if((result = nesl_audio_buffer_initialize(&noise->buffer, 256)) == NESL_FAILURE) {
-        goto exit;
+    if(half && !noise->state.envelope.loop && noise->length) {
+        --noise->length;
     }
+}
 
-exit:
-    return result;
+uint8_t nesl_audio_noise_get_length(const nesl_audio_noise_t *noise)
+{
+    return noise->length;
 }
 
-int nesl_audio_noise_read(nesl_audio_noise_t *noise, float *data, int length)
+uint8_t nesl_audio_noise_get_output(const nesl_audio_noise_t *noise)
 {
-    return nesl_audio_buffer_read(&noise->buffer, data, length);
+    uint8_t result = 0;
+
+    if(noise->length && !(noise->shift & 1)) {
+        result = noise->state.envelope.volume_const ? noise->state.envelope.volume : noise->envelope.decay;
+    }
+
+    return result;
 }
 
-int nesl_audio_noise_readable(nesl_audio_noise_t *noise)
+nesl_error_e nesl_audio_noise_initialize(nesl_audio_noise_t *noise)
 {
-    return nesl_audio_buffer_readable(&noise->buffer);
+    return nesl_audio_noise_reset(noise);
 }
 
 nesl_error_e nesl_audio_noise_reset(nesl_audio_noise_t *noise)
 {
-    int result;
+    memset(noise, 0, sizeof(*noise));
+    noise->shift = 1;
 
-    if((result = nesl_audio_buffer_reset(&noise->buffer)) == NESL_FAILURE) {
-        goto exit;
-    }
+    return NESL_SUCCESS;
+}
 
-    memset(&noise->state, 0, sizeof(noise->state));
+void nesl_audio_noise_set_enable(nesl_audio_noise_t *noise, bool enable)
+{
 
-exit:
-    return result;
+    if(!(noise->enable = enable)) {
+        noise->length = 0;
+    }
 }
 
 void nesl_audio_noise_uninitialize(nesl_audio_noise_t *noise)
 {
-    nesl_audio_buffer_uninitialize(&noise->buffer);
     memset(noise, 0, sizeof(*noise));
 }
 
@@ -82,25 +138,13 @@ void nesl_audio_noise_write(nesl_audio_noise_t *noise, uint16_t address, uint8_t
     noise->state.byte[address - 0x400C] = data;
 
     switch(address) {
-        case 0x400C:
-
-            /* TODO: PERFORM ANY NEEDED STATE-CHANGE OPERATIONS */
-
-            break;
-        case 0x400D:
-
-            /* TODO: PERFORM ANY NEEDED STATE-CHANGE OPERATIONS */
-
-            break;
-        case 0x400E:
-
-            /* TODO: PERFORM ANY NEEDED STATE-CHANGE OPERATIONS */
-
-            break;
         case 0x400F:
 
-            /* TODO: PERFORM ANY NEEDED STATE-CHANGE OPERATIONS */
+            if(noise->enable) {
+                noise->length = LENGTH[noise->state.length.index];
+            }
 
+            noise->envelope.start = true;
             break;
         default:
             break;
@@ -0,0 +1,392 @@
+/*
+ * NESL
+ * Copyright (C) 2022 David Jolly
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+ * @file audio_resampler.c
+ * @brief Audio polyphase FIR resampler.
+ */
+
+#include <math.h>
+#include <audio_resampler.h>
+
+#if defined(__AVX2__) || defined(__SSE__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif /* __AVX2__ || __SSE__ || __SSE2__ */
+
+/*!
+ * @struct nesl_audio_resampler_table_t
+ * @brief Audio resampler coefficient table, shared read-only by every resampler with the same sample rates.
+ */
+typedef struct nesl_audio_resampler_table_s {
+    struct nesl_audio_resampler_table_s *next;  /*!< Next coefficient table */
+    uint32_t input;                             /*!< Input sample rate (Hz) */
+    uint32_t output;                            /*!< Output sample rate (Hz) */
+    int taps;                                   /*!< Filter taps per phase */
+    int count;                                  /*!< Coefficient table reference count */
+    nesl_audio_sample_t *coefficient;           /*!< Filter coefficients, per phase (32-byte aligned) */
+} nesl_audio_resampler_table_t;
+
+/*!
+ * @struct nesl_audio_resampler_cache_t
+ * @brief Audio resampler coefficient table cache context.
+ */
+typedef struct {
+    pthread_mutex_t lock;                       /*!< Cache lock */
+    nesl_audio_resampler_table_t *table;        /*!< Coefficient tables */
+} nesl_audio_resampler_cache_t;
+
+static nesl_audio_resampler_cache_t g_cache = { .lock = PTHREAD_MUTEX_INITIALIZER, };  /*!< Coefficient table cache context (process-wide) */
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*!
+ * @brief Calculate filter coefficient (Blackman-windowed sinc).
+ * @param[in] cutoff Cutoff frequency, normalized to the input sample rate
+ * @param[in] distance Distance from the filter center, in input samples
+ * @param[in] width Half-width of the filter, in input samples
+ * @return Filter coefficient
+ */
+static double nesl_audio_resampler_coefficient(double cutoff, double distance, double width)
+{
+    double result = 2.0 * cutoff, window;
+
+    if(fabs(distance) >= width) {
+        return 0.0;
+    }
+
+    if(distance != 0.0) {
+        result = sin(2.0 * AUDIO_RESAMPLER_PI * cutoff * distance) / (AUDIO_RESAMPLER_PI * distance);
+    }
+
+    window = 0.42 + (0.5 * cos(AUDIO_RESAMPLER_PI * distance / width)) + (0.08 * cos(2.0 * AUDIO_RESAMPLER_PI * distance / width));
+
+    return result * window;
+}
+
+#ifdef NESL_AUDIO_S16
+
+/*!
+ * @brief Calculate fixed-point dot product of the history window and phase coefficients.
+ * @param[in] history Constant pointer to history window
+ * @param[in] coefficient Constant pointer to Q15 phase coefficients (32-byte aligned)
+ * @param[in] taps Number of taps (multiple of 16)
+ * @return Dot product (Q15)
+ */
+static int32_t nesl_audio_resampler_dot(const int16_t *history, const int16_t *coefficient, int taps)
+{
+    int32_t result;
+#if defined(__AVX2__)
+    __m256i sum = _mm256_setzero_si256();
+    __m128i half;
+
+    for(int tap = 0; tap < taps; tap += 16) {
+        sum = _mm256_add_epi32(sum, _mm256_madd_epi16(_mm256_loadu_si256((const __m256i *)&history[tap]),
+            _mm256_load_si256((const __m256i *)&coefficient[tap])));
+    }
+
+    half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+    result = _mm_cvtsi128_si32(half);
+#elif defined(__SSE2__)
+    __m128i sum = _mm_setzero_si128();
+
+    for(int tap = 0; tap < taps; tap += 8) {
+        sum = _mm_add_epi32(sum, _mm_madd_epi16(_mm_loadu_si128((const __m128i *)&history[tap]),
+            _mm_load_si128((const __m128i *)&coefficient[tap])));
+    }
+
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+    result = _mm_cvtsi128_si32(sum);
+#else
+    result = 0;
+
+    for(int tap = 0; tap < taps; ++tap) {
+        result += history[tap] * coefficient[tap];
+    }
+#endif /* __AVX2__ */
+
+    return result;
+}
+#else
+
+/*!
+ * @brief Calculate dot product of the history window and phase coefficients.
+ * @param[in] history Constant pointer to history window
+ * @param[in] coefficient Constant pointer to phase coefficients (32-byte aligned)
+ * @param[in] taps Number of taps (multiple of 8)
+ * @return Dot product
+ */
+static float nesl_audio_resampler_dot(const float *history, const float *coefficient, int taps)
+{
+    float result;
+#if defined(__AVX2__)
+    __m256 sum = _mm256_setzero_ps();
+    __m128 half;
+
+    for(int tap = 0; tap < taps; tap += 8) {
+#if defined(__FMA__)
+        sum = _mm256_fmadd_ps(_mm256_loadu_ps(&history[tap]), _mm256_load_ps(&coefficient[tap]), sum);
+#else
+        sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_loadu_ps(&history[tap]), _mm256_load_ps(&coefficient[tap])));
+#endif /* __FMA__ */
+    }
+
+    half = _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1));
+    half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+    half = _mm_add_ss(half, _mm_shuffle_ps(half, half, 1));
+    result = _mm_cvtss_f32(half);
+#elif defined(__SSE__)
+    __m128 sum = _mm_setzero_ps();
+
+    for(int tap = 0; tap < taps; tap += 4) {
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(&history[tap]), _mm_load_ps(&coefficient[tap])));
+    }
+
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+    result = _mm_cvtss_f32(sum);
+#else
+    result = 0.f;
+
+    for(int tap = 0; tap < taps; ++tap) {
+        result += history[tap] * coefficient[tap];
+    }
+#endif /* __AVX2__ */
+
+    return result;
+}
+#endif /* NESL_AUDIO_S16 */
+
+/*!
+ * @brief Fill audio resampler coefficient table, normalizing each phase to unity gain.
+ * @param[in,out] table Pointer to coefficient table, holding the sample rates and taps
+ */
+static void nesl_audio_resampler_fill(nesl_audio_resampler_table_t *table)
+{
+    double cutoff = (0.45 * table->output) / table->input, width = table->taps / 2.0;
+
+    for(int phase = 0; phase < AUDIO_RESAMPLER_PHASES; ++phase) {
+        nesl_audio_sample_t *coefficient = &table->coefficient[phase * table->taps];
+        double offset = ((table->taps - 1) / 2.0) - (phase / (double)AUDIO_RESAMPLER_PHASES), sum = 0.0;
+#ifdef NESL_AUDIO_S16
+        int32_t total = 0;
+#endif /* NESL_AUDIO_S16 */
+
+        for(int tap = 0; tap < table->taps; ++tap) {
+            sum += nesl_audio_resampler_coefficient(cutoff, tap - offset, width);
+        }
+
+        for(int tap = 0; tap < table->taps; ++tap) {
+            double value = nesl_audio_resampler_coefficient(cutoff, tap - offset, width) / sum;
+#ifdef NESL_AUDIO_S16
+            total += (coefficient[tap] = lrint(value * (1 << AUDIO_RESAMPLER_SHIFT)));
+#else
+            coefficient[tap] = value;
+#endif /* NESL_AUDIO_S16 */
+        }
+#ifdef NESL_AUDIO_S16
+
+        /* Fold the rounding error into the center tap, so each phase keeps unity gain */
+        coefficient[table->taps / 2] += (1 << AUDIO_RESAMPLER_SHIFT) - total;
+#endif /* NESL_AUDIO_S16 */
+    }
+}
+
+/*!
+ * @brief Acquire audio resampler coefficient table for the resampler sample rates, building it on first use. Resamplers with the
+ *        same sample rates share one reference-counted table.
+ * @param[in,out] resampler Pointer to audio resampler context, holding the sample rates
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_audio_resampler_acquire(nesl_audio_resampler_t *resampler)
+{
+    nesl_audio_resampler_table_t *table;
+    nesl_error_e result = NESL_SUCCESS;
+
+    pthread_mutex_lock(&g_cache.lock);
+
+    for(table = g_cache.table; table; table = table->next) {
+
+        if((table->input == resampler->input) && (table->output == resampler->output)) {
+            break;
+        }
+    }
+
+    if(!table) {
+        int taps = ((int)ceil((2.0 * AUDIO_RESAMPLER_ZEROS * resampler->input) / resampler->output) + (AUDIO_RESAMPLER_LANES - 1))
+            & ~(AUDIO_RESAMPLER_LANES - 1);
+        size_t length = AUDIO_RESAMPLER_PHASES * taps * sizeof(*table->coefficient);
+
+        if(!(table = calloc(1, sizeof(*table)))) {
+            result = SET_ERROR("Failed to allocate buffer -- %.02f KB (%zu bytes)", sizeof(*table) / 1024.f, sizeof(*table));
+            goto exit;
+        }
+
+        if(!(table->coefficient = aligned_alloc(32, length))) {
+            result = SET_ERROR("Failed to allocate buffer -- %.02f KB (%zu bytes)", length / 1024.f, length);
+            free(table);
+            table = NULL;
+            goto exit;
+        }
+
+        table->input = resampler->input;
+        table->output = resampler->output;
+        table->taps = taps;
+        nesl_audio_resampler_fill(table);
+        table->next = g_cache.table;
+        g_cache.table = table;
+    }
+
+    ++table->count;
+    resampler->coefficient = table->coefficient;
+    resampler->taps = table->taps;
+
+exit:
+    pthread_mutex_unlock(&g_cache.lock);
+
+    return result;
+}
+
+/*!
+ * @brief Release audio resampler coefficient table, freeing it when the last reference is released.
+ * @param[in] coefficient Constant pointer to filter coefficients (can be NULL)
+ */
+static void nesl_audio_resampler_release(const nesl_audio_sample_t *coefficient)
+{
+    nesl_audio_resampler_table_t **table;
+
+    pthread_mutex_lock(&g_cache.lock);
+
+    for(table = &g_cache.table; *table; table = &(*table)->next) {
+
+        if((*table)->coefficient == coefficient) {
+
+            if(!--(*table)->count) {
+                nesl_audio_resampler_table_t *next = (*table)->next;
+
+                free((*table)->coefficient);
+                free(*table);
+                *table = next;
+            }
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&g_cache.lock);
+}
+
+nesl_error_e nesl_audio_resampler_initialize(nesl_audio_resampler_t *resampler, uint32_t input, uint32_t output)
+{
+    nesl_error_e result = NESL_SUCCESS;
+
+    if(!output || (output >= (input / 2))) {
+        result = SET_ERROR("Unsupported sample rate -- %u Hz", output);
+        goto exit;
+    }
+
+    resampler->input = input;
+    resampler->output = output;
+
+    if((result = nesl_audio_resampler_acquire(resampler)) == NESL_FAILURE) {
+        goto exit;
+    }
+
+    if(!(resampler->history = calloc(2 * resampler->taps, sizeof(*resampler->history)))) {
+        result = SET_ERROR("Failed to allocate buffer -- %.02f KB (%i bytes)", (2 * resampler->taps * sizeof(*resampler->history)) / 1024.f,
+            2 * resampler->taps * sizeof(*resampler->history));
+        goto exit;
+    }
+
+    if((result = nesl_audio_resampler_reset(resampler)) == NESL_FAILURE) {
+        goto exit;
+    }
+
+exit:
+    return result;
+}
+
+nesl_error_e nesl_audio_resampler_reset(nesl_audio_resampler_t *resampler)
+{
+    memset(resampler->history, 0, 2 * resampler->taps * sizeof(*resampler->history));
+    resampler->accumulator = 0;
+    resampler->index = 0;
+
+    return NESL_SUCCESS;
+}
+
+void nesl_audio_resampler_uninitialize(nesl_audio_resampler_t *resampler)
+{
+
+    if(resampler->history) {
+        free(resampler->history);
+        resampler->history = NULL;
+    }
+
+    if(resampler->coefficient) {
+        nesl_audio_resampler_release(resampler->coefficient);
+        resampler->coefficient = NULL;
+    }
+
+    memset(resampler, 0, sizeof(*resampler));
+}
+
+bool nesl_audio_resampler_write(nesl_audio_resampler_t *resampler, nesl_audio_sample_t input, nesl_audio_sample_t *output)
+{
+    bool result = false;
+
+    resampler->history[resampler->index] = input;
+    resampler->history[resampler->index + resampler->taps] = input;
+
+    if(++resampler->index == resampler->taps) {
+        resampler->index = 0;
+    }
+
+    if((resampler->accumulator += resampler->output) >= resampler->input) {
+        int phase;
+#ifdef NESL_AUDIO_S16
+        int32_t sample;
+#else
+        float sample;
+#endif /* NESL_AUDIO_S16 */
+
+        resampler->accumulator -= resampler->input;
+        phase = ((uint64_t)resampler->accumulator * AUDIO_RESAMPLER_PHASES) / resampler->output;
+        sample = nesl_audio_resampler_dot(&resampler->history[resampler->index],
+            &resampler->coefficient[phase * resampler->taps], resampler->taps);
+#ifdef NESL_AUDIO_S16
+        sample = (sample + (1 << (AUDIO_RESAMPLER_SHIFT - 1))) >> AUDIO_RESAMPLER_SHIFT;
+        *output = (sample >= INT16_MAX) ? INT16_MAX : ((sample <= INT16_MIN) ? INT16_MIN : sample);
+#else
+        *output = sample;
+#endif /* NESL_AUDIO_S16 */
+        result = true;
+    }
+
+    return result;
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
@@ -0,0 +1,291 @@
+/*
+ * NESL
+ * Copyright (C) 2022 David Jolly
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+ * @file audio_sink.c
+ * @brief Audio file sink (WAV/raw PCM), written from a background thread.
+ */
+
+#include <audio_sink.h>
+
+/*!
+ * @struct nesl_audio_sink_header_t
+ * @brief WAV file header (little-endian).
+ */
+typedef struct {
+    char riff[4];                   /*!< RIFF chunk identifier */
+    uint32_t riff_length;           /*!< RIFF chunk length in bytes */
+    char wave[4];                   /*!< WAVE format identifier */
+    char fmt[4];                    /*!< Format chunk identifier */
+    uint32_t fmt_length;            /*!< Format chunk length in bytes */
+    uint16_t format;                /*!< Sample format (1:integer PCM, 3:float PCM) */
+    uint16_t channels;              /*!< Channel count */
+    uint32_t rate;                  /*!< Sample rate (Hz) */
+    uint32_t byte_rate;             /*!< Byte rate (bytes/second) */
+    uint16_t block_align;           /*!< Bytes per sample frame */
+    uint16_t bits;                  /*!< Bits per sample */
+    char data[4];                   /*!< Data chunk identifier */
+    uint32_t data_length;           /*!< Data chunk length in bytes */
+} nesl_audio_sink_header_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*!
+ * @brief Queue front batch for the writer thread, waiting for the previous batch to be written.
+ * @param[in,out] sink Pointer to audio sink context
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_audio_sink_flush(nesl_audio_sink_t *sink)
+{
+    nesl_audio_sample_t *data;
+    nesl_error_e result = NESL_SUCCESS;
+
+    pthread_mutex_lock(&sink->lock);
+
+    while(sink->pending) {
+        pthread_cond_wait(&sink->signal, &sink->lock);
+    }
+
+    if(sink->error) {
+        result = SET_ERROR("Failed to write audio sink -- %i: %s", sink->error, strerror(sink->error));
+    } else {
+        data = sink->batch[1].data;
+        sink->batch[1] = sink->batch[0];
+        sink->batch[0].data = data;
+        sink->batch[0].count = 0;
+        sink->pending = true;
+        pthread_cond_broadcast(&sink->signal);
+    }
+
+    pthread_mutex_unlock(&sink->lock);
+
+    return result;
+}
+
+/*!
+ * @brief Write WAV header, reflecting the number of bytes written so far.
+ * @param[in,out] sink Pointer to audio sink context
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_audio_sink_header(nesl_audio_sink_t *sink)
+{
+    nesl_error_e result = NESL_SUCCESS;
+    nesl_audio_sink_header_t header = {
+        .riff = { 'R', 'I', 'F', 'F', },
+        .riff_length = sizeof(header) - 8 + sink->length,
+        .wave = { 'W', 'A', 'V', 'E', },
+        .fmt = { 'f', 'm', 't', ' ', },
+        .fmt_length = 16,
+#ifdef NESL_AUDIO_S16
+        .format = 1,
+#else
+        .format = 3,
+#endif /* NESL_AUDIO_S16 */
+        .channels = 1,
+        .rate = sink->rate,
+        .byte_rate = sink->rate * sizeof(nesl_audio_sample_t),
+        .block_align = sizeof(nesl_audio_sample_t),
+        .bits = sizeof(nesl_audio_sample_t) * 8,
+        .data = { 'd', 'a', 't', 'a', },
+        .data_length = sink->length,
+        };
+
+    if(fseek(sink->file, 0, SEEK_SET)
+            || (fwrite(&header, sizeof(header), 1, sink->file) != 1)) {
+        result = SET_ERROR("Failed to write audio sink header -- %i: %s", errno, strerror(errno));
+        goto exit;
+    }
+
+exit:
+    return result;
+}
+
+/*!
+ * @brief Audio sink writer thread, writing queued batches to file until stopped.
+ * @param[in,out] context Pointer to audio sink context
+ * @return NULL
+ */
+static void *nesl_audio_sink_run(void *context)
+{
+    nesl_audio_sink_t *sink = context;
+
+    pthread_mutex_lock(&sink->lock);
+
+    for(;;) {
+        int count, error = 0;
+
+        while(sink->running && !sink->pending) {
+            pthread_cond_wait(&sink->signal, &sink->lock);
+        }
+
+        if(!sink->pending) {
+            break;
+        }
+
+        pthread_mutex_unlock(&sink->lock);
+        errno = 0;
+
+        if(((count = fwrite(sink->batch[1].data, sizeof(*sink->batch[1].data), sink->batch[1].count, sink->file)) != sink->batch[1].count)
+                || fflush(sink->file)) {
+            error = errno ? errno : EIO;
+        }
+
+        pthread_mutex_lock(&sink->lock);
+
+        if(error && !sink->error) {
+            sink->error = error;
+        }
+
+        sink->length += count * sizeof(*sink->batch[1].data);
+        sink->batch[1].count = 0;
+        sink->pending = false;
+        pthread_cond_broadcast(&sink->signal);
+    }
+
+    pthread_mutex_unlock(&sink->lock);
+
+    return NULL;
+}
+
+nesl_error_e nesl_audio_sink_initialize(nesl_audio_sink_t *sink, const char *path, int rate)
+{
+    const char *extension;
+    nesl_error_e result = NESL_SUCCESS;
+
+    if(pthread_mutex_init(&sink->lock, NULL) || pthread_cond_init(&sink->signal, NULL)) {
+        result = SET_ERROR("Failed to initialize lock -- %i: %s", errno, strerror(errno));
+        goto exit;
+    }
+
+    sink->rate = rate;
+    sink->type = ((extension = strrchr(path, '.')) && (!strcmp(extension, ".wav") || !strcmp(extension, ".WAV")))
+        ? AUDIO_SINK_WAV : AUDIO_SINK_RAW;
+
+    for(int index = 0; index < 2; ++index) {
+
+        if(!(sink->batch[index].data = calloc(AUDIO_SINK_SAMPLES, sizeof(*sink->batch[index].data)))) {
+            result = SET_ERROR("Failed to allocate buffer -- %.02f KB (%i bytes)", (AUDIO_SINK_SAMPLES * sizeof(*sink->batch[index].data)) / 1024.f,
+                AUDIO_SINK_SAMPLES * sizeof(*sink->batch[index].data));
+            goto exit;
+        }
+    }
+
+    if(!(sink->file = fopen(path, "wb"))) {
+        result = SET_ERROR("Failed to open file -- %s", path);
+        goto exit;
+    }
+
+    if((sink->type == AUDIO_SINK_WAV) && ((result = nesl_audio_sink_header(sink)) == NESL_FAILURE)) {
+        goto exit;
+    }
+
+    sink->running = true;
+
+    if(pthread_create(&sink->thread, NULL, nesl_audio_sink_run, sink)) {
+        sink->running = false;
+        result = SET_ERROR("Failed to create thread -- %i: %s", errno, strerror(errno));
+        goto exit;
+    }
+
+exit:
+    return result;
+}
+
+nesl_error_e nesl_audio_sink_uninitialize(nesl_audio_sink_t *sink)
+{
+    nesl_error_e result = NESL_SUCCESS;
+
+    if(sink->running) {
+
+        if(sink->batch[0].count) {
+            result = nesl_audio_sink_flush(sink);
+        }
+
+        pthread_mutex_lock(&sink->lock);
+        sink->running = false;
+        pthread_cond_broadcast(&sink->signal);
+        pthread_mutex_unlock(&sink->lock);
+        pthread_join(sink->thread, NULL);
+
+        if((result == NESL_SUCCESS) && sink->error) {
+            result = SET_ERROR("Failed to write audio sink -- %i: %s", sink->error, strerror(sink->error));
+        }
+    }
+
+    if(sink->file) {
+
+        if((sink->type == AUDIO_SINK_WAV) && (nesl_audio_sink_header(sink) == NESL_FAILURE)) {
+            result = NESL_FAILURE;
+        }
+
+        if(fclose(sink->file) && (result == NESL_SUCCESS)) {
+            result = SET_ERROR("Failed to close audio sink -- %i: %s", errno, strerror(errno));
+        }
+
+        sink->file = NULL;
+    }
+
+    for(int index = 0; index < 2; ++index) {
+
+        if(sink->batch[index].data) {
+            free(sink->batch[index].data);
+            sink->batch[index].data = NULL;
+        }
+    }
+
+    pthread_cond_destroy(&sink->signal);
+    pthread_mutex_destroy(&sink->lock);
+    memset(sink, 0, sizeof(*sink));
+
+    return result;
+}
+
+nesl_error_e nesl_audio_sink_write(nesl_audio_sink_t *sink, const nesl_audio_sample_t *data, int count)
+{
+    nesl_error_e result = NESL_SUCCESS;
+
+    while(count > 0) {
+        int length = AUDIO_SINK_SAMPLES - sink->batch[0].count;
+
+        if(length > count) {
+            length = count;
+        }
+
+        memcpy(&sink->batch[0].data[sink->batch[0].count], data, length * sizeof(*data));
+        sink->batch[0].count += length;
+        count -= length;
+        data += length;
+
+        if((sink->batch[0].count == AUDIO_SINK_SAMPLES)
+                && ((result = nesl_audio_sink_flush(sink)) == NESL_FAILURE)) {
+            goto exit;
+        }
+    }
+
+exit:
+    return result;
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
@@ -26,81 +26,200 @@
 
 #include <audio_square.h>
 
+/*!
+ * @brief Duty-cycle sequences, indexed by duty-cycle and step.
+ */
+static const uint8_t DUTY[4][8] = {
+    { 0, 1, 0, 0, 0, 0, 0, 0, },    /*!< 12.5% */
+    { 0, 1, 1, 0, 0, 0, 0, 0, },    /*!< 25% */
+    { 0, 1, 1, 1, 1, 0, 0, 0, },    /*!< 50% */
+    { 1, 0, 0, 1, 1, 1, 1, 1, },    /*!< 25% (negated) */
+    };
+
+/*!
+ * @brief Length counter values, indexed by length register.
+ */
+static const uint8_t LENGTH[32] = {
+    10, 254, 20, 2, 40, 4, 80, 6, 160, 8, 60, 10, 14, 12, 26, 14,
+    12, 16, 24, 18, 48, 20, 96, 22, 192, 24, 72, 26, 16, 28, 32, 30,
+    };
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
 
-void nesl_audio_square_cycle(nesl_audio_square_t *square, float elapsed)
+/*!
+ * @brief Get audio square-wave synthesizer timer period.
+ * @param[in] square Constant pointer to audio square-wave synthesizer context
+ * @return Timer period
+ */
+static uint16_t nesl_audio_square_get_period(const nesl_audio_square_t *square)
 {
-    /* TODO: CYCLE SYNTHESIZER */
+    return (square->state.length.period_high << 8) | square->state.period_low;
 }
 
-nesl_error_e nesl_audio_square_initialize(nesl_audio_square_t *square)
+/*!
+ * @brief Get audio square-wave synthesizer sweep target period.
+ * @param[in] square Constant pointer to audio square-wave synthesizer context
+ * @return Sweep target period
+ */
+static uint16_t nesl_audio_square_get_target(const nesl_audio_square_t *square)
 {
-    int result;
+    uint16_t period = nesl_audio_square_get_period(square), change = period >> square->state.sweep.shift;
 
-    if((result = nesl_audio_buffer_initialize(&square->buffer, 256)) == NESL_FAILURE) {
-        goto exit;
+    if(square->state.sweep.negative) {
+        change += !square->channel;
+        period = (change > period) ? 0 : (period - change);
+    } else {
+        period += change;
     }
 
-exit:
-    return result;
+    return period;
 }
 
-int nesl_audio_square_read(nesl_audio_square_t *square, float *data, int length)
+/*!
+ * @brief Determine if audio square-wave synthesizer is muted by the sweep unit.
+ * @param[in] square Constant pointer to audio square-wave synthesizer context
+ * @return true if muted, false otherwise
+ */
+static bool nesl_audio_square_is_muted(const nesl_audio_square_t *square)
 {
-    return nesl_audio_buffer_read(&square->buffer, data, length);
+    return (nesl_audio_square_get_period(square) < 8) || (nesl_audio_square_get_target(square) > 0x07FF);
 }
 
-int nesl_audio_square_readable(nesl_audio_square_t *square)
+/*!
+ * @brief Clock audio square-wave synthesizer envelope unit.
+ * @param[in,out] square Pointer to audio square-wave synthesizer context
+ */
+static void nesl_audio_square_envelope(nesl_audio_square_t *square)
 {
-    return nesl_audio_buffer_readable(&square->buffer);
+
+    if(square->envelope.start) {
+        square->envelope.start = false;
+        square->envelope.decay = 15;
+        square->envelope.divider = square->state.envelope.volume;
+    } else if(!square->envelope.divider) {
+        square->envelope.divider = square->state.envelope.volume;
+
+        if(square->envelope.decay) {
+            --square->envelope.decay;
+        } else if(square->state.envelope.loop) {
+            square->envelope.decay = 15;
+        }
+    } else {
+        --square->envelope.divider;
+    }
 }
 
-nesl_error_e nesl_audio_square_reset(nesl_audio_square_t *square)
+/*!
+ * @brief Clock audio square-wave synthesizer sweep unit.
+ * @param[in,out] square Pointer to audio square-wave synthesizer context
+ */
+static void nesl_audio_square_sweep(nesl_audio_square_t *square)
+{
+
+    if(!square->sweep.divider && square->state.sweep.enable && square->state.sweep.shift && !nesl_audio_square_is_muted(square)) {
+        uint16_t period = nesl_audio_square_get_target(square);
+
+        square->state.period_low = period;
+        square->state.length.period_high = period >> 8;
+    }
+
+    if(!square->sweep.divider || square->sweep.reload) {
+        square->sweep.divider = square->state.sweep.period;
+        square->sweep.reload = false;
+    } else {
+        --square->sweep.divider;
+    }
+}
+
+void nesl_audio_square_cycle(nesl_audio_square_t *square)
+{
+
+    if(!square->timer.count) {
+        square->timer.count = nesl_audio_square_get_period(square);
+        square->timer.step = (square->timer.step + 1) & 7;
+    } else {
+        --square->timer.count;
+    }
+}
+
+void nesl_audio_square_frame(nesl_audio_square_t *square, bool half)
 {
-    int result;
+    nesl_audio_square_envelope(square);
 
-    if((result = nesl_audio_buffer_reset(&square->buffer)) == NESL_FAILURE) {
-        goto exit;
+    if(half) {
+
+        if(!square->state.envelope.loop && square->length) {
+            --square->length;
+        }
+
+        nesl_audio_square_sweep(square);
     }
+}
 
-    memset(&square->state, 0, sizeof(square->state));
+uint8_t nesl_audio_square_get_length(const nesl_audio_square_t *square)
+{
+    return square->length;
+}
+
+uint8_t nesl_audio_square_get_output(const nesl_audio_square_t *square)
+{
+    uint8_t result = 0;
+
+    if(square->length && DUTY[square->state.envelope.duty][square->timer.step] && !nesl_audio_square_is_muted(square)) {
+        result = square->state.envelope.volume_const ? square->state.envelope.volume : square->envelope.decay;
+    }
 
-exit:
     return result;
 }
 
-void nesl_audio_square_uninitialize(nesl_audio_square_t *square)
+nesl_error_e nesl_audio_square_initialize(nesl_audio_square_t *square, uint8_t channel)
 {
-    nesl_audio_buffer_uninitialize(&square->buffer);
-    memset(square, 0, sizeof(*square));
+    square->channel = channel;
+
+    return nesl_audio_square_reset(square);
 }
 
-void nesl_audio_square_write(nesl_audio_square_t *square, uint16_t address, uint8_t data)
+nesl_error_e nesl_audio_square_reset(nesl_audio_square_t *square)
 {
-    square->state.byte[address - 0x4000] = data;
+    uint8_t channel = square->channel;
 
-    switch(address) {
-        case 0x4000:
+    memset(square, 0, sizeof(*square));
+    square->channel = channel;
 
-            /* TODO: PERFORM ANY NEEDED STATE-CHANGE OPERATIONS */
+    return NESL_SUCCESS;
+}
 
-            break;
-        case 0x4001:
+void nesl_audio_square_set_enable(nesl_audio_square_t *square, bool enable)
+{
 
-            /* TODO: PERFORM ANY NEEDED STATE-CHANGE OPERATIONS */
+    if(!(square->enable = enable)) {
+        square->length = 0;
+    }
+}
 
-            break;
-        case 0x4002:
+void nesl_audio_square_uninitialize(nesl_audio_square_t *square)
+{
+    memset(square, 0, sizeof(*square));
+}
 
-            /* TODO: PERFORM ANY NEEDED STATE-CHANGE OPERATIONS */
+void nesl_audio_square_write(nesl_audio_square_t *square, uint16_t address, uint8_t data)
+{
+    square->state.byte[address - 0x4000] = data;
 
+    switch(address) {
+        case 0x4001:
+            square->sweep.reload = true;
             break;
         case 0x4003:
 
-            /* TODO: PERFORM ANY NEEDED STATE-CHANGE OPERATIONS */
+            if(square->enable) {
+                square->length = LENGTH[square->state.length.counter];
+            }
 
+            square->envelope.start = true;
+            square->timer.step = 0;
             break;
         default:
             break;
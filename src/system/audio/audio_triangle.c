@@ -26,54 +26,100 @@
 
 #include <audio_triangle.h>
 
+/*!
+ * @brief Length counter values, indexed by length register.
+ */
+static const uint8_t LENGTH[32] = {
+    10, 254, 20, 2, 40, 4, 80, 6, 160, 8, 60, 10, 14, 12, 26, 14,
+    12, 16, 24, 18, 48, 20, 96, 22, 192, 24, 72, 26, 16, 28, 32, 30,
+    };
+
+/*!
+ * @brief Triangle-wave sequence, indexed by step.
+ */
+static const uint8_t SEQUENCE[32] = {
+    15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+    };
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
 
-void nesl_audio_triangle_cycle(nesl_audio_triangle_t *triangle, float elapsed)
+/*!
+ * @brief Get audio triangle-wave synthesizer timer period.
+ * @param[in] triangle Constant pointer to audio triangle-wave synthesizer context
+ * @return Timer period
+ */
+static uint16_t nesl_audio_triangle_get_period(const nesl_audio_triangle_t *triangle)
 {
-    /* TODO: CYCLE SYNTHESIZER */
+    return (triangle->state.length.period_high << 8) | triangle->state.period_low;
 }
 
-nesl_error_e nesl_audio_triangle_initialize(nesl_audio_triangle_t *triangle)
+void nesl_audio_triangle_cycle(nesl_audio_triangle_t *triangle)
 {
-    int result;
 
-    if((result = nesl_audio_buffer_initialize(&triangle->buffer, 256)) == NESL_FAILURE) {
-        goto exit;
+    if(!triangle->timer.count) {
+        triangle->timer.count = nesl_audio_triangle_get_period(triangle);
+
+        if(triangle->length && triangle->linear.counter && (triangle->timer.count > 1)) {
+            triangle->timer.step = (triangle->timer.step + 1) & 31;
+        }
+    } else {
+        --triangle->timer.count;
+    }
+}
+
+void nesl_audio_triangle_frame(nesl_audio_triangle_t *triangle, bool half)
+{
+
+    if(triangle->linear.reload) {
+        triangle->linear.counter = triangle->state.control.counter;
+    } else if(triangle->linear.counter) {
+        --triangle->linear.counter;
+    }
+
+    if(!triangle->state.control.control) {
+        triangle->linear.reload = false;
+    }
+
+    if(half && !triangle->state.control.control && triangle->length) {
+        --triangle->length;
     }
+}
 
-exit:
-    return result;
+uint8_t nesl_audio_triangle_get_length(const nesl_audio_triangle_t *triangle)
+{
+    return triangle->length;
 }
 
-int nesl_audio_triangle_read(nesl_audio_triangle_t *triangle, float *data, int length)
+uint8_t nesl_audio_triangle_get_output(const nesl_audio_triangle_t *triangle)
 {
-    return nesl_audio_buffer_read(&triangle->buffer, data, length);
+    return SEQUENCE[triangle->timer.step];
 }
 
-int nesl_audio_triangle_readable(nesl_audio_triangle_t *triangle)
+nesl_error_e nesl_audio_triangle_initialize(nesl_audio_triangle_t *triangle)
 {
-    return nesl_audio_buffer_readable(&triangle->buffer);
+    return nesl_audio_triangle_reset(triangle);
 }
 
 nesl_error_e nesl_audio_triangle_reset(nesl_audio_triangle_t *triangle)
 {
-    int result;
+    memset(triangle, 0, sizeof(*triangle));
 
-    if((result = nesl_audio_buffer_reset(&triangle->buffer)) == NESL_FAILURE) {
-        goto exit;
-    }
+    return NESL_SUCCESS;
+}
 
-    memset(&triangle->state, 0, sizeof(triangle->state));
+void nesl_audio_triangle_set_enable(nesl_audio_triangle_t *triangle, bool enable)
+{
 
-exit:
-    return result;
+    if(!(triangle->enable = enable)) {
+        triangle->length = 0;
+    }
 }
 
 void nesl_audio_triangle_uninitialize(nesl_audio_triangle_t *triangle)
 {
-    nesl_audio_buffer_uninitialize(&triangle->buffer);
     memset(triangle, 0, sizeof(*triangle));
 }
 
@@ -82,25 +128,13 @@ void nesl_audio_triangle_write(nesl_audio_triangle_t *triangle, uint16_t address
     triangle->state.byte[address - 0x4008] = data;
 
     switch(address) {
-        case 0x4008:
-
-            /* TODO: PERFORM ANY NEEDED STATE-CHANGE OPERATIONS */
-
-            break;
-        case 0x4009:
-
-            /* TODO: PERFORM ANY NEEDED STATE-CHANGE OPERATIONS */
-
-            break;
-        case 0x400A:
-
-            /* TODO: PERFORM ANY NEEDED STATE-CHANGE OPERATIONS */
-
-            break;
         case 0x400B:
 
-            /* TODO: PERFORM ANY NEEDED STATE-CHANGE OPERATIONS */
+            if(triangle->enable) {
+                triangle->length = LENGTH[triangle->state.length.counter];
+            }
 
+            triangle->linear.reload = true;
             break;
         default:
             break;
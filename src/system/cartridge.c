@@ -24,12 +24,93 @@
  * @brief Cartridge subsystem.
  */
 
+#define _GNU_SOURCE
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <cartridge.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
 
+/*!
+ * @brief Get cartridge character RAM bank count.
+ * @param[in] header Constant pointer to cartridge header
+ * @return Character RAM bank count (0 if character ROM is present)
+ */
+static int nesl_cartridge_get_character_ram(const nesl_cartridge_header_t *header)
+{
+    int result = 0;
+
+    if(!header->rom.character) {
+        result = (((header->flag_7.type_high << 4) | header->flag_6.type_low) == MAPPER_30) ? 4 : 1;
+    }
+
+    return result;
+}
+
+/*!
+ * @brief Get cartridge program RAM bank count.
+ * @param[in] header Constant pointer to cartridge header
+ * @return Program RAM bank count
+ */
+static int nesl_cartridge_get_program_ram(const nesl_cartridge_header_t *header)
+{
+    return header->ram.program ? header->ram.program : 1;
+}
+
+/*!
+ * @brief Map cartridge program RAM from battery save file, extending the file with zeros if it is shorter than the program RAM.
+ *        On failure, the failure is recorded in the battery context and the program RAM is left unmapped, to be allocated without
+ *        persistence.
+ * @param[in,out] cartridge Pointer to cartridge subsystem context
+ * @param[in] save Constant pointer to battery save path string
+ * @return true if the program RAM was mapped, false otherwise
+ */
+static bool nesl_cartridge_map_program_ram(nesl_cartridge_t *cartridge, const char *save)
+{
+    int file = -1;
+    bool result = false;
+    struct stat status = {};
+    void *data = MAP_FAILED;
+    size_t length = nesl_cartridge_get_program_ram(cartridge->header) * 8 * 1024;
+
+    if((file = open(save, O_RDWR | O_CREAT, 0644)) == -1) {
+        cartridge->battery.failure = "open";
+        goto exit;
+    }
+
+    if((fstat(file, &status) == -1) || ((status.st_size < length) && (ftruncate(file, length) == -1))) {
+        cartridge->battery.failure = "resize";
+        goto exit;
+    }
+
+    if((data = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0)) == MAP_FAILED) {
+        cartridge->battery.failure = "map";
+        goto exit;
+    }
+
+    cartridge->ram.program = data;
+    cartridge->battery.length = length;
+    result = true;
+
+exit:
+
+    if(cartridge->battery.failure) {
+        cartridge->battery.error = errno;
+    }
+
+    if(file != -1) {
+        close(file);
+        file = -1;
+    }
+
+    return result;
+}
+
 /*!
  * @brief Validate cartridge length/data.
  * @param[in] data Pointer to data array
@@ -82,6 +163,29 @@ exit:
     return result;
 }
 
+size_t nesl_cartridge_capture(nesl_cartridge_t *cartridge, void *data)
+{
+    size_t result = 0;
+    uint8_t *offset = data;
+
+    if(cartridge->ram.character) {
+        result += nesl_dirty_copy(cartridge->dirty.character, offset, cartridge->ram.character, cartridge->mask.character + 1);
+    }
+
+    result += nesl_dirty_copy(cartridge->dirty.program, &offset[result], cartridge->ram.program,
+        nesl_cartridge_get_program_ram(cartridge->header) * 8 * 1024);
+
+    return result;
+}
+
+void nesl_cartridge_flush(nesl_cartridge_t *cartridge)
+{
+
+    if(cartridge->battery.length) {
+        msync(cartridge->ram.program, cartridge->battery.length, MS_ASYNC);
+    }
+}
+
 uint8_t nesl_cartridge_get_banks(nesl_cartridge_t *cartridge, nesl_bank_e type)
 {
     uint8_t result = 0;
@@ -103,6 +207,18 @@ uint8_t nesl_cartridge_get_banks(nesl_cartridge_t *cartridge, nesl_bank_e type)
     return result;
 }
 
+nesl_error_e nesl_cartridge_get_battery(const nesl_cartridge_t *cartridge)
+{
+    nesl_error_e result = NESL_SUCCESS;
+
+    if(cartridge->battery.failure) {
+        result = SET_ERROR("Failed to %s battery save, program RAM will not persist -- %i: %s", cartridge->battery.failure, cartridge->battery.error,
+            strerror(cartridge->battery.error));
+    }
+
+    return result;
+}
+
 nesl_mapper_e nesl_cartridge_get_mapper(nesl_cartridge_t *cartridge)
 {
     return (nesl_mapper_e)((cartridge->header->flag_7.type_high << 4) | cartridge->header->flag_6.type_low);
@@ -113,7 +229,21 @@ nesl_mirror_e nesl_cartridge_get_mirror(nesl_cartridge_t *cartridge)
     return (nesl_mirror_e)cartridge->header->flag_6.mirror;
 }
 
-nesl_error_e nesl_cartridge_initialize(nesl_cartridge_t *cartridge, const void *data, int length)
+size_t nesl_cartridge_get_size(const void *data, int length)
+{
+    size_t result = 0;
+    const nesl_cartridge_header_t *header = (const nesl_cartridge_header_t *)data;
+
+    if(data && (length >= sizeof(*header))) {
+        result = ARENA_SIZE(nesl_cartridge_get_character_ram(header) * 8 * 1024) + ARENA_SIZE(nesl_cartridge_get_program_ram(header) * 8 * 1024)
+            + ARENA_SIZE(DIRTY_WORDS(nesl_cartridge_get_character_ram(header) * 8 * 1024) * sizeof(uint64_t))
+            + ARENA_SIZE(DIRTY_WORDS(nesl_cartridge_get_program_ram(header) * 8 * 1024) * sizeof(uint64_t));
+    }
+
+    return result;
+}
+
+nesl_error_e nesl_cartridge_initialize(nesl_cartridge_t *cartridge, nesl_arena_t *arena, const void *data, int length, const char *save)
 {
     nesl_error_e result;
     const uint8_t *offset = data;
@@ -136,29 +266,65 @@ nesl_error_e nesl_cartridge_initialize(nesl_cartridge_t *cartridge, const void *
 
     if(cartridge->header->rom.character) {
         cartridge->rom.character = offset;
+        cartridge->mask.character = UINT32_MAX;
         offset += (cartridge->header->rom.character * 8 * 1024 );
     } else {
+        int banks = nesl_cartridge_get_character_ram(cartridge->header);
 
-        if(!(cartridge->ram.character = calloc(32 * 8 * 1024, sizeof(uint8_t)))) {
-            result = SET_ERROR("Failed to allocate buffer -- %u KB (%i bytes)", 8, 8 * 1024);
+        if(!(cartridge->ram.character = nesl_arena_allocate(arena, banks * 8 * 1024))) {
+            result = SET_ERROR("Failed to allocate buffer -- %u KB (%i bytes)", banks * 8, banks * 8 * 1024);
+            goto exit;
+        }
+
+        if(!(cartridge->dirty.character = nesl_arena_allocate(arena, DIRTY_WORDS(banks * 8 * 1024) * sizeof(uint64_t)))) {
+            result = SET_ERROR("Failed to allocate buffer -- %.02f KB (%i bytes)", DIRTY_WORDS(banks * 8 * 1024) * sizeof(uint64_t) / 1024.f,
+                (int)(DIRTY_WORDS(banks * 8 * 1024) * sizeof(uint64_t)));
             goto exit;
         }
 
         cartridge->rom.character = cartridge->ram.character;
+        cartridge->mask.character = (banks * 8 * 1024) - 1;
+        nesl_dirty_set(cartridge->dirty.character, banks * 8 * 1024);
     }
 
-    if(!(cartridge->ram.program = calloc((cartridge->header->ram.program ? cartridge->header->ram.program : 1) * 8 * 1024, sizeof(uint8_t)))) {
-        result = SET_ERROR("Failed to allocate buffer -- %u KB (%i bytes)", (cartridge->header->ram.program ? cartridge->header->ram.program : 1) * 8,
-            (cartridge->header->ram.program ? cartridge->header->ram.program : 1) * 8 * 1024);
+    if(!(save && cartridge->header->flag_6.ram && nesl_cartridge_map_program_ram(cartridge, save))
+            && !(cartridge->ram.program = nesl_arena_allocate(arena, nesl_cartridge_get_program_ram(cartridge->header) * 8 * 1024))) {
+        result = SET_ERROR("Failed to allocate buffer -- %u KB (%i bytes)", nesl_cartridge_get_program_ram(cartridge->header) * 8,
+            nesl_cartridge_get_program_ram(cartridge->header) * 8 * 1024);
         goto exit;
     }
 
-    memset(cartridge->ram.program, 0, (cartridge->header->ram.program ? cartridge->header->ram.program : 1) * 8 * 1024);
+    if(!(cartridge->dirty.program = nesl_arena_allocate(arena, DIRTY_WORDS(nesl_cartridge_get_program_ram(cartridge->header) * 8 * 1024) * sizeof(uint64_t)))) {
+        result = SET_ERROR("Failed to allocate buffer -- %.02f KB (%i bytes)",
+            DIRTY_WORDS(nesl_cartridge_get_program_ram(cartridge->header) * 8 * 1024) * sizeof(uint64_t) / 1024.f,
+            (int)(DIRTY_WORDS(nesl_cartridge_get_program_ram(cartridge->header) * 8 * 1024) * sizeof(uint64_t)));
+        goto exit;
+    }
+
+    nesl_dirty_set(cartridge->dirty.program, nesl_cartridge_get_program_ram(cartridge->header) * 8 * 1024);
 
 exit:
     return result;
 }
 
+size_t nesl_cartridge_load(nesl_cartridge_t *cartridge, const void *data)
+{
+    size_t result = 0;
+    const uint8_t *offset = data;
+
+    if(cartridge->ram.character) {
+        memcpy(cartridge->ram.character, offset, cartridge->mask.character + 1);
+        nesl_dirty_set(cartridge->dirty.character, cartridge->mask.character + 1);
+        result += cartridge->mask.character + 1;
+    }
+
+    memcpy(cartridge->ram.program, &offset[result], nesl_cartridge_get_program_ram(cartridge->header) * 8 * 1024);
+    nesl_dirty_set(cartridge->dirty.program, nesl_cartridge_get_program_ram(cartridge->header) * 8 * 1024);
+    result += nesl_cartridge_get_program_ram(cartridge->header) * 8 * 1024;
+
+    return result;
+}
+
 uint8_t nesl_cartridge_read_ram(nesl_cartridge_t *cartridge, nesl_bank_e type, uint32_t address)
 {
     uint8_t result = 0;
@@ -180,7 +346,7 @@ uint8_t nesl_cartridge_read_rom(nesl_cartridge_t *cartridge, nesl_bank_e type, u
 
     switch(type) {
         case BANK_CHARACTER_ROM:
-            result = cartridge->rom.character[address];
+            result = cartridge->rom.character[address & cartridge->mask.character];
             break;
         case BANK_PROGRAM_ROM:
             result = cartridge->rom.program[address];
@@ -192,17 +358,50 @@ uint8_t nesl_cartridge_read_rom(nesl_cartridge_t *cartridge, nesl_bank_e type, u
     return result;
 }
 
-void nesl_cartridge_uninitialize(nesl_cartridge_t *cartridge)
+size_t nesl_cartridge_restore(nesl_cartridge_t *cartridge, const void *data)
+{
+    size_t result = 0;
+    const uint8_t *offset = data;
+
+    if(cartridge->ram.character) {
+        result += nesl_dirty_copy(cartridge->dirty.character, cartridge->ram.character, offset, cartridge->mask.character + 1);
+    }
+
+    result += nesl_dirty_copy(cartridge->dirty.program, cartridge->ram.program, &offset[result],
+        nesl_cartridge_get_program_ram(cartridge->header) * 8 * 1024);
+
+    return result;
+}
+
+size_t nesl_cartridge_save(const nesl_cartridge_t *cartridge, void *data)
 {
+    size_t result = 0;
+    uint8_t *offset = data;
 
     if(cartridge->ram.character) {
-        free(cartridge->ram.character);
-        cartridge->ram.character = NULL;
+
+        if(offset) {
+            memcpy(offset, cartridge->ram.character, cartridge->mask.character + 1);
+        }
+
+        result += cartridge->mask.character + 1;
     }
 
-    if(cartridge->ram.program) {
-        free(cartridge->ram.program);
-        cartridge->ram.program = NULL;
+    if(offset) {
+        memcpy(&offset[result], cartridge->ram.program, nesl_cartridge_get_program_ram(cartridge->header) * 8 * 1024);
+    }
+
+    result += nesl_cartridge_get_program_ram(cartridge->header) * 8 * 1024;
+
+    return result;
+}
+
+void nesl_cartridge_uninitialize(nesl_cartridge_t *cartridge)
+{
+
+    if(cartridge->battery.length) {
+        msync(cartridge->ram.program, cartridge->battery.length, MS_SYNC);
+        munmap(cartridge->ram.program, cartridge->battery.length);
     }
 
     memset(cartridge, 0, sizeof(*cartridge));
@@ -213,10 +412,12 @@ void nesl_cartridge_write_ram(nesl_cartridge_t *cartridge, nesl_bank_e type, uin
 
     switch(type) {
         case BANK_CHARACTER_RAM:
-            cartridge->ram.character[address] = data;
+            cartridge->ram.character[address & cartridge->mask.character] = data;
+            DIRTY_SET(cartridge->dirty.character, address & cartridge->mask.character);
             break;
         case BANK_PROGRAM_RAM:
             cartridge->ram.program[address] = data;
+            DIRTY_SET(cartridge->dirty.program, address);
             break;
         default:
             break;
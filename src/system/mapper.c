@@ -38,7 +38,8 @@
  */
 typedef struct {
     nesl_mapper_e type;                                                     /*!< Mapper type */
-    nesl_error_e (*initialize)(nesl_mapper_t *mapper);                      /*!< Mapper extension initialization */
+    size_t size;                                                            /*!< Mapper extension context size in bytes */
+    nesl_error_e (*initialize)(nesl_mapper_t *mapper, nesl_arena_t *arena); /*!< Mapper extension initialization */
     void (*uninitialize)(nesl_mapper_t *mapper);                            /*!< Mapper extension uninitialization */
 } nesl_mapper_extension_t;
 
@@ -47,13 +48,13 @@ typedef struct {
  * @note If a new mapper extension is added, it must be added into this array
  */
 static const nesl_mapper_extension_t CONTEXT[] = {
-    { MAPPER_0, nesl_mapper_0_initialize, nesl_mapper_0_uninitialize, },    /*!< Mapper 0 (NROM) */
-    { MAPPER_1, nesl_mapper_1_initialize, nesl_mapper_1_uninitialize, },    /*!< Mapper 1 (MMC1) */
-    { MAPPER_2, nesl_mapper_2_initialize, nesl_mapper_2_uninitialize, },    /*!< Mapper 2 (UxROM) */
-    { MAPPER_3, nesl_mapper_3_initialize, nesl_mapper_3_uninitialize, },    /*!< Mapper 3 (CNROM) */
-    { MAPPER_4, nesl_mapper_4_initialize, nesl_mapper_4_uninitialize, },    /*!< Mapper 4 (MMC3) */
-    { MAPPER_30, nesl_mapper_30_initialize, nesl_mapper_30_uninitialize, }, /*!< Mapper 30 (UNROM) */
-    { MAPPER_66, nesl_mapper_66_initialize, nesl_mapper_66_uninitialize, }, /*!< Mapper 66 (GxROM) */
+    { MAPPER_0, 0, nesl_mapper_0_initialize, nesl_mapper_0_uninitialize, },                               /*!< Mapper 0 (NROM) */
+    { MAPPER_1, sizeof(nesl_mapper_1_t), nesl_mapper_1_initialize, nesl_mapper_1_uninitialize, },         /*!< Mapper 1 (MMC1) */
+    { MAPPER_2, sizeof(nesl_mapper_2_t), nesl_mapper_2_initialize, nesl_mapper_2_uninitialize, },         /*!< Mapper 2 (UxROM) */
+    { MAPPER_3, sizeof(nesl_mapper_3_t), nesl_mapper_3_initialize, nesl_mapper_3_uninitialize, },         /*!< Mapper 3 (CNROM) */
+    { MAPPER_4, sizeof(nesl_mapper_4_t), nesl_mapper_4_initialize, nesl_mapper_4_uninitialize, },         /*!< Mapper 4 (MMC3) */
+    { MAPPER_30, sizeof(nesl_mapper_30_t), nesl_mapper_30_initialize, nesl_mapper_30_uninitialize, },     /*!< Mapper 30 (UNROM) */
+    { MAPPER_66, sizeof(nesl_mapper_66_t), nesl_mapper_66_initialize, nesl_mapper_66_uninitialize, },     /*!< Mapper 66 (GxROM) */
     };
 
 #ifdef __cplusplus
@@ -63,9 +64,10 @@ extern "C" {
 /*!
  * @brief Initialize mapper extension.
  * @param[in,out] mapper Pointer to mapper subsystem context
+ * @param[in,out] arena Pointer to arena context
  * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
  */
-static nesl_error_e nesl_mapper_extension_initialize(nesl_mapper_t *mapper)
+static nesl_error_e nesl_mapper_extension_initialize(nesl_mapper_t *mapper, nesl_arena_t *arena)
 {
     nesl_error_e result = NESL_FAILURE;
     const nesl_mapper_extension_t *extension = NULL;
@@ -76,7 +78,7 @@ static nesl_error_e nesl_mapper_extension_initialize(nesl_mapper_t *mapper)
 
         if(extension->type == mapper->type) {
 
-            if((result = extension->initialize(mapper)) == NESL_FAILURE) {
+            if((result = extension->initialize(mapper, arena)) == NESL_FAILURE) {
                 goto exit;
             }
             break;
@@ -109,18 +111,65 @@ static void nesl_mapper_extension_uninitialize(nesl_mapper_t *mapper)
     }
 }
 
-nesl_error_e nesl_mapper_initialize(nesl_mapper_t *mapper, const void *data, int length)
+size_t nesl_mapper_capture(nesl_mapper_t *mapper, void *data)
+{
+    size_t result = 0;
+    uint8_t *offset = data;
+
+    memcpy(&offset[result], &mapper->mirror, sizeof(mapper->mirror));
+    result += sizeof(mapper->mirror);
+    memcpy(&offset[result], &mapper->ram, sizeof(mapper->ram));
+    result += sizeof(mapper->ram);
+    memcpy(&offset[result], &mapper->rom, sizeof(mapper->rom));
+    result += sizeof(mapper->rom);
+    result += mapper->extension.save(mapper, &offset[result]);
+    result += nesl_cartridge_capture(&mapper->cartridge, &offset[result]);
+
+    return result;
+}
+
+void nesl_mapper_flush(nesl_mapper_t *mapper)
+{
+    nesl_cartridge_flush(&mapper->cartridge);
+}
+
+nesl_error_e nesl_mapper_get_battery(const nesl_mapper_t *mapper)
+{
+    return nesl_cartridge_get_battery(&mapper->cartridge);
+}
+
+size_t nesl_mapper_get_size(const void *data, int length)
+{
+    size_t result = nesl_cartridge_get_size(data, length);
+
+    if(result) {
+        const nesl_cartridge_header_t *header = (const nesl_cartridge_header_t *)data;
+        nesl_mapper_e type = (header->flag_7.type_high << 4) | header->flag_6.type_low;
+
+        for(int index = 0; index < (sizeof(CONTEXT) / sizeof(*(CONTEXT))); ++index) {
+
+            if(CONTEXT[index].type == type) {
+                result += ARENA_SIZE(CONTEXT[index].size);
+                break;
+            }
+        }
+    }
+
+    return result;
+}
+
+nesl_error_e nesl_mapper_initialize(nesl_mapper_t *mapper, nesl_arena_t *arena, const void *data, int length, const char *save)
 {
     nesl_error_e result;
 
-    if((result = nesl_cartridge_initialize(&mapper->cartridge, data, length)) == NESL_FAILURE) {
+    if((result = nesl_cartridge_initialize(&mapper->cartridge, arena, data, length, save)) == NESL_FAILURE) {
         goto exit;
     }
 
     mapper->mirror = nesl_cartridge_get_mirror(&mapper->cartridge);
     mapper->type = nesl_cartridge_get_mapper(&mapper->cartridge);
 
-    if((result = nesl_mapper_extension_initialize(mapper)) == NESL_FAILURE) {
+    if((result = nesl_mapper_extension_initialize(mapper, arena)) == NESL_FAILURE) {
         goto exit;
     }
 
@@ -137,6 +186,23 @@ nesl_error_e nesl_mapper_interrupt(nesl_mapper_t *mapper)
     return mapper->extension.interrupt(mapper);
 }
 
+size_t nesl_mapper_load(nesl_mapper_t *mapper, const void *data)
+{
+    size_t result = 0;
+    const uint8_t *offset = data;
+
+    memcpy(&mapper->mirror, &offset[result], sizeof(mapper->mirror));
+    result += sizeof(mapper->mirror);
+    memcpy(&mapper->ram, &offset[result], sizeof(mapper->ram));
+    result += sizeof(mapper->ram);
+    memcpy(&mapper->rom, &offset[result], sizeof(mapper->rom));
+    result += sizeof(mapper->rom);
+    result += mapper->extension.load(mapper, &offset[result]);
+    result += nesl_cartridge_load(&mapper->cartridge, &offset[result]);
+
+    return result;
+}
+
 uint8_t nesl_mapper_read(nesl_mapper_t *mapper, nesl_bank_e type, uint16_t address)
 {
     uint8_t result = 0;
@@ -162,6 +228,40 @@ nesl_error_e nesl_mapper_reset(nesl_mapper_t *mapper)
     return mapper->extension.reset(mapper);
 }
 
+size_t nesl_mapper_restore(nesl_mapper_t *mapper, const void *data)
+{
+    size_t result = 0;
+    const uint8_t *offset = data;
+
+    memcpy(&mapper->mirror, &offset[result], sizeof(mapper->mirror));
+    result += sizeof(mapper->mirror);
+    memcpy(&mapper->ram, &offset[result], sizeof(mapper->ram));
+    result += sizeof(mapper->ram);
+    memcpy(&mapper->rom, &offset[result], sizeof(mapper->rom));
+    result += sizeof(mapper->rom);
+    result += mapper->extension.load(mapper, &offset[result]);
+    result += nesl_cartridge_restore(&mapper->cartridge, &offset[result]);
+
+    return result;
+}
+
+size_t nesl_mapper_save(const nesl_mapper_t *mapper, void *data)
+{
+    size_t result = sizeof(mapper->mirror) + sizeof(mapper->ram) + sizeof(mapper->rom);
+    uint8_t *offset = data;
+
+    if(offset) {
+        memcpy(offset, &mapper->mirror, sizeof(mapper->mirror));
+        memcpy(&offset[sizeof(mapper->mirror)], &mapper->ram, sizeof(mapper->ram));
+        memcpy(&offset[sizeof(mapper->mirror) + sizeof(mapper->ram)], &mapper->rom, sizeof(mapper->rom));
+    }
+
+    result += mapper->extension.save(mapper, offset ? &offset[result] : NULL);
+    result += nesl_cartridge_save(&mapper->cartridge, offset ? &offset[result] : NULL);
+
+    return result;
+}
+
 void nesl_mapper_uninitialize(nesl_mapper_t *mapper)
 {
     nesl_mapper_extension_uninitialize(mapper);
@@ -30,12 +30,14 @@
 extern "C" {
 #endif /* __cplusplus */
 
-nesl_error_e nesl_mapper_0_initialize(nesl_mapper_t *mapper)
+nesl_error_e nesl_mapper_0_initialize(nesl_mapper_t *mapper, nesl_arena_t *arena)
 {
     mapper->extension.interrupt = &nesl_mapper_0_interrupt;
+    mapper->extension.load = &nesl_mapper_0_load;
     mapper->extension.read_ram = &nesl_mapper_0_read_ram;
     mapper->extension.read_rom = &nesl_mapper_0_read_rom;
     mapper->extension.reset = &nesl_mapper_0_reset;
+    mapper->extension.save = &nesl_mapper_0_save;
     mapper->extension.write_ram = &nesl_mapper_0_write_ram;
     mapper->extension.write_rom = &nesl_mapper_0_write_rom;
     mapper->ram.program = 0;
@@ -51,6 +53,11 @@ nesl_error_e nesl_mapper_0_interrupt(nesl_mapper_t *mapper)
     return NESL_SUCCESS;
 }
 
+size_t nesl_mapper_0_load(nesl_mapper_t *mapper, const void *data)
+{
+    return 0;
+}
+
 uint8_t nesl_mapper_0_read_ram(nesl_mapper_t *mapper, nesl_bank_e type, uint16_t address)
 {
     uint8_t result = 0;
@@ -113,6 +120,11 @@ nesl_error_e nesl_mapper_0_reset(nesl_mapper_t *mapper)
     return NESL_SUCCESS;
 }
 
+size_t nesl_mapper_0_save(const nesl_mapper_t *mapper, void *data)
+{
+    return 0;
+}
+
 void nesl_mapper_0_uninitialize(nesl_mapper_t *mapper)
 {
     memset(&mapper->extension, 0, sizeof(mapper->extension));
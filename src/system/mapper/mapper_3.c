@@ -39,19 +39,21 @@ static void nesl_mapper_3_set(nesl_mapper_t *mapper)
     mapper->rom.character[0] = ((nesl_mapper_3_t *)mapper->context)->character.bank * 8 * 1024;
 }
 
-nesl_error_e nesl_mapper_3_initialize(nesl_mapper_t *mapper)
+nesl_error_e nesl_mapper_3_initialize(nesl_mapper_t *mapper, nesl_arena_t *arena)
 {
     nesl_error_e result = NESL_SUCCESS;
 
-    if(!(mapper->context = calloc(1, sizeof(nesl_mapper_3_t)))) {
+    if(!(mapper->context = nesl_arena_allocate(arena, sizeof(nesl_mapper_3_t)))) {
         result = SET_ERROR("Failed to allocate buffer -- %u KB (%i bytes)", sizeof(nesl_mapper_3_t), sizeof(nesl_mapper_3_t));
         goto exit;
     }
 
     mapper->extension.interrupt = &nesl_mapper_3_interrupt;
+    mapper->extension.load = &nesl_mapper_3_load;
     mapper->extension.read_ram = &nesl_mapper_3_read_ram;
     mapper->extension.read_rom = &nesl_mapper_3_read_rom;
     mapper->extension.reset = &nesl_mapper_3_reset;
+    mapper->extension.save = &nesl_mapper_3_save;
     mapper->extension.write_ram = &nesl_mapper_3_write_ram;
     mapper->extension.write_rom = &nesl_mapper_3_write_rom;
 
@@ -68,6 +70,13 @@ nesl_error_e nesl_mapper_3_interrupt(nesl_mapper_t *mapper)
     return NESL_SUCCESS;
 }
 
+size_t nesl_mapper_3_load(nesl_mapper_t *mapper, const void *data)
+{
+    memcpy(mapper->context, data, sizeof(nesl_mapper_3_t));
+
+    return sizeof(nesl_mapper_3_t);
+}
+
 uint8_t nesl_mapper_3_read_ram(nesl_mapper_t *mapper, nesl_bank_e type, uint16_t address)
 {
     uint8_t result = 0;
@@ -135,14 +144,20 @@ nesl_error_e nesl_mapper_3_reset(nesl_mapper_t *mapper)
     return NESL_SUCCESS;
 }
 
-void nesl_mapper_3_uninitialize(nesl_mapper_t *mapper)
+size_t nesl_mapper_3_save(const nesl_mapper_t *mapper, void *data)
 {
-    memset(&mapper->extension, 0, sizeof(mapper->extension));
 
-    if(mapper->context) {
-        free(mapper->context);
-        mapper->context = NULL;
+    if(data) {
+        memcpy(data, mapper->context, sizeof(nesl_mapper_3_t));
     }
+
+    return sizeof(nesl_mapper_3_t);
+}
+
+void nesl_mapper_3_uninitialize(nesl_mapper_t *mapper)
+{
+    memset(&mapper->extension, 0, sizeof(mapper->extension));
+    mapper->context = NULL;
 }
 
 void nesl_mapper_3_write_ram(nesl_mapper_t *mapper, nesl_bank_e type, uint16_t address, uint8_t data)
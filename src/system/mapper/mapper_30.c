@@ -41,19 +41,21 @@ static void nesl_mapper_30_set(nesl_mapper_t *mapper)
     mapper->mirror = ((nesl_mapper_30_t *)mapper->context)->bank.one_screen ? MIRROR_ONE_LOW : nesl_cartridge_get_mirror(&mapper->cartridge);
 }
 
-nesl_error_e nesl_mapper_30_initialize(nesl_mapper_t *mapper)
+nesl_error_e nesl_mapper_30_initialize(nesl_mapper_t *mapper, nesl_arena_t *arena)
 {
     nesl_error_e result = NESL_SUCCESS;
 
-    if(!(mapper->context = calloc(1, sizeof(nesl_mapper_30_t)))) {
+    if(!(mapper->context = nesl_arena_allocate(arena, sizeof(nesl_mapper_30_t)))) {
         result = SET_ERROR("Failed to allocate buffer -- %u KB (%i bytes)", sizeof(nesl_mapper_30_t), sizeof(nesl_mapper_30_t));
         goto exit;
     }
 
     mapper->extension.interrupt = &nesl_mapper_30_interrupt;
+    mapper->extension.load = &nesl_mapper_30_load;
     mapper->extension.read_ram = &nesl_mapper_30_read_ram;
     mapper->extension.read_rom = &nesl_mapper_30_read_rom;
     mapper->extension.reset = &nesl_mapper_30_reset;
+    mapper->extension.save = &nesl_mapper_30_save;
     mapper->extension.write_ram = &nesl_mapper_30_write_ram;
     mapper->extension.write_rom = &nesl_mapper_30_write_rom;
 
@@ -70,6 +72,13 @@ nesl_error_e nesl_mapper_30_interrupt(nesl_mapper_t *mapper)
     return NESL_SUCCESS;
 }
 
+size_t nesl_mapper_30_load(nesl_mapper_t *mapper, const void *data)
+{
+    memcpy(mapper->context, data, sizeof(nesl_mapper_30_t));
+
+    return sizeof(nesl_mapper_30_t);
+}
+
 uint8_t nesl_mapper_30_read_ram(nesl_mapper_t *mapper, nesl_bank_e type, uint16_t address)
 {
     uint8_t result = 0;
@@ -154,14 +163,20 @@ void nesl_mapper_30_write_ram(nesl_mapper_t *mapper, nesl_bank_e type, uint16_t
     }
 }
 
-void nesl_mapper_30_uninitialize(nesl_mapper_t *mapper)
+size_t nesl_mapper_30_save(const nesl_mapper_t *mapper, void *data)
 {
-    memset(&mapper->extension, 0, sizeof(mapper->extension));
 
-    if(mapper->context) {
-        free(mapper->context);
-        mapper->context = NULL;
+    if(data) {
+        memcpy(data, mapper->context, sizeof(nesl_mapper_30_t));
     }
+
+    return sizeof(nesl_mapper_30_t);
+}
+
+void nesl_mapper_30_uninitialize(nesl_mapper_t *mapper)
+{
+    memset(&mapper->extension, 0, sizeof(mapper->extension));
+    mapper->context = NULL;
 }
 
 void nesl_mapper_30_write_rom(nesl_mapper_t *mapper, nesl_bank_e type, uint16_t address, uint8_t data)
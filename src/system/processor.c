@@ -1275,6 +1275,7 @@ uint8_t nesl_processor_read(nesl_processor_t *processor, uint16_t address)
 nesl_error_e nesl_processor_reset(nesl_processor_t *processor)
 {
     memset(processor, 0, sizeof(*processor));
+    processor->dirty = UINT64_MAX;
     nesl_processor_push_word(processor, processor->state.program_counter.word);
     nesl_processor_push(processor, processor->state.status.raw);
     processor->state.program_counter.word = nesl_processor_read_word(processor, 0xFFFC);
@@ -1297,6 +1298,7 @@ void nesl_processor_write(nesl_processor_t *processor, uint16_t address, uint8_t
     switch(address) {
         case 0x0000 ... 0x1FFF:
             processor->ram[address & 0x07FF] = data;
+            DIRTY_SET(&processor->dirty, address & 0x07FF);
             break;
         case 0x4014:
             processor->interrupt.transfer = true;
@@ -357,7 +357,7 @@ static void nesl_video_render(nesl_video_t *video)
         }
     }
 
-    if((video->scanline >= 0) && (video->scanline < 240) && ((video->cycle - 1) < 256)) {
+    if(!video->hidden && (video->scanline >= 0) && (video->scanline < 240) && ((video->cycle - 1) < 256)) {
         nesl_service_set_pixel(nesl_bus_read(BUS_VIDEO, 0x3F00 + (4 * palette[0]) + color[0]),
             video->port.mask.red_emphasis, video->port.mask.green_emphasis, video->port.mask.blue_emphasis,
             video->cycle - 1, video->scanline);
@@ -433,6 +433,7 @@ static void nesl_video_set_port_oam_address(nesl_video_t *video, uint8_t data)
 static void nesl_video_set_port_oam_data(nesl_video_t *video, uint8_t data)
 {
     ((uint8_t *)video->ram.oam)[video->port.oam_address.low] = data;
+    DIRTY_SET(&video->dirty, &((uint8_t *)video->ram.oam)[video->port.oam_address.low] - (uint8_t *)&video->ram);
 
     if(!video->port.status.vertical_blank) {
         ++video->port.oam_address.low;
@@ -766,6 +767,7 @@ uint8_t nesl_video_read_port(nesl_video_t *video, uint16_t address)
 nesl_error_e nesl_video_reset(nesl_video_t *video, const nesl_mirror_e *mirror)
 {
     memset(video, 0, sizeof(*video));
+    video->dirty = UINT64_MAX;
     video->scanline = -1;
     video->mirror = mirror;
 
@@ -787,9 +789,12 @@ void nesl_video_write(nesl_video_t *video, uint16_t address, uint8_t data)
         case 0x2000 ... 0x2FFF:
             address = nesl_video_nametable_address(address, *video->mirror, &bank);
             video->ram.nametable[bank][address] = data;
+            DIRTY_SET(&video->dirty, &video->ram.nametable[bank][address] - (uint8_t *)&video->ram);
             break;
         case 0x3F00 ... 0x3FFF:
-            video->ram.palette[nesl_video_palette_address(address)] = data;
+            address = nesl_video_palette_address(address);
+            video->ram.palette[address] = data;
+            DIRTY_SET(&video->dirty, &video->ram.palette[address] - (uint8_t *)&video->ram);
             break;
         default:
             break;
@@ -799,6 +804,7 @@ void nesl_video_write(nesl_video_t *video, uint16_t address, uint8_t data)
 void nesl_video_write_oam(nesl_video_t *video, uint8_t address, uint8_t data)
 {
     ((uint8_t *)video->ram.oam)[address] = data;
+    DIRTY_SET(&video->dirty, &((uint8_t *)video->ram.oam)[address] - (uint8_t *)&video->ram);
 }
 
 void nesl_video_write_port(nesl_video_t *video, uint16_t address, uint8_t data)
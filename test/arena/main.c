@@ -0,0 +1,206 @@
+/*
+ * NESL
+ * Copyright (C) 2022 David Jolly
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+ * @file main.c
+ * @brief Test application for arena.
+ */
+
+#include <arena.h>
+#include <test.h>
+
+/*!
+ * @struct nesl_test_t
+ * @brief Contains the test contexts.
+ */
+typedef struct {
+    nesl_arena_t arena;         /*!< Arena context */
+} nesl_test_t;
+
+static nesl_test_t g_test = {}; /*!< Test context */
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+nesl_error_e nesl_set_error(const char *file, const char *function, int line, const char *format, ...)
+{
+    return NESL_FAILURE;
+}
+
+/*!
+ * @brief Uninitialize test context.
+ */
+static void nesl_test_uninitialize(void)
+{
+    nesl_arena_uninitialize(&g_test.arena);
+    memset(&g_test, 0, sizeof(g_test));
+}
+
+/*!
+ * @brief Initialize test context.
+ * @param[in] capacity Arena capacity in bytes
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_initialize(size_t capacity)
+{
+    nesl_test_uninitialize();
+
+    return nesl_arena_initialize(&g_test.arena, capacity);
+}
+
+/*!
+ * @brief Test arena allocation.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_arena_allocate(void)
+{
+    uint8_t *block[4] = {};
+    const size_t SIZE[] = { 1, ARENA_ALIGNMENT, 3 * ARENA_ALIGNMENT + 5, 8 * 1024, };
+    size_t capacity = 0;
+    nesl_error_e result = NESL_SUCCESS;
+
+    for(int index = 0; index < TEST_COUNT(SIZE); ++index) {
+        capacity += ARENA_SIZE(SIZE[index]);
+    }
+
+    if(ASSERT(nesl_test_initialize(capacity) == NESL_SUCCESS)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    for(int index = 0; index < TEST_COUNT(SIZE); ++index) {
+
+        if(ASSERT((block[index] = nesl_arena_allocate(&g_test.arena, SIZE[index])) != NULL)) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+
+        if(ASSERT(!((uintptr_t)block[index] % ARENA_ALIGNMENT)
+                && (!index || (block[index] == (block[index - 1] + ARENA_SIZE(SIZE[index - 1])))))) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+
+        for(size_t offset = 0; offset < SIZE[index]; ++offset) {
+
+            if(ASSERT(!block[index][offset])) {
+                result = NESL_FAILURE;
+                goto exit;
+            }
+        }
+
+        memset(block[index], 0xFF, SIZE[index]);
+    }
+
+    if(ASSERT((g_test.arena.offset == capacity) && !nesl_arena_allocate(&g_test.arena, 1))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+    nesl_test_uninitialize();
+
+    return result;
+}
+
+/*!
+ * @brief Test arena initialization.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_arena_initialize(void)
+{
+    nesl_error_e result = NESL_SUCCESS;
+
+    for(size_t capacity = 0; capacity <= (2 * ARENA_ALIGNMENT); capacity += (ARENA_ALIGNMENT / 2)) {
+
+        if(ASSERT(nesl_test_initialize(capacity) == NESL_SUCCESS)) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+
+        if(ASSERT((g_test.arena.data != NULL)
+                && (g_test.arena.capacity == ARENA_SIZE(capacity))
+                && (g_test.arena.offset == 0))) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+    }
+
+exit:
+    TEST_RESULT(result);
+    nesl_test_uninitialize();
+
+    return result;
+}
+
+/*!
+ * @brief Test arena uninitialization.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_arena_uninitialize(void)
+{
+    nesl_error_e result = NESL_SUCCESS;
+
+    if(ASSERT(nesl_test_initialize(ARENA_ALIGNMENT) == NESL_SUCCESS)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    nesl_arena_allocate(&g_test.arena, 1);
+    nesl_arena_uninitialize(&g_test.arena);
+
+    if(ASSERT((g_test.arena.data == NULL)
+            && (g_test.arena.capacity == 0)
+            && (g_test.arena.offset == 0))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+    nesl_test_uninitialize();
+
+    return result;
+}
+
+int main(void)
+{
+    const test TEST[] = {
+        nesl_test_arena_allocate, nesl_test_arena_initialize, nesl_test_arena_uninitialize,
+        };
+
+    nesl_error_e result = NESL_SUCCESS;
+
+    for(int index = 0; index < TEST_COUNT(TEST); ++index) {
+
+        if(TEST[index]() == NESL_FAILURE) {
+            result = NESL_FAILURE;
+        }
+    }
+
+    return (int)result;
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
@@ -40,6 +40,19 @@ typedef struct {
         void *context;                      /*!< Audio callback context */
     } setup;
 
+    struct {
+        const char *path;                   /*!< Sink path */
+        bool initialized;                   /*!< Initialized state */
+    } sink;
+
+    struct {
+        uint32_t input;                     /*!< Input sample rate */
+        uint32_t output;                    /*!< Output sample rate */
+        bool initialized;                   /*!< Initialized state */
+        bool reset;                         /*!< Reset state */
+        bool write;                         /*!< Write state */
+    } resampler;
+
     struct {
 
         struct {
@@ -82,12 +95,12 @@ static nesl_test_t g_test = {};             /*!< Test context */
 extern "C" {
 #endif /* __cplusplus */
 
-nesl_error_e nesl_audio_buffer_initialize(nesl_audio_buffer_t *buffer, int length)
+nesl_error_e nesl_audio_buffer_initialize(nesl_audio_buffer_t *buffer, nesl_arena_t *arena, int length)
 {
     return NESL_SUCCESS;
 }
 
-int nesl_audio_buffer_read(nesl_audio_buffer_t *buffer, float *data, int length)
+int nesl_audio_buffer_read(nesl_audio_buffer_t *buffer, nesl_audio_sample_t *data, int length)
 {
     return 0;
 }
@@ -107,33 +120,88 @@ void nesl_audio_buffer_uninitialize(nesl_audio_buffer_t *buffer)
     return;
 }
 
-int nesl_audio_buffer_write(nesl_audio_buffer_t *buffer, float *data, int length)
+int nesl_audio_buffer_write(nesl_audio_buffer_t *buffer, nesl_audio_sample_t *data, int length)
 {
     return 0;
 }
 
-void nesl_audio_dmc_cycle(nesl_audio_dmc_t *dmc, float elapsed)
+nesl_error_e nesl_audio_resampler_initialize(nesl_audio_resampler_t *resampler, uint32_t input, uint32_t output)
 {
-    g_test.synthesizer.dmc.cycle = true;
+    resampler->input = input;
+    resampler->output = output;
+    g_test.resampler.input = input;
+    g_test.resampler.output = output;
+    g_test.resampler.initialized = true;
+
+    return NESL_SUCCESS;
 }
 
-nesl_error_e nesl_audio_dmc_initialize(nesl_audio_dmc_t *dmc)
+nesl_error_e nesl_audio_resampler_reset(nesl_audio_resampler_t *resampler)
 {
-    g_test.synthesizer.dmc.initialized = true;
+    g_test.resampler.reset = true;
+
+    return NESL_SUCCESS;
+}
+
+void nesl_audio_resampler_uninitialize(nesl_audio_resampler_t *resampler)
+{
+    g_test.resampler.initialized = false;
+}
+
+bool nesl_audio_resampler_write(nesl_audio_resampler_t *resampler, nesl_audio_sample_t input, nesl_audio_sample_t *output)
+{
+    g_test.resampler.write = true;
+
+    return false;
+}
+
+nesl_error_e nesl_audio_sink_initialize(nesl_audio_sink_t *sink, const char *path, int rate)
+{
+    g_test.sink.path = path;
+    g_test.sink.initialized = true;
 
     return NESL_SUCCESS;
 }
 
-int nesl_audio_dmc_read(nesl_audio_dmc_t *dmc, float *data, int length)
+nesl_error_e nesl_audio_sink_uninitialize(nesl_audio_sink_t *sink)
+{
+    g_test.sink.initialized = false;
+
+    return NESL_SUCCESS;
+}
+
+nesl_error_e nesl_audio_sink_write(nesl_audio_sink_t *sink, const nesl_audio_sample_t *data, int count)
+{
+    return NESL_SUCCESS;
+}
+
+void nesl_audio_dmc_cycle(nesl_audio_dmc_t *dmc)
+{
+    g_test.synthesizer.dmc.cycle = true;
+}
+
+bool nesl_audio_dmc_get_interrupt(const nesl_audio_dmc_t *dmc)
+{
+    return false;
+}
+
+uint16_t nesl_audio_dmc_get_length(const nesl_audio_dmc_t *dmc)
 {
     return 0;
 }
 
-int nesl_audio_dmc_readable(nesl_audio_dmc_t *dmc)
+uint8_t nesl_audio_dmc_get_output(const nesl_audio_dmc_t *dmc)
 {
     return 0;
 }
 
+nesl_error_e nesl_audio_dmc_initialize(nesl_audio_dmc_t *dmc)
+{
+    g_test.synthesizer.dmc.initialized = true;
+
+    return NESL_SUCCESS;
+}
+
 nesl_error_e nesl_audio_dmc_reset(nesl_audio_dmc_t *dmc)
 {
     g_test.synthesizer.dmc.reset = true;
@@ -141,6 +209,11 @@ nesl_error_e nesl_audio_dmc_reset(nesl_audio_dmc_t *dmc)
     return NESL_SUCCESS;
 }
 
+void nesl_audio_dmc_set_enable(nesl_audio_dmc_t *dmc, bool enable)
+{
+    return;
+}
+
 void nesl_audio_dmc_uninitialize(nesl_audio_dmc_t *dmc)
 {
     g_test.synthesizer.dmc.initialized = false;
@@ -152,28 +225,33 @@ void nesl_audio_dmc_write(nesl_audio_dmc_t *dmc, uint16_t address, uint8_t data)
     g_test.synthesizer.dmc.data = data;
 }
 
-void nesl_audio_noise_cycle(nesl_audio_noise_t *noise, float elapsed)
+void nesl_audio_noise_cycle(nesl_audio_noise_t *noise)
 {
     g_test.synthesizer.noise.cycle = true;
 }
 
-nesl_error_e nesl_audio_noise_initialize(nesl_audio_noise_t *noise)
+void nesl_audio_noise_frame(nesl_audio_noise_t *noise, bool half)
 {
-    g_test.synthesizer.noise.initialized = true;
-
-    return NESL_SUCCESS;
+    return;
 }
 
-int nesl_audio_noise_read(nesl_audio_noise_t *noise, float *data, int length)
+uint8_t nesl_audio_noise_get_length(const nesl_audio_noise_t *noise)
 {
     return 0;
 }
 
-int nesl_audio_noise_readable(nesl_audio_noise_t *noise)
+uint8_t nesl_audio_noise_get_output(const nesl_audio_noise_t *noise)
 {
     return 0;
 }
 
+nesl_error_e nesl_audio_noise_initialize(nesl_audio_noise_t *noise)
+{
+    g_test.synthesizer.noise.initialized = true;
+
+    return NESL_SUCCESS;
+}
+
 nesl_error_e nesl_audio_noise_reset(nesl_audio_noise_t *noise)
 {
     g_test.synthesizer.noise.reset = true;
@@ -181,6 +259,11 @@ nesl_error_e nesl_audio_noise_reset(nesl_audio_noise_t *noise)
     return NESL_SUCCESS;
 }
 
+void nesl_audio_noise_set_enable(nesl_audio_noise_t *noise, bool enable)
+{
+    return;
+}
+
 void nesl_audio_noise_uninitialize(nesl_audio_noise_t *noise)
 {
     g_test.synthesizer.noise.initialized = false;
@@ -192,7 +275,7 @@ void nesl_audio_noise_write(nesl_audio_noise_t *noise, uint16_t address, uint8_t
     g_test.synthesizer.noise.data = data;
 }
 
-void nesl_audio_square_cycle(nesl_audio_square_t *square, float elapsed)
+void nesl_audio_square_cycle(nesl_audio_square_t *square)
 {
 
     for(nesl_synthesizer_e channel = SYNTHESIZER_SQUARE_1; channel <= SYNTHESIZER_SQUARE_2; ++channel) {
@@ -204,7 +287,22 @@ void nesl_audio_square_cycle(nesl_audio_square_t *square, float elapsed)
     }
 }
 
-nesl_error_e nesl_audio_square_initialize(nesl_audio_square_t *square)
+void nesl_audio_square_frame(nesl_audio_square_t *square, bool half)
+{
+    return;
+}
+
+uint8_t nesl_audio_square_get_length(const nesl_audio_square_t *square)
+{
+    return 0;
+}
+
+uint8_t nesl_audio_square_get_output(const nesl_audio_square_t *square)
+{
+    return 0;
+}
+
+nesl_error_e nesl_audio_square_initialize(nesl_audio_square_t *square, uint8_t channel)
 {
     nesl_error_e result = NESL_FAILURE;
 
@@ -223,16 +321,6 @@ nesl_error_e nesl_audio_square_initialize(nesl_audio_square_t *square)
     return result;
 }
 
-int nesl_audio_square_read(nesl_audio_square_t *square, float *data, int length)
-{
-    return 0;
-}
-
-int nesl_audio_square_readable(nesl_audio_square_t *square)
-{
-    return 0;
-}
-
 nesl_error_e nesl_audio_square_reset(nesl_audio_square_t *square)
 {
     nesl_error_e result = NESL_FAILURE;
@@ -249,6 +337,11 @@ nesl_error_e nesl_audio_square_reset(nesl_audio_square_t *square)
     return result;
 }
 
+void nesl_audio_square_set_enable(nesl_audio_square_t *square, bool enable)
+{
+    return;
+}
+
 void nesl_audio_square_uninitialize(nesl_audio_square_t *square)
 {
 
@@ -277,28 +370,33 @@ void nesl_audio_square_write(nesl_audio_square_t *square, uint16_t address, uint
     }
 }
 
-void nesl_audio_triangle_cycle(nesl_audio_triangle_t *triangle, float elapsed)
+void nesl_audio_triangle_cycle(nesl_audio_triangle_t *triangle)
 {
     g_test.synthesizer.triangle.cycle = true;
 }
 
-nesl_error_e nesl_audio_triangle_initialize(nesl_audio_triangle_t *triangle)
+void nesl_audio_triangle_frame(nesl_audio_triangle_t *triangle, bool half)
 {
-    g_test.synthesizer.triangle.initialized = true;
-
-    return NESL_SUCCESS;
+    return;
 }
 
-int nesl_audio_triangle_read(nesl_audio_triangle_t *triangle, float *data, int length)
+uint8_t nesl_audio_triangle_get_length(const nesl_audio_triangle_t *triangle)
 {
     return 0;
 }
 
-int nesl_audio_triangle_readable(nesl_audio_triangle_t *triangle)
+uint8_t nesl_audio_triangle_get_output(const nesl_audio_triangle_t *triangle)
 {
     return 0;
 }
 
+nesl_error_e nesl_audio_triangle_initialize(nesl_audio_triangle_t *triangle)
+{
+    g_test.synthesizer.triangle.initialized = true;
+
+    return NESL_SUCCESS;
+}
+
 nesl_error_e nesl_audio_triangle_reset(nesl_audio_triangle_t *triangle)
 {
     g_test.synthesizer.triangle.reset = true;
@@ -306,6 +404,11 @@ nesl_error_e nesl_audio_triangle_reset(nesl_audio_triangle_t *triangle)
     return NESL_SUCCESS;
 }
 
+void nesl_audio_triangle_set_enable(nesl_audio_triangle_t *triangle, bool enable)
+{
+    return;
+}
+
 void nesl_audio_triangle_uninitialize(nesl_audio_triangle_t *triangle)
 {
     g_test.synthesizer.triangle.initialized = false;
@@ -317,7 +420,12 @@ void nesl_audio_triangle_write(nesl_audio_triangle_t *triangle, uint16_t address
     g_test.synthesizer.triangle.data = data;
 }
 
-nesl_error_e nesl_service_set_audio(nesl_service_get_audio callback, void *context)
+nesl_error_e nesl_bus_interrupt(nesl_interrupt_e type)
+{
+    return NESL_SUCCESS;
+}
+
+nesl_error_e nesl_service_set_audio(nesl_service_get_audio callback, void *context, int rate)
 {
     nesl_error_e result = NESL_SUCCESS;
 
@@ -335,15 +443,27 @@ exit:
     return result;
 }
 
+void nesl_service_write_audio(const void *data, int length)
+{
+    return;
+}
+
+nesl_error_e nesl_set_error(const char *file, const char *function, int line, const char *format, ...)
+{
+    return NESL_FAILURE;
+}
+
 /*!
  * @brief Initialize test context.
+ * @param[in] quiet Quiet flag
+ * @param[in] record Constant pointer to record path
  * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
  */
-static nesl_error_e nesl_test_initialize(void)
+static nesl_error_e nesl_test_initialize(bool quiet, const char *record)
 {
     memset(&g_test, 0, sizeof(g_test));
 
-    return nesl_audio_initialize(&g_test.audio);
+    return nesl_audio_initialize(&g_test.audio, NULL, quiet, record, 0);
 }
 
 /*!
@@ -354,23 +474,29 @@ static nesl_error_e nesl_test_audio_cycle(void)
 {
     nesl_error_e result = NESL_SUCCESS;
 
-    for(uint64_t cycle = 0; cycle <= 12; ++cycle) {
-        bool expected = !(cycle % 6);
+    for(int mode = 0; mode < 8; ++mode) {
+        bool quiet = mode & 1, record = mode & 2, hidden = mode & 4, synthesize = !quiet || record;
 
-        if(ASSERT(nesl_test_initialize() == NESL_SUCCESS)) {
-            result = NESL_FAILURE;
-            goto exit;
-        }
+        for(uint64_t cycle = 0; cycle <= 12; ++cycle) {
+            bool expected = !(cycle % 3), expected_square = !(cycle % 6);
 
-        nesl_audio_cycle(&g_test.audio, cycle);
+            if(ASSERT(nesl_test_initialize(quiet, record ? "audio.wav" : NULL) == NESL_SUCCESS)) {
+                result = NESL_FAILURE;
+                goto exit;
+            }
 
-        if(ASSERT((g_test.synthesizer.square[SYNTHESIZER_SQUARE_1].cycle == expected)
-                && (g_test.synthesizer.square[SYNTHESIZER_SQUARE_2].cycle == expected)
-                && (g_test.synthesizer.triangle.cycle == expected)
-                && (g_test.synthesizer.noise.cycle == expected)
-                && (g_test.synthesizer.dmc.cycle == expected))) {
-            result = NESL_FAILURE;
-            goto exit;
+            g_test.audio.hidden = hidden;
+            nesl_audio_cycle(&g_test.audio, cycle);
+
+            if(ASSERT((g_test.synthesizer.square[SYNTHESIZER_SQUARE_1].cycle == (expected_square && synthesize))
+                    && (g_test.synthesizer.square[SYNTHESIZER_SQUARE_2].cycle == (expected_square && synthesize))
+                    && (g_test.synthesizer.triangle.cycle == (expected && synthesize))
+                    && (g_test.synthesizer.noise.cycle == (expected && synthesize))
+                    && (g_test.synthesizer.dmc.cycle == expected)
+                    && (g_test.resampler.write == (expected_square && synthesize && !hidden)))) {
+                result = NESL_FAILURE;
+                goto exit;
+            }
         }
     }
 
@@ -380,6 +506,32 @@ exit:
     return result;
 }
 
+/*!
+ * @brief Test audio subsystem error, failing once recording has failed.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_audio_get_error(void)
+{
+    nesl_error_e result = NESL_SUCCESS;
+
+    if(ASSERT((nesl_test_initialize(true, "audio.wav") == NESL_SUCCESS) && (nesl_audio_get_error(&g_test.audio) == NESL_SUCCESS))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    g_test.audio.failed = true;
+
+    if(ASSERT(nesl_audio_get_error(&g_test.audio) == NESL_FAILURE)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+
+    return result;
+}
+
 /*!
  * @brief Test audio subsystem initialization.
  * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
@@ -388,7 +540,7 @@ static nesl_error_e nesl_test_audio_initialize(void)
 {
     nesl_error_e result = NESL_SUCCESS;
 
-    if(ASSERT(nesl_test_initialize() == NESL_SUCCESS)) {
+    if(ASSERT(nesl_test_initialize(false, NULL) == NESL_SUCCESS)) {
         result = NESL_FAILURE;
         goto exit;
     }
@@ -397,6 +549,30 @@ static nesl_error_e nesl_test_audio_initialize(void)
             && (g_test.audio.frame.raw == 0)
             && (g_test.setup.callback != NULL)
             && (g_test.setup.context == &g_test.audio)
+            && g_test.resampler.initialized
+            && (g_test.resampler.input == (AUDIO_CYCLES / 2))
+            && (g_test.resampler.output == AUDIO_RATE)
+            && g_test.synthesizer.square[SYNTHESIZER_SQUARE_1].initialized
+            && g_test.synthesizer.square[SYNTHESIZER_SQUARE_2].initialized
+            && g_test.synthesizer.triangle.initialized
+            && g_test.synthesizer.noise.initialized
+            && g_test.synthesizer.dmc.initialized)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    if(ASSERT(nesl_test_initialize(true, "audio.wav") == NESL_SUCCESS)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    if(ASSERT(g_test.audio.quiet
+            && g_test.audio.record
+            && g_test.sink.initialized
+            && !strcmp(g_test.sink.path, "audio.wav")
+            && (g_test.setup.callback == NULL)
+            && (g_test.setup.context == NULL)
+            && g_test.resampler.initialized
             && g_test.synthesizer.square[SYNTHESIZER_SQUARE_1].initialized
             && g_test.synthesizer.square[SYNTHESIZER_SQUARE_2].initialized
             && g_test.synthesizer.triangle.initialized
@@ -406,6 +582,20 @@ static nesl_error_e nesl_test_audio_initialize(void)
         goto exit;
     }
 
+    if(ASSERT(nesl_test_initialize(true, NULL) == NESL_SUCCESS)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    if(ASSERT(g_test.audio.quiet
+            && !g_test.audio.record
+            && !g_test.sink.initialized
+            && !g_test.resampler.initialized
+            && (g_test.setup.callback == NULL))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
 exit:
     TEST_RESULT(result);
 
@@ -420,7 +610,7 @@ static nesl_error_e nesl_test_audio_read(void)
 {
     nesl_error_e result = NESL_SUCCESS;
 
-    if(ASSERT(nesl_test_initialize() == NESL_SUCCESS)) {
+    if(ASSERT(nesl_test_initialize(false, NULL) == NESL_SUCCESS)) {
         result = NESL_FAILURE;
         goto exit;
     }
@@ -459,7 +649,7 @@ static nesl_error_e nesl_test_audio_reset(void)
 {
     nesl_error_e result = NESL_SUCCESS;
 
-    if(ASSERT(nesl_test_initialize() == NESL_SUCCESS)) {
+    if(ASSERT(nesl_test_initialize(false, NULL) == NESL_SUCCESS)) {
         result = NESL_FAILURE;
         goto exit;
     }
@@ -494,7 +684,7 @@ static nesl_error_e nesl_test_audio_uninitialize(void)
 {
     nesl_error_e result = NESL_SUCCESS;
 
-    if(ASSERT(nesl_test_initialize() == NESL_SUCCESS)) {
+    if(ASSERT(nesl_test_initialize(false, "audio.wav") == NESL_SUCCESS)) {
         result = NESL_FAILURE;
         goto exit;
     }
@@ -503,6 +693,8 @@ static nesl_error_e nesl_test_audio_uninitialize(void)
 
     if(ASSERT((g_test.audio.status.raw == 0)
             && (g_test.audio.frame.raw == 0)
+            && !g_test.audio.record
+            && !g_test.sink.initialized
             && !g_test.synthesizer.square[SYNTHESIZER_SQUARE_1].initialized
             && !g_test.synthesizer.square[SYNTHESIZER_SQUARE_2].initialized
             && !g_test.synthesizer.triangle.initialized
@@ -526,7 +718,7 @@ static nesl_error_e nesl_test_audio_write(void)
 {
     nesl_error_e result = NESL_SUCCESS;
 
-    if(ASSERT(nesl_test_initialize() == NESL_SUCCESS)) {
+    if(ASSERT(nesl_test_initialize(false, NULL) == NESL_SUCCESS)) {
         result = NESL_FAILURE;
         goto exit;
     }
@@ -603,7 +795,7 @@ exit:
 int main(void)
 {
     const test TEST[] = {
-        nesl_test_audio_cycle, nesl_test_audio_initialize, nesl_test_audio_read, nesl_test_audio_reset,
+        nesl_test_audio_cycle, nesl_test_audio_get_error, nesl_test_audio_initialize, nesl_test_audio_read, nesl_test_audio_reset,
         nesl_test_audio_uninitialize, nesl_test_audio_write,
         };
 
@@ -32,15 +32,21 @@
  * @brief Contains the test contexts.
  */
 typedef struct {
-    nesl_audio_buffer_t buffer; /*!< Audio buffer context */
+    nesl_audio_buffer_t buffer;     /*!< Audio buffer context */
+    nesl_audio_sample_t data[32];   /*!< Audio buffer entries */
 } nesl_test_t;
 
-static nesl_test_t g_test = {}; /*!< Test context */
+static nesl_test_t g_test = {};     /*!< Test context */
 
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
 
+void *nesl_arena_allocate(nesl_arena_t *arena, size_t size)
+{
+    return (size <= sizeof(g_test.data)) ? memset(g_test.data, 0, size) : NULL;
+}
+
 nesl_error_e nesl_set_error(const char *file, const char *function, int line, const char *format, ...)
 {
     return NESL_FAILURE;
@@ -94,7 +100,7 @@ static nesl_error_e nesl_test_initialize(int count)
 {
     nesl_test_uninitialize();
 
-    return nesl_audio_buffer_initialize(&g_test.buffer, count);
+    return nesl_audio_buffer_initialize(&g_test.buffer, NULL, count);
 }
 
 /*!
@@ -131,7 +137,7 @@ exit:
 static nesl_error_e nesl_test_audio_buffer_read(void)
 {
     nesl_error_e result = NESL_SUCCESS;
-    float buffer[10] = {}, data = 1024.f;
+    nesl_audio_sample_t buffer[10] = {}, data = 1024;
 
     if(ASSERT(nesl_test_initialize(5) == NESL_SUCCESS)) {
         result = NESL_FAILURE;
@@ -214,7 +220,7 @@ static nesl_error_e nesl_test_audio_buffer_read_write(void)
 {
     int index, read, write;
     nesl_error_e result = NESL_SUCCESS;
-    float consumer[2] = {}, producer[20] = {};
+    nesl_audio_sample_t consumer[2] = {}, producer[20] = {};
 
     if(ASSERT(nesl_test_initialize(10) == NESL_SUCCESS)) {
         result = NESL_FAILURE;
@@ -225,7 +231,7 @@ static nesl_error_e nesl_test_audio_buffer_read_write(void)
     write = g_test.buffer.write;
 
     for(index = 0; index < 20; ++index) {
-        producer[index] = (index + 1) * 1024.f;
+        producer[index] = (index + 1) * 1024;
     }
 
     for(int trial = 0; trial < 10; ++trial) {
@@ -374,7 +380,7 @@ exit:
 static nesl_error_e nesl_test_audio_buffer_write(void)
 {
     nesl_error_e result = NESL_SUCCESS;
-    float buffer[10] = {}, data = 1024.f;
+    nesl_audio_sample_t buffer[10] = {}, data = 1024;
 
     if(ASSERT(nesl_test_initialize(5) == NESL_SUCCESS)) {
         result = NESL_FAILURE;
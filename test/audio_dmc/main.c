@@ -33,7 +33,12 @@
  */
 typedef struct {
     nesl_audio_dmc_t dmc;       /*!< Audio dmc synthesizer context */
-    float buffer[256];          /*!< Audio buffer */
+
+    struct {
+        nesl_interrupt_e int_type;  /*!< Interrupt type */
+        uint16_t address;       /*!< Bus address */
+        uint8_t data;           /*!< Bus data */
+    } bus;
 } nesl_test_t;
 
 static nesl_test_t g_test = {}; /*!< Test context */
@@ -42,143 +47,137 @@ static nesl_test_t g_test = {}; /*!< Test context */
 extern "C" {
 #endif /* __cplusplus */
 
-/*!
- * @brief Copy audio data into circular buffer.
- * @param[in,out] buffer Constant pointer to audio buffer context
- * @param[in,out] data Pointer to data array
- * @param[in] count Maximum number of entries in data array
- */
-static void nesl_audio_buffer_copy_out(nesl_audio_buffer_t *buffer, float *data, int count)
+nesl_error_e nesl_bus_interrupt(nesl_interrupt_e type)
 {
+    g_test.bus.int_type = type;
 
-    if((buffer->read + count) >= buffer->count) {
-        int offset = buffer->count - buffer->read;
+    return NESL_SUCCESS;
+}
 
-        memcpy(data, &buffer->data[buffer->read], offset * sizeof(*data));
-        count -= offset;
-        data += offset;
-        buffer->read = 0;
-    }
+uint8_t nesl_bus_read(nesl_bus_e type, uint16_t address)
+{
+    g_test.bus.address = address;
 
-    memcpy(data, &buffer->data[buffer->read], count * sizeof(*data));
-    buffer->read += count;
-    buffer->full = false;
+    return g_test.bus.data;
 }
 
 /*!
- * @brief Calculate the distance between the left and right offet, with wrap-around.
- * @param[in] count Maximum count (used to wrap-around)
- * @param[in] left Left offset
- * @param[in] right Right offset
- * @return Distance between offsets
+ * @brief Uninitialize test context.
  */
-static int nesl_audio_buffer_distance(int count, int left, int right)
+static void nesl_test_uninitialize(void)
 {
-    int result = 0;
-
-    if(left <= right) {
-        result = right - left;
-    } else {
-        result = (count - left) + right;
-    }
-
-    return result;
+    nesl_audio_dmc_uninitialize(&g_test.dmc);
+    memset(&g_test, 0, sizeof(g_test));
 }
 
 /*!
- * @brief Calculate the minimum between the left and right offset.
- * @param[in] left Left offset
- * @param[in] right Right offset
- * @return Minimum between offsets
+ * @brief Initialize test context.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
  */
-static int nesl_audio_buffer_minimum(int left, int right)
+static int nesl_test_initialize(void)
 {
-    return (left > right) ? right : left;
+    nesl_test_uninitialize();
+    g_test.bus.int_type = INTERRUPT_RESET;
+
+    return nesl_audio_dmc_initialize(&g_test.dmc);
 }
 
 /*!
- * @brief Determine if buffer is empty.
- * @return true if empty, false otherwise
+ * @brief Test audio DMC synthesizer cycle.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
  */
-static bool nesl_audio_buffer_empty(nesl_audio_buffer_t *buffer)
+static nesl_error_e nesl_test_audio_dmc_cycle(void)
 {
-    return !buffer->full && (buffer->write == buffer->read);
-}
+    nesl_error_e result;
 
-nesl_error_e nesl_audio_buffer_initialize(nesl_audio_buffer_t *buffer, int count)
-{
-    nesl_error_e result = NESL_SUCCESS;
+    if((result = nesl_test_initialize()) == NESL_FAILURE) {
+        goto exit;
+    }
 
-    if(count != 256) {
+    g_test.bus.data = 0x01;
+    nesl_audio_dmc_write(&g_test.dmc, 0x4010, 0x0F);
+    nesl_audio_dmc_write(&g_test.dmc, 0x4011, 0x40);
+    nesl_audio_dmc_write(&g_test.dmc, 0x4012, 0x01);
+    nesl_audio_dmc_set_enable(&g_test.dmc, true);
+    nesl_audio_dmc_cycle(&g_test.dmc);
+
+    if(ASSERT((g_test.bus.address == 0xC040)
+            && !g_test.dmc.reader.empty
+            && (g_test.dmc.reader.data == 0x01)
+            && (g_test.dmc.reader.address == 0xC041)
+            && (nesl_audio_dmc_get_length(&g_test.dmc) == 0)
+            && (g_test.dmc.timer.count == 53))) {
         result = NESL_FAILURE;
         goto exit;
     }
 
-    buffer->data = g_test.buffer;
-    buffer->count = count;
-
-exit:
-    return result;
-}
+    for(int cycle = 0; cycle < (54 * 7); ++cycle) {
+        nesl_audio_dmc_cycle(&g_test.dmc);
+    }
 
-int nesl_audio_buffer_read(nesl_audio_buffer_t *buffer, float *data, int count)
-{
-    int result = 0;
+    if(ASSERT(g_test.dmc.reader.empty
+            && !g_test.dmc.output.silence
+            && (g_test.dmc.output.shift == 0x01)
+            && (g_test.dmc.output.remaining == 8))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
 
-    if(!nesl_audio_buffer_empty(buffer)) {
+    for(int cycle = 0; cycle < (54 * 2); ++cycle) {
+        nesl_audio_dmc_cycle(&g_test.dmc);
+    }
 
-        if((result = nesl_audio_buffer_minimum(nesl_audio_buffer_distance(buffer->count, buffer->read, buffer->write), count)) > 0) {
-            nesl_audio_buffer_copy_out(buffer, data, result);
-        }
+    if(ASSERT(nesl_audio_dmc_get_output(&g_test.dmc) == 0x40)) {
+        result = NESL_FAILURE;
+        goto exit;
     }
 
+exit:
+    TEST_RESULT(result);
+
     return result;
 }
 
-int nesl_audio_buffer_readable(nesl_audio_buffer_t *buffer)
+/*!
+ * @brief Test audio DMC synthesizer get interrupt.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_audio_dmc_get_interrupt(void)
 {
-    return nesl_audio_buffer_distance(buffer->count, buffer->read, buffer->write);
-}
+    nesl_error_e result;
 
-nesl_error_e nesl_audio_buffer_reset(nesl_audio_buffer_t *buffer)
-{
-    buffer->read = 0;
-    buffer->write = 0;
+    if((result = nesl_test_initialize()) == NESL_FAILURE) {
+        goto exit;
+    }
 
-    return NESL_SUCCESS;
-}
+    nesl_audio_dmc_write(&g_test.dmc, 0x4010, 0x80);
+    nesl_audio_dmc_set_enable(&g_test.dmc, true);
+    nesl_audio_dmc_cycle(&g_test.dmc);
 
-void nesl_audio_buffer_uninitialize(nesl_audio_buffer_t *buffer)
-{
-    memset(g_test.buffer, 0, 256 * sizeof(*g_test.buffer));
-    memset(buffer, 0, sizeof(*buffer));
-}
+    if(ASSERT(nesl_audio_dmc_get_interrupt(&g_test.dmc)
+            && (g_test.bus.int_type == INTERRUPT_MASKABLE))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
 
-/*!
- * @brief Uninitialize test context.
- */
-static void nesl_test_uninitialize(void)
-{
-    nesl_audio_dmc_uninitialize(&g_test.dmc);
-    memset(&g_test, 0, sizeof(g_test));
-}
+    nesl_audio_dmc_write(&g_test.dmc, 0x4010, 0x00);
 
-/*!
- * @brief Initialize test context.
- * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
- */
-static int nesl_test_initialize(void)
-{
-    nesl_test_uninitialize();
+    if(ASSERT(!nesl_audio_dmc_get_interrupt(&g_test.dmc))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
 
-    return nesl_audio_dmc_initialize(&g_test.dmc);
+exit:
+    TEST_RESULT(result);
+
+    return result;
 }
 
 /*!
- * @brief Test audio DMC synthesizer cycle.
+ * @brief Test audio DMC synthesizer get length.
  * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
  */
-static nesl_error_e nesl_test_audio_dmc_cycle(void)
+static nesl_error_e nesl_test_audio_dmc_get_length(void)
 {
     nesl_error_e result;
 
@@ -186,7 +185,19 @@ static nesl_error_e nesl_test_audio_dmc_cycle(void)
         goto exit;
     }
 
-    /* TODO: TEST CONTENT */
+    nesl_audio_dmc_write(&g_test.dmc, 0x4013, 0x01);
+
+    if(ASSERT(nesl_audio_dmc_get_length(&g_test.dmc) == 0)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    nesl_audio_dmc_set_enable(&g_test.dmc, true);
+
+    if(ASSERT(nesl_audio_dmc_get_length(&g_test.dmc) == 17)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
 
 exit:
     TEST_RESULT(result);
@@ -195,10 +206,10 @@ exit:
 }
 
 /*!
- * @brief Test audio DMC synthesizer initialization.
+ * @brief Test audio DMC synthesizer get output.
  * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
  */
-static nesl_error_e nesl_test_audio_dmc_initialize(void)
+static nesl_error_e nesl_test_audio_dmc_get_output(void)
 {
     nesl_error_e result;
 
@@ -206,7 +217,31 @@ static nesl_error_e nesl_test_audio_dmc_initialize(void)
         goto exit;
     }
 
-    /* TODO: TEST CONTENT */
+    for(uint8_t data = 0x00; data < 0x80; ++data) {
+        nesl_audio_dmc_write(&g_test.dmc, 0x4011, data);
+
+        if(ASSERT(nesl_audio_dmc_get_output(&g_test.dmc) == data)) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+    }
+
+    g_test.dmc.output.silence = false;
+    g_test.dmc.output.shift = 0x01;
+    nesl_audio_dmc_cycle(&g_test.dmc);
+
+    if(ASSERT(nesl_audio_dmc_get_output(&g_test.dmc) == 0x7F)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    g_test.dmc.timer.count = 0;
+    nesl_audio_dmc_cycle(&g_test.dmc);
+
+    if(ASSERT(nesl_audio_dmc_get_output(&g_test.dmc) == 0x7D)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
 
 exit:
     TEST_RESULT(result);
@@ -215,10 +250,10 @@ exit:
 }
 
 /*!
- * @brief Test audio DMC synthesizer read.
+ * @brief Test audio DMC synthesizer initialization.
  * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
  */
-static nesl_error_e nesl_test_audio_dmc_read(void)
+static nesl_error_e nesl_test_audio_dmc_initialize(void)
 {
     nesl_error_e result;
 
@@ -226,7 +261,14 @@ static nesl_error_e nesl_test_audio_dmc_read(void)
         goto exit;
     }
 
-    /* TODO: TEST CONTENT */
+    if(ASSERT(!g_test.dmc.interrupt
+            && g_test.dmc.reader.empty
+            && (g_test.dmc.reader.remaining == 0)
+            && g_test.dmc.output.silence
+            && (g_test.dmc.output.remaining == 8))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
 
 exit:
     TEST_RESULT(result);
@@ -235,10 +277,10 @@ exit:
 }
 
 /*!
- * @brief Test audio DMC synthesizer readable.
+ * @brief Test audio DMC synthesizer reset.
  * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
  */
-static nesl_error_e nesl_test_audio_dmc_readable(void)
+static nesl_error_e nesl_test_audio_dmc_reset(void)
 {
     nesl_error_e result;
 
@@ -246,7 +288,25 @@ static nesl_error_e nesl_test_audio_dmc_readable(void)
         goto exit;
     }
 
-    /* TODO: TEST CONTENT */
+    nesl_audio_dmc_write(&g_test.dmc, 0x4011, 0x40);
+    nesl_audio_dmc_set_enable(&g_test.dmc, true);
+    nesl_audio_dmc_cycle(&g_test.dmc);
+
+    if(ASSERT(nesl_audio_dmc_reset(&g_test.dmc) == NESL_SUCCESS)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    if(ASSERT(!g_test.dmc.interrupt
+            && (g_test.dmc.level == 0)
+            && g_test.dmc.reader.empty
+            && (g_test.dmc.reader.remaining == 0)
+            && g_test.dmc.output.silence
+            && (g_test.dmc.output.remaining == 8)
+            && (g_test.dmc.state.load.raw == 0))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
 
 exit:
     TEST_RESULT(result);
@@ -255,10 +315,10 @@ exit:
 }
 
 /*!
- * @brief Test audio DMC synthesizer reset.
+ * @brief Test audio DMC synthesizer set enable.
  * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
  */
-static nesl_error_e nesl_test_audio_dmc_reset(void)
+static nesl_error_e nesl_test_audio_dmc_set_enable(void)
 {
     nesl_error_e result;
 
@@ -266,7 +326,24 @@ static nesl_error_e nesl_test_audio_dmc_reset(void)
         goto exit;
     }
 
-    /* TODO: TEST CONTENT */
+    nesl_audio_dmc_write(&g_test.dmc, 0x4012, 0xFF);
+    nesl_audio_dmc_write(&g_test.dmc, 0x4013, 0xFF);
+    g_test.dmc.interrupt = true;
+    nesl_audio_dmc_set_enable(&g_test.dmc, true);
+
+    if(ASSERT(!g_test.dmc.interrupt
+            && (g_test.dmc.reader.address == 0xFFC0)
+            && (g_test.dmc.reader.remaining == 0x0FF1))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    nesl_audio_dmc_set_enable(&g_test.dmc, false);
+
+    if(ASSERT(g_test.dmc.reader.remaining == 0)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
 
 exit:
     TEST_RESULT(result);
@@ -286,7 +363,20 @@ static nesl_error_e nesl_test_audio_dmc_uninitialize(void)
         goto exit;
     }
 
-    /* TODO: TEST CONTENT */
+    nesl_audio_dmc_write(&g_test.dmc, 0x4011, 0x40);
+    nesl_audio_dmc_set_enable(&g_test.dmc, true);
+    nesl_audio_dmc_uninitialize(&g_test.dmc);
+
+    if(ASSERT(!g_test.dmc.interrupt
+            && (g_test.dmc.level == 0)
+            && !g_test.dmc.reader.empty
+            && (g_test.dmc.reader.remaining == 0)
+            && !g_test.dmc.output.silence
+            && (g_test.dmc.output.remaining == 0)
+            && (g_test.dmc.state.load.raw == 0))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
 
 exit:
     TEST_RESULT(result);
@@ -306,7 +396,19 @@ static nesl_error_e nesl_test_audio_dmc_write(void)
         goto exit;
     }
 
-    /* TODO: TEST CONTENT */
+    for(uint16_t address = 0x4010, data = 0x11; address <= 0x4013; ++address, data += 0x11) {
+        nesl_audio_dmc_write(&g_test.dmc, address, data);
+
+        if(ASSERT(g_test.dmc.state.byte[address - 0x4010] == data)) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+    }
+
+    if(ASSERT(g_test.dmc.level == 0x22)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
 
 exit:
     TEST_RESULT(result);
@@ -317,8 +419,9 @@ exit:
 int main(void)
 {
     const test TEST[] = {
-        nesl_test_audio_dmc_cycle, nesl_test_audio_dmc_initialize, nesl_test_audio_dmc_read, nesl_test_audio_dmc_readable,
-        nesl_test_audio_dmc_reset, nesl_test_audio_dmc_uninitialize, nesl_test_audio_dmc_write,
+        nesl_test_audio_dmc_cycle, nesl_test_audio_dmc_get_interrupt, nesl_test_audio_dmc_get_length, nesl_test_audio_dmc_get_output,
+        nesl_test_audio_dmc_initialize, nesl_test_audio_dmc_reset, nesl_test_audio_dmc_set_enable, nesl_test_audio_dmc_uninitialize,
+        nesl_test_audio_dmc_write,
         };
 
     nesl_error_e result = NESL_SUCCESS;
@@ -33,7 +33,6 @@
  */
 typedef struct {
     nesl_audio_noise_t noise;   /*!< Audio noise synthesizer context */
-    float buffer[256];          /*!< Audio buffer */
 } nesl_test_t;
 
 static nesl_test_t g_test = {}; /*!< Test context */
@@ -43,142 +42,116 @@ extern "C" {
 #endif /* __cplusplus */
 
 /*!
- * @brief Copy audio data into circular buffer.
- * @param[in,out] buffer Constant pointer to audio buffer context
- * @param[in,out] data Pointer to data array
- * @param[in] count Maximum number of entries in data array
+ * @brief Uninitialize test context.
  */
-static void nesl_audio_buffer_copy_out(nesl_audio_buffer_t *buffer, float *data, int count)
+static void nesl_test_uninitialize(void)
 {
-
-    if((buffer->read + count) >= buffer->count) {
-        int offset = buffer->count - buffer->read;
-
-        memcpy(data, &buffer->data[buffer->read], offset * sizeof(*data));
-        count -= offset;
-        data += offset;
-        buffer->read = 0;
-    }
-
-    memcpy(data, &buffer->data[buffer->read], count * sizeof(*data));
-    buffer->read += count;
-    buffer->full = false;
+    nesl_audio_noise_uninitialize(&g_test.noise);
+    memset(&g_test, 0, sizeof(g_test));
 }
 
 /*!
- * @brief Calculate the distance between the left and right offet, with wrap-around.
- * @param[in] count Maximum count (used to wrap-around)
- * @param[in] left Left offset
- * @param[in] right Right offset
- * @return Distance between offsets
+ * @brief Initialize test context.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
  */
-static int nesl_audio_buffer_distance(int count, int left, int right)
+static int nesl_test_initialize(void)
 {
-    int result = 0;
-
-    if(left <= right) {
-        result = right - left;
-    } else {
-        result = (count - left) + right;
-    }
-
-    return result;
-}
+    nesl_test_uninitialize();
 
-/*!
- * @brief Calculate the minimum between the left and right offset.
- * @param[in] left Left offset
- * @param[in] right Right offset
- * @return Minimum between offsets
- */
-static int nesl_audio_buffer_minimum(int left, int right)
-{
-    return (left > right) ? right : left;
+    return nesl_audio_noise_initialize(&g_test.noise);
 }
 
 /*!
- * @brief Determine if buffer is empty.
- * @return true if empty, false otherwise
+ * @brief Test audio noise synthesizer cycle.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
  */
-static bool nesl_audio_buffer_empty(nesl_audio_buffer_t *buffer)
-{
-    return !buffer->full && (buffer->write == buffer->read);
-}
-
-nesl_error_e nesl_audio_buffer_initialize(nesl_audio_buffer_t *buffer, int count)
+static nesl_error_e nesl_test_audio_noise_cycle(void)
 {
-    nesl_error_e result = NESL_SUCCESS;
+    nesl_error_e result;
 
-    if(count != 256) {
-        result = NESL_FAILURE;
+    if((result = nesl_test_initialize()) == NESL_FAILURE) {
         goto exit;
     }
 
-    buffer->data = g_test.buffer;
-    buffer->count = count;
+    for(uint8_t mode = 0; mode <= 1; ++mode) {
+        uint16_t expected = 1;
 
-exit:
-    return result;
-}
+        nesl_audio_noise_reset(&g_test.noise);
+        nesl_audio_noise_write(&g_test.noise, 0x400E, mode << 7);
 
-int nesl_audio_buffer_read(nesl_audio_buffer_t *buffer, float *data, int count)
-{
-    int result = 0;
+        for(int clock = 0; clock < 16; ++clock) {
+            expected = (expected >> 1) | (((expected ^ (expected >> (mode ? 6 : 1))) & 1) << 14);
 
-    if(!nesl_audio_buffer_empty(buffer)) {
+            for(int cycle = 0; cycle < 4; ++cycle) {
+                nesl_audio_noise_cycle(&g_test.noise);
+            }
 
-        if((result = nesl_audio_buffer_minimum(nesl_audio_buffer_distance(buffer->count, buffer->read, buffer->write), count)) > 0) {
-            nesl_audio_buffer_copy_out(buffer, data, result);
+            if(ASSERT(g_test.noise.shift == expected)) {
+                result = NESL_FAILURE;
+                goto exit;
+            }
         }
     }
 
+exit:
+    TEST_RESULT(result);
+
     return result;
 }
 
-int nesl_audio_buffer_readable(nesl_audio_buffer_t *buffer)
+/*!
+ * @brief Test audio noise synthesizer frame.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_audio_noise_frame(void)
 {
-    return nesl_audio_buffer_distance(buffer->count, buffer->read, buffer->write);
-}
+    nesl_error_e result;
 
-nesl_error_e nesl_audio_buffer_reset(nesl_audio_buffer_t *buffer)
-{
-    buffer->read = 0;
-    buffer->write = 0;
+    if((result = nesl_test_initialize()) == NESL_FAILURE) {
+        goto exit;
+    }
 
-    return NESL_SUCCESS;
-}
+    nesl_audio_noise_set_enable(&g_test.noise, true);
+    nesl_audio_noise_write(&g_test.noise, 0x400C, 0x00);
+    nesl_audio_noise_write(&g_test.noise, 0x400F, 0x08);
+    nesl_audio_noise_frame(&g_test.noise, false);
 
-void nesl_audio_buffer_uninitialize(nesl_audio_buffer_t *buffer)
-{
-    memset(g_test.buffer, 0, 256 * sizeof(*g_test.buffer));
-    memset(buffer, 0, sizeof(*buffer));
-}
+    if(ASSERT((g_test.noise.envelope.decay == 15)
+            && (g_test.noise.length == 254))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
 
-/*!
- * @brief Uninitialize test context.
- */
-static void nesl_test_uninitialize(void)
-{
-    nesl_audio_noise_uninitialize(&g_test.noise);
-    memset(&g_test, 0, sizeof(g_test));
-}
+    for(int frame = 0; frame < 15; ++frame) {
+        nesl_audio_noise_frame(&g_test.noise, true);
+    }
 
-/*!
- * @brief Initialize test context.
- * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
- */
-static int nesl_test_initialize(void)
-{
-    nesl_test_uninitialize();
+    if(ASSERT((g_test.noise.envelope.decay == 0)
+            && (g_test.noise.length == 239))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
 
-    return nesl_audio_noise_initialize(&g_test.noise);
+    nesl_audio_noise_write(&g_test.noise, 0x400C, 0x20);
+    nesl_audio_noise_frame(&g_test.noise, true);
+
+    if(ASSERT((g_test.noise.envelope.decay == 15)
+            && (g_test.noise.length == 239))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+
+    return result;
 }
 
 /*!
- * @brief Test audio noise synthesizer cycle.
+ * @brief Test audio noise synthesizer get length.
  * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
  */
-static nesl_error_e nesl_test_audio_noise_cycle(void)
+static nesl_error_e nesl_test_audio_noise_get_length(void)
 {
     nesl_error_e result;
 
@@ -186,7 +159,20 @@ static nesl_error_e nesl_test_audio_noise_cycle(void)
         goto exit;
     }
 
-    /* TODO: TEST CONTENT */
+    nesl_audio_noise_write(&g_test.noise, 0x400F, 0x08);
+
+    if(ASSERT(nesl_audio_noise_get_length(&g_test.noise) == 0)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    nesl_audio_noise_set_enable(&g_test.noise, true);
+    nesl_audio_noise_write(&g_test.noise, 0x400F, 0x08);
+
+    if(ASSERT(nesl_audio_noise_get_length(&g_test.noise) == 254)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
 
 exit:
     TEST_RESULT(result);
@@ -195,10 +181,10 @@ exit:
 }
 
 /*!
- * @brief Test audio noise synthesizer initialization.
+ * @brief Test audio noise synthesizer get output.
  * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
  */
-static nesl_error_e nesl_test_audio_noise_initialize(void)
+static nesl_error_e nesl_test_audio_noise_get_output(void)
 {
     nesl_error_e result;
 
@@ -206,7 +192,25 @@ static nesl_error_e nesl_test_audio_noise_initialize(void)
         goto exit;
     }
 
-    /* TODO: TEST CONTENT */
+    nesl_audio_noise_set_enable(&g_test.noise, true);
+    nesl_audio_noise_write(&g_test.noise, 0x400C, 0x17);
+    nesl_audio_noise_write(&g_test.noise, 0x400F, 0x08);
+
+    for(uint16_t shift = 0; shift < 4; ++shift) {
+        g_test.noise.shift = shift;
+
+        if(ASSERT(nesl_audio_noise_get_output(&g_test.noise) == ((shift & 1) ? 0 : 7))) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+    }
+
+    nesl_audio_noise_set_enable(&g_test.noise, false);
+
+    if(ASSERT(nesl_audio_noise_get_output(&g_test.noise) == 0)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
 
 exit:
     TEST_RESULT(result);
@@ -215,10 +219,10 @@ exit:
 }
 
 /*!
- * @brief Test audio noise synthesizer read.
+ * @brief Test audio noise synthesizer initialization.
  * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
  */
-static nesl_error_e nesl_test_audio_noise_read(void)
+static nesl_error_e nesl_test_audio_noise_initialize(void)
 {
     nesl_error_e result;
 
@@ -226,7 +230,12 @@ static nesl_error_e nesl_test_audio_noise_read(void)
         goto exit;
     }
 
-    /* TODO: TEST CONTENT */
+    if(ASSERT(!g_test.noise.enable
+            && (g_test.noise.length == 0)
+            && (g_test.noise.shift == 1))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
 
 exit:
     TEST_RESULT(result);
@@ -235,10 +244,10 @@ exit:
 }
 
 /*!
- * @brief Test audio noise synthesizer readable.
+ * @brief Test audio noise synthesizer reset.
  * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
  */
-static nesl_error_e nesl_test_audio_noise_readable(void)
+static nesl_error_e nesl_test_audio_noise_reset(void)
 {
     nesl_error_e result;
 
@@ -246,7 +255,22 @@ static nesl_error_e nesl_test_audio_noise_readable(void)
         goto exit;
     }
 
-    /* TODO: TEST CONTENT */
+    nesl_audio_noise_set_enable(&g_test.noise, true);
+    nesl_audio_noise_write(&g_test.noise, 0x400F, 0x08);
+    nesl_audio_noise_cycle(&g_test.noise);
+
+    if(ASSERT(nesl_audio_noise_reset(&g_test.noise) == NESL_SUCCESS)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    if(ASSERT(!g_test.noise.enable
+            && (g_test.noise.length == 0)
+            && (g_test.noise.shift == 1)
+            && (g_test.noise.state.length.raw == 0))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
 
 exit:
     TEST_RESULT(result);
@@ -255,10 +279,10 @@ exit:
 }
 
 /*!
- * @brief Test audio noise synthesizer reset.
+ * @brief Test audio noise synthesizer set enable.
  * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
  */
-static nesl_error_e nesl_test_audio_noise_reset(void)
+static nesl_error_e nesl_test_audio_noise_set_enable(void)
 {
     nesl_error_e result;
 
@@ -266,7 +290,20 @@ static nesl_error_e nesl_test_audio_noise_reset(void)
         goto exit;
     }
 
-    /* TODO: TEST CONTENT */
+    nesl_audio_noise_set_enable(&g_test.noise, true);
+    nesl_audio_noise_write(&g_test.noise, 0x400F, 0x08);
+
+    if(ASSERT(g_test.noise.enable && (g_test.noise.length == 254))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    nesl_audio_noise_set_enable(&g_test.noise, false);
+
+    if(ASSERT(!g_test.noise.enable && (g_test.noise.length == 0))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
 
 exit:
     TEST_RESULT(result);
@@ -286,7 +323,17 @@ static nesl_error_e nesl_test_audio_noise_uninitialize(void)
         goto exit;
     }
 
-    /* TODO: TEST CONTENT */
+    nesl_audio_noise_set_enable(&g_test.noise, true);
+    nesl_audio_noise_write(&g_test.noise, 0x400F, 0x08);
+    nesl_audio_noise_uninitialize(&g_test.noise);
+
+    if(ASSERT(!g_test.noise.enable
+            && (g_test.noise.length == 0)
+            && (g_test.noise.shift == 0)
+            && (g_test.noise.state.length.raw == 0))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
 
 exit:
     TEST_RESULT(result);
@@ -306,7 +353,19 @@ static nesl_error_e nesl_test_audio_noise_write(void)
         goto exit;
     }
 
-    /* TODO: TEST CONTENT */
+    for(uint16_t address = 0x400C, data = 0x11; address <= 0x400F; ++address, data += 0x11) {
+        nesl_audio_noise_write(&g_test.noise, address, data);
+
+        if(ASSERT(g_test.noise.state.byte[address - 0x400C] == data)) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+
+        if(ASSERT(g_test.noise.envelope.start == (address == 0x400F))) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+    }
 
 exit:
     TEST_RESULT(result);
@@ -317,8 +376,9 @@ exit:
 int main(void)
 {
     const test TEST[] = {
-        nesl_test_audio_noise_cycle, nesl_test_audio_noise_initialize, nesl_test_audio_noise_read, nesl_test_audio_noise_readable,
-        nesl_test_audio_noise_reset, nesl_test_audio_noise_uninitialize, nesl_test_audio_noise_write,
+        nesl_test_audio_noise_cycle, nesl_test_audio_noise_frame, nesl_test_audio_noise_get_length, nesl_test_audio_noise_get_output,
+        nesl_test_audio_noise_initialize, nesl_test_audio_noise_reset, nesl_test_audio_noise_set_enable, nesl_test_audio_noise_uninitialize,
+        nesl_test_audio_noise_write,
         };
 
     nesl_error_e result = NESL_SUCCESS;
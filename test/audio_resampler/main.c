@@ -0,0 +1,360 @@
+/*
+ * NESL
+ * Copyright (C) 2022 David Jolly
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+ * @file main.c
+ * @brief Test application for audio polyphase FIR resampler.
+ */
+
+#include <math.h>
+#include <audio_resampler.h>
+#include <test.h>
+
+#define TEST_INPUT 893420               /*!< Input sample rate (Hz) */
+
+#ifdef NESL_AUDIO_S16
+#define TEST_AMPLITUDE 16384.f          /*!< Test signal amplitude */
+#else
+#define TEST_AMPLITUDE 0.5f             /*!< Test signal amplitude */
+#endif /* NESL_AUDIO_S16 */
+
+/*!
+ * @struct nesl_test_t
+ * @brief Contains the test contexts.
+ */
+typedef struct {
+    nesl_audio_resampler_t resampler;   /*!< Audio resampler context */
+} nesl_test_t;
+
+static nesl_test_t g_test = {};         /*!< Test context */
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+nesl_error_e nesl_set_error(const char *file, const char *function, int line, const char *format, ...)
+{
+    return NESL_FAILURE;
+}
+
+/*!
+ * @brief Uninitialize test context.
+ */
+static void nesl_test_uninitialize(void)
+{
+    nesl_audio_resampler_uninitialize(&g_test.resampler);
+    memset(&g_test, 0, sizeof(g_test));
+}
+
+/*!
+ * @brief Initialize test context.
+ * @param[in] output Output sample rate (Hz)
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_initialize(uint32_t output)
+{
+    nesl_test_uninitialize();
+
+    return nesl_audio_resampler_initialize(&g_test.resampler, TEST_INPUT, output);
+}
+
+/*!
+ * @brief Resample one second of a sine wave, returning the peak output amplitude after the filter settles.
+ * @param[in] frequency Sine wave frequency (Hz), or 0 for a constant signal
+ * @param[out] count Pointer to output sample count
+ * @return Peak output amplitude
+ */
+static float nesl_test_peak(float frequency, int *count)
+{
+    float result = 0.f;
+
+    *count = 0;
+
+    for(int index = 0; index < TEST_INPUT; ++index) {
+        nesl_audio_sample_t output;
+        float input = TEST_AMPLITUDE;
+
+        if(frequency > 0.f) {
+            input *= sinf((2.f * AUDIO_RESAMPLER_PI * frequency * index) / TEST_INPUT);
+        }
+
+#ifdef NESL_AUDIO_S16
+        input = lrintf(input);
+#endif /* NESL_AUDIO_S16 */
+
+        if(nesl_audio_resampler_write(&g_test.resampler, input, &output)) {
+
+            if((++*count > 100) && (fabsf(output) > result)) {
+                result = fabsf(output);
+            }
+        }
+    }
+
+    return result;
+}
+
+/*!
+ * @brief Test audio resampler initialization.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_audio_resampler_initialize(void)
+{
+    const uint32_t OUTPUT[] = { 44100, 48000, 96000, };
+    nesl_error_e result = NESL_SUCCESS;
+
+    if(ASSERT((nesl_test_initialize(0) == NESL_FAILURE)
+            && (nesl_test_initialize(TEST_INPUT / 2) == NESL_FAILURE))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    for(int index = 0; index < TEST_COUNT(OUTPUT); ++index) {
+
+        if(ASSERT(nesl_test_initialize(OUTPUT[index]) == NESL_SUCCESS)) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+
+        if(ASSERT((g_test.resampler.input == TEST_INPUT)
+                && (g_test.resampler.output == OUTPUT[index])
+                && (g_test.resampler.taps >= ((2 * AUDIO_RESAMPLER_ZEROS * TEST_INPUT) / OUTPUT[index]))
+                && !(g_test.resampler.taps % AUDIO_RESAMPLER_LANES)
+                && !((uintptr_t)g_test.resampler.coefficient % 32)
+                && (g_test.resampler.history != NULL))) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+
+        for(int phase = 0; phase < AUDIO_RESAMPLER_PHASES; ++phase) {
+            float sum = 0.f;
+
+            for(int tap = 0; tap < g_test.resampler.taps; ++tap) {
+                sum += g_test.resampler.coefficient[(phase * g_test.resampler.taps) + tap];
+            }
+
+#ifdef NESL_AUDIO_S16
+            sum /= (1 << AUDIO_RESAMPLER_SHIFT);
+#endif /* NESL_AUDIO_S16 */
+
+            if(ASSERT(fabsf(sum - 1.f) < 0.0001f)) {
+                result = NESL_FAILURE;
+                goto exit;
+            }
+        }
+    }
+
+exit:
+    TEST_RESULT(result);
+
+    return result;
+}
+
+/*!
+ * @brief Test audio resampler initialization, sharing one coefficient table between resamplers with the same sample rates.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_audio_resampler_initialize_shared(void)
+{
+    nesl_audio_resampler_t resampler[2] = {};
+    nesl_error_e result = NESL_SUCCESS;
+
+    if(ASSERT((nesl_test_initialize(44100) == NESL_SUCCESS)
+            && (nesl_audio_resampler_initialize(&resampler[0], TEST_INPUT, 44100) == NESL_SUCCESS)
+            && (nesl_audio_resampler_initialize(&resampler[1], TEST_INPUT, 48000) == NESL_SUCCESS))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    if(ASSERT((resampler[0].coefficient == g_test.resampler.coefficient)
+            && (resampler[1].coefficient != g_test.resampler.coefficient)
+            && (resampler[0].history != g_test.resampler.history))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    nesl_test_uninitialize();
+
+    for(int phase = 0; phase < AUDIO_RESAMPLER_PHASES; ++phase) {
+        float sum = 0.f;
+
+        for(int tap = 0; tap < resampler[0].taps; ++tap) {
+            sum += resampler[0].coefficient[(phase * resampler[0].taps) + tap];
+        }
+#ifdef NESL_AUDIO_S16
+        sum /= (1 << AUDIO_RESAMPLER_SHIFT);
+#endif /* NESL_AUDIO_S16 */
+
+        if(ASSERT(fabsf(sum - 1.f) < 0.0001f)) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+    }
+
+exit:
+    TEST_RESULT(result);
+    nesl_audio_resampler_uninitialize(&resampler[1]);
+    nesl_audio_resampler_uninitialize(&resampler[0]);
+    nesl_test_uninitialize();
+
+    return result;
+}
+
+/*!
+ * @brief Test audio resampler reset.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_audio_resampler_reset(void)
+{
+    nesl_audio_sample_t output;
+    nesl_error_e result;
+
+    if((result = nesl_test_initialize(44100)) == NESL_FAILURE) {
+        goto exit;
+    }
+
+    for(int index = 0; index < 1000; ++index) {
+        nesl_audio_resampler_write(&g_test.resampler, TEST_AMPLITUDE, &output);
+    }
+
+    if(ASSERT(nesl_audio_resampler_reset(&g_test.resampler) == NESL_SUCCESS)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    if(ASSERT((g_test.resampler.accumulator == 0)
+            && (g_test.resampler.index == 0))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    for(int index = 0; index < (2 * g_test.resampler.taps); ++index) {
+
+        if(ASSERT(g_test.resampler.history[index] == 0.f)) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+    }
+
+exit:
+    TEST_RESULT(result);
+
+    return result;
+}
+
+/*!
+ * @brief Test audio resampler uninitialization.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_audio_resampler_uninitialize(void)
+{
+    nesl_error_e result;
+
+    if((result = nesl_test_initialize(44100)) == NESL_FAILURE) {
+        goto exit;
+    }
+
+    nesl_audio_resampler_uninitialize(&g_test.resampler);
+
+    if(ASSERT((g_test.resampler.coefficient == NULL)
+            && (g_test.resampler.history == NULL)
+            && (g_test.resampler.taps == 0))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+
+    return result;
+}
+
+/*!
+ * @brief Test audio resampler write.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_audio_resampler_write(void)
+{
+    const uint32_t OUTPUT[] = { 44100, 48000, 96000, };
+    nesl_error_e result = NESL_SUCCESS;
+
+    for(int index = 0; index < TEST_COUNT(OUTPUT); ++index) {
+        int count;
+        float peak;
+
+        if(ASSERT(nesl_test_initialize(OUTPUT[index]) == NESL_SUCCESS)) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+
+        peak = nesl_test_peak(0.f, &count);
+
+        if(ASSERT((count == OUTPUT[index])
+                && (fabsf(peak - TEST_AMPLITUDE) < (TEST_AMPLITUDE * 0.001f)))) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+
+        nesl_audio_resampler_reset(&g_test.resampler);
+        peak = nesl_test_peak(1000.f, &count);
+
+        if(ASSERT(fabsf(peak - TEST_AMPLITUDE) < (TEST_AMPLITUDE * 0.01f))) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+
+        nesl_audio_resampler_reset(&g_test.resampler);
+        peak = nesl_test_peak(OUTPUT[index] * 0.75f, &count);
+
+        if(ASSERT(peak < (TEST_AMPLITUDE * 0.01f))) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+    }
+
+exit:
+    TEST_RESULT(result);
+
+    return result;
+}
+
+int main(void)
+{
+    const test TEST[] = {
+        nesl_test_audio_resampler_initialize, nesl_test_audio_resampler_initialize_shared, nesl_test_audio_resampler_reset, nesl_test_audio_resampler_uninitialize, nesl_test_audio_resampler_write,
+        };
+
+    nesl_error_e result = NESL_SUCCESS;
+
+    for(int index = 0; index < TEST_COUNT(TEST); ++index) {
+
+        if(TEST[index]() == NESL_FAILURE) {
+            result = NESL_FAILURE;
+        }
+    }
+
+    nesl_test_uninitialize();
+
+    return (int)result;
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
@@ -0,0 +1,299 @@
+/*
+ * NESL
+ * Copyright (C) 2022 David Jolly
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+ * @file main.c
+ * @brief Test application for audio file sink.
+ */
+
+#include <audio_sink.h>
+#include <test.h>
+
+#define TEST_PATH_FULL "/dev/full"              /*!< Full device test file path, failing every write */
+#define TEST_PATH_RAW "test_audio_sink.raw"     /*!< Raw PCM test file path */
+#define TEST_PATH_WAV "test_audio_sink.wav"     /*!< WAV test file path */
+
+/*!
+ * @struct nesl_test_t
+ * @brief Contains the test contexts.
+ */
+typedef struct {
+    nesl_audio_sink_t sink;                     /*!< Audio sink context */
+    nesl_audio_sample_t data[(AUDIO_SINK_SAMPLES * 2) + 5]; /*!< Audio data */
+} nesl_test_t;
+
+static nesl_test_t g_test = {};                 /*!< Test context */
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+nesl_error_e nesl_set_error(const char *file, const char *function, int line, const char *format, ...)
+{
+    return NESL_FAILURE;
+}
+
+/*!
+ * @brief Uninitialize test context.
+ */
+static void nesl_test_uninitialize(void)
+{
+    nesl_audio_sink_uninitialize(&g_test.sink);
+    memset(&g_test, 0, sizeof(g_test));
+    remove(TEST_PATH_RAW);
+    remove(TEST_PATH_WAV);
+}
+
+/*!
+ * @brief Initialize test context.
+ * @param[in] path Constant pointer to file path
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_initialize(const char *path)
+{
+    nesl_test_uninitialize();
+
+    for(int index = 0; index < TEST_COUNT(g_test.data); ++index) {
+        g_test.data[index] = (index % 256) - 128;
+    }
+
+    return nesl_audio_sink_initialize(&g_test.sink, path, 44100);
+}
+
+/*!
+ * @brief Read file at path into buffer.
+ * @param[in] path Constant pointer to file path
+ * @param[out] data Pointer to data buffer
+ * @param[in] length Data buffer length in bytes
+ * @return Number of bytes read, or -1 if the file does not exist
+ */
+static int nesl_test_read(const char *path, void *data, int length)
+{
+    FILE *file;
+    int result = -1;
+
+    if((file = fopen(path, "rb"))) {
+        result = fread(data, 1, length, file);
+        fclose(file);
+    }
+
+    return result;
+}
+
+/*!
+ * @brief Test audio sink initialization.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_audio_sink_initialize(void)
+{
+    nesl_error_e result;
+
+    if((result = nesl_test_initialize(TEST_PATH_RAW)) == NESL_FAILURE) {
+        goto exit;
+    }
+
+    if(ASSERT((g_test.sink.type == AUDIO_SINK_RAW)
+            && (g_test.sink.file != NULL)
+            && (g_test.sink.rate == 44100)
+            && (g_test.sink.length == 0)
+            && g_test.sink.running
+            && !g_test.sink.pending
+            && !g_test.sink.error)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    if((result = nesl_test_initialize(TEST_PATH_WAV)) == NESL_FAILURE) {
+        goto exit;
+    }
+
+    if(ASSERT((g_test.sink.type == AUDIO_SINK_WAV)
+            && (g_test.sink.file != NULL)
+            && g_test.sink.running)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    nesl_test_uninitialize();
+
+    if(ASSERT(nesl_audio_sink_initialize(&g_test.sink, "", 44100) == NESL_FAILURE)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+
+    return result;
+}
+
+/*!
+ * @brief Test audio sink uninitialization.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_audio_sink_uninitialize(void)
+{
+    uint8_t header[44] = {};
+    nesl_error_e result;
+
+    if((result = nesl_test_initialize(TEST_PATH_WAV)) == NESL_FAILURE) {
+        goto exit;
+    }
+
+    nesl_audio_sink_uninitialize(&g_test.sink);
+
+    if(ASSERT((g_test.sink.file == NULL)
+            && !g_test.sink.running
+            && (g_test.sink.batch[0].data == NULL)
+            && (g_test.sink.batch[1].data == NULL))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    if(ASSERT((nesl_test_read(TEST_PATH_WAV, header, sizeof(header)) == sizeof(header))
+            && !memcmp(&header[0], "RIFF", 4)
+            && (*(uint32_t *)&header[4] == 36)
+            && !memcmp(&header[8], "WAVEfmt ", 8)
+            && (*(uint16_t *)&header[22] == 1)
+            && (*(uint32_t *)&header[24] == 44100)
+            && (*(uint16_t *)&header[34] == (sizeof(nesl_audio_sample_t) * 8))
+            && !memcmp(&header[36], "data", 4)
+            && (*(uint32_t *)&header[40] == 0))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+
+    return result;
+}
+
+/*!
+ * @brief Test audio sink write.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_audio_sink_write(void)
+{
+    nesl_error_e result;
+    static nesl_audio_sample_t data[(AUDIO_SINK_SAMPLES * 2) + 64] = {};
+
+    if((result = nesl_test_initialize(TEST_PATH_RAW)) == NESL_FAILURE) {
+        goto exit;
+    }
+
+    for(int index = 0; index < TEST_COUNT(g_test.data); index += 128) {
+        int count = TEST_COUNT(g_test.data) - index;
+
+        if(ASSERT(nesl_audio_sink_write(&g_test.sink, &g_test.data[index], (count > 128) ? 128 : count) == NESL_SUCCESS)) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+    }
+
+    nesl_audio_sink_uninitialize(&g_test.sink);
+
+    if(ASSERT((nesl_test_read(TEST_PATH_RAW, data, sizeof(data)) == sizeof(g_test.data))
+            && !memcmp(data, g_test.data, sizeof(g_test.data)))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    if((result = nesl_test_initialize(TEST_PATH_WAV)) == NESL_FAILURE) {
+        goto exit;
+    }
+
+    if(ASSERT(nesl_audio_sink_write(&g_test.sink, g_test.data, TEST_COUNT(g_test.data)) == NESL_SUCCESS)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    nesl_audio_sink_uninitialize(&g_test.sink);
+
+    if(ASSERT((nesl_test_read(TEST_PATH_WAV, data, sizeof(data)) == (sizeof(g_test.data) + 44))
+            && (*(uint32_t *)((uint8_t *)data + 4) == (sizeof(g_test.data) + 36))
+            && (*(uint32_t *)((uint8_t *)data + 40) == sizeof(g_test.data))
+            && !memcmp((uint8_t *)data + 44, g_test.data, sizeof(g_test.data)))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+
+    return result;
+}
+
+/*!
+ * @brief Test audio sink write failure, reported by the next batch queued and on uninitialization.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_audio_sink_write_failure(void)
+{
+    nesl_error_e result;
+
+    if((result = nesl_test_initialize(TEST_PATH_FULL)) == NESL_FAILURE) {
+        goto exit;
+    }
+
+    if(ASSERT((nesl_audio_sink_write(&g_test.sink, g_test.data, AUDIO_SINK_SAMPLES) == NESL_SUCCESS)
+            && (nesl_audio_sink_write(&g_test.sink, g_test.data, AUDIO_SINK_SAMPLES) == NESL_FAILURE)
+            && (g_test.sink.error == ENOSPC))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    if(ASSERT(nesl_audio_sink_uninitialize(&g_test.sink) == NESL_FAILURE)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+    nesl_test_uninitialize();
+
+    return result;
+}
+
+int main(void)
+{
+    const test TEST[] = {
+        nesl_test_audio_sink_initialize, nesl_test_audio_sink_uninitialize, nesl_test_audio_sink_write,
+        nesl_test_audio_sink_write_failure,
+        };
+
+    nesl_error_e result = NESL_SUCCESS;
+
+    for(int index = 0; index < TEST_COUNT(TEST); ++index) {
+
+        if(TEST[index]() == NESL_FAILURE) {
+            result = NESL_FAILURE;
+        }
+    }
+
+    nesl_test_uninitialize();
+
+    return (int)result;
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
@@ -33,7 +33,6 @@
  */
 typedef struct {
     nesl_audio_square_t square; /*!< Audio square-wave synthesizer context */
-    float buffer[256];          /*!< Audio buffer */
 } nesl_test_t;
 
 static nesl_test_t g_test = {}; /*!< Test context */
@@ -43,142 +42,139 @@ extern "C" {
 #endif /* __cplusplus */
 
 /*!
- * @brief Copy audio data into circular buffer.
- * @param[in,out] buffer Constant pointer to audio buffer context
- * @param[in,out] data Pointer to data array
- * @param[in] count Maximum number of entries in data array
+ * @brief Uninitialize test context.
  */
-static void nesl_audio_buffer_copy_out(nesl_audio_buffer_t *buffer, float *data, int count)
+static void nesl_test_uninitialize(void)
 {
-
-    if((buffer->read + count) >= buffer->count) {
-        int offset = buffer->count - buffer->read;
-
-        memcpy(data, &buffer->data[buffer->read], offset * sizeof(*data));
-        count -= offset;
-        data += offset;
-        buffer->read = 0;
-    }
-
-    memcpy(data, &buffer->data[buffer->read], count * sizeof(*data));
-    buffer->read += count;
-    buffer->full = false;
+    nesl_audio_square_uninitialize(&g_test.square);
+    memset(&g_test, 0, sizeof(g_test));
 }
 
 /*!
- * @brief Calculate the distance between the left and right offet, with wrap-around.
- * @param[in] count Maximum count (used to wrap-around)
- * @param[in] left Left offset
- * @param[in] right Right offset
- * @return Distance between offsets
+ * @brief Initialize test context.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
  */
-static int nesl_audio_buffer_distance(int count, int left, int right)
+static int nesl_test_initialize(void)
 {
-    int result = 0;
-
-    if(left <= right) {
-        result = right - left;
-    } else {
-        result = (count - left) + right;
-    }
+    nesl_test_uninitialize();
 
-    return result;
+    return nesl_audio_square_initialize(&g_test.square, 0);
 }
 
 /*!
- * @brief Calculate the minimum between the left and right offset.
- * @param[in] left Left offset
- * @param[in] right Right offset
- * @return Minimum between offsets
+ * @brief Test audio square synthesizer cycle.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
  */
-static int nesl_audio_buffer_minimum(int left, int right)
+static nesl_error_e nesl_test_audio_square_cycle(void)
 {
-    return (left > right) ? right : left;
-}
+    nesl_error_e result;
 
-/*!
- * @brief Determine if buffer is empty.
- * @return true if empty, false otherwise
- */
-static bool nesl_audio_buffer_empty(nesl_audio_buffer_t *buffer)
-{
-    return !buffer->full && (buffer->write == buffer->read);
-}
+    if((result = nesl_test_initialize()) == NESL_FAILURE) {
+        goto exit;
+    }
 
-nesl_error_e nesl_audio_buffer_initialize(nesl_audio_buffer_t *buffer, int count)
-{
-    nesl_error_e result = NESL_SUCCESS;
+    nesl_audio_square_write(&g_test.square, 0x4002, 0x10);
+    nesl_audio_square_write(&g_test.square, 0x4003, 0x00);
 
-    if(count != 256) {
+    for(int cycle = 0; cycle <= 0x10; ++cycle) {
+        nesl_audio_square_cycle(&g_test.square);
+    }
+
+    if(ASSERT((g_test.square.timer.step == 1)
+            && (g_test.square.timer.count == 0))) {
         result = NESL_FAILURE;
         goto exit;
     }
 
-    buffer->data = g_test.buffer;
-    buffer->count = count;
+    for(int step = 1; step < 8; ++step) {
+
+        for(int cycle = 0; cycle <= 0x10; ++cycle) {
+            nesl_audio_square_cycle(&g_test.square);
+        }
+    }
+
+    if(ASSERT(g_test.square.timer.step == 0)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
 
 exit:
+    TEST_RESULT(result);
+
     return result;
 }
 
-int nesl_audio_buffer_read(nesl_audio_buffer_t *buffer, float *data, int count)
+/*!
+ * @brief Test audio square synthesizer frame.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_audio_square_frame(void)
 {
-    int result = 0;
+    nesl_error_e result;
 
-    if(!nesl_audio_buffer_empty(buffer)) {
+    if((result = nesl_test_initialize()) == NESL_FAILURE) {
+        goto exit;
+    }
 
-        if((result = nesl_audio_buffer_minimum(nesl_audio_buffer_distance(buffer->count, buffer->read, buffer->write), count)) > 0) {
-            nesl_audio_buffer_copy_out(buffer, data, result);
-        }
+    nesl_audio_square_set_enable(&g_test.square, true);
+    nesl_audio_square_write(&g_test.square, 0x4000, 0x02);
+    nesl_audio_square_write(&g_test.square, 0x4003, 0x08);
+    nesl_audio_square_frame(&g_test.square, false);
+
+    if(ASSERT((g_test.square.envelope.decay == 15)
+            && (g_test.square.envelope.divider == 2)
+            && (g_test.square.length == 254))) {
+        result = NESL_FAILURE;
+        goto exit;
     }
 
-    return result;
-}
+    for(int frame = 0; frame < 3; ++frame) {
+        nesl_audio_square_frame(&g_test.square, false);
+    }
 
-int nesl_audio_buffer_readable(nesl_audio_buffer_t *buffer)
-{
-    return nesl_audio_buffer_distance(buffer->count, buffer->read, buffer->write);
-}
+    if(ASSERT((g_test.square.envelope.decay == 14)
+            && (g_test.square.envelope.divider == 2))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
 
-nesl_error_e nesl_audio_buffer_reset(nesl_audio_buffer_t *buffer)
-{
-    buffer->read = 0;
-    buffer->write = 0;
+    nesl_audio_square_frame(&g_test.square, true);
 
-    return NESL_SUCCESS;
-}
+    if(ASSERT(g_test.square.length == 253)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
 
-void nesl_audio_buffer_uninitialize(nesl_audio_buffer_t *buffer)
-{
-    memset(g_test.buffer, 0, 256 * sizeof(*g_test.buffer));
-    memset(buffer, 0, sizeof(*buffer));
-}
+    nesl_audio_square_write(&g_test.square, 0x4000, 0x20);
+    nesl_audio_square_frame(&g_test.square, true);
 
-/*!
- * @brief Uninitialize test context.
- */
-static void nesl_test_uninitialize(void)
-{
-    nesl_audio_square_uninitialize(&g_test.square);
-    memset(&g_test, 0, sizeof(g_test));
-}
+    if(ASSERT(g_test.square.length == 253)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
 
-/*!
- * @brief Initialize test context.
- * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
- */
-static int nesl_test_initialize(void)
-{
-    nesl_test_uninitialize();
+    nesl_audio_square_write(&g_test.square, 0x4001, 0x81);
+    nesl_audio_square_write(&g_test.square, 0x4002, 0x00);
+    nesl_audio_square_write(&g_test.square, 0x4003, 0x01);
+    nesl_audio_square_frame(&g_test.square, true);
+
+    if(ASSERT((g_test.square.state.period_low == 0x80)
+            && (g_test.square.state.length.period_high == 0x01))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
 
-    return nesl_audio_square_initialize(&g_test.square);
+exit:
+    TEST_RESULT(result);
+
+    return result;
 }
 
 /*!
- * @brief Test audio square synthesizer cycle.
+ * @brief Test audio square synthesizer get length.
  * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
  */
-static nesl_error_e nesl_test_audio_square_cycle(void)
+static nesl_error_e nesl_test_audio_square_get_length(void)
 {
     nesl_error_e result;
 
@@ -186,7 +182,20 @@ static nesl_error_e nesl_test_audio_square_cycle(void)
         goto exit;
     }
 
-    /* TODO: TEST CONTENT */
+    nesl_audio_square_write(&g_test.square, 0x4003, 0x08);
+
+    if(ASSERT(nesl_audio_square_get_length(&g_test.square) == 0)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    nesl_audio_square_set_enable(&g_test.square, true);
+    nesl_audio_square_write(&g_test.square, 0x4003, 0x08);
+
+    if(ASSERT(nesl_audio_square_get_length(&g_test.square) == 254)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
 
 exit:
     TEST_RESULT(result);
@@ -195,10 +204,10 @@ exit:
 }
 
 /*!
- * @brief Test audio square synthesizer initialization.
+ * @brief Test audio square synthesizer get output.
  * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
  */
-static nesl_error_e nesl_test_audio_square_initialize(void)
+static nesl_error_e nesl_test_audio_square_get_output(void)
 {
     nesl_error_e result;
 
@@ -206,7 +215,31 @@ static nesl_error_e nesl_test_audio_square_initialize(void)
         goto exit;
     }
 
-    /* TODO: TEST CONTENT */
+    nesl_audio_square_set_enable(&g_test.square, true);
+    nesl_audio_square_write(&g_test.square, 0x4000, 0x9A);
+    nesl_audio_square_write(&g_test.square, 0x4002, 0x10);
+    nesl_audio_square_write(&g_test.square, 0x4003, 0x08);
+
+    for(int step = 0; step < 8; ++step) {
+
+        if(ASSERT(nesl_audio_square_get_output(&g_test.square) == (((step >= 1) && (step <= 4)) ? 10 : 0))) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+
+        for(int cycle = 0; cycle <= 0x10; ++cycle) {
+            nesl_audio_square_cycle(&g_test.square);
+        }
+    }
+
+    nesl_audio_square_write(&g_test.square, 0x4002, 0x07);
+    nesl_audio_square_write(&g_test.square, 0x4003, 0x08);
+    nesl_audio_square_cycle(&g_test.square);
+
+    if(ASSERT(nesl_audio_square_get_output(&g_test.square) == 0)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
 
 exit:
     TEST_RESULT(result);
@@ -215,10 +248,10 @@ exit:
 }
 
 /*!
- * @brief Test audio square synthesizer read.
+ * @brief Test audio square synthesizer initialization.
  * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
  */
-static nesl_error_e nesl_test_audio_square_read(void)
+static nesl_error_e nesl_test_audio_square_initialize(void)
 {
     nesl_error_e result;
 
@@ -226,7 +259,14 @@ static nesl_error_e nesl_test_audio_square_read(void)
         goto exit;
     }
 
-    /* TODO: TEST CONTENT */
+    if(ASSERT((g_test.square.channel == 0)
+            && !g_test.square.enable
+            && (g_test.square.length == 0)
+            && (g_test.square.timer.count == 0)
+            && (g_test.square.timer.step == 0))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
 
 exit:
     TEST_RESULT(result);
@@ -235,10 +275,10 @@ exit:
 }
 
 /*!
- * @brief Test audio square synthesizer readable.
+ * @brief Test audio square synthesizer reset.
  * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
  */
-static nesl_error_e nesl_test_audio_square_readable(void)
+static nesl_error_e nesl_test_audio_square_reset(void)
 {
     nesl_error_e result;
 
@@ -246,7 +286,22 @@ static nesl_error_e nesl_test_audio_square_readable(void)
         goto exit;
     }
 
-    /* TODO: TEST CONTENT */
+    g_test.square.channel = 1;
+    nesl_audio_square_set_enable(&g_test.square, true);
+    nesl_audio_square_write(&g_test.square, 0x4003, 0x08);
+
+    if(ASSERT(nesl_audio_square_reset(&g_test.square) == NESL_SUCCESS)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    if(ASSERT((g_test.square.channel == 1)
+            && !g_test.square.enable
+            && (g_test.square.length == 0)
+            && (g_test.square.state.length.raw == 0))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
 
 exit:
     TEST_RESULT(result);
@@ -255,10 +310,10 @@ exit:
 }
 
 /*!
- * @brief Test audio square synthesizer reset.
+ * @brief Test audio square synthesizer set enable.
  * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
  */
-static nesl_error_e nesl_test_audio_square_reset(void)
+static nesl_error_e nesl_test_audio_square_set_enable(void)
 {
     nesl_error_e result;
 
@@ -266,7 +321,20 @@ static nesl_error_e nesl_test_audio_square_reset(void)
         goto exit;
     }
 
-    /* TODO: TEST CONTENT */
+    nesl_audio_square_set_enable(&g_test.square, true);
+    nesl_audio_square_write(&g_test.square, 0x4003, 0x08);
+
+    if(ASSERT(g_test.square.enable && (g_test.square.length == 254))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    nesl_audio_square_set_enable(&g_test.square, false);
+
+    if(ASSERT(!g_test.square.enable && (g_test.square.length == 0))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
 
 exit:
     TEST_RESULT(result);
@@ -286,7 +354,16 @@ static nesl_error_e nesl_test_audio_square_uninitialize(void)
         goto exit;
     }
 
-    /* TODO: TEST CONTENT */
+    nesl_audio_square_set_enable(&g_test.square, true);
+    nesl_audio_square_write(&g_test.square, 0x4003, 0x08);
+    nesl_audio_square_uninitialize(&g_test.square);
+
+    if(ASSERT(!g_test.square.enable
+            && (g_test.square.length == 0)
+            && (g_test.square.state.length.raw == 0))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
 
 exit:
     TEST_RESULT(result);
@@ -306,7 +383,33 @@ static nesl_error_e nesl_test_audio_square_write(void)
         goto exit;
     }
 
-    /* TODO: TEST CONTENT */
+    for(uint16_t address = 0x4000, data = 0x11; address <= 0x4003; ++address, data += 0x11) {
+        nesl_audio_square_write(&g_test.square, address, data);
+
+        if(ASSERT(g_test.square.state.byte[address - 0x4000] == data)) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+
+        switch(address) {
+            case 0x4001:
+
+                if(ASSERT(g_test.square.sweep.reload)) {
+                    result = NESL_FAILURE;
+                    goto exit;
+                }
+                break;
+            case 0x4003:
+
+                if(ASSERT(g_test.square.envelope.start && (g_test.square.timer.step == 0))) {
+                    result = NESL_FAILURE;
+                    goto exit;
+                }
+                break;
+            default:
+                break;
+        }
+    }
 
 exit:
     TEST_RESULT(result);
@@ -317,8 +420,9 @@ exit:
 int main(void)
 {
     const test TEST[] = {
-        nesl_test_audio_square_cycle, nesl_test_audio_square_initialize, nesl_test_audio_square_read, nesl_test_audio_square_readable,
-        nesl_test_audio_square_reset, nesl_test_audio_square_uninitialize, nesl_test_audio_square_write,
+        nesl_test_audio_square_cycle, nesl_test_audio_square_frame, nesl_test_audio_square_get_length, nesl_test_audio_square_get_output,
+        nesl_test_audio_square_initialize, nesl_test_audio_square_reset, nesl_test_audio_square_set_enable, nesl_test_audio_square_uninitialize,
+        nesl_test_audio_square_write,
         };
 
     nesl_error_e result = NESL_SUCCESS;
@@ -33,7 +33,6 @@
  */
 typedef struct {
     nesl_audio_triangle_t triangle; /*!< Audio triangle-wave synthesizer context */
-    float buffer[256];              /*!< Audio buffer */
 } nesl_test_t;
 
 static nesl_test_t g_test = {};     /*!< Test context */
@@ -43,142 +42,127 @@ extern "C" {
 #endif /* __cplusplus */
 
 /*!
- * @brief Copy audio data into circular buffer.
- * @param[in,out] buffer Constant pointer to audio buffer context
- * @param[in,out] data Pointer to data array
- * @param[in] count Maximum number of entries in data array
+ * @brief Uninitialize test context.
  */
-static void nesl_audio_buffer_copy_out(nesl_audio_buffer_t *buffer, float *data, int count)
+static void nesl_test_uninitialize(void)
 {
-
-    if((buffer->read + count) >= buffer->count) {
-        int offset = buffer->count - buffer->read;
-
-        memcpy(data, &buffer->data[buffer->read], offset * sizeof(*data));
-        count -= offset;
-        data += offset;
-        buffer->read = 0;
-    }
-
-    memcpy(data, &buffer->data[buffer->read], count * sizeof(*data));
-    buffer->read += count;
-    buffer->full = false;
+    nesl_audio_triangle_uninitialize(&g_test.triangle);
+    memset(&g_test, 0, sizeof(g_test));
 }
 
 /*!
- * @brief Calculate the distance between the left and right offet, with wrap-around.
- * @param[in] count Maximum count (used to wrap-around)
- * @param[in] left Left offset
- * @param[in] right Right offset
- * @return Distance between offsets
+ * @brief Initialize test context.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
  */
-static int nesl_audio_buffer_distance(int count, int left, int right)
+static int nesl_test_initialize(void)
 {
-    int result = 0;
-
-    if(left <= right) {
-        result = right - left;
-    } else {
-        result = (count - left) + right;
-    }
+    nesl_test_uninitialize();
 
-    return result;
+    return nesl_audio_triangle_initialize(&g_test.triangle);
 }
 
 /*!
- * @brief Calculate the minimum between the left and right offset.
- * @param[in] left Left offset
- * @param[in] right Right offset
- * @return Minimum between offsets
+ * @brief Test audio triangle synthesizer cycle.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
  */
-static int nesl_audio_buffer_minimum(int left, int right)
+static nesl_error_e nesl_test_audio_triangle_cycle(void)
 {
-    return (left > right) ? right : left;
-}
+    nesl_error_e result;
 
-/*!
- * @brief Determine if buffer is empty.
- * @return true if empty, false otherwise
- */
-static bool nesl_audio_buffer_empty(nesl_audio_buffer_t *buffer)
-{
-    return !buffer->full && (buffer->write == buffer->read);
-}
+    if((result = nesl_test_initialize()) == NESL_FAILURE) {
+        goto exit;
+    }
 
-nesl_error_e nesl_audio_buffer_initialize(nesl_audio_buffer_t *buffer, int count)
-{
-    nesl_error_e result = NESL_SUCCESS;
+    nesl_audio_triangle_write(&g_test.triangle, 0x400A, 0x10);
+    nesl_audio_triangle_write(&g_test.triangle, 0x400B, 0x00);
+
+    for(int cycle = 0; cycle <= 0x10; ++cycle) {
+        nesl_audio_triangle_cycle(&g_test.triangle);
+    }
 
-    if(count != 256) {
+    if(ASSERT(g_test.triangle.timer.step == 0)) {
         result = NESL_FAILURE;
         goto exit;
     }
 
-    buffer->data = g_test.buffer;
-    buffer->count = count;
-
-exit:
-    return result;
-}
+    nesl_audio_triangle_set_enable(&g_test.triangle, true);
+    nesl_audio_triangle_write(&g_test.triangle, 0x4008, 0x7F);
+    nesl_audio_triangle_write(&g_test.triangle, 0x400B, 0x08);
+    nesl_audio_triangle_frame(&g_test.triangle, false);
 
-int nesl_audio_buffer_read(nesl_audio_buffer_t *buffer, float *data, int count)
-{
-    int result = 0;
+    for(int step = 0; step < 32; ++step) {
 
-    if(!nesl_audio_buffer_empty(buffer)) {
+        for(int cycle = 0; cycle <= 0x10; ++cycle) {
+            nesl_audio_triangle_cycle(&g_test.triangle);
+        }
 
-        if((result = nesl_audio_buffer_minimum(nesl_audio_buffer_distance(buffer->count, buffer->read, buffer->write), count)) > 0) {
-            nesl_audio_buffer_copy_out(buffer, data, result);
+        if(ASSERT(g_test.triangle.timer.step == ((step + 1) & 31))) {
+            result = NESL_FAILURE;
+            goto exit;
         }
     }
 
+exit:
+    TEST_RESULT(result);
+
     return result;
 }
 
-int nesl_audio_buffer_readable(nesl_audio_buffer_t *buffer)
+/*!
+ * @brief Test audio triangle synthesizer frame.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_audio_triangle_frame(void)
 {
-    return nesl_audio_buffer_distance(buffer->count, buffer->read, buffer->write);
-}
+    nesl_error_e result;
 
-nesl_error_e nesl_audio_buffer_reset(nesl_audio_buffer_t *buffer)
-{
-    buffer->read = 0;
-    buffer->write = 0;
+    if((result = nesl_test_initialize()) == NESL_FAILURE) {
+        goto exit;
+    }
 
-    return NESL_SUCCESS;
-}
+    nesl_audio_triangle_set_enable(&g_test.triangle, true);
+    nesl_audio_triangle_write(&g_test.triangle, 0x4008, 0x04);
+    nesl_audio_triangle_write(&g_test.triangle, 0x400B, 0x08);
+    nesl_audio_triangle_frame(&g_test.triangle, false);
 
-void nesl_audio_buffer_uninitialize(nesl_audio_buffer_t *buffer)
-{
-    memset(g_test.buffer, 0, 256 * sizeof(*g_test.buffer));
-    memset(buffer, 0, sizeof(*buffer));
-}
+    if(ASSERT((g_test.triangle.linear.counter == 4)
+            && !g_test.triangle.linear.reload
+            && (g_test.triangle.length == 254))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
 
-/*!
- * @brief Uninitialize test context.
- */
-static void nesl_test_uninitialize(void)
-{
-    nesl_audio_triangle_uninitialize(&g_test.triangle);
-    memset(&g_test, 0, sizeof(g_test));
-}
+    nesl_audio_triangle_frame(&g_test.triangle, true);
 
-/*!
- * @brief Initialize test context.
- * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
- */
-static int nesl_test_initialize(void)
-{
-    nesl_test_uninitialize();
+    if(ASSERT((g_test.triangle.linear.counter == 3)
+            && (g_test.triangle.length == 253))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
 
-    return nesl_audio_triangle_initialize(&g_test.triangle);
+    nesl_audio_triangle_write(&g_test.triangle, 0x4008, 0x84);
+    nesl_audio_triangle_write(&g_test.triangle, 0x400B, 0x08);
+    nesl_audio_triangle_frame(&g_test.triangle, true);
+    nesl_audio_triangle_frame(&g_test.triangle, true);
+
+    if(ASSERT((g_test.triangle.linear.counter == 4)
+            && g_test.triangle.linear.reload
+            && (g_test.triangle.length == 254))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+
+    return result;
 }
 
 /*!
- * @brief Test audio triangle synthesizer cycle.
+ * @brief Test audio triangle synthesizer get length.
  * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
  */
-static nesl_error_e nesl_test_audio_triangle_cycle(void)
+static nesl_error_e nesl_test_audio_triangle_get_length(void)
 {
     nesl_error_e result;
 
@@ -186,7 +170,20 @@ static nesl_error_e nesl_test_audio_triangle_cycle(void)
         goto exit;
     }
 
-    /* TODO: TEST CONTENT */
+    nesl_audio_triangle_write(&g_test.triangle, 0x400B, 0x18);
+
+    if(ASSERT(nesl_audio_triangle_get_length(&g_test.triangle) == 0)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    nesl_audio_triangle_set_enable(&g_test.triangle, true);
+    nesl_audio_triangle_write(&g_test.triangle, 0x400B, 0x18);
+
+    if(ASSERT(nesl_audio_triangle_get_length(&g_test.triangle) == 2)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
 
 exit:
     TEST_RESULT(result);
@@ -195,10 +192,10 @@ exit:
 }
 
 /*!
- * @brief Test audio triangle synthesizer initialization.
+ * @brief Test audio triangle synthesizer get output.
  * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
  */
-static nesl_error_e nesl_test_audio_triangle_initialize(void)
+static nesl_error_e nesl_test_audio_triangle_get_output(void)
 {
     nesl_error_e result;
 
@@ -206,7 +203,14 @@ static nesl_error_e nesl_test_audio_triangle_initialize(void)
         goto exit;
     }
 
-    /* TODO: TEST CONTENT */
+    for(uint8_t step = 0; step < 32; ++step) {
+        g_test.triangle.timer.step = step;
+
+        if(ASSERT(nesl_audio_triangle_get_output(&g_test.triangle) == ((step < 16) ? (15 - step) : (step - 16)))) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+    }
 
 exit:
     TEST_RESULT(result);
@@ -215,10 +219,10 @@ exit:
 }
 
 /*!
- * @brief Test audio triangle synthesizer read.
+ * @brief Test audio triangle synthesizer initialization.
  * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
  */
-static nesl_error_e nesl_test_audio_triangle_read(void)
+static nesl_error_e nesl_test_audio_triangle_initialize(void)
 {
     nesl_error_e result;
 
@@ -226,7 +230,13 @@ static nesl_error_e nesl_test_audio_triangle_read(void)
         goto exit;
     }
 
-    /* TODO: TEST CONTENT */
+    if(ASSERT(!g_test.triangle.enable
+            && (g_test.triangle.length == 0)
+            && (g_test.triangle.linear.counter == 0)
+            && (g_test.triangle.timer.step == 0))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
 
 exit:
     TEST_RESULT(result);
@@ -235,10 +245,10 @@ exit:
 }
 
 /*!
- * @brief Test audio triangle synthesizer readable.
+ * @brief Test audio triangle synthesizer reset.
  * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
  */
-static nesl_error_e nesl_test_audio_triangle_readable(void)
+static nesl_error_e nesl_test_audio_triangle_reset(void)
 {
     nesl_error_e result;
 
@@ -246,7 +256,21 @@ static nesl_error_e nesl_test_audio_triangle_readable(void)
         goto exit;
     }
 
-    /* TODO: TEST CONTENT */
+    nesl_audio_triangle_set_enable(&g_test.triangle, true);
+    nesl_audio_triangle_write(&g_test.triangle, 0x400B, 0x08);
+
+    if(ASSERT(nesl_audio_triangle_reset(&g_test.triangle) == NESL_SUCCESS)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    if(ASSERT(!g_test.triangle.enable
+            && (g_test.triangle.length == 0)
+            && !g_test.triangle.linear.reload
+            && (g_test.triangle.state.length.raw == 0))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
 
 exit:
     TEST_RESULT(result);
@@ -255,10 +279,10 @@ exit:
 }
 
 /*!
- * @brief Test audio triangle synthesizer reset.
+ * @brief Test audio triangle synthesizer set enable.
  * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
  */
-static nesl_error_e nesl_test_audio_triangle_reset(void)
+static nesl_error_e nesl_test_audio_triangle_set_enable(void)
 {
     nesl_error_e result;
 
@@ -266,7 +290,20 @@ static nesl_error_e nesl_test_audio_triangle_reset(void)
         goto exit;
     }
 
-    /* TODO: TEST CONTENT */
+    nesl_audio_triangle_set_enable(&g_test.triangle, true);
+    nesl_audio_triangle_write(&g_test.triangle, 0x400B, 0x08);
+
+    if(ASSERT(g_test.triangle.enable && (g_test.triangle.length == 254))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    nesl_audio_triangle_set_enable(&g_test.triangle, false);
+
+    if(ASSERT(!g_test.triangle.enable && (g_test.triangle.length == 0))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
 
 exit:
     TEST_RESULT(result);
@@ -286,7 +323,16 @@ static nesl_error_e nesl_test_audio_triangle_uninitialize(void)
         goto exit;
     }
 
-    /* TODO: TEST CONTENT */
+    nesl_audio_triangle_set_enable(&g_test.triangle, true);
+    nesl_audio_triangle_write(&g_test.triangle, 0x400B, 0x08);
+    nesl_audio_triangle_uninitialize(&g_test.triangle);
+
+    if(ASSERT(!g_test.triangle.enable
+            && (g_test.triangle.length == 0)
+            && (g_test.triangle.state.length.raw == 0))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
 
 exit:
     TEST_RESULT(result);
@@ -306,7 +352,19 @@ static nesl_error_e nesl_test_audio_triangle_write(void)
         goto exit;
     }
 
-    /* TODO: TEST CONTENT */
+    for(uint16_t address = 0x4008, data = 0x11; address <= 0x400B; ++address, data += 0x11) {
+        nesl_audio_triangle_write(&g_test.triangle, address, data);
+
+        if(ASSERT(g_test.triangle.state.byte[address - 0x4008] == data)) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+
+        if(ASSERT(g_test.triangle.linear.reload == (address == 0x400B))) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+    }
 
 exit:
     TEST_RESULT(result);
@@ -317,8 +375,9 @@ exit:
 int main(void)
 {
     const test TEST[] = {
-        nesl_test_audio_triangle_cycle, nesl_test_audio_triangle_initialize, nesl_test_audio_triangle_read, nesl_test_audio_triangle_readable,
-        nesl_test_audio_triangle_reset, nesl_test_audio_triangle_uninitialize, nesl_test_audio_triangle_write,
+        nesl_test_audio_triangle_cycle, nesl_test_audio_triangle_frame, nesl_test_audio_triangle_get_length, nesl_test_audio_triangle_get_output,
+        nesl_test_audio_triangle_initialize, nesl_test_audio_triangle_reset, nesl_test_audio_triangle_set_enable, nesl_test_audio_triangle_uninitialize,
+        nesl_test_audio_triangle_write,
         };
 
     nesl_error_e result = NESL_SUCCESS;
@@ -28,9 +28,16 @@
 #include <input.h>
 #include <mapper.h>
 #include <processor.h>
+#include <rewind.h>
+#include <slot.h>
 #include <video.h>
 #include <test.h>
 
+/*!
+ * @brief Maximum number of rewind states held by the test.
+ */
+#define TEST_REWIND 4
+
 /*!
  * @struct nesl_test_t
  * @brief Contains the test contexts.
@@ -40,6 +47,19 @@ typedef struct {
     uint16_t address;                   /*!< Bank address */
     uint8_t data;                       /*!< Bank data */
 
+    struct {
+        nesl_rewind_t *context;         /*!< Rewind context */
+        size_t length;                  /*!< State length in bytes */
+        uint8_t *state[TEST_REWIND];    /*!< Pushed states */
+    } rewind;
+
+    struct {
+        const char *directory;          /*!< Save slot directory */
+        size_t length;                  /*!< State length in bytes */
+        int index;                      /*!< Saved slot index (-1 if none) */
+        uint8_t *state;                 /*!< Saved state */
+    } slot;
+
     struct {
         bool reset;                     /*!< Reset state */
     } service;
@@ -47,6 +67,7 @@ typedef struct {
     struct {
 
         struct {
+            bool hidden;                /*!< Hidden state */
             bool reset;                 /*!< Reset state */
         } audio;
 
@@ -55,6 +76,7 @@ typedef struct {
         } input;
 
         struct {
+            int flush;                  /*!< Flush count */
             bool interrupt;             /*!< Interrupt state */
             bool reset;                 /*!< Reset state */
         } mapper;
@@ -66,6 +88,7 @@ typedef struct {
         } processor;
 
         struct {
+            bool hidden;                /*!< Hidden state */
             bool reset;                 /*!< Reset state */
         } video;
     } subsystem;
@@ -77,12 +100,56 @@ static nesl_test_t g_test = {};         /*!< Test context */
 extern "C" {
 #endif /* __cplusplus */
 
+void *nesl_arena_allocate(nesl_arena_t *arena, size_t size)
+{
+    void *result = NULL;
+
+    if(ARENA_SIZE(size) <= (arena->capacity - arena->offset)) {
+        result = &arena->data[arena->offset];
+        arena->offset += ARENA_SIZE(size);
+    }
+
+    return result;
+}
+
+nesl_error_e nesl_arena_initialize(nesl_arena_t *arena, size_t capacity)
+{
+    arena->capacity = capacity;
+    arena->offset = 0;
+
+    return (arena->data = calloc(1, capacity)) ? NESL_SUCCESS : NESL_FAILURE;
+}
+
+void nesl_arena_uninitialize(nesl_arena_t *arena)
+{
+    free(arena->data);
+    memset(arena, 0, sizeof(*arena));
+}
+
+size_t nesl_dirty_copy(uint64_t *dirty, void *destination, const void *source, size_t length)
+{
+    memcpy(destination, source, length);
+    memset(dirty, 0, DIRTY_WORDS(length) * sizeof(*dirty));
+
+    return length;
+}
+
+void nesl_dirty_set(uint64_t *dirty, size_t length)
+{
+    memset(dirty, 0xFF, DIRTY_WORDS(length) * sizeof(*dirty));
+}
+
 void nesl_audio_cycle(nesl_audio_t *audio, uint64_t cycle)
 {
-    return;
+    g_test.subsystem.audio.hidden = audio->hidden;
+}
+
+size_t nesl_audio_get_size(bool quiet)
+{
+    return 0;
 }
 
-nesl_error_e nesl_audio_initialize(nesl_audio_t *audio)
+nesl_error_e nesl_audio_initialize(nesl_audio_t *audio, nesl_arena_t *arena, bool quiet, const char *record, int rate)
 {
     return NESL_SUCCESS;
 }
@@ -101,9 +168,14 @@ nesl_error_e nesl_audio_reset(nesl_audio_t *audio)
     return NESL_SUCCESS;
 }
 
-void nesl_audio_uninitialize(nesl_audio_t *audio)
+nesl_error_e nesl_audio_get_error(const nesl_audio_t *audio)
 {
-    return;
+    return NESL_SUCCESS;
+}
+
+nesl_error_e nesl_audio_uninitialize(nesl_audio_t *audio)
+{
+    return NESL_SUCCESS;
 }
 
 void nesl_audio_write(nesl_audio_t *audio, uint16_t address, uint8_t data)
@@ -112,6 +184,11 @@ void nesl_audio_write(nesl_audio_t *audio, uint16_t address, uint8_t data)
     g_test.data = data;
 }
 
+uint64_t nesl_hash(const void *data, size_t length, uint64_t seed)
+{
+    return seed + length;
+}
+
 nesl_error_e nesl_input_initialize(nesl_input_t *input)
 {
     return NESL_SUCCESS;
@@ -142,7 +219,22 @@ void nesl_input_write(nesl_input_t *input, uint16_t address, uint8_t data)
     g_test.data = data;
 }
 
-nesl_error_e nesl_mapper_initialize(nesl_mapper_t *mapper, const void *data, int length)
+void nesl_mapper_flush(nesl_mapper_t *mapper)
+{
+    ++g_test.subsystem.mapper.flush;
+}
+
+nesl_error_e nesl_mapper_get_battery(const nesl_mapper_t *mapper)
+{
+    return NESL_SUCCESS;
+}
+
+size_t nesl_mapper_get_size(const void *data, int length)
+{
+    return 0;
+}
+
+nesl_error_e nesl_mapper_initialize(nesl_mapper_t *mapper, nesl_arena_t *arena, const void *data, int length, const char *save)
 {
     return NESL_SUCCESS;
 }
@@ -154,6 +246,20 @@ nesl_error_e nesl_mapper_interrupt(nesl_mapper_t *mapper)
     return NESL_SUCCESS;
 }
 
+size_t nesl_mapper_capture(nesl_mapper_t *mapper, void *data)
+{
+    *(uint8_t *)data = g_test.data;
+
+    return sizeof(uint8_t);
+}
+
+size_t nesl_mapper_load(nesl_mapper_t *mapper, const void *data)
+{
+    g_test.data = *(const uint8_t *)data;
+
+    return sizeof(uint8_t);
+}
+
 uint8_t nesl_mapper_read(nesl_mapper_t *mapper, nesl_bank_e type, uint16_t address)
 {
     g_test.type = type;
@@ -169,6 +275,23 @@ nesl_error_e nesl_mapper_reset(nesl_mapper_t *mapper)
     return NESL_SUCCESS;
 }
 
+size_t nesl_mapper_restore(nesl_mapper_t *mapper, const void *data)
+{
+    g_test.data = *(const uint8_t *)data;
+
+    return sizeof(uint8_t);
+}
+
+size_t nesl_mapper_save(const nesl_mapper_t *mapper, void *data)
+{
+
+    if(data) {
+        *(uint8_t *)data = g_test.data;
+    }
+
+    return sizeof(uint8_t);
+}
+
 void nesl_mapper_uninitialize(nesl_mapper_t *mapper)
 {
     return;
@@ -224,6 +347,89 @@ void nesl_processor_write(nesl_processor_t *processor, uint16_t address, uint8_t
     g_test.data = data;
 }
 
+bool nesl_rewind_peek(nesl_rewind_t *rewind, void *state)
+{
+    bool result = false;
+
+    if(rewind->entry.count) {
+        memcpy(state, g_test.rewind.state[rewind->entry.count - 1], rewind->length);
+        result = true;
+    }
+
+    return result;
+}
+
+nesl_error_e nesl_rewind_initialize(nesl_rewind_t *rewind, size_t capacity, size_t length)
+{
+    g_test.rewind.context = rewind;
+    g_test.rewind.length = length;
+    rewind->length = length;
+
+    return (rewind->state = calloc(1, length)) ? NESL_SUCCESS : NESL_FAILURE;
+}
+
+bool nesl_rewind_pop(nesl_rewind_t *rewind)
+{
+    bool result = false;
+
+    if(rewind->entry.count) {
+        --rewind->entry.count;
+        result = true;
+    }
+
+    return result;
+}
+
+void nesl_rewind_push(nesl_rewind_t *rewind, const void *state)
+{
+
+    if(rewind->entry.count < TEST_REWIND) {
+        uint8_t **entry = &g_test.rewind.state[rewind->entry.count++];
+
+        if(!*entry) {
+            *entry = malloc(rewind->length);
+        }
+
+        memcpy(*entry, state, rewind->length);
+    }
+}
+
+void nesl_rewind_uninitialize(nesl_rewind_t *rewind)
+{
+    free(rewind->state);
+    memset(rewind, 0, sizeof(*rewind));
+}
+
+nesl_error_e nesl_slot_initialize(nesl_slot_t *slot, const char *directory, uint64_t hash, size_t length)
+{
+    g_test.slot.directory = directory;
+    g_test.slot.length = length;
+    g_test.slot.index = -1;
+    slot->length = length;
+
+    return (g_test.slot.state = calloc(1, length)) ? NESL_SUCCESS : NESL_FAILURE;
+}
+
+const void *nesl_slot_load(nesl_slot_t *slot, int index)
+{
+    return (index == g_test.slot.index) ? g_test.slot.state : NULL;
+}
+
+nesl_error_e nesl_slot_save(nesl_slot_t *slot, int index, const void *state)
+{
+    memcpy(g_test.slot.state, state, slot->length);
+    g_test.slot.index = index;
+
+    return NESL_SUCCESS;
+}
+
+void nesl_slot_uninitialize(nesl_slot_t *slot)
+{
+    free(g_test.slot.state);
+    g_test.slot.state = NULL;
+    memset(slot, 0, sizeof(*slot));
+}
+
 nesl_error_e nesl_service_reset(void)
 {
     g_test.service.reset = true;
@@ -233,6 +439,8 @@ nesl_error_e nesl_service_reset(void)
 
 bool nesl_video_cycle(nesl_video_t *video)
 {
+    g_test.subsystem.video.hidden = video->hidden;
+
     return true;
 }
 
@@ -292,14 +500,161 @@ void nesl_video_write_port(nesl_video_t *video, uint16_t address, uint8_t data)
     g_test.data = data;
 }
 
+nesl_error_e nesl_set_error(const char *file, const char *function, int line, const char *format, ...)
+{
+    return NESL_FAILURE;
+}
+
+/*!
+ * @brief Uninitialize test context.
+ */
+static void nesl_test_uninitialize(void)
+{
+    nesl_bus_uninitialize();
+
+    for(int index = 0; index < TEST_REWIND; ++index) {
+        free(g_test.rewind.state[index]);
+    }
+
+    memset(&g_test, 0, sizeof(g_test));
+}
+
 /*!
  * @brief Initialize test context.
  */
 static void nesl_test_initialize(void)
 {
+    const nesl_t context = {};
+
+    nesl_test_uninitialize();
+    nesl_bus_initialize(&context);
     memset(&g_test, 0, sizeof(g_test));
 }
 
+/*!
+ * @brief Test bus capture/restore.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_bus_capture(void)
+{
+    size_t length;
+    uint8_t *state = NULL;
+    nesl_error_e result = NESL_SUCCESS;
+
+    nesl_test_initialize();
+    length = nesl_bus_save(NULL);
+
+    if(ASSERT((state = calloc(1, length)) != NULL)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    g_test.data = 0xAB;
+    nesl_bus_save(state);
+
+    if(ASSERT(!memcmp(nesl_bus_capture(), state, length))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    g_test.data = 0xCD;
+
+    for(int cycle = 0; cycle < 10; ++cycle) {
+        nesl_bus_cycle();
+    }
+
+    nesl_bus_restore();
+
+    if(ASSERT(g_test.data == 0xAB)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+    free(state);
+
+    return result;
+}
+
+/*!
+ * @brief Test bus cycle battery save flush, on a fixed period of frames skipping frames with hidden audio.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_bus_cycle(void)
+{
+    int period = 0;
+    nesl_error_e result = NESL_SUCCESS;
+
+    nesl_test_initialize();
+
+    while(!g_test.subsystem.mapper.flush && (period < 1000)) {
+        nesl_bus_cycle();
+        ++period;
+    }
+
+    if(ASSERT((g_test.subsystem.mapper.flush == 1) && (period > 1) && (period < 1000))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    nesl_bus_set_hidden(true, true);
+
+    for(int frame = 0; frame < period; ++frame) {
+        nesl_bus_cycle();
+    }
+
+    nesl_bus_set_hidden(false, false);
+
+    for(int frame = 0; frame < (period - 1); ++frame) {
+        nesl_bus_cycle();
+    }
+
+    if(ASSERT(g_test.subsystem.mapper.flush == 1)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    nesl_bus_cycle();
+
+    if(ASSERT(g_test.subsystem.mapper.flush == 2)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+    nesl_test_uninitialize();
+
+    return result;
+}
+
+/*!
+ * @brief Test bus hash, chaining each state range into the hash of its subsystem.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_bus_hash(void)
+{
+    uint64_t hash[SUBSYSTEM_MAX] = {};
+    nesl_error_e result = NESL_SUCCESS;
+
+    nesl_test_initialize();
+    nesl_bus_hash(hash);
+
+    if(ASSERT((hash[SUBSYSTEM_BUS] == sizeof(uint64_t)) && (hash[SUBSYSTEM_INPUT] == sizeof(nesl_input_t))
+            && (hash[SUBSYSTEM_MAPPER] == sizeof(uint8_t)) && hash[SUBSYSTEM_AUDIO] && hash[SUBSYSTEM_PROCESSOR]
+            && (hash[SUBSYSTEM_VIDEO] > sizeof(((nesl_video_t *)NULL)->ram)))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+    nesl_test_uninitialize();
+
+    return result;
+}
+
 /*!
  * @brief Test bus interrupt.
  * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
@@ -329,7 +684,8 @@ static nesl_error_e nesl_test_bus_interrupt(void)
                         && (g_test.subsystem.input.reset == true)
                         && (g_test.subsystem.mapper.reset == true)
                         && (g_test.subsystem.processor.reset == true)
-                        && (g_test.subsystem.video.reset == true))) {
+                        && (g_test.subsystem.video.reset == true)
+                        && (nesl_bus_get_reset() == 1))) {
                     result = NESL_FAILURE;
                     goto exit;
                 }
@@ -352,6 +708,69 @@ exit:
     return result;
 }
 
+/*!
+ * @brief Test bus load.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_bus_load(void)
+{
+    size_t length;
+    uint8_t *state[3] = {};
+    nesl_error_e result = NESL_SUCCESS;
+
+    nesl_test_initialize();
+    length = nesl_bus_save(NULL);
+
+    for(int index = 0; index < TEST_COUNT(state); ++index) {
+
+        if(ASSERT((state[index] = calloc(1, length)) != NULL)) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+    }
+
+    g_test.data = 0xAB;
+
+    if(ASSERT(nesl_bus_save(state[0]) == length)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    g_test.data = 0xCD;
+
+    for(int cycle = 0; cycle < 10; ++cycle) {
+        nesl_bus_cycle();
+    }
+
+    nesl_bus_save(state[1]);
+
+    if(ASSERT(memcmp(state[0], state[1], length))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    if(ASSERT((nesl_bus_load(state[0]) == length) && (g_test.data == 0xAB))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    nesl_bus_save(state[2]);
+
+    if(ASSERT(!memcmp(state[0], state[2], length))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+
+    for(int index = 0; index < TEST_COUNT(state); ++index) {
+        free(state[index]);
+    }
+
+    return result;
+}
+
 /*!
  * @brief Test bus read.
  * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
@@ -588,10 +1007,186 @@ exit:
     return result;
 }
 
+/*!
+ * @brief Test bus rewind.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_bus_rewind(void)
+{
+    const nesl_t context = { .rewind = 1, };
+    nesl_error_e result = NESL_SUCCESS;
+
+    nesl_test_uninitialize();
+
+    if(ASSERT((nesl_bus_initialize(&context) == NESL_SUCCESS) && (g_test.rewind.length == nesl_bus_save(NULL)))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    for(uint8_t frame = 1; frame <= 3; ++frame) {
+        g_test.data = frame;
+
+        if(ASSERT(nesl_bus_cycle() && (g_test.rewind.context->entry.count == frame))) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+    }
+
+    g_test.data = 0;
+    nesl_bus_rewind();
+
+    if(ASSERT((g_test.data == 1) && (g_test.rewind.context->entry.count == 1))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    g_test.data = 0;
+    nesl_bus_rewind();
+
+    if(ASSERT((g_test.data == 0) && (g_test.rewind.context->entry.count == 1))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+    nesl_test_uninitialize();
+
+    return result;
+}
+
+/*!
+ * @brief Test bus set.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_bus_set(void)
+{
+    nesl_bus_t *bus;
+    nesl_error_e result = NESL_SUCCESS;
+
+    nesl_test_initialize();
+
+    if(ASSERT((bus = nesl_bus_get()) != NULL)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    nesl_bus_set(NULL);
+
+    if(ASSERT(nesl_bus_get() == NULL)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    nesl_bus_set(bus);
+
+    if(ASSERT(nesl_bus_get() == bus)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+
+    return result;
+}
+
+/*!
+ * @brief Test bus set hidden.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_bus_set_hidden(void)
+{
+    const nesl_t context = { .rewind = 1, };
+    nesl_error_e result = NESL_SUCCESS;
+
+    nesl_test_uninitialize();
+
+    if(ASSERT(nesl_bus_initialize(&context) == NESL_SUCCESS)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    for(int mode = 0; mode < 4; ++mode) {
+        bool video = mode & 1, audio = mode & 2;
+        int count = g_test.rewind.context->entry.count;
+
+        nesl_bus_set_hidden(video, audio);
+
+        if(ASSERT(nesl_bus_cycle() && (g_test.subsystem.video.hidden == video) && (g_test.subsystem.audio.hidden == audio)
+                && (g_test.rewind.context->entry.count == (audio ? count : (count + 1))))) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+    }
+
+exit:
+    TEST_RESULT(result);
+    nesl_test_uninitialize();
+
+    return result;
+}
+
+/*!
+ * @brief Test bus save slots.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_bus_slot(void)
+{
+    const nesl_t context = { .slot = "slots", };
+    nesl_error_e result = NESL_SUCCESS;
+
+    nesl_test_initialize();
+    g_test.data = 1;
+    nesl_bus_save_slot(0);
+    nesl_bus_load_slot(0);
+
+    if(ASSERT((g_test.data == 1) && !g_test.slot.state)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    nesl_test_uninitialize();
+
+    if(ASSERT((nesl_bus_initialize(&context) == NESL_SUCCESS) && !strcmp(g_test.slot.directory, context.slot)
+            && (g_test.slot.length == nesl_bus_save(NULL)))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    g_test.data = 1;
+
+    if(ASSERT((nesl_bus_save_slot(2) == NESL_SUCCESS) && (g_test.slot.index == 2))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    g_test.data = 0;
+    nesl_bus_load_slot(1);
+
+    if(ASSERT(g_test.data == 0)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    nesl_bus_load_slot(2);
+
+    if(ASSERT(g_test.data == 1)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+    nesl_test_uninitialize();
+
+    return result;
+}
+
 int main(void)
 {
     const test TEST[] = {
-        nesl_test_bus_interrupt, nesl_test_bus_read, nesl_test_bus_write,
+        nesl_test_bus_capture, nesl_test_bus_cycle, nesl_test_bus_hash, nesl_test_bus_interrupt, nesl_test_bus_load, nesl_test_bus_read, nesl_test_bus_rewind, nesl_test_bus_set, nesl_test_bus_set_hidden, nesl_test_bus_slot, nesl_test_bus_write,
         };
 
     nesl_error_e result = NESL_SUCCESS;
@@ -603,6 +1198,8 @@ int main(void)
         }
     }
 
+    nesl_test_uninitialize();
+
     return (int)result;
 }
 
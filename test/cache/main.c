@@ -0,0 +1,225 @@
+/*
+ * NESL
+ * Copyright (C) 2022 David Jolly
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+ * @file main.c
+ * @brief Test application for process-wide ROM cache.
+ */
+
+#include <cache.h>
+#include <test.h>
+
+/*!
+ * @struct nesl_test_t
+ * @brief Contains the test contexts.
+ */
+typedef struct {
+    uint8_t data[3][64];        /*!< ROM data */
+    const void *image[4];       /*!< ROM images */
+} nesl_test_t;
+
+static nesl_test_t g_test = {}; /*!< Test context */
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+uint64_t nesl_hash(const void *data, size_t length, uint64_t seed)
+{
+    return length;
+}
+
+nesl_error_e nesl_set_error(const char *file, const char *function, int line, const char *format, ...)
+{
+    return NESL_FAILURE;
+}
+
+/*!
+ * @brief Initialize test context, with the first two ROMs identical and the third differing in one byte (same hash).
+ */
+static void nesl_test_initialize(void)
+{
+    memset(&g_test, 0, sizeof(g_test));
+
+    for(int index = 0; index < TEST_COUNT(g_test.data); ++index) {
+
+        for(int offset = 0; offset < TEST_COUNT(g_test.data[index]); ++offset) {
+            g_test.data[index][offset] = offset;
+        }
+    }
+
+    g_test.data[2][63] = 0xFF;
+}
+
+/*!
+ * @brief Test ROM cache acquire.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_cache_acquire(void)
+{
+    nesl_error_e result = NESL_SUCCESS;
+
+    nesl_test_initialize();
+
+    if(ASSERT((nesl_cache_acquire(&g_test.image[0], NULL, 0) == NESL_SUCCESS) && !g_test.image[0])) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    for(int index = 0; index < TEST_COUNT(g_test.data); ++index) {
+
+        if(ASSERT(nesl_cache_acquire(&g_test.image[index], g_test.data[index], sizeof(g_test.data[index])) == NESL_SUCCESS)) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+
+        if(ASSERT((g_test.image[index] != g_test.data[index])
+                && !memcmp(g_test.image[index], g_test.data[index], sizeof(g_test.data[index])))) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+    }
+
+    if(ASSERT((g_test.image[0] == g_test.image[1]) && (g_test.image[0] != g_test.image[2]))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    memset(g_test.data[0], 0, sizeof(g_test.data[0]));
+
+    if(ASSERT(!memcmp(g_test.image[0], g_test.data[1], sizeof(g_test.data[1])))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+
+    for(int index = 0; index < TEST_COUNT(g_test.image); ++index) {
+        nesl_cache_release(g_test.image[index]);
+    }
+
+    return result;
+}
+
+/*!
+ * @brief Test ROM cache release.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_cache_release(void)
+{
+    nesl_error_e result = NESL_SUCCESS;
+
+    nesl_test_initialize();
+
+    if(ASSERT((nesl_cache_acquire(&g_test.image[0], g_test.data[0], sizeof(g_test.data[0])) == NESL_SUCCESS)
+            && (nesl_cache_acquire(&g_test.image[1], g_test.data[1], sizeof(g_test.data[1])) == NESL_SUCCESS))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    nesl_cache_release(g_test.image[0]);
+    nesl_cache_release(NULL);
+
+    if(ASSERT((nesl_cache_acquire(&g_test.image[2], g_test.data[1], sizeof(g_test.data[1])) == NESL_SUCCESS)
+            && (g_test.image[2] == g_test.image[1]))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    nesl_cache_release(g_test.image[1]);
+    nesl_cache_release(g_test.image[2]);
+    memset(g_test.image, 0, sizeof(g_test.image));
+    g_test.data[1][0] = 0xFF;
+
+    if(ASSERT((nesl_cache_acquire(&g_test.image[0], g_test.data[1], sizeof(g_test.data[1])) == NESL_SUCCESS)
+            && !memcmp(g_test.image[0], g_test.data[1], sizeof(g_test.data[1])))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+
+    for(int index = 0; index < TEST_COUNT(g_test.image); ++index) {
+        nesl_cache_release(g_test.image[index]);
+    }
+
+    return result;
+}
+
+/*!
+ * @brief Test ROM cache retain.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_cache_retain(void)
+{
+    nesl_error_e result = NESL_SUCCESS;
+
+    nesl_test_initialize();
+
+    if(ASSERT(nesl_cache_acquire(&g_test.image[0], g_test.data[0], sizeof(g_test.data[0])) == NESL_SUCCESS)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    nesl_cache_retain(g_test.image[0]);
+    nesl_cache_retain(g_test.data[1]);
+    nesl_cache_retain(NULL);
+    nesl_cache_release(g_test.image[0]);
+
+    if(ASSERT((nesl_cache_acquire(&g_test.image[1], g_test.data[1], sizeof(g_test.data[1])) == NESL_SUCCESS)
+            && (g_test.image[1] == g_test.image[0]))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+
+    for(int index = 0; index < TEST_COUNT(g_test.image); ++index) {
+        nesl_cache_release(g_test.image[index]);
+    }
+
+    return result;
+}
+
+int main(void)
+{
+    const test TEST[] = {
+        nesl_test_cache_acquire, nesl_test_cache_release, nesl_test_cache_retain,
+        };
+
+    nesl_error_e result = NESL_SUCCESS;
+
+    for(int index = 0; index < TEST_COUNT(TEST); ++index) {
+
+        if(TEST[index]() == NESL_FAILURE) {
+            result = NESL_FAILURE;
+        }
+    }
+
+    return (int)result;
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
@@ -27,26 +27,56 @@
 #include <cartridge.h>
 #include <test.h>
 
+#define TEST_SAVE "./test.sav"                  /*!< Test battery save path */
+
 /*!
  * @struct nesl_test_t
  * @brief Contains the test contexts.
  */
 typedef struct {
-    nesl_cartridge_t cartridge;         /*!< Cartridge context */
+    nesl_cartridge_t cartridge;             /*!< Cartridge context */
+    nesl_arena_t arena;                     /*!< Arena context */
+    uint8_t memory[16 * 1024];              /*!< Arena memory */
+    uint64_t dirty[DIRTY_WORDS(8 * 1024)];  /*!< Character RAM dirty pages */
 
     struct {
-        nesl_cartridge_header_t header; /*!< Cartridge header */
-        uint8_t program[2][16 * 1024];  /*!< Program banks */
-        uint8_t character[1][8 * 1024]; /*!< Character banks */
+        nesl_cartridge_header_t header;     /*!< Cartridge header */
+        uint8_t program[2][16 * 1024];      /*!< Program banks */
+        uint8_t character[1][8 * 1024];     /*!< Character banks */
     } data;
 } nesl_test_t;
 
-static nesl_test_t g_test = {};         /*!< Test context */
+static nesl_test_t g_test = {};             /*!< Test context */
 
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
 
+void *nesl_arena_allocate(nesl_arena_t *arena, size_t size)
+{
+    void *result = NULL;
+
+    if(ARENA_SIZE(size) <= (arena->capacity - arena->offset)) {
+        result = memset(&arena->data[arena->offset], 0, size);
+        arena->offset += ARENA_SIZE(size);
+    }
+
+    return result;
+}
+
+size_t nesl_dirty_copy(uint64_t *dirty, void *destination, const void *source, size_t length)
+{
+    memcpy(destination, source, length);
+    memset(dirty, 0, DIRTY_WORDS(length) * sizeof(*dirty));
+
+    return length;
+}
+
+void nesl_dirty_set(uint64_t *dirty, size_t length)
+{
+    memset(dirty, 0xFF, DIRTY_WORDS(length) * sizeof(*dirty));
+}
+
 nesl_error_e nesl_set_error(const char *file, const char *function, int line, const char *format, ...)
 {
     return NESL_FAILURE;
@@ -91,7 +121,10 @@ static nesl_error_e nesl_test_initialize(void)
         }
     }
 
-    if((result = nesl_cartridge_initialize(&g_test.cartridge, &g_test.data.header, sizeof(g_test.data))) == NESL_FAILURE) {
+    g_test.arena.data = g_test.memory;
+    g_test.arena.capacity = sizeof(g_test.memory);
+
+    if((result = nesl_cartridge_initialize(&g_test.cartridge, &g_test.arena, &g_test.data.header, sizeof(g_test.data), NULL)) == NESL_FAILURE) {
         goto exit;
     }
 
@@ -107,6 +140,157 @@ exit:
     return result;
 }
 
+/*!
+ * @brief Test cartridge subsystem battery-backed program RAM, mapped from and flushed to the battery save file.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_cartridge_battery(void)
+{
+    FILE *file = NULL;
+    uint8_t data[8 * 1024] = {};
+    nesl_error_e result = NESL_SUCCESS;
+
+    remove(TEST_SAVE);
+    nesl_cartridge_uninitialize(&g_test.cartridge);
+    g_test.arena.offset = 0;
+
+    if(ASSERT((nesl_cartridge_initialize(&g_test.cartridge, &g_test.arena, &g_test.data.header, sizeof(g_test.data), TEST_SAVE) == NESL_SUCCESS)
+            && !g_test.cartridge.battery.length && !(file = fopen(TEST_SAVE, "rb")))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    nesl_cartridge_uninitialize(&g_test.cartridge);
+    g_test.arena.offset = 0;
+    g_test.data.header.flag_6.ram = 1;
+
+    if(ASSERT((nesl_cartridge_initialize(&g_test.cartridge, &g_test.arena, &g_test.data.header, sizeof(g_test.data), TEST_SAVE) == NESL_SUCCESS)
+            && (g_test.cartridge.battery.length == sizeof(data)))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    for(uint16_t address = 0; address < sizeof(data); ++address) {
+
+        if(ASSERT(nesl_cartridge_read_ram(&g_test.cartridge, BANK_PROGRAM_RAM, address) == 0)) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+
+        nesl_cartridge_write_ram(&g_test.cartridge, BANK_PROGRAM_RAM, address, address ^ 0x5A);
+    }
+
+    nesl_cartridge_flush(&g_test.cartridge);
+    nesl_cartridge_uninitialize(&g_test.cartridge);
+
+    if(ASSERT((file = fopen(TEST_SAVE, "rb")) && (fread(data, sizeof(data), 1, file) == 1) && (fgetc(file) == EOF))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    for(uint16_t address = 0; address < sizeof(data); ++address) {
+
+        if(ASSERT(data[address] == (uint8_t)(address ^ 0x5A))) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+    }
+
+    g_test.arena.offset = 0;
+
+    if(ASSERT((nesl_cartridge_initialize(&g_test.cartridge, &g_test.arena, &g_test.data.header, sizeof(g_test.data), TEST_SAVE) == NESL_SUCCESS)
+            && (nesl_cartridge_get_battery(&g_test.cartridge) == NESL_SUCCESS))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    for(uint16_t address = 0; address < sizeof(data); ++address) {
+
+        if(ASSERT(nesl_cartridge_read_ram(&g_test.cartridge, BANK_PROGRAM_RAM, address) == (uint8_t)(address ^ 0x5A))) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+    }
+
+    nesl_cartridge_uninitialize(&g_test.cartridge);
+    g_test.arena.offset = 0;
+
+    if(ASSERT((nesl_cartridge_initialize(&g_test.cartridge, &g_test.arena, &g_test.data.header, sizeof(g_test.data), "./missing/test.sav")
+            == NESL_SUCCESS) && !g_test.cartridge.battery.length && g_test.cartridge.ram.program
+            && (nesl_cartridge_get_battery(&g_test.cartridge) == NESL_FAILURE) && (g_test.cartridge.battery.error == ENOENT))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    nesl_cartridge_write_ram(&g_test.cartridge, BANK_PROGRAM_RAM, 0, 0xA5);
+
+    if(ASSERT(nesl_cartridge_read_ram(&g_test.cartridge, BANK_PROGRAM_RAM, 0) == 0xA5)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    nesl_cartridge_uninitialize(&g_test.cartridge);
+    g_test.arena.offset = 0;
+
+exit:
+    TEST_RESULT(result);
+
+    if(file) {
+        fclose(file);
+        file = NULL;
+    }
+
+    remove(TEST_SAVE);
+    g_test.data.header.flag_6.ram = 0;
+
+    return result;
+}
+
+/*!
+ * @brief Test cartridge subsystem state capture/restore.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_cartridge_capture(void)
+{
+    static uint8_t state[8 * 1024] = {};
+    nesl_error_e result;
+
+    if((result = nesl_test_initialize()) == NESL_FAILURE) {
+        goto exit;
+    }
+
+    if(ASSERT((g_test.cartridge.dirty.program[0] == UINT64_MAX) && (nesl_cartridge_capture(&g_test.cartridge, state) == (8 * 1024))
+            && !memcmp(state, g_test.cartridge.ram.program, 8 * 1024) && !g_test.cartridge.dirty.program[0])) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    nesl_cartridge_write_ram(&g_test.cartridge, BANK_PROGRAM_RAM, 0x1100, 0xAB);
+
+    if(ASSERT((g_test.cartridge.dirty.program[0] == 0) && (g_test.cartridge.dirty.program[1] == (1ULL << 4)))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    if(ASSERT((nesl_cartridge_restore(&g_test.cartridge, state) == (8 * 1024)) && !memcmp(state, g_test.cartridge.ram.program, 8 * 1024)
+            && !g_test.cartridge.dirty.program[1])) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    nesl_cartridge_load(&g_test.cartridge, state);
+
+    if(ASSERT((g_test.cartridge.dirty.program[0] == UINT64_MAX) && (g_test.cartridge.dirty.program[1] == UINT64_MAX))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+
+    return result;
+}
+
 /*!
  * @brief Test cartridge subsystem bank count.
  * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
@@ -219,6 +403,101 @@ exit:
     return result;
 }
 
+/*!
+ * @brief Test cartridge subsystem arena size.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_cartridge_get_size(void)
+{
+    nesl_error_e result = NESL_SUCCESS;
+
+    if((result = nesl_test_initialize()) == NESL_FAILURE) {
+        goto exit;
+    }
+
+    if(ASSERT((nesl_cartridge_get_size(NULL, 0) == 0)
+            && (nesl_cartridge_get_size(&g_test.data.header, sizeof(g_test.data.header) - 1) == 0)
+            && (nesl_cartridge_get_size(&g_test.data.header, sizeof(g_test.data)) == ((8 * 1024) + ARENA_SIZE(DIRTY_WORDS(8 * 1024) * sizeof(uint64_t)))))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    g_test.data.header.ram.program = 2;
+    g_test.data.header.rom.character = 0;
+
+    if(ASSERT(nesl_cartridge_get_size(&g_test.data.header, sizeof(g_test.data)) == ((3 * 8 * 1024) + ARENA_SIZE(DIRTY_WORDS(8 * 1024) * sizeof(uint64_t))
+            + ARENA_SIZE(DIRTY_WORDS(2 * 8 * 1024) * sizeof(uint64_t))))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    g_test.data.header.flag_6.type_low = MAPPER_30 & 0x0F;
+    g_test.data.header.flag_7.type_high = (MAPPER_30 & 0xF0) >> 4;
+
+    if(ASSERT(nesl_cartridge_get_size(&g_test.data.header, sizeof(g_test.data)) == ((6 * 8 * 1024) + ARENA_SIZE(DIRTY_WORDS(4 * 8 * 1024) * sizeof(uint64_t))
+            + ARENA_SIZE(DIRTY_WORDS(2 * 8 * 1024) * sizeof(uint64_t))))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+
+    return result;
+}
+
+/*!
+ * @brief Test cartridge subsystem state load/save.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_cartridge_load(void)
+{
+    static uint8_t state[2][16 * 1024] = {};
+    nesl_error_e result;
+
+    if((result = nesl_test_initialize()) == NESL_FAILURE) {
+        goto exit;
+    }
+
+    if(ASSERT((nesl_cartridge_save(&g_test.cartridge, NULL) == (8 * 1024)) && (nesl_cartridge_save(&g_test.cartridge, state[0]) == (8 * 1024))
+            && !memcmp(state[0], g_test.cartridge.ram.program, 8 * 1024))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    memset(g_test.cartridge.ram.program, 0xFF, 8 * 1024);
+
+    if(ASSERT((nesl_cartridge_load(&g_test.cartridge, state[0]) == (8 * 1024)) && !memcmp(state[0], g_test.cartridge.ram.program, 8 * 1024))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    g_test.cartridge.ram.character = g_test.data.character[0];
+    g_test.cartridge.dirty.character = g_test.dirty;
+    g_test.cartridge.mask.character = (8 * 1024) - 1;
+
+    if(ASSERT((nesl_cartridge_save(&g_test.cartridge, state[1]) == (16 * 1024)) && !memcmp(state[1], g_test.data.character[0], 8 * 1024)
+            && !memcmp(&state[1][8 * 1024], g_test.cartridge.ram.program, 8 * 1024))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    memset(g_test.data.character[0], 0, 8 * 1024);
+
+    if(ASSERT((nesl_cartridge_load(&g_test.cartridge, state[1]) == (16 * 1024)) && !memcmp(state[1], g_test.data.character[0], 8 * 1024))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    g_test.cartridge.ram.character = NULL;
+    g_test.cartridge.dirty.character = NULL;
+    g_test.cartridge.mask.character = UINT32_MAX;
+    TEST_RESULT(result);
+
+    return result;
+}
+
 /*!
  * @brief Test cartridge subsystem read.
  * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
@@ -280,6 +559,8 @@ static nesl_error_e nesl_test_cartridge_write(void)
     nesl_error_e result = NESL_SUCCESS;
 
     g_test.cartridge.ram.character = g_test.data.character[0];
+    g_test.cartridge.dirty.character = g_test.dirty;
+    g_test.cartridge.mask.character = (8 * 1024) - 1;
 
     for(uint16_t address = 0; address < (8 * 1024); ++address) {
         nesl_cartridge_write_ram(&g_test.cartridge, BANK_CHARACTER_RAM, address, data);
@@ -288,9 +569,18 @@ static nesl_error_e nesl_test_cartridge_write(void)
             result = NESL_FAILURE;
             goto exit;
         }
+
+        nesl_cartridge_write_ram(&g_test.cartridge, BANK_CHARACTER_RAM, (8 * 1024) + address, data);
+
+        if(ASSERT(g_test.cartridge.ram.character[address] == data)) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
     }
 
     g_test.cartridge.ram.character = NULL;
+    g_test.cartridge.dirty.character = NULL;
+    g_test.cartridge.mask.character = UINT32_MAX;
 
     for(int bank = 0; bank < 1; ++bank) {
         data = 0xFF;
@@ -314,8 +604,8 @@ exit:
 int main(void)
 {
     const test TEST[] = {
-        nesl_test_cartridge_get_banks, nesl_test_cartridge_get_mapper, nesl_test_cartridge_get_mirror, nesl_test_cartridge_read,
-        nesl_test_cartridge_write,
+        nesl_test_cartridge_battery, nesl_test_cartridge_capture, nesl_test_cartridge_get_banks, nesl_test_cartridge_get_mapper, nesl_test_cartridge_get_mirror, nesl_test_cartridge_get_size,
+        nesl_test_cartridge_load, nesl_test_cartridge_read, nesl_test_cartridge_write,
         };
 
     nesl_error_e result = NESL_SUCCESS;
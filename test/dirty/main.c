@@ -0,0 +1,159 @@
+/*
+ * NESL
+ * Copyright (C) 2022 David Jolly
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+ * @file main.c
+ * @brief Test application for dirty page bitmap.
+ */
+
+#include <dirty.h>
+#include <test.h>
+
+#define TEST_LENGTH ((3 * DIRTY_WORD) + 100) /*!< Test buffer length in bytes, ending in a partial page */
+
+/*!
+ * @struct nesl_test_t
+ * @brief Contains the test contexts.
+ */
+typedef struct {
+    uint64_t dirty[DIRTY_WORDS(TEST_LENGTH)]; /*!< Dirty page bitmap */
+    uint8_t destination[TEST_LENGTH];   /*!< Destination buffer */
+    uint8_t source[TEST_LENGTH];        /*!< Source buffer */
+} nesl_test_t;
+
+static nesl_test_t g_test = {};         /*!< Test context */
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*!
+ * @brief Initialize test context.
+ */
+static void nesl_test_initialize(void)
+{
+    memset(&g_test, 0, sizeof(g_test));
+    memset(g_test.source, 0xAA, sizeof(g_test.source));
+}
+
+/*!
+ * @brief Test dirty page copy.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_dirty_copy(void)
+{
+    const size_t offset[] = { 0, 65, (2 * DIRTY_WORD) + 64, TEST_LENGTH - 1 };
+    nesl_error_e result = NESL_SUCCESS;
+
+    nesl_test_initialize();
+
+    for(size_t index = 0; index < TEST_COUNT(offset); ++index) {
+        DIRTY_SET(g_test.dirty, offset[index]);
+    }
+
+    if(ASSERT(nesl_dirty_copy(g_test.dirty, g_test.destination, g_test.source, TEST_LENGTH) == TEST_LENGTH)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    for(size_t address = 0; address < TEST_LENGTH; ++address) {
+        bool dirty = false;
+
+        for(size_t index = 0; index < TEST_COUNT(offset); ++index) {
+
+            if((address >> DIRTY_SHIFT) == (offset[index] >> DIRTY_SHIFT)) {
+                dirty = true;
+                break;
+            }
+        }
+
+        if(ASSERT(g_test.destination[address] == (dirty ? 0xAA : 0x00))) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+    }
+
+    for(size_t word = 0; word < DIRTY_WORDS(TEST_LENGTH); ++word) {
+
+        if(ASSERT(!g_test.dirty[word])) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+    }
+
+exit:
+    TEST_RESULT(result);
+
+    return result;
+}
+
+/*!
+ * @brief Test dirty page set.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_dirty_set(void)
+{
+    nesl_error_e result = NESL_SUCCESS;
+
+    nesl_test_initialize();
+    nesl_dirty_set(g_test.dirty, TEST_LENGTH);
+
+    for(size_t word = 0; word < DIRTY_WORDS(TEST_LENGTH); ++word) {
+
+        if(ASSERT(g_test.dirty[word] == UINT64_MAX)) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+    }
+
+    if(ASSERT((nesl_dirty_copy(g_test.dirty, g_test.destination, g_test.source, TEST_LENGTH) == TEST_LENGTH)
+            && !memcmp(g_test.destination, g_test.source, TEST_LENGTH))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+
+    return result;
+}
+
+int main(void)
+{
+    const test TEST[] = {
+        nesl_test_dirty_copy, nesl_test_dirty_set,
+        };
+
+    nesl_error_e result = NESL_SUCCESS;
+
+    for(int index = 0; index < TEST_COUNT(TEST); ++index) {
+
+        if(TEST[index]() == NESL_FAILURE) {
+            result = NESL_FAILURE;
+        }
+    }
+
+    return (int)result;
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
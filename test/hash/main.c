@@ -0,0 +1,120 @@
+/*
+ * NESL
+ * Copyright (C) 2022 David Jolly
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+ * @file main.c
+ * @brief Test application for 64-bit content hash.
+ */
+
+#include <hash.h>
+#include <test.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+nesl_error_e nesl_set_error(const char *file, const char *function, int line, const char *format, ...)
+{
+    return NESL_FAILURE;
+}
+
+/*!
+ * @brief Test hash.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_hash(void)
+{
+    uint8_t data[37] = {};
+    uint64_t hash[TEST_COUNT(data) + 1] = {};
+    nesl_error_e result = NESL_SUCCESS;
+
+    for(int index = 0; index < TEST_COUNT(data); ++index) {
+        data[index] = index * 7;
+    }
+
+    for(int length = 0; length <= TEST_COUNT(data); ++length) {
+        hash[length] = nesl_hash(data, length, 0);
+
+        if(ASSERT(hash[length] == nesl_hash(data, length, 0))) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+
+        for(int index = 0; index < length; ++index) {
+
+            if(ASSERT(hash[index] != hash[length])) {
+                result = NESL_FAILURE;
+                goto exit;
+            }
+        }
+
+        if(ASSERT(nesl_hash(data, length, 1) != hash[length])) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+    }
+
+    for(int index = 0; index < TEST_COUNT(data); ++index) {
+
+        for(int bit = 0; bit < 8; ++bit) {
+            data[index] ^= (1 << bit);
+
+            if(ASSERT(nesl_hash(data, TEST_COUNT(data), 0) != hash[TEST_COUNT(data)])) {
+                result = NESL_FAILURE;
+                goto exit;
+            }
+
+            data[index] ^= (1 << bit);
+        }
+    }
+
+    if(ASSERT(nesl_hash(data, TEST_COUNT(data), 0) == hash[TEST_COUNT(data)])) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+
+    return result;
+}
+
+int main(void)
+{
+    const test TEST[] = {
+        nesl_test_hash,
+        };
+
+    nesl_error_e result = NESL_SUCCESS;
+
+    for(int index = 0; index < TEST_COUNT(TEST); ++index) {
+
+        if(TEST[index]() == NESL_FAILURE) {
+            result = NESL_FAILURE;
+        }
+    }
+
+    return (int)result;
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
@@ -22,6 +22,7 @@ DIR_INCLUDE_TEST=../include/
 DIR_ROOT=./
 
 FILE_BIN=$(DIR_ROOT)test_$(FILE)
+FLAGS_LIB=-lm
 FLAGS_INCLUDE=$(subst $(DIR_INCLUDE),-I$(DIR_INCLUDE),$(shell find $(DIR_INCLUDE) -maxdepth 2 -type d))
 FLAGS_INCLUDE_TEST=$(subst $(DIR_INCLUDE_TEST),-I$(DIR_INCLUDE_TEST),$(shell find $(DIR_INCLUDE_TEST) -maxdepth 1 -type d))
 FILES_OBJ=$(patsubst $(DIR_ROOT)%.c,$(DIR_ROOT)%.o,$(FILES_SRC))
@@ -52,4 +53,4 @@ $(DIR_ROOT)%.o: $(DIR_ROOT)%.c
 	$(CC) $(FLAGS) $(FLAGS_INCLUDE) $(FLAGS_INCLUDE_TEST) -c -o $@ $<
 
 $(FILE_BIN): $(DIR_SRC)$(FILE).o $(FILES_OBJ)
-	$(CC) $(FLAGS) $(DIR_SRC)$(FILE).o $(FILES_OBJ) -o $@
+	$(CC) $(FLAGS) $(DIR_SRC)$(FILE).o $(FILES_OBJ) $(FLAGS_LIB) -o $@
@@ -0,0 +1,181 @@
+/*
+ * NESL
+ * Copyright (C) 2022 David Jolly
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+ * @file main.c
+ * @brief Test application for LZ codec.
+ */
+
+#include <lz.h>
+#include <test.h>
+
+#define TEST_LENGTH (64 * 1024)             /*!< Test data length in bytes */
+
+/*!
+ * @struct nesl_test_t
+ * @brief Contains the test contexts.
+ */
+typedef struct {
+    uint8_t data[TEST_LENGTH];              /*!< Data */
+    uint8_t compressed[LZ_BOUND(TEST_LENGTH)]; /*!< Compressed data */
+    uint8_t decompressed[TEST_LENGTH];      /*!< Decompressed data */
+} nesl_test_t;
+
+static nesl_test_t g_test = {};             /*!< Test context */
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*!
+ * @brief Initialize test context, with data of zero runs, repeated short patterns, text-like runs and noise.
+ * @param[in] seed Noise seed
+ */
+static void nesl_test_initialize(uint32_t seed)
+{
+    memset(&g_test, 0, sizeof(g_test));
+
+    for(size_t offset = 0; offset < TEST_LENGTH; ++offset) {
+        seed = (seed * 1103515245) + 12345;
+
+        switch((offset / 4096) % 4) {
+            case 0:
+                break;
+            case 1:
+                g_test.data[offset] = offset % 3;
+                break;
+            case 2:
+                g_test.data[offset] = "NESL save-state "[(offset * 7) % 16];
+                break;
+            default:
+                g_test.data[offset] = seed >> 16;
+                break;
+        }
+    }
+}
+
+/*!
+ * @brief Test LZ compression.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_lz_compress(void)
+{
+    size_t length;
+    nesl_error_e result = NESL_SUCCESS;
+
+    for(size_t size = 0; size <= TEST_LENGTH; size = size ? (size * 2) + 1 : 1) {
+        nesl_test_initialize(size);
+
+        if(ASSERT((length = nesl_lz_compress(g_test.data, size, g_test.compressed, LZ_BOUND(size))) > 0)) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+
+        if(ASSERT((nesl_lz_decompress(g_test.compressed, length, g_test.decompressed, size) == size)
+                && !memcmp(g_test.data, g_test.decompressed, size))) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+    }
+
+    nesl_test_initialize(0);
+
+    if(ASSERT((length = nesl_lz_compress(g_test.data, TEST_LENGTH, g_test.compressed, sizeof(g_test.compressed))) < (TEST_LENGTH / 2))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    if(ASSERT(!nesl_lz_compress(g_test.data, TEST_LENGTH, g_test.compressed, length - 1))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+
+    return result;
+}
+
+/*!
+ * @brief Test LZ decompression.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_lz_decompress(void)
+{
+    size_t length;
+    nesl_error_e result = NESL_SUCCESS;
+    const uint8_t OFFSET_ZERO[] = { 0x14, 'A', 0x00, 0x00, }, OFFSET_FAR[] = { 0x14, 'A', 0x02, 0x00, }, TRUNCATED[] = { 0x30, 'A', 'B', },
+        RUN[] = { 0x1F, 'A', 0x01, 0x00, 0x02, 0x10, 'B', };
+
+    nesl_test_initialize(0);
+
+    if(ASSERT(!nesl_lz_decompress(OFFSET_ZERO, sizeof(OFFSET_ZERO), g_test.decompressed, TEST_LENGTH)
+            && !nesl_lz_decompress(OFFSET_FAR, sizeof(OFFSET_FAR), g_test.decompressed, TEST_LENGTH)
+            && !nesl_lz_decompress(TRUNCATED, sizeof(TRUNCATED), g_test.decompressed, TEST_LENGTH))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    if(ASSERT((nesl_lz_decompress(RUN, sizeof(RUN), g_test.decompressed, TEST_LENGTH) == 23)
+            && !memcmp(g_test.decompressed, "AAAAAAAAAAAAAAAAAAAAAAB", 23))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    if(ASSERT(!nesl_lz_decompress(RUN, sizeof(RUN), g_test.decompressed, 22))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    length = nesl_lz_compress(g_test.data, TEST_LENGTH, g_test.compressed, sizeof(g_test.compressed));
+
+    if(ASSERT(!nesl_lz_decompress(g_test.compressed, length, g_test.decompressed, TEST_LENGTH - 1))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+
+    return result;
+}
+
+int main(void)
+{
+    const test TEST[] = {
+        nesl_test_lz_compress, nesl_test_lz_decompress,
+        };
+
+    nesl_error_e result = NESL_SUCCESS;
+
+    for(int index = 0; index < TEST_COUNT(TEST); ++index) {
+
+        if(TEST[index]() == NESL_FAILURE) {
+            result = NESL_FAILURE;
+        }
+    }
+
+    return (int)result;
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
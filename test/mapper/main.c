@@ -25,6 +25,8 @@
  */
 
 #include <mapper.h>
+#include <mapper_4.h>
+#include <mapper_66.h>
 #include <test.h>
 
 /*!
@@ -43,6 +45,8 @@ typedef struct {
         const nesl_cartridge_header_t *header;  /*!< Cartridge header */
         const void *data;                       /*!< Cartridge data */
         int length;                             /*!< Cartridge data length in bytes */
+        const char *save;                       /*!< Cartridge battery save path */
+        bool flushed;                           /*!< Cartridge flushed state */
         bool initialized;                       /*!< Cartridge initialized state */
         nesl_error_e status;                    /*!< Cartridge error state */
     } cartridge;
@@ -59,6 +63,23 @@ static nesl_test_t g_test = {};                 /*!< Test context */
 extern "C" {
 #endif /* __cplusplus */
 
+size_t nesl_cartridge_capture(nesl_cartridge_t *cartridge, void *data)
+{
+    *(uint8_t *)data = g_test.data;
+
+    return sizeof(uint8_t);
+}
+
+void nesl_cartridge_flush(nesl_cartridge_t *cartridge)
+{
+    g_test.cartridge.flushed = true;
+}
+
+nesl_error_e nesl_cartridge_get_battery(const nesl_cartridge_t *cartridge)
+{
+    return cartridge->battery.failure ? NESL_FAILURE : NESL_SUCCESS;
+}
+
 nesl_mapper_e nesl_cartridge_get_mapper(nesl_cartridge_t *cartridge)
 {
     return (nesl_mapper_e)((cartridge->header->flag_7.type_high << 4) | cartridge->header->flag_6.type_low);
@@ -69,22 +90,52 @@ nesl_mirror_e nesl_cartridge_get_mirror(nesl_cartridge_t *cartridge)
     return (nesl_mirror_e)cartridge->header->flag_6.mirror;
 }
 
-nesl_error_e nesl_cartridge_initialize(nesl_cartridge_t *cartridge, const void *data, int length)
+size_t nesl_cartridge_get_size(const void *data, int length)
+{
+    return (data && (length >= sizeof(nesl_cartridge_header_t))) ? (16 * 1024) : 0;
+}
+
+nesl_error_e nesl_cartridge_initialize(nesl_cartridge_t *cartridge, nesl_arena_t *arena, const void *data, int length, const char *save)
 {
     g_test.cartridge.data = data;
     g_test.cartridge.length = length;
+    g_test.cartridge.save = save;
     g_test.cartridge.initialized = (g_test.cartridge.status == NESL_SUCCESS);
 
     return g_test.cartridge.status;
 }
 
+size_t nesl_cartridge_load(nesl_cartridge_t *cartridge, const void *data)
+{
+    g_test.data = *(const uint8_t *)data;
+
+    return sizeof(uint8_t);
+}
+
+size_t nesl_cartridge_restore(nesl_cartridge_t *cartridge, const void *data)
+{
+    g_test.data = *(const uint8_t *)data;
+
+    return sizeof(uint8_t);
+}
+
+size_t nesl_cartridge_save(const nesl_cartridge_t *cartridge, void *data)
+{
+
+    if(data) {
+        *(uint8_t *)data = g_test.data;
+    }
+
+    return sizeof(uint8_t);
+}
+
 void nesl_cartridge_uninitialize(nesl_cartridge_t *cartridge)
 {
     g_test.cartridge.initialized = false;
 }
 
 
-nesl_error_e nesl_mapper_0_initialize(nesl_mapper_t *mapper)
+nesl_error_e nesl_mapper_0_initialize(nesl_mapper_t *mapper, nesl_arena_t *arena)
 {
     g_test.state.initialized = (g_test.state.status == NESL_SUCCESS);
 
@@ -96,7 +147,7 @@ void nesl_mapper_0_uninitialize(nesl_mapper_t *mapper)
     g_test.state.initialized = false;
 }
 
-nesl_error_e nesl_mapper_1_initialize(nesl_mapper_t *mapper)
+nesl_error_e nesl_mapper_1_initialize(nesl_mapper_t *mapper, nesl_arena_t *arena)
 {
     g_test.state.initialized = (g_test.state.status == NESL_SUCCESS);
 
@@ -108,7 +159,7 @@ void nesl_mapper_1_uninitialize(nesl_mapper_t *mapper)
     g_test.state.initialized = false;
 }
 
-nesl_error_e nesl_mapper_2_initialize(nesl_mapper_t *mapper)
+nesl_error_e nesl_mapper_2_initialize(nesl_mapper_t *mapper, nesl_arena_t *arena)
 {
     g_test.state.initialized = (g_test.state.status == NESL_SUCCESS);
 
@@ -120,7 +171,7 @@ void nesl_mapper_2_uninitialize(nesl_mapper_t *mapper)
     g_test.state.initialized = false;
 }
 
-nesl_error_e nesl_mapper_3_initialize(nesl_mapper_t *mapper)
+nesl_error_e nesl_mapper_3_initialize(nesl_mapper_t *mapper, nesl_arena_t *arena)
 {
     g_test.state.initialized = (g_test.state.status == NESL_SUCCESS);
 
@@ -132,7 +183,7 @@ void nesl_mapper_3_uninitialize(nesl_mapper_t *mapper)
     g_test.state.initialized = false;
 }
 
-nesl_error_e nesl_mapper_30_initialize(nesl_mapper_t *mapper)
+nesl_error_e nesl_mapper_30_initialize(nesl_mapper_t *mapper, nesl_arena_t *arena)
 {
     g_test.state.initialized = (g_test.state.status == NESL_SUCCESS);
 
@@ -144,7 +195,7 @@ void nesl_mapper_30_uninitialize(nesl_mapper_t *mapper)
     g_test.state.initialized = false;
 }
 
-nesl_error_e nesl_mapper_4_initialize(nesl_mapper_t *mapper)
+nesl_error_e nesl_mapper_4_initialize(nesl_mapper_t *mapper, nesl_arena_t *arena)
 {
     g_test.state.initialized = (g_test.state.status == NESL_SUCCESS);
 
@@ -156,7 +207,7 @@ void nesl_mapper_4_uninitialize(nesl_mapper_t *mapper)
     g_test.state.initialized = false;
 }
 
-nesl_error_e nesl_mapper_66_initialize(nesl_mapper_t *mapper)
+nesl_error_e nesl_mapper_66_initialize(nesl_mapper_t *mapper, nesl_arena_t *arena)
 {
     g_test.state.initialized = (g_test.state.status == NESL_SUCCESS);
 
@@ -185,6 +236,19 @@ static nesl_error_e nesl_test_interrupt_handler(nesl_mapper_t *mapper)
     return NESL_SUCCESS;
 }
 
+/*!
+ * @brief Test load handler.
+ * @param[in,out] mapper Pointer to mapper subsystem context
+ * @param[in] data Constant pointer to state data
+ * @return State length in bytes
+ */
+static size_t nesl_test_load_handler(nesl_mapper_t *mapper, const void *data)
+{
+    memcpy(mapper->context, data, sizeof(nesl_mapper_4_t));
+
+    return sizeof(nesl_mapper_4_t);
+}
+
 /*!
  * @brief Test read handler.
  * @param[in,out] mapper Pointer to mapper subsystem context
@@ -212,6 +276,22 @@ static nesl_error_e nesl_test_reset_handler(nesl_mapper_t *mapper)
     return NESL_SUCCESS;
 }
 
+/*!
+ * @brief Test save handler.
+ * @param[in] mapper Constant pointer to mapper subsystem context
+ * @param[out] data Pointer to state data, or NULL to query the state length
+ * @return State length in bytes
+ */
+static size_t nesl_test_save_handler(const nesl_mapper_t *mapper, void *data)
+{
+
+    if(data) {
+        memcpy(data, mapper->context, sizeof(nesl_mapper_4_t));
+    }
+
+    return sizeof(nesl_mapper_4_t);
+}
+
 /*!
  * @brief Test write handler.
  * @param[in,out] mapper Pointer to mapper subsystem context
@@ -239,13 +319,157 @@ static void nesl_test_initialize(nesl_cartridge_header_t *header, nesl_mapper_e
     g_test.cartridge.header = header;
     g_test.mapper.cartridge.header = g_test.cartridge.header;
     g_test.mapper.extension.interrupt = &nesl_test_interrupt_handler;
+    g_test.mapper.extension.load = &nesl_test_load_handler;
     g_test.mapper.extension.read_ram = &nesl_test_read_handler;
     g_test.mapper.extension.read_rom = &nesl_test_read_handler;
     g_test.mapper.extension.reset = &nesl_test_reset_handler;
+    g_test.mapper.extension.save = &nesl_test_save_handler;
     g_test.mapper.extension.write_ram = &nesl_test_write_handler;
     g_test.mapper.extension.write_rom = &nesl_test_write_handler;
 }
 
+/*!
+ * @brief Test mapper subsystem capture.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_mapper_capture(void)
+{
+    size_t length;
+    uint8_t state[2][256] = {};
+    nesl_mapper_4_t context = {};
+    nesl_error_e result = NESL_SUCCESS;
+    nesl_cartridge_header_t header = {};
+
+    nesl_test_initialize(&header, MAPPER_4);
+    memset(&context, 0xAB, sizeof(context));
+    g_test.mapper.context = &context;
+    g_test.mapper.mirror = MIRROR_VERTICAL;
+    g_test.mapper.type = MAPPER_4;
+    g_test.mapper.ram.program = 1;
+    g_test.data = 0xCD;
+    length = sizeof(g_test.mapper.mirror) + sizeof(g_test.mapper.ram) + sizeof(g_test.mapper.rom) + sizeof(context) + sizeof(uint8_t);
+
+    if(ASSERT((nesl_mapper_capture(&g_test.mapper, state[0]) == length) && (state[0][length - 1] == 0xCD))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    memset(&context, 0, sizeof(context));
+    memset(&g_test.mapper.ram, 0, sizeof(g_test.mapper.ram));
+    g_test.mapper.mirror = MIRROR_HORIZONTAL;
+    g_test.data = 0;
+
+    if(ASSERT((nesl_mapper_restore(&g_test.mapper, state[0]) == length) && (g_test.data == 0xCD))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    nesl_mapper_save(&g_test.mapper, state[1]);
+
+    if(ASSERT(!memcmp(state[0], state[1], length))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+
+    return result;
+}
+
+/*!
+ * @brief Test mapper subsystem flush.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_mapper_flush(void)
+{
+    nesl_error_e result = NESL_SUCCESS;
+    nesl_cartridge_header_t header = {};
+
+    nesl_test_initialize(&header, MAPPER_0);
+    nesl_mapper_flush(&g_test.mapper);
+
+    if(ASSERT(g_test.cartridge.flushed == true)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+
+    return result;
+}
+
+/*!
+ * @brief Test mapper subsystem battery save status.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_mapper_get_battery(void)
+{
+    nesl_error_e result = NESL_SUCCESS;
+    nesl_cartridge_header_t header = {};
+
+    nesl_test_initialize(&header, MAPPER_0);
+
+    if(ASSERT(nesl_mapper_get_battery(&g_test.mapper) == NESL_SUCCESS)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    g_test.mapper.cartridge.battery.failure = "open";
+
+    if(ASSERT(nesl_mapper_get_battery(&g_test.mapper) == NESL_FAILURE)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+
+    return result;
+}
+
+/*!
+ * @brief Test mapper subsystem arena size.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_mapper_get_size(void)
+{
+    nesl_error_e result = NESL_SUCCESS;
+    nesl_cartridge_header_t header = {};
+
+    if(ASSERT(nesl_mapper_get_size(NULL, 0) == 0)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    nesl_test_initialize(&header, MAPPER_0);
+
+    if(ASSERT(nesl_mapper_get_size(&header, sizeof(header)) == (16 * 1024))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    nesl_test_initialize(&header, MAPPER_4);
+
+    if(ASSERT(nesl_mapper_get_size(&header, sizeof(header)) == ((16 * 1024) + ARENA_SIZE(sizeof(nesl_mapper_4_t))))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    nesl_test_initialize(&header, MAPPER_66);
+
+    if(ASSERT(nesl_mapper_get_size(&header, sizeof(header)) == ((16 * 1024) + ARENA_SIZE(sizeof(nesl_mapper_66_t))))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+
+    return result;
+}
+
 /*!
  * @brief Test mapper subsystem initialization.
  * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
@@ -258,7 +482,7 @@ static nesl_error_e nesl_test_mapper_initialize(void)
     nesl_test_initialize(&header, 0);
     g_test.cartridge.status = NESL_FAILURE;
 
-    if(ASSERT(nesl_mapper_initialize(&g_test.mapper, &header, sizeof(header)) == NESL_FAILURE)) {
+    if(ASSERT(nesl_mapper_initialize(&g_test.mapper, NULL, &header, sizeof(header), NULL) == NESL_FAILURE)) {
         result = NESL_FAILURE;
         goto exit;
     }
@@ -266,14 +490,14 @@ static nesl_error_e nesl_test_mapper_initialize(void)
     nesl_test_initialize(&header, 0);
     g_test.state.status = NESL_FAILURE;
 
-    if(ASSERT(nesl_mapper_initialize(&g_test.mapper, &header, sizeof(header)) == NESL_FAILURE)) {
+    if(ASSERT(nesl_mapper_initialize(&g_test.mapper, NULL, &header, sizeof(header), NULL) == NESL_FAILURE)) {
         result = NESL_FAILURE;
         goto exit;
     }
 
     nesl_test_initialize(&header, 0xFF);
 
-    if(ASSERT(nesl_mapper_initialize(&g_test.mapper, &header, sizeof(header)) == NESL_FAILURE)) {
+    if(ASSERT(nesl_mapper_initialize(&g_test.mapper, NULL, &header, sizeof(header), NULL) == NESL_FAILURE)) {
         result = NESL_FAILURE;
         goto exit;
     }
@@ -281,9 +505,10 @@ static nesl_error_e nesl_test_mapper_initialize(void)
     memset(&header, 0, sizeof(header));
     nesl_test_initialize(&header, MAPPER_0);
 
-    if(ASSERT((nesl_mapper_initialize(&g_test.mapper, &header, sizeof(header)) == NESL_SUCCESS)
+    if(ASSERT((nesl_mapper_initialize(&g_test.mapper, NULL, &header, sizeof(header), "test.sav") == NESL_SUCCESS)
             && (g_test.cartridge.data == &header)
             && (g_test.cartridge.length == sizeof(header))
+            && !strcmp(g_test.cartridge.save, "test.sav")
             && (g_test.cartridge.initialized == true)
             && (g_test.state.initialized == true)
             && (g_test.mapper.type == MAPPER_0)
@@ -329,6 +554,66 @@ exit:
     return result;
 }
 
+/*!
+ * @brief Test mapper subsystem state load/save.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_mapper_load(void)
+{
+    size_t length;
+    uint8_t state[2][256] = {};
+    nesl_mapper_4_t context = {};
+    nesl_error_e result = NESL_SUCCESS;
+    nesl_cartridge_header_t header = {};
+
+    nesl_test_initialize(&header, MAPPER_4);
+    memset(&context, 0xAB, sizeof(context));
+    g_test.mapper.context = &context;
+    g_test.mapper.mirror = MIRROR_VERTICAL;
+    g_test.mapper.type = MAPPER_4;
+    g_test.mapper.ram.program = 1;
+    g_test.data = 0xCD;
+
+    for(int index = 0; index < TEST_COUNT(g_test.mapper.rom.character); ++index) {
+        g_test.mapper.rom.character[index] = index;
+    }
+
+    for(int index = 0; index < TEST_COUNT(g_test.mapper.rom.program); ++index) {
+        g_test.mapper.rom.program[index] = index;
+    }
+
+    length = sizeof(g_test.mapper.mirror) + sizeof(g_test.mapper.ram) + sizeof(g_test.mapper.rom) + sizeof(context) + sizeof(uint8_t);
+
+    if(ASSERT((nesl_mapper_save(&g_test.mapper, NULL) == length) && (nesl_mapper_save(&g_test.mapper, state[0]) == length)
+            && (state[0][length - 1] == 0xCD))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    memset(&context, 0, sizeof(context));
+    memset(&g_test.mapper.ram, 0, sizeof(g_test.mapper.ram));
+    memset(&g_test.mapper.rom, 0, sizeof(g_test.mapper.rom));
+    g_test.mapper.mirror = MIRROR_HORIZONTAL;
+    g_test.data = 0;
+
+    if(ASSERT((nesl_mapper_load(&g_test.mapper, state[0]) == length) && (g_test.data == 0xCD))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    nesl_mapper_save(&g_test.mapper, state[1]);
+
+    if(ASSERT(!memcmp(state[0], state[1], length))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+
+    return result;
+}
+
 /*!
  * @brief Test mapper subsystem read.
  * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
@@ -450,8 +735,9 @@ exit:
 int main(void)
 {
     const test TEST[] = {
-        nesl_test_mapper_initialize, nesl_test_mapper_interrupt, nesl_test_mapper_read, nesl_test_mapper_reset,
-        nesl_test_mapper_uninitialize, nesl_test_mapper_write,
+        nesl_test_mapper_capture, nesl_test_mapper_flush, nesl_test_mapper_get_battery, nesl_test_mapper_get_size, nesl_test_mapper_initialize, nesl_test_mapper_interrupt, nesl_test_mapper_load,
+        nesl_test_mapper_read,
+        nesl_test_mapper_reset, nesl_test_mapper_uninitialize, nesl_test_mapper_write,
         };
 
     nesl_error_e result = NESL_SUCCESS;
@@ -118,9 +118,11 @@ void nesl_cartridge_write_ram(nesl_cartridge_t *cartridge, nesl_bank_e type, uin
 static void nesl_test_uninitialize(void)
 {
     g_test.mapper.extension.interrupt = NULL;
+    g_test.mapper.extension.load = NULL;
     g_test.mapper.extension.read_ram = NULL;
     g_test.mapper.extension.read_rom = NULL;
     g_test.mapper.extension.reset = NULL;
+    g_test.mapper.extension.save = NULL;
     g_test.mapper.extension.write_ram = NULL;
     g_test.mapper.extension.write_rom = NULL;
 }
@@ -136,13 +138,15 @@ static nesl_error_e nesl_test_initialize(const nesl_cartridge_header_t *header)
     memset(&g_test, 0, sizeof(g_test));
     g_test.mapper.cartridge.header = header;
     g_test.mapper.extension.interrupt = &nesl_mapper_0_interrupt;
+    g_test.mapper.extension.load = &nesl_mapper_0_load;
     g_test.mapper.extension.read_ram = &nesl_mapper_0_read_ram;
     g_test.mapper.extension.read_rom = &nesl_mapper_0_read_rom;
     g_test.mapper.extension.reset = &nesl_mapper_0_reset;
+    g_test.mapper.extension.save = &nesl_mapper_0_save;
     g_test.mapper.extension.write_ram = &nesl_mapper_0_write_ram;
     g_test.mapper.extension.write_rom = &nesl_mapper_0_write_rom;
 
-    return nesl_mapper_0_initialize(&g_test.mapper);
+    return nesl_mapper_0_initialize(&g_test.mapper, NULL);
 }
 
 /*!
@@ -164,9 +168,11 @@ static nesl_error_e nesl_test_mapper_0_initialize(void)
             && (g_test.mapper.rom.program[1] == 0)
             && (g_test.mapper.context == NULL)
             && (g_test.mapper.extension.interrupt == &nesl_mapper_0_interrupt)
+            && (g_test.mapper.extension.load == &nesl_mapper_0_load)
             && (g_test.mapper.extension.read_ram == &nesl_mapper_0_read_ram)
             && (g_test.mapper.extension.read_rom == &nesl_mapper_0_read_rom)
             && (g_test.mapper.extension.reset == &nesl_mapper_0_reset)
+            && (g_test.mapper.extension.save == &nesl_mapper_0_save)
             && (g_test.mapper.extension.write_ram == &nesl_mapper_0_write_ram)
             && (g_test.mapper.extension.write_rom == &nesl_mapper_0_write_rom))) {
         result = NESL_FAILURE;
@@ -186,9 +192,11 @@ static nesl_error_e nesl_test_mapper_0_initialize(void)
             && (g_test.mapper.rom.program[1] == 16 * 1024)
             && (g_test.mapper.context == NULL)
             && (g_test.mapper.extension.interrupt == &nesl_mapper_0_interrupt)
+            && (g_test.mapper.extension.load == &nesl_mapper_0_load)
             && (g_test.mapper.extension.read_ram == &nesl_mapper_0_read_ram)
             && (g_test.mapper.extension.read_rom == &nesl_mapper_0_read_rom)
             && (g_test.mapper.extension.reset == &nesl_mapper_0_reset)
+            && (g_test.mapper.extension.save == &nesl_mapper_0_save)
             && (g_test.mapper.extension.write_ram == &nesl_mapper_0_write_ram)
             && (g_test.mapper.extension.write_rom == &nesl_mapper_0_write_rom))) {
         result = NESL_FAILURE;
@@ -225,6 +233,32 @@ exit:
     return result;
 }
 
+/*!
+ * @brief Test mapper-0 extension state load/save.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_mapper_0_load(void)
+{
+    uint8_t state[1] = {};
+    nesl_error_e result = NESL_SUCCESS;
+    nesl_cartridge_header_t header = {};
+
+    if((result = nesl_test_initialize(&header)) == NESL_FAILURE) {
+        goto exit;
+    }
+
+    if(ASSERT((nesl_mapper_0_save(&g_test.mapper, NULL) == 0) && (nesl_mapper_0_save(&g_test.mapper, state) == 0)
+            && (nesl_mapper_0_load(&g_test.mapper, state) == 0))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+
+    return result;
+}
+
 /*!
  * @brief Test mapper-0 extension RAM read.
  * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
@@ -498,8 +532,9 @@ exit:
 int main(void)
 {
     const test TEST[] = {
-        nesl_test_mapper_0_initialize, nesl_test_mapper_0_interrupt, nesl_test_mapper_0_read_ram, nesl_test_mapper_0_read_rom,
-        nesl_test_mapper_0_reset, nesl_test_mapper_0_uninitialize, nesl_test_mapper_0_write_ram, nesl_test_mapper_0_write_rom,
+        nesl_test_mapper_0_initialize, nesl_test_mapper_0_interrupt, nesl_test_mapper_0_load, nesl_test_mapper_0_read_ram,
+        nesl_test_mapper_0_read_rom, nesl_test_mapper_0_reset, nesl_test_mapper_0_uninitialize, nesl_test_mapper_0_write_ram,
+        nesl_test_mapper_0_write_rom,
         };
 
     nesl_error_e result = NESL_SUCCESS;
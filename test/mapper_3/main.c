@@ -33,6 +33,7 @@
  */
 typedef struct {
     nesl_mapper_t mapper;                       /*!< Mapper type */
+    uint8_t context[256];                       /*!< Extension context */
     nesl_bank_e type;                           /*!< Bank type */
     uint32_t address;                           /*!< Bank address */
     uint8_t data;                               /*!< Bank data */
@@ -57,6 +58,11 @@ static nesl_test_t g_test = {};                 /*!< Test context */
 extern "C" {
 #endif /* __cplusplus */
 
+void *nesl_arena_allocate(nesl_arena_t *arena, size_t size)
+{
+    return (size <= sizeof(g_test.context)) ? memset(g_test.context, 0, size) : NULL;
+}
+
 uint8_t nesl_cartridge_get_banks(nesl_cartridge_t *cartridge, nesl_bank_e type)
 {
     return g_test.mapper.cartridge.header->rom.program;
@@ -124,9 +130,11 @@ static void nesl_test_uninitialize(void)
 {
     nesl_mapper_3_uninitialize(&g_test.mapper);
     g_test.mapper.extension.interrupt = NULL;
+    g_test.mapper.extension.load = NULL;
     g_test.mapper.extension.read_ram = NULL;
     g_test.mapper.extension.read_rom = NULL;
     g_test.mapper.extension.reset = NULL;
+    g_test.mapper.extension.save = NULL;
     g_test.mapper.extension.write_ram = NULL;
     g_test.mapper.extension.write_rom = NULL;
 }
@@ -142,13 +150,15 @@ static nesl_error_e nesl_test_initialize(const nesl_cartridge_header_t *header)
     memset(&g_test, 0, sizeof(g_test));
     g_test.mapper.cartridge.header = header;
     g_test.mapper.extension.interrupt = &nesl_mapper_3_interrupt;
+    g_test.mapper.extension.load = &nesl_mapper_3_load;
     g_test.mapper.extension.read_ram = &nesl_mapper_3_read_ram;
     g_test.mapper.extension.read_rom = &nesl_mapper_3_read_rom;
     g_test.mapper.extension.reset = &nesl_mapper_3_reset;
+    g_test.mapper.extension.save = &nesl_mapper_3_save;
     g_test.mapper.extension.write_ram = &nesl_mapper_3_write_ram;
     g_test.mapper.extension.write_rom = &nesl_mapper_3_write_rom;
 
-    return nesl_mapper_3_initialize(&g_test.mapper);
+    return nesl_mapper_3_initialize(&g_test.mapper, NULL);
 }
 
 /*!
@@ -174,9 +184,11 @@ static nesl_error_e nesl_test_mapper_3_initialize(void)
             && (g_test.mapper.mirror == MIRROR_HORIZONTAL)
             && (g_test.mapper.context != NULL)
             && (g_test.mapper.extension.interrupt == &nesl_mapper_3_interrupt)
+            && (g_test.mapper.extension.load == &nesl_mapper_3_load)
             && (g_test.mapper.extension.read_ram == &nesl_mapper_3_read_ram)
             && (g_test.mapper.extension.read_rom == &nesl_mapper_3_read_rom)
             && (g_test.mapper.extension.reset == &nesl_mapper_3_reset)
+            && (g_test.mapper.extension.save == &nesl_mapper_3_save)
             && (g_test.mapper.extension.write_ram == &nesl_mapper_3_write_ram)
             && (g_test.mapper.extension.write_rom == &nesl_mapper_3_write_rom))) {
         result = NESL_FAILURE;
@@ -197,9 +209,11 @@ static nesl_error_e nesl_test_mapper_3_initialize(void)
             && (g_test.mapper.mirror == MIRROR_HORIZONTAL)
             && (g_test.mapper.context != NULL)
             && (g_test.mapper.extension.interrupt == &nesl_mapper_3_interrupt)
+            && (g_test.mapper.extension.load == &nesl_mapper_3_load)
             && (g_test.mapper.extension.read_ram == &nesl_mapper_3_read_ram)
             && (g_test.mapper.extension.read_rom == &nesl_mapper_3_read_rom)
             && (g_test.mapper.extension.reset == &nesl_mapper_3_reset)
+            && (g_test.mapper.extension.save == &nesl_mapper_3_save)
             && (g_test.mapper.extension.write_ram == &nesl_mapper_3_write_ram)
             && (g_test.mapper.extension.write_rom == &nesl_mapper_3_write_rom))) {
         result = NESL_FAILURE;
@@ -236,6 +250,41 @@ exit:
     return result;
 }
 
+/*!
+ * @brief Test mapper-3 extension state load/save.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_mapper_3_load(void)
+{
+    uint8_t state[sizeof(nesl_mapper_3_t)] = {};
+    nesl_error_e result = NESL_SUCCESS;
+    nesl_cartridge_header_t header = {};
+
+    if((result = nesl_test_initialize(&header)) == NESL_FAILURE) {
+        goto exit;
+    }
+
+    memset(g_test.mapper.context, 0xAB, sizeof(state));
+
+    if(ASSERT((nesl_mapper_3_save(&g_test.mapper, NULL) == sizeof(state)) && (nesl_mapper_3_save(&g_test.mapper, state) == sizeof(state))
+            && !memcmp(state, g_test.mapper.context, sizeof(state)))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    memset(g_test.mapper.context, 0, sizeof(state));
+
+    if(ASSERT((nesl_mapper_3_load(&g_test.mapper, state) == sizeof(state)) && !memcmp(state, g_test.mapper.context, sizeof(state)))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+
+    return result;
+}
+
 /*!
  * @brief Test mapper-3 extension RAM read.
  * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
@@ -534,8 +583,9 @@ exit:
 int main(void)
 {
     const test TEST[] = {
-        nesl_test_mapper_3_initialize, nesl_test_mapper_3_interrupt, nesl_test_mapper_3_read_ram, nesl_test_mapper_3_read_rom,
-        nesl_test_mapper_3_reset, nesl_test_mapper_3_uninitialize, nesl_test_mapper_3_write_ram, nesl_test_mapper_3_write_rom,
+        nesl_test_mapper_3_initialize, nesl_test_mapper_3_interrupt, nesl_test_mapper_3_load, nesl_test_mapper_3_read_ram,
+        nesl_test_mapper_3_read_rom, nesl_test_mapper_3_reset, nesl_test_mapper_3_uninitialize, nesl_test_mapper_3_write_ram,
+        nesl_test_mapper_3_write_rom,
         };
 
     nesl_error_e result = NESL_SUCCESS;
@@ -0,0 +1,230 @@
+/*
+ * NESL
+ * Copyright (C) 2022 David Jolly
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+ * @file main.c
+ * @brief Test application for input movie.
+ */
+
+#include <unistd.h>
+#include <movie.h>
+#include <test.h>
+
+#define TEST_FRAMES ((2 * MOVIE_INTERVAL) + 10) /*!< Test frame count */
+#define TEST_HASH 0x0123456789ABCDEFULL     /*!< Test cartridge data hash */
+#define TEST_LENGTH 32                      /*!< Test state length in bytes */
+#define TEST_PATH "./test.movie"            /*!< Test movie path */
+
+/*!
+ * @struct nesl_test_t
+ * @brief Contains the test contexts.
+ */
+typedef struct {
+    nesl_movie_t movie[2];                  /*!< Input movies */
+    uint8_t state[TEST_LENGTH];             /*!< State */
+} nesl_test_t;
+
+static nesl_test_t g_test = {};             /*!< Test context */
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+nesl_error_e nesl_set_error(const char *file, const char *function, int line, const char *format, ...)
+{
+    return NESL_FAILURE;
+}
+
+/*!
+ * @brief Uninitialize test context.
+ */
+static void nesl_test_uninitialize(void)
+{
+
+    for(int index = 0; index < TEST_COUNT(g_test.movie); ++index) {
+        nesl_movie_uninitialize(&g_test.movie[index]);
+    }
+
+    unlink(TEST_PATH);
+}
+
+/*!
+ * @brief Initialize test context, recording a movie with input from the frame index, resets every 100 frames and the
+ *        frame index in the first state byte.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_initialize(void)
+{
+    nesl_error_e result = NESL_SUCCESS;
+
+    nesl_test_uninitialize();
+    memset(&g_test, 0, sizeof(g_test));
+
+    if((result = nesl_movie_initialize(&g_test.movie[0], TEST_HASH, TEST_LENGTH)) == NESL_FAILURE) {
+        goto exit;
+    }
+
+    for(int frame = 0; frame < TEST_FRAMES; ++frame) {
+        uint8_t input = frame;
+
+        g_test.state[0] = frame / MOVIE_INTERVAL;
+
+        if((result = nesl_movie_append(&g_test.movie[0], &input, !(frame % 100), g_test.state)) == NESL_FAILURE) {
+            goto exit;
+        }
+    }
+
+exit:
+    return result;
+}
+
+/*!
+ * @brief Test input movie append.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_movie_append(void)
+{
+    nesl_error_e result = NESL_SUCCESS;
+
+    if(ASSERT(nesl_test_initialize() == NESL_SUCCESS)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    if(ASSERT((g_test.movie[0].header.frames == TEST_FRAMES) && (g_test.movie[0].header.ports == MOVIE_PORTS)
+            && (g_test.movie[0].header.resets == 13) && (g_test.movie[0].header.keyframes == 3)
+            && (g_test.movie[0].header.length == TEST_LENGTH) && (g_test.movie[0].header.hash == TEST_HASH))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    for(int frame = 0; frame < TEST_FRAMES; ++frame) {
+
+        if(ASSERT(g_test.movie[0].input[frame] == (uint8_t)frame)) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+    }
+
+    for(int keyframe = 0; keyframe < g_test.movie[0].header.keyframes; ++keyframe) {
+
+        if(ASSERT(g_test.movie[0].state[keyframe * TEST_LENGTH] == keyframe)) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+    }
+
+exit:
+    TEST_RESULT(result);
+    nesl_test_uninitialize();
+
+    return result;
+}
+
+/*!
+ * @brief Test input movie reset.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_movie_is_reset(void)
+{
+    nesl_error_e result = NESL_SUCCESS;
+
+    if(ASSERT(nesl_test_initialize() == NESL_SUCCESS)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    for(int frame = 0; frame < TEST_FRAMES + 100; ++frame) {
+
+        if(ASSERT(nesl_movie_is_reset(&g_test.movie[0], frame) == ((frame < TEST_FRAMES) && !(frame % 100)))) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+    }
+
+exit:
+    TEST_RESULT(result);
+    nesl_test_uninitialize();
+
+    return result;
+}
+
+/*!
+ * @brief Test input movie read/write.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_movie_read(void)
+{
+    nesl_error_e result = NESL_SUCCESS;
+
+    if(ASSERT((nesl_test_initialize() == NESL_SUCCESS) && (nesl_movie_write(&g_test.movie[0], TEST_PATH) == NESL_SUCCESS))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    if(ASSERT((nesl_movie_read(&g_test.movie[1], TEST_PATH, TEST_HASH + 1, TEST_LENGTH) == NESL_FAILURE)
+            && (nesl_movie_read(&g_test.movie[1], TEST_PATH, TEST_HASH, TEST_LENGTH + 1) == NESL_FAILURE)
+            && (nesl_movie_read(&g_test.movie[1], TEST_PATH ".missing", TEST_HASH, TEST_LENGTH) == NESL_FAILURE))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    if(ASSERT(nesl_movie_read(&g_test.movie[1], TEST_PATH, TEST_HASH, TEST_LENGTH) == NESL_SUCCESS)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    if(ASSERT(!memcmp(&g_test.movie[0].header, &g_test.movie[1].header, sizeof(g_test.movie[0].header))
+            && !memcmp(g_test.movie[0].input, g_test.movie[1].input, TEST_FRAMES * MOVIE_PORTS)
+            && !memcmp(g_test.movie[0].reset, g_test.movie[1].reset, g_test.movie[0].header.resets * sizeof(uint32_t))
+            && !memcmp(g_test.movie[0].state, g_test.movie[1].state, g_test.movie[0].header.keyframes * TEST_LENGTH))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+    nesl_test_uninitialize();
+
+    return result;
+}
+
+int main(void)
+{
+    const test TEST[] = {
+        nesl_test_movie_append, nesl_test_movie_is_reset, nesl_test_movie_read,
+        };
+
+    nesl_error_e result = NESL_SUCCESS;
+
+    for(int index = 0; index < TEST_COUNT(TEST); ++index) {
+
+        if(TEST[index]() == NESL_FAILURE) {
+            result = NESL_FAILURE;
+        }
+    }
+
+    return (int)result;
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
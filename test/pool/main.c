@@ -0,0 +1,228 @@
+/*
+ * NESL
+ * Copyright (C) 2022 David Jolly
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+ * @file main.c
+ * @brief Test application for work-stealing thread pool.
+ */
+
+#include <pool.h>
+#include <test.h>
+
+/*!
+ * @struct nesl_test_t
+ * @brief Contains the test contexts.
+ */
+typedef struct {
+    nesl_pool_t pool;           /*!< Thread pool context */
+    atomic_int run[1024];       /*!< Task run counts */
+} nesl_test_t;
+
+static nesl_test_t g_test = {}; /*!< Test context */
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+nesl_error_e nesl_set_error(const char *file, const char *function, int line, const char *format, ...)
+{
+    return NESL_FAILURE;
+}
+
+/*!
+ * @brief Test task, counting each run of an index.
+ * @param[in,out] context Pointer to task run counts
+ * @param[in] index Task index
+ */
+static void nesl_test_task(void *context, int index)
+{
+    atomic_fetch_add(&((atomic_int *)context)[index], 1);
+}
+
+/*!
+ * @brief Uninitialize test context.
+ */
+static void nesl_test_uninitialize(void)
+{
+    nesl_pool_uninitialize(&g_test.pool);
+    memset(&g_test, 0, sizeof(g_test));
+}
+
+/*!
+ * @brief Initialize test context.
+ * @param[in] count Worker thread count
+ * @param[in] affinity Worker thread affinity
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_initialize(int count, bool affinity)
+{
+    memset(&g_test, 0, sizeof(g_test));
+
+    return nesl_pool_initialize(&g_test.pool, count, affinity);
+}
+
+/*!
+ * @brief Test thread pool initialization.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_pool_initialize(void)
+{
+    nesl_error_e result = NESL_SUCCESS;
+
+    for(int count = 0; count <= 4; ++count) {
+
+        for(int affinity = 0; affinity <= 1; ++affinity) {
+
+            if(ASSERT(nesl_test_initialize(count, affinity) == NESL_SUCCESS)) {
+                result = NESL_FAILURE;
+                goto exit;
+            }
+
+            if(ASSERT((g_test.pool.count == count) && (!count || g_test.pool.worker) && g_test.pool.deque
+                    && (g_test.pool.affinity == affinity) && g_test.pool.running && !g_test.pool.job)) {
+                result = NESL_FAILURE;
+                goto exit;
+            }
+
+            for(int index = 0; index < count; ++index) {
+
+                if(ASSERT((g_test.pool.worker[index].pool == &g_test.pool) && (g_test.pool.worker[index].index == index))) {
+                    result = NESL_FAILURE;
+                    goto exit;
+                }
+            }
+
+            nesl_test_uninitialize();
+        }
+    }
+
+exit:
+    TEST_RESULT(result);
+    nesl_test_uninitialize();
+
+    return result;
+}
+
+/*!
+ * @brief Test thread pool run.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_pool_run(void)
+{
+    nesl_error_e result = NESL_SUCCESS;
+
+    for(int count = 0; count <= 4; ++count) {
+
+        if(ASSERT(nesl_test_initialize(count, false) == NESL_SUCCESS)) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+
+        for(int job = 0; job < 64; ++job) {
+            int tasks = (job < 8) ? job : ((job * 17) % TEST_COUNT(g_test.run));
+
+            for(int index = 0; index < TEST_COUNT(g_test.run); ++index) {
+                atomic_store(&g_test.run[index], 0);
+            }
+
+            nesl_pool_run(&g_test.pool, nesl_test_task, g_test.run, tasks);
+
+            for(int index = 0; index < TEST_COUNT(g_test.run); ++index) {
+
+                if(ASSERT(atomic_load(&g_test.run[index]) == ((index < tasks) ? 1 : 0))) {
+                    result = NESL_FAILURE;
+                    goto exit;
+                }
+            }
+
+            if(ASSERT(!g_test.pool.job)) {
+                result = NESL_FAILURE;
+                goto exit;
+            }
+
+            for(int index = 0; index <= count; ++index) {
+                uint64_t range = atomic_load(&g_test.pool.deque[index].range);
+
+                if(ASSERT((uint32_t)range >= (uint32_t)(range >> 32))) {
+                    result = NESL_FAILURE;
+                    goto exit;
+                }
+            }
+        }
+
+        nesl_test_uninitialize();
+    }
+
+exit:
+    TEST_RESULT(result);
+    nesl_test_uninitialize();
+
+    return result;
+}
+
+/*!
+ * @brief Test thread pool uninitialization.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_pool_uninitialize(void)
+{
+    nesl_error_e result = NESL_SUCCESS;
+
+    if(ASSERT(nesl_test_initialize(4, false) == NESL_SUCCESS)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    nesl_pool_uninitialize(&g_test.pool);
+
+    if(ASSERT(!g_test.pool.worker && !g_test.pool.deque && !g_test.pool.count && !g_test.pool.running)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+    memset(&g_test, 0, sizeof(g_test));
+
+    return result;
+}
+
+int main(void)
+{
+    const test TEST[] = {
+        nesl_test_pool_initialize, nesl_test_pool_run, nesl_test_pool_uninitialize,
+        };
+
+    nesl_error_e result = NESL_SUCCESS;
+
+    for(int index = 0; index < TEST_COUNT(TEST); ++index) {
+
+        if(TEST[index]() == NESL_FAILURE) {
+            result = NESL_FAILURE;
+        }
+    }
+
+    return (int)result;
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
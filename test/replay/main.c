@@ -0,0 +1,246 @@
+/*
+ * NESL
+ * Copyright (C) 2022 David Jolly
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+ * @file main.c
+ * @brief Test application for replay hashes.
+ */
+
+#include <unistd.h>
+#include <replay.h>
+#include <test.h>
+
+#define TEST_COUNT_HASH 7                   /*!< Test hash count per frame */
+#define TEST_FRAMES 2000                    /*!< Test frame count */
+#define TEST_HASH 0x0123456789ABCDEFULL     /*!< Test cartridge data hash */
+#define TEST_PATH "./test.replay"           /*!< Test replay hashes path */
+
+/*!
+ * @struct nesl_test_t
+ * @brief Contains the test contexts.
+ */
+typedef struct {
+    nesl_replay_t replay[2];                /*!< Replay hashes */
+    uint64_t hash[TEST_COUNT_HASH];         /*!< Frame hashes */
+} nesl_test_t;
+
+static nesl_test_t g_test = {};             /*!< Test context */
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+nesl_error_e nesl_set_error(const char *file, const char *function, int line, const char *format, ...)
+{
+    return NESL_FAILURE;
+}
+
+/*!
+ * @brief Set frame hashes, from the frame and hash indices.
+ * @param[in] frame Frame index
+ */
+static void nesl_test_hash(uint32_t frame)
+{
+
+    for(int index = 0; index < TEST_COUNT_HASH; ++index) {
+        g_test.hash[index] = ((uint64_t)frame << 8) | index;
+    }
+}
+
+/*!
+ * @brief Uninitialize test context.
+ */
+static void nesl_test_uninitialize(void)
+{
+
+    for(int index = 0; index < TEST_COUNT(g_test.replay); ++index) {
+        nesl_replay_uninitialize(&g_test.replay[index]);
+    }
+
+    unlink(TEST_PATH);
+}
+
+/*!
+ * @brief Initialize test context, recording replay hashes for each frame.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_initialize(void)
+{
+    nesl_error_e result = NESL_SUCCESS;
+
+    nesl_test_uninitialize();
+    memset(&g_test, 0, sizeof(g_test));
+
+    if((result = nesl_replay_initialize(&g_test.replay[0], TEST_HASH, TEST_COUNT_HASH)) == NESL_FAILURE) {
+        goto exit;
+    }
+
+    for(uint32_t frame = 0; frame < TEST_FRAMES; ++frame) {
+        nesl_test_hash(frame);
+
+        if((result = nesl_replay_append(&g_test.replay[0], g_test.hash)) == NESL_FAILURE) {
+            goto exit;
+        }
+    }
+
+exit:
+    return result;
+}
+
+/*!
+ * @brief Test replay hashes append.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_replay_append(void)
+{
+    nesl_error_e result = NESL_SUCCESS;
+
+    if(ASSERT(nesl_test_initialize() == NESL_SUCCESS)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    if(ASSERT((g_test.replay[0].header.frames == TEST_FRAMES) && (g_test.replay[0].header.count == TEST_COUNT_HASH)
+            && (g_test.replay[0].header.hash == TEST_HASH) && (g_test.replay[0].capacity >= TEST_FRAMES))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    for(uint32_t frame = 0; frame < TEST_FRAMES; ++frame) {
+
+        for(int index = 0; index < TEST_COUNT_HASH; ++index) {
+
+            if(ASSERT(g_test.replay[0].hash[(frame * TEST_COUNT_HASH) + index] == (((uint64_t)frame << 8) | index))) {
+                result = NESL_FAILURE;
+                goto exit;
+            }
+        }
+    }
+
+exit:
+    TEST_RESULT(result);
+    nesl_test_uninitialize();
+
+    return result;
+}
+
+/*!
+ * @brief Test replay hashes compare.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_replay_compare(void)
+{
+    nesl_error_e result = NESL_SUCCESS;
+
+    if(ASSERT(nesl_test_initialize() == NESL_SUCCESS)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    for(uint32_t frame = 0; frame < TEST_FRAMES; ++frame) {
+        nesl_test_hash(frame);
+
+        if(ASSERT(nesl_replay_compare(&g_test.replay[0], frame, g_test.hash) == -1)) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+
+        for(int index = TEST_COUNT_HASH - 1; index >= 0; --index) {
+            g_test.hash[index] ^= 1;
+
+            if(ASSERT(nesl_replay_compare(&g_test.replay[0], frame, g_test.hash) == index)) {
+                result = NESL_FAILURE;
+                goto exit;
+            }
+        }
+    }
+
+    if(ASSERT(nesl_replay_compare(&g_test.replay[0], TEST_FRAMES, g_test.hash) == TEST_COUNT_HASH)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+    nesl_test_uninitialize();
+
+    return result;
+}
+
+/*!
+ * @brief Test replay hashes read/write.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_replay_read(void)
+{
+    nesl_error_e result = NESL_SUCCESS;
+
+    if(ASSERT((nesl_test_initialize() == NESL_SUCCESS) && (nesl_replay_write(&g_test.replay[0], TEST_PATH) == NESL_SUCCESS))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    if(ASSERT((nesl_replay_read(&g_test.replay[1], TEST_PATH, TEST_HASH + 1, TEST_COUNT_HASH) == NESL_FAILURE)
+            && (nesl_replay_read(&g_test.replay[1], TEST_PATH, TEST_HASH, TEST_COUNT_HASH + 1) == NESL_FAILURE)
+            && (nesl_replay_read(&g_test.replay[1], TEST_PATH ".missing", TEST_HASH, TEST_COUNT_HASH) == NESL_FAILURE))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    if(ASSERT(nesl_replay_read(&g_test.replay[1], TEST_PATH, TEST_HASH, TEST_COUNT_HASH) == NESL_SUCCESS)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    if(ASSERT(!memcmp(&g_test.replay[0].header, &g_test.replay[1].header, sizeof(g_test.replay[0].header))
+            && !memcmp(g_test.replay[0].hash, g_test.replay[1].hash, TEST_FRAMES * TEST_COUNT_HASH * sizeof(uint64_t)))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+    nesl_test_uninitialize();
+
+    return result;
+}
+
+int main(void)
+{
+    const test TEST[] = {
+        nesl_test_replay_append, nesl_test_replay_compare, nesl_test_replay_read,
+        };
+
+    nesl_error_e result = NESL_SUCCESS;
+
+    for(int index = 0; index < TEST_COUNT(TEST); ++index) {
+
+        if(TEST[index]() == NESL_FAILURE) {
+            result = NESL_FAILURE;
+        }
+    }
+
+    return (int)result;
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
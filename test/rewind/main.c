@@ -0,0 +1,315 @@
+/*
+ * NESL
+ * Copyright (C) 2022 David Jolly
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+ * @file main.c
+ * @brief Test application for rewind buffer.
+ */
+
+#include <rewind.h>
+#include <test.h>
+
+#define TEST_FRAMES 1000                /*!< Test frame count */
+#define TEST_LENGTH 4096                /*!< Test state length in bytes */
+
+/*!
+ * @struct nesl_test_t
+ * @brief Contains the test contexts.
+ */
+typedef struct {
+    nesl_rewind_t rewind;               /*!< Rewind context */
+    uint8_t state[TEST_LENGTH];         /*!< Popped state */
+} nesl_test_t;
+
+static nesl_test_t g_test = {};         /*!< Test context */
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+size_t nesl_lz_compress(const void *data, size_t length, void *compressed, size_t capacity)
+{
+    size_t result = 0;
+
+    if(length <= capacity) {
+        memcpy(compressed, data, length);
+        result = length;
+    }
+
+    return result;
+}
+
+size_t nesl_lz_decompress(const void *compressed, size_t length, void *data, size_t capacity)
+{
+    size_t result = 0;
+
+    if(length <= capacity) {
+        memcpy(data, compressed, length);
+        result = length;
+    }
+
+    return result;
+}
+
+nesl_error_e nesl_set_error(const char *file, const char *function, int line, const char *format, ...)
+{
+    return NESL_FAILURE;
+}
+
+/*!
+ * @brief Set test state for a frame, changing a few bytes per frame and one region each keyframe interval.
+ * @param[out] state Pointer to state
+ * @param[in] frame Frame index
+ */
+static void nesl_test_set_state(uint8_t *state, int frame)
+{
+    memset(state, 0, TEST_LENGTH);
+
+    for(int offset = 0; offset < 2048; offset += 64) {
+        state[offset] = frame + offset;
+    }
+
+    memset(&state[2048 + ((frame / REWIND_INTERVAL) % 16) * 64], frame / REWIND_INTERVAL, 64);
+    state[TEST_LENGTH - 1] = frame;
+}
+
+/*!
+ * @brief Uninitialize test context.
+ */
+static void nesl_test_uninitialize(void)
+{
+    nesl_rewind_uninitialize(&g_test.rewind);
+    memset(&g_test, 0, sizeof(g_test));
+}
+
+/*!
+ * @brief Test rewind buffer initialization.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_rewind_initialize(void)
+{
+    nesl_error_e result = NESL_SUCCESS;
+
+    nesl_test_uninitialize();
+
+    if(ASSERT(nesl_rewind_initialize(&g_test.rewind, 3 * TEST_LENGTH, TEST_LENGTH) == NESL_FAILURE)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    if(ASSERT((nesl_rewind_initialize(&g_test.rewind, 64 * 1024, TEST_LENGTH) == NESL_SUCCESS)
+            && (g_test.rewind.length == TEST_LENGTH)
+            && (g_test.rewind.entry.capacity > 0)
+            && !g_test.rewind.entry.count
+            && (g_test.rewind.data.capacity >= REWIND_BOUND(TEST_LENGTH))
+            && ((g_test.rewind.record + REWIND_BOUND(TEST_LENGTH)) == ((uint8_t *)g_test.rewind.entry.data + (64 * 1024))))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+    nesl_test_uninitialize();
+
+    return result;
+}
+
+/*!
+ * @brief Test rewind buffer peek/pop.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_rewind_pop(void)
+{
+    uint8_t state[TEST_LENGTH] = {};
+    nesl_error_e result = NESL_SUCCESS;
+
+    nesl_test_uninitialize();
+
+    if(ASSERT((nesl_rewind_initialize(&g_test.rewind, 1024 * 1024, TEST_LENGTH) == NESL_SUCCESS)
+            && !nesl_rewind_peek(&g_test.rewind, g_test.state) && !nesl_rewind_pop(&g_test.rewind))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    for(int frame = 0; frame < 200; ++frame) {
+        nesl_test_set_state(state, frame);
+        nesl_rewind_push(&g_test.rewind, state);
+    }
+
+    if(ASSERT(nesl_rewind_pop(&g_test.rewind) && (g_test.rewind.entry.count == 199))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    for(int frame = 198; frame >= 100; --frame) {
+        nesl_test_set_state(state, frame);
+
+        if(ASSERT(nesl_rewind_peek(&g_test.rewind, g_test.state) && !memcmp(state, g_test.state, TEST_LENGTH)
+                && nesl_rewind_pop(&g_test.rewind))) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+    }
+
+    for(int frame = 100; frame < 300; ++frame) {
+        nesl_test_set_state(state, frame);
+        nesl_rewind_push(&g_test.rewind, state);
+    }
+
+    for(int frame = 299; frame >= 0; --frame) {
+        nesl_test_set_state(state, frame);
+
+        if(ASSERT(nesl_rewind_peek(&g_test.rewind, g_test.state) && !memcmp(state, g_test.state, TEST_LENGTH)
+                && nesl_rewind_pop(&g_test.rewind))) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+    }
+
+    if(ASSERT(!nesl_rewind_peek(&g_test.rewind, g_test.state) && !nesl_rewind_pop(&g_test.rewind) && !g_test.rewind.entry.count)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+    nesl_test_uninitialize();
+
+    return result;
+}
+
+/*!
+ * @brief Test rewind buffer push, evicting the oldest states once full.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_rewind_push(void)
+{
+    int frame, count = 0;
+    uint8_t state[TEST_LENGTH] = {};
+    nesl_error_e result = NESL_SUCCESS;
+
+    nesl_test_uninitialize();
+
+    if(ASSERT(nesl_rewind_initialize(&g_test.rewind, 64 * 1024, TEST_LENGTH) == NESL_SUCCESS)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    for(frame = 0; frame < TEST_FRAMES; ++frame) {
+        nesl_test_set_state(state, frame);
+        nesl_rewind_push(&g_test.rewind, state);
+
+        if(ASSERT((g_test.rewind.entry.count > 0) && (g_test.rewind.entry.count <= g_test.rewind.entry.capacity)
+                && (g_test.rewind.data.head <= g_test.rewind.data.capacity)
+                && g_test.rewind.entry.data[g_test.rewind.entry.tail].keyframe)) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+    }
+
+    if(ASSERT(g_test.rewind.entry.count < TEST_FRAMES)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    while(nesl_rewind_peek(&g_test.rewind, g_test.state) && nesl_rewind_pop(&g_test.rewind)) {
+        nesl_test_set_state(state, --frame);
+
+        if(ASSERT(!memcmp(state, g_test.state, TEST_LENGTH))) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+
+        ++count;
+    }
+
+    if(ASSERT(count >= REWIND_INTERVAL)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+    nesl_test_uninitialize();
+
+    return result;
+}
+
+/*!
+ * @brief Test rewind buffer push, pushing a delta that does not fit the record bound as a keyframe.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_rewind_push_bound(void)
+{
+    uint8_t state[TEST_LENGTH] = {};
+    nesl_error_e result = NESL_SUCCESS;
+
+    nesl_test_uninitialize();
+
+    if(ASSERT(nesl_rewind_initialize(&g_test.rewind, 64 * 1024, TEST_LENGTH) == NESL_SUCCESS)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    nesl_rewind_push(&g_test.rewind, state);
+
+    for(int offset = 0; offset < TEST_LENGTH; offset += 2) {
+        state[offset] = 0xFF;
+    }
+
+    nesl_rewind_push(&g_test.rewind, state);
+
+    if(ASSERT((g_test.rewind.entry.count == 2)
+            && g_test.rewind.entry.data[1].keyframe
+            && (g_test.rewind.entry.data[1].length <= REWIND_BOUND(TEST_LENGTH))
+            && nesl_rewind_peek(&g_test.rewind, g_test.state) && !memcmp(state, g_test.state, TEST_LENGTH))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+    nesl_test_uninitialize();
+
+    return result;
+}
+
+int main(void)
+{
+    const test TEST[] = {
+        nesl_test_rewind_initialize, nesl_test_rewind_pop, nesl_test_rewind_push, nesl_test_rewind_push_bound,
+        };
+
+    nesl_error_e result = NESL_SUCCESS;
+
+    for(int index = 0; index < TEST_COUNT(TEST); ++index) {
+
+        if(TEST[index]() == NESL_FAILURE) {
+            result = NESL_FAILURE;
+        }
+    }
+
+    return (int)result;
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
@@ -0,0 +1,412 @@
+/*
+ * NESL
+ * Copyright (C) 2022 David Jolly
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+ * @file main.c
+ * @brief Test application for headless service backend.
+ */
+
+#include <service_headless.h>
+#include <test.h>
+
+/*!
+ * @struct nesl_test_t
+ * @brief Contains the test contexts.
+ */
+typedef struct {
+    void *service;              /*!< Headless backend context */
+    nesl_t configuration;       /*!< Caller defined context */
+    uint8_t input[4];           /*!< Input button bits */
+} nesl_test_t;
+
+static nesl_test_t g_test = {}; /*!< Test context */
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+uint32_t nesl_service_get_color(uint16_t index)
+{
+    return 0xFF000000 | index;
+}
+
+nesl_error_e nesl_set_error(const char *file, const char *function, int line, const char *format, ...)
+{
+    return NESL_FAILURE;
+}
+
+/*!
+ * @brief Uninitialize test context.
+ */
+static void nesl_test_uninitialize(void)
+{
+    nesl_service_headless_uninitialize(g_test.service);
+    memset(&g_test, 0, sizeof(g_test));
+}
+
+/*!
+ * @brief Initialize test context.
+ * @param[in] length Input length in frames
+ * @param[in] capture Audio capture enabled
+ * @param[in] compact Compact display enabled
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_initialize(int length, bool capture, bool compact)
+{
+    const uint8_t INPUT[] = { 0x00, 0x01, 0x88, 0xFF, };
+
+    nesl_test_uninitialize();
+    memcpy(g_test.input, INPUT, sizeof(INPUT));
+    g_test.configuration.service = NESL_SERVICE_HEADLESS;
+    g_test.configuration.input = g_test.input;
+    g_test.configuration.input_length = length;
+    g_test.configuration.capture = capture;
+    g_test.configuration.compact = compact;
+
+    return nesl_service_headless_initialize(&g_test.service, &g_test.configuration);
+}
+
+/*!
+ * @brief Test headless backend get button.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_service_headless_get_button(void)
+{
+    nesl_error_e result = NESL_SUCCESS;
+
+    if(ASSERT(nesl_test_initialize(TEST_COUNT(g_test.input), false, false) == NESL_SUCCESS)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    for(int frame = 0; frame < TEST_COUNT(g_test.input); ++frame) {
+
+        if(ASSERT(nesl_service_headless_poll(g_test.service) == NESL_SUCCESS)) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+
+        for(nesl_button_e button = 0; button < BUTTON_MAX; ++button) {
+
+            if(ASSERT(nesl_service_headless_get_button(g_test.service, button) == ((g_test.input[frame] & (1 << button)) ? true : false))) {
+                result = NESL_FAILURE;
+                goto exit;
+            }
+        }
+
+        if(ASSERT(nesl_service_headless_redraw(g_test.service) == NESL_SUCCESS)) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+    }
+
+exit:
+    TEST_RESULT(result);
+    nesl_test_uninitialize();
+
+    return result;
+}
+
+/*!
+ * @brief Test headless backend get sensor/trigger.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_service_headless_get_sensor(void)
+{
+    nesl_error_e result = NESL_SUCCESS;
+
+    if(ASSERT(nesl_test_initialize(0, false, false) == NESL_SUCCESS)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    if(ASSERT((nesl_service_headless_get_sensor(g_test.service) == true)
+            && (nesl_service_headless_get_trigger(g_test.service) == false))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+    nesl_test_uninitialize();
+
+    return result;
+}
+
+/*!
+ * @brief Test headless backend initialization.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_service_headless_initialize(void)
+{
+    int length = -1;
+    nesl_error_e result = NESL_SUCCESS;
+
+    for(int compact = 0; compact <= 1; ++compact) {
+        const uint32_t *display = NULL;
+        const uint16_t *index = NULL;
+
+        if(ASSERT(nesl_test_initialize(0, false, compact) == NESL_SUCCESS)) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+
+        display = nesl_service_headless_get_display(g_test.service);
+        index = nesl_service_headless_get_index(g_test.service);
+
+        if(ASSERT(compact ? (!display && index) : (display && !index))) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+
+        for(int pixel = 0; pixel < (256 * 240); ++pixel) {
+
+            if(ASSERT(compact ? (index[pixel] == 0x0F) : (display[pixel] == 0xFF000000))) {
+                result = NESL_FAILURE;
+                goto exit;
+            }
+        }
+
+        if(ASSERT((nesl_service_headless_get_capture(g_test.service, &length) == NULL) && !length)) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+    }
+
+exit:
+    TEST_RESULT(result);
+    nesl_test_uninitialize();
+
+    return result;
+}
+
+/*!
+ * @brief Test headless backend poll.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_service_headless_poll(void)
+{
+    nesl_error_e result = NESL_SUCCESS;
+
+    for(int length = 0; length <= TEST_COUNT(g_test.input); ++length) {
+
+        if(ASSERT(nesl_test_initialize(length, false, false) == NESL_SUCCESS)) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+
+        for(int frame = 0; frame <= TEST_COUNT(g_test.input); ++frame) {
+
+            if(ASSERT(nesl_service_headless_poll(g_test.service) == ((length && (frame >= length)) ? NESL_QUIT : NESL_SUCCESS))) {
+                result = NESL_FAILURE;
+                goto exit;
+            }
+
+            if(ASSERT(nesl_service_headless_redraw(g_test.service) == NESL_SUCCESS)) {
+                result = NESL_FAILURE;
+                goto exit;
+            }
+        }
+    }
+
+exit:
+    TEST_RESULT(result);
+    nesl_test_uninitialize();
+
+    return result;
+}
+
+/*!
+ * @brief Test headless backend reset.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_service_headless_reset(void)
+{
+    int length = -1;
+    float data[16] = {};
+    const uint32_t *display = NULL;
+    nesl_error_e result = NESL_SUCCESS;
+
+    if(ASSERT(nesl_test_initialize(0, true, false) == NESL_SUCCESS)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    nesl_service_headless_set_pixel(g_test.service, 0x1FF, 255, 239);
+    nesl_service_headless_write_audio(g_test.service, data, sizeof(data));
+
+    if(ASSERT(nesl_service_headless_reset(g_test.service) == NESL_SUCCESS)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    display = nesl_service_headless_get_display(g_test.service);
+
+    if(ASSERT(display[(239 * 256) + 255] == 0xFF000000)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    nesl_service_headless_get_capture(g_test.service, &length);
+
+    if(ASSERT(!length)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+    nesl_test_uninitialize();
+
+    return result;
+}
+
+/*!
+ * @brief Test headless backend set pixel.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_service_headless_set_pixel(void)
+{
+    nesl_error_e result = NESL_SUCCESS;
+
+    for(int compact = 0; compact <= 1; ++compact) {
+        const uint32_t *display = NULL;
+        const uint16_t *index = NULL;
+
+        if(ASSERT(nesl_test_initialize(0, false, compact) == NESL_SUCCESS)) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+
+        display = nesl_service_headless_get_display(g_test.service);
+        index = nesl_service_headless_get_index(g_test.service);
+
+        for(int y = 0; y < 240; y += 7) {
+
+            for(int x = 0; x < 256; x += 5) {
+                nesl_service_headless_set_pixel(g_test.service, (x + y) & 0x1FF, x, y);
+
+                if(ASSERT(compact ? (index[(y * 256) + x] == ((x + y) & 0x1FF)) : (display[(y * 256) + x] == (0xFF000000 | ((x + y) & 0x1FF))))) {
+                    result = NESL_FAILURE;
+                    goto exit;
+                }
+            }
+        }
+    }
+
+exit:
+    TEST_RESULT(result);
+    nesl_test_uninitialize();
+
+    return result;
+}
+
+/*!
+ * @brief Test headless backend write audio.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_service_headless_write_audio(void)
+{
+    float data[128];
+    int length = -1;
+    const float *capture = NULL;
+    nesl_error_e result = NESL_SUCCESS;
+
+    for(int index = 0; index < TEST_COUNT(data); ++index) {
+        data[index] = index / (float)TEST_COUNT(data);
+    }
+
+    for(int enabled = 0; enabled <= 1; ++enabled) {
+
+        if(ASSERT(nesl_test_initialize(0, enabled, false) == NESL_SUCCESS)) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+
+        for(int frame = 0; frame < 3; ++frame) {
+
+            if(ASSERT(nesl_service_headless_poll(g_test.service) == NESL_SUCCESS)) {
+                result = NESL_FAILURE;
+                goto exit;
+            }
+
+            for(int batch = 0; batch <= frame; ++batch) {
+                nesl_service_headless_write_audio(g_test.service, data, sizeof(data));
+            }
+
+            capture = nesl_service_headless_get_capture(g_test.service, &length);
+
+            if(enabled) {
+
+                if(ASSERT(capture && (length == ((frame + 1) * sizeof(data))))) {
+                    result = NESL_FAILURE;
+                    goto exit;
+                }
+
+                for(int batch = 0; batch <= frame; ++batch) {
+
+                    if(ASSERT(!memcmp(&capture[batch * TEST_COUNT(data)], data, sizeof(data)))) {
+                        result = NESL_FAILURE;
+                        goto exit;
+                    }
+                }
+            } else if(ASSERT(!capture && !length)) {
+                result = NESL_FAILURE;
+                goto exit;
+            }
+
+            if(ASSERT(nesl_service_headless_redraw(g_test.service) == NESL_SUCCESS)) {
+                result = NESL_FAILURE;
+                goto exit;
+            }
+        }
+    }
+
+exit:
+    TEST_RESULT(result);
+    nesl_test_uninitialize();
+
+    return result;
+}
+
+int main(void)
+{
+    const test TEST[] = {
+        nesl_test_service_headless_get_button, nesl_test_service_headless_get_sensor, nesl_test_service_headless_initialize,
+        nesl_test_service_headless_poll, nesl_test_service_headless_reset, nesl_test_service_headless_set_pixel,
+        nesl_test_service_headless_write_audio,
+        };
+
+    nesl_error_e result = NESL_SUCCESS;
+
+    for(int index = 0; index < TEST_COUNT(TEST); ++index) {
+
+        if(TEST[index]() == NESL_FAILURE) {
+            result = NESL_FAILURE;
+        }
+    }
+
+    return (int)result;
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
@@ -0,0 +1,449 @@
+/*
+ * NESL
+ * Copyright (C) 2022 David Jolly
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+ * @file main.c
+ * @brief Test application for save slots.
+ */
+
+#include <inttypes.h>
+#include <sys/stat.h>
+#include <stddef.h>
+#include <unistd.h>
+#include <slot.h>
+#include <test.h>
+
+#define TEST_DIRECTORY "."                  /*!< Test save slot directory */
+#define TEST_DIRECTORY_REMOVED "./test.slots"   /*!< Test save slot directory, removed after initialization */
+#define TEST_HASH 0x0123456789ABCDEF        /*!< Test cartridge data hash */
+
+/*!
+ * @struct nesl_test_t
+ * @brief Contains the test contexts.
+ */
+typedef struct {
+    nesl_slot_t slot;                       /*!< Save slot context */
+    uint8_t state[2][64];                   /*!< States */
+} nesl_test_t;
+
+static nesl_test_t g_test = {};             /*!< Test context */
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+uint64_t nesl_hash(const void *data, size_t length, uint64_t seed)
+{
+    uint64_t result = seed;
+
+    for(size_t index = 0; index < length; ++index) {
+        result = (result * 31) + ((const uint8_t *)data)[index];
+    }
+
+    return result;
+}
+
+size_t nesl_lz_compress(const void *data, size_t length, void *compressed, size_t capacity)
+{
+    size_t result = 0;
+
+    if(length <= capacity) {
+        memcpy(compressed, data, length);
+        result = length;
+    }
+
+    return result;
+}
+
+size_t nesl_lz_decompress(const void *compressed, size_t length, void *data, size_t capacity)
+{
+    size_t result = 0;
+
+    if(length <= capacity) {
+        memcpy(data, compressed, length);
+        result = length;
+    }
+
+    return result;
+}
+
+nesl_error_e nesl_set_error(const char *file, const char *function, int line, const char *format, ...)
+{
+    return NESL_FAILURE;
+}
+
+/*!
+ * @brief Get test save slot path.
+ * @param[out] path Pointer to path string
+ * @param[in] length Path string length in bytes
+ * @param[in] index Save slot index
+ */
+static void nesl_test_get_path(char *path, size_t length, int index)
+{
+    snprintf(path, length, "%s/%016" PRIx64 ".%i.state", TEST_DIRECTORY, (uint64_t)TEST_HASH, index + 1);
+}
+
+/*!
+ * @brief Uninitialize test context, removing any test save slots.
+ */
+static void nesl_test_uninitialize(void)
+{
+    nesl_slot_uninitialize(&g_test.slot);
+
+    for(int index = 0; index < SLOT_COUNT; ++index) {
+        char path[256] = {};
+
+        nesl_test_get_path(path, sizeof(path), index);
+        remove(path);
+    }
+
+    memset(&g_test, 0, sizeof(g_test));
+}
+
+/*!
+ * @brief Initialize test context, with the two states differing in every byte.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_initialize(void)
+{
+    nesl_test_uninitialize();
+
+    for(int index = 0; index < TEST_COUNT(g_test.state); ++index) {
+
+        for(int offset = 0; offset < TEST_COUNT(g_test.state[index]); ++offset) {
+            g_test.state[index][offset] = offset + (index * 0x80);
+        }
+    }
+
+    return nesl_slot_initialize(&g_test.slot, TEST_DIRECTORY, TEST_HASH, sizeof(g_test.state[0]));
+}
+
+/*!
+ * @brief Test save slot initialization.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_slot_initialize(void)
+{
+    nesl_error_e result = NESL_SUCCESS;
+
+    if(ASSERT(nesl_test_initialize() == NESL_SUCCESS)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    if(ASSERT(g_test.slot.data && (g_test.slot.hash == TEST_HASH) && (g_test.slot.length == sizeof(g_test.state[0]))
+            && (g_test.slot.writer.active == -1) && !g_test.slot.writer.quit)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    for(int index = 0; index < SLOT_COUNT; ++index) {
+
+        if(ASSERT((g_test.slot.state[index] == g_test.slot.data + (index * g_test.slot.length)) && !g_test.slot.pending[index])) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+    }
+
+    if(ASSERT((g_test.slot.load == g_test.slot.data + (SLOT_COUNT * g_test.slot.length))
+            && (g_test.slot.writer.state == g_test.slot.load + g_test.slot.length)
+            && (g_test.slot.writer.compressed == g_test.slot.writer.state + g_test.slot.length))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    nesl_slot_uninitialize(&g_test.slot);
+
+    if(ASSERT(!g_test.slot.data && !g_test.slot.length)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+    nesl_test_uninitialize();
+
+    return result;
+}
+
+/*!
+ * @brief Test save slot load.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_slot_load(void)
+{
+    const void *state = NULL;
+    nesl_error_e result = NESL_SUCCESS;
+
+    if(ASSERT(nesl_test_initialize() == NESL_SUCCESS)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    if(ASSERT(!nesl_slot_load(&g_test.slot, 0) && !nesl_slot_load(&g_test.slot, -1) && !nesl_slot_load(&g_test.slot, SLOT_COUNT))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    nesl_slot_save(&g_test.slot, 0, g_test.state[0]);
+    nesl_slot_save(&g_test.slot, 1, g_test.state[1]);
+
+    if(ASSERT((state = nesl_slot_load(&g_test.slot, 0)) && !memcmp(state, g_test.state[0], sizeof(g_test.state[0])))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    if(ASSERT((state = nesl_slot_load(&g_test.slot, 1)) && !memcmp(state, g_test.state[1], sizeof(g_test.state[1])))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    nesl_slot_uninitialize(&g_test.slot);
+
+    if(ASSERT(nesl_slot_initialize(&g_test.slot, TEST_DIRECTORY, TEST_HASH, sizeof(g_test.state[0])) == NESL_SUCCESS)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    if(ASSERT((state = nesl_slot_load(&g_test.slot, 0)) && !memcmp(state, g_test.state[0], sizeof(g_test.state[0])))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    if(ASSERT((state = nesl_slot_load(&g_test.slot, 1)) && !memcmp(state, g_test.state[1], sizeof(g_test.state[1])))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    if(ASSERT(!nesl_slot_load(&g_test.slot, 2))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    nesl_slot_uninitialize(&g_test.slot);
+
+    if(ASSERT(nesl_slot_initialize(&g_test.slot, TEST_DIRECTORY, TEST_HASH + 1, sizeof(g_test.state[0])) == NESL_SUCCESS)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    if(ASSERT(!nesl_slot_load(&g_test.slot, 0))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    nesl_slot_uninitialize(&g_test.slot);
+
+    if(ASSERT(nesl_slot_initialize(&g_test.slot, TEST_DIRECTORY, TEST_HASH, sizeof(g_test.state[0]) / 2) == NESL_SUCCESS)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    if(ASSERT(!nesl_slot_load(&g_test.slot, 0))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+    nesl_test_uninitialize();
+
+    return result;
+}
+
+/*!
+ * @brief Test save slot load from a corrupted save slot.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_slot_load_corrupt(void)
+{
+    FILE *file = NULL;
+    char path[256] = {};
+    nesl_error_e result = NESL_SUCCESS;
+
+    if(ASSERT(nesl_test_initialize() == NESL_SUCCESS)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    nesl_slot_save(&g_test.slot, 0, g_test.state[0]);
+    nesl_slot_save(&g_test.slot, 1, g_test.state[1]);
+    nesl_slot_uninitialize(&g_test.slot);
+    nesl_test_get_path(path, sizeof(path), 0);
+
+    if(ASSERT((file = fopen(path, "r+b")) != NULL)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    fseek(file, sizeof(nesl_slot_header_t), SEEK_SET);
+    fputc(0xFF, file);
+    fclose(file);
+    nesl_test_get_path(path, sizeof(path), 1);
+
+    if(ASSERT((file = fopen(path, "r+b")) != NULL)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    fseek(file, offsetof(nesl_slot_header_t, slot), SEEK_SET);
+    fputc(0x02, file);
+    fclose(file);
+
+    if(ASSERT(nesl_slot_initialize(&g_test.slot, TEST_DIRECTORY, TEST_HASH, sizeof(g_test.state[0])) == NESL_SUCCESS)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    if(ASSERT(!nesl_slot_load(&g_test.slot, 0) && !nesl_slot_load(&g_test.slot, 1))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+    nesl_test_uninitialize();
+
+    return result;
+}
+
+/*!
+ * @brief Test save slot save.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_slot_save(void)
+{
+    const void *state = NULL;
+    nesl_error_e result = NESL_SUCCESS;
+
+    if(ASSERT(nesl_test_initialize() == NESL_SUCCESS)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    for(int index = 0; index < 16; ++index) {
+        nesl_slot_save(&g_test.slot, SLOT_COUNT - 1, g_test.state[index % (TEST_COUNT(g_test.state))]);
+    }
+
+    nesl_slot_save(&g_test.slot, -1, g_test.state[0]);
+    nesl_slot_save(&g_test.slot, SLOT_COUNT, g_test.state[0]);
+    nesl_slot_uninitialize(&g_test.slot);
+
+    if(ASSERT(nesl_slot_initialize(&g_test.slot, TEST_DIRECTORY, TEST_HASH, sizeof(g_test.state[0])) == NESL_SUCCESS)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    if(ASSERT((state = nesl_slot_load(&g_test.slot, SLOT_COUNT - 1)) && !memcmp(state, g_test.state[1], sizeof(g_test.state[1])))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    for(int index = 0; index < (SLOT_COUNT - 1); ++index) {
+
+        if(ASSERT(!nesl_slot_load(&g_test.slot, index))) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+    }
+
+exit:
+    TEST_RESULT(result);
+    nesl_test_uninitialize();
+
+    return result;
+}
+
+/*!
+ * @brief Test save slot save failure, reported by the next save.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_slot_save_failure(void)
+{
+    bool written = false;
+    nesl_error_e result = NESL_SUCCESS;
+
+    nesl_test_uninitialize();
+    rmdir(TEST_DIRECTORY_REMOVED);
+
+    if(ASSERT(nesl_slot_initialize(&g_test.slot, TEST_DIRECTORY_REMOVED, TEST_HASH, sizeof(g_test.state[0])) == NESL_FAILURE)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    if(ASSERT(!mkdir(TEST_DIRECTORY_REMOVED, 0755)
+            && (nesl_slot_initialize(&g_test.slot, TEST_DIRECTORY_REMOVED, TEST_HASH, sizeof(g_test.state[0])) == NESL_SUCCESS)
+            && !rmdir(TEST_DIRECTORY_REMOVED))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    if(ASSERT(nesl_slot_save(&g_test.slot, 0, g_test.state[0]) == NESL_SUCCESS)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    while(!written) {
+        pthread_mutex_lock(&g_test.slot.writer.lock);
+        written = !g_test.slot.pending[0] && (g_test.slot.writer.active == -1);
+        pthread_mutex_unlock(&g_test.slot.writer.lock);
+    }
+
+    if(ASSERT((g_test.slot.writer.error == ENOENT) && (g_test.slot.writer.failed == 0))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    if(ASSERT(nesl_slot_save(&g_test.slot, 1, g_test.state[1]) == NESL_FAILURE)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+    nesl_test_uninitialize();
+    rmdir(TEST_DIRECTORY_REMOVED);
+
+    return result;
+}
+
+int main(void)
+{
+    const test TEST[] = {
+        nesl_test_slot_initialize, nesl_test_slot_load, nesl_test_slot_load_corrupt, nesl_test_slot_save,
+        nesl_test_slot_save_failure,
+        };
+
+    nesl_error_e result = NESL_SUCCESS;
+
+    for(int index = 0; index < TEST_COUNT(TEST); ++index) {
+
+        if(TEST[index]() == NESL_FAILURE) {
+            result = NESL_FAILURE;
+        }
+    }
+
+    return (int)result;
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
@@ -0,0 +1,318 @@
+/*
+ * NESL
+ * Copyright (C) 2022 David Jolly
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+ * @file main.c
+ * @brief Test application for startup snapshot cache.
+ */
+
+#include <inttypes.h>
+#include <snapshot.h>
+#include <test.h>
+
+#define TEST_DIRECTORY "."                  /*!< Test snapshot directory */
+
+/*!
+ * @struct nesl_test_t
+ * @brief Contains the test contexts.
+ */
+typedef struct {
+    uint8_t data[2][64];                    /*!< Cartridge data */
+    uint8_t state[32];                      /*!< Bus state */
+    int cycle;                              /*!< Bus cycle count */
+    bool loaded;                            /*!< Bus state loaded */
+
+    struct {
+        bool enabled;                       /*!< Input enabled state */
+        uint8_t state;                      /*!< Input state */
+    } input;
+} nesl_test_t;
+
+static nesl_test_t g_test = {};             /*!< Test context */
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+bool nesl_bus_cycle(void)
+{
+    g_test.state[g_test.cycle++ % sizeof(g_test.state)] += 1;
+
+    return true;
+}
+
+size_t nesl_bus_load(const void *data)
+{
+    memcpy(g_test.state, data, sizeof(g_test.state));
+    g_test.loaded = true;
+
+    return sizeof(g_test.state);
+}
+
+size_t nesl_bus_save(void *data)
+{
+
+    if(data) {
+        memcpy(data, g_test.state, sizeof(g_test.state));
+    }
+
+    return sizeof(g_test.state);
+}
+
+const nesl_version_t *nesl_get_version(void)
+{
+    static const nesl_version_t VERSION = { .major = 1, .minor = 2, .patch = 3, };
+
+    return &VERSION;
+}
+
+uint64_t nesl_hash(const void *data, size_t length, uint64_t seed)
+{
+    uint64_t result = seed;
+
+    for(size_t index = 0; index < length; ++index) {
+        result = (result * 31) + ((const uint8_t *)data)[index];
+    }
+
+    return result;
+}
+
+size_t nesl_lz_compress(const void *data, size_t length, void *compressed, size_t capacity)
+{
+    size_t result = 0;
+
+    if(length <= capacity) {
+        memcpy(compressed, data, length);
+        result = length;
+    }
+
+    return result;
+}
+
+size_t nesl_lz_decompress(const void *compressed, size_t length, void *data, size_t capacity)
+{
+    size_t result = 0;
+
+    if(length <= capacity) {
+        memcpy(data, compressed, length);
+        result = length;
+    }
+
+    return result;
+}
+
+void nesl_service_set_input(bool enabled, uint8_t state)
+{
+    g_test.input.enabled = enabled;
+    g_test.input.state = state;
+}
+
+nesl_error_e nesl_set_error(const char *file, const char *function, int line, const char *format, ...)
+{
+    return NESL_FAILURE;
+}
+
+/*!
+ * @brief Get test snapshot path.
+ * @param[out] path Pointer to path string
+ * @param[in] length Path string length in bytes
+ * @param[in] index Cartridge data index
+ */
+static void nesl_test_get_path(char *path, size_t length, int index)
+{
+    snprintf(path, length, "%s/%016" PRIx64 ".snapshot", TEST_DIRECTORY, nesl_hash(g_test.data[index], sizeof(g_test.data[index]), 0));
+}
+
+/*!
+ * @brief Uninitialize test context, removing any test snapshots.
+ */
+static void nesl_test_uninitialize(void)
+{
+
+    for(int index = 0; index < TEST_COUNT(g_test.data); ++index) {
+        char path[256] = {};
+
+        nesl_test_get_path(path, sizeof(path), index);
+        remove(path);
+    }
+
+    memset(&g_test, 0, sizeof(g_test));
+}
+
+/*!
+ * @brief Initialize test context, with the two cartridges differing in one byte.
+ */
+static void nesl_test_initialize(void)
+{
+    nesl_test_uninitialize();
+
+    for(int index = 0; index < TEST_COUNT(g_test.data); ++index) {
+
+        for(int offset = 0; offset < TEST_COUNT(g_test.data[index]); ++offset) {
+            g_test.data[index][offset] = offset;
+        }
+    }
+
+    g_test.data[1][63] = 0xFF;
+}
+
+/*!
+ * @brief Reset test bus state, as if a new bus was initialized.
+ */
+static void nesl_test_reset(void)
+{
+    memset(g_test.state, 0, sizeof(g_test.state));
+    g_test.cycle = 0;
+    g_test.loaded = false;
+    g_test.input.enabled = false;
+    g_test.input.state = 0xFF;
+}
+
+/*!
+ * @brief Test startup snapshot boot.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_snapshot_boot(void)
+{
+    uint8_t state[32] = {};
+    char directory[8192] = {};
+    nesl_error_e result = NESL_SUCCESS;
+
+    nesl_test_initialize();
+    nesl_test_reset();
+
+    if(ASSERT((nesl_snapshot_boot(TEST_DIRECTORY, g_test.data[0], sizeof(g_test.data[0])) == NESL_SUCCESS)
+            && (g_test.cycle == SNAPSHOT_FRAMES) && !g_test.loaded && g_test.input.enabled && !g_test.input.state)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    memcpy(state, g_test.state, sizeof(state));
+    nesl_test_reset();
+
+    if(ASSERT((nesl_snapshot_boot(TEST_DIRECTORY, g_test.data[0], sizeof(g_test.data[0])) == NESL_SUCCESS)
+            && !g_test.cycle && g_test.loaded && !memcmp(state, g_test.state, sizeof(state)))) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    nesl_test_reset();
+
+    if(ASSERT((nesl_snapshot_boot(TEST_DIRECTORY, g_test.data[1], sizeof(g_test.data[1])) == NESL_SUCCESS)
+            && (g_test.cycle == SNAPSHOT_FRAMES) && !g_test.loaded)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    nesl_test_reset();
+
+    if(ASSERT(nesl_snapshot_boot(TEST_DIRECTORY "/missing", g_test.data[0], sizeof(g_test.data[0])) == NESL_FAILURE)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    memset(directory, 'a', sizeof(directory) - 1);
+    nesl_test_reset();
+
+    if(ASSERT(nesl_snapshot_boot(directory, g_test.data[0], sizeof(g_test.data[0])) == NESL_FAILURE)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+    nesl_test_uninitialize();
+
+    return result;
+}
+
+/*!
+ * @brief Test startup snapshot boot from a corrupted snapshot.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_snapshot_boot_corrupt(void)
+{
+    FILE *file = NULL;
+    char path[256] = {};
+    nesl_error_e result = NESL_SUCCESS;
+
+    nesl_test_initialize();
+    nesl_test_reset();
+
+    if(ASSERT(nesl_snapshot_boot(TEST_DIRECTORY, g_test.data[0], sizeof(g_test.data[0])) == NESL_SUCCESS)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    nesl_test_get_path(path, sizeof(path), 0);
+
+    if(ASSERT((file = fopen(path, "r+b")) != NULL)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    fseek(file, sizeof(nesl_snapshot_header_t), SEEK_SET);
+    fputc(0xFF, file);
+    fclose(file);
+    nesl_test_reset();
+
+    if(ASSERT((nesl_snapshot_boot(TEST_DIRECTORY, g_test.data[0], sizeof(g_test.data[0])) == NESL_SUCCESS)
+            && (g_test.cycle == SNAPSHOT_FRAMES) && !g_test.loaded)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+    nesl_test_reset();
+
+    if(ASSERT((nesl_snapshot_boot(TEST_DIRECTORY, g_test.data[0], sizeof(g_test.data[0])) == NESL_SUCCESS)
+            && !g_test.cycle && g_test.loaded)) {
+        result = NESL_FAILURE;
+        goto exit;
+    }
+
+exit:
+    TEST_RESULT(result);
+    nesl_test_uninitialize();
+
+    return result;
+}
+
+int main(void)
+{
+    const test TEST[] = {
+        nesl_test_snapshot_boot, nesl_test_snapshot_boot_corrupt,
+        };
+
+    nesl_error_e result = NESL_SUCCESS;
+
+    for(int index = 0; index < TEST_COUNT(TEST); ++index) {
+
+        if(TEST[index]() == NESL_FAILURE) {
+            result = NESL_FAILURE;
+        }
+    }
+
+    return (int)result;
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
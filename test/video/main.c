@@ -42,6 +42,10 @@ typedef struct {
         nesl_interrupt_e int_type;  /*!< Bus interrupt */
         nesl_mirror_e mirror;       /*!< Bus mirror */
     } bus;
+
+    struct {
+        int count;                  /*!< Pixel count */
+    } pixel;
 } nesl_test_t;
 
 /*!
@@ -98,7 +102,7 @@ void nesl_bus_write(nesl_bus_e type, uint16_t address, uint8_t data)
 
 void nesl_service_set_pixel(uint8_t color, bool red_emphasis, bool green_emphasis, bool blue_emphasis, uint8_t x, uint8_t y)
 {
-    return;
+    ++g_test.pixel.count;
 }
 
 /*!
@@ -617,6 +621,36 @@ exit:
     return result;
 }
 
+/*!
+ * @brief Test video subsystem hidden frames.
+ * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
+ */
+static nesl_error_e nesl_test_video_hidden(void)
+{
+    nesl_error_e result = NESL_SUCCESS;
+
+    for(int hidden = 0; hidden <= 1; ++hidden) {
+
+        if((result = nesl_test_initialize(MIRROR_HORIZONTAL, true)) == NESL_FAILURE) {
+            goto exit;
+        }
+
+        g_test.video.hidden = hidden;
+
+        while(!nesl_video_cycle(&g_test.video));
+
+        if(ASSERT((g_test.pixel.count == 0) == hidden)) {
+            result = NESL_FAILURE;
+            goto exit;
+        }
+    }
+
+exit:
+    TEST_RESULT(result);
+
+    return result;
+}
+
 /*!
  * @brief Test video subsystem initialization.
  * @return NESL_FAILURE on failure, NESL_SUCCESS otherwise
@@ -928,7 +962,7 @@ exit:
 int main(void)
 {
     const test TEST[] = {
-        nesl_test_video_cycle, nesl_test_video_initialize, nesl_test_video_read, nesl_test_video_read_port,
+        nesl_test_video_cycle, nesl_test_video_hidden, nesl_test_video_initialize, nesl_test_video_read, nesl_test_video_read_port,
         nesl_test_video_reset, nesl_test_video_uninitialize, nesl_test_video_write, nesl_test_video_write_port,
         };
 